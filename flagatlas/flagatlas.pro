@@ -0,0 +1,21 @@
+QT += gui
+
+TEMPLATE = app
+TARGET = flagatlas
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+mac:CONFIG += sdk_no_version_check
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    ../leif/utils/atlaspacker.cpp \
+    main.cpp
+
+HEADERS += \
+    ../leif/utils/atlaspacker.h
+
+INCLUDEPATH += ../leif
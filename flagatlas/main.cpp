@@ -0,0 +1,143 @@
+/**
+ * @brief Defines the main() method of the flagatlas build tool.
+ *
+ * flagatlas packs the country flags into one atlas image and writes it,
+ * together with the place of every flag, into a C++ source file:
+ *
+ * \code
+ * flagatlas --output flagatlas_data.cpp img/flags/de.png img/flags/fr.png ...
+ * \endcode
+ *
+ * The flag is named after the file, without the extension. The tool runs at
+ * build time, see pri/flagatlas.pri.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMap>
+#include <QPainter>
+#include <QTextStream>
+
+#include "utils/atlaspacker.h"
+
+namespace
+{
+QByteArray sourceFile(const QByteArray &png, const QMap<QString, QRect> &entries)
+{
+    QByteArray source;
+    source.reserve(png.size() * 6 + entries.count() * 64 + 512);
+
+    source += "// Generated by flagatlas, do not edit.\n"
+              "#include \"utils/flagatlasdata.h\"\n\n"
+              "namespace FlagAtlasData\n{\n"
+              "const unsigned char png[] = {";
+
+    for(qsizetype i = 0; i < png.size(); ++i)
+    {
+        source += (i % 16 == 0) ? "\n    " : " ";
+        source += QByteArray::number(static_cast<uchar>(png.at(i))) + ',';
+    }
+
+    source += "\n};\n\nconst int pngSize {" + QByteArray::number(png.size()) + "};\n\n"
+              "const Entry entries[] = {\n";
+
+    for(auto it = entries.cbegin(); it != entries.cend(); ++it)
+    {
+        const QRect &rect = it.value();
+        source += "    {\"" + it.key().toUtf8() + "\", " +
+                  QByteArray::number(rect.x()) + ", " + QByteArray::number(rect.y()) + ", " +
+                  QByteArray::number(rect.width()) + ", " + QByteArray::number(rect.height()) + "},\n";
+    }
+
+    source += "};\n\nconst int entryCount {" + QByteArray::number(entries.count()) + "};\n}\n";
+
+    return source;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("flagatlas"));
+
+    const QCommandLineOption outputOption {{QStringLiteral("o"), QStringLiteral("output")}, QStringLiteral("The C++ source file to write."), QStringLiteral("file")};
+    const QCommandLineOption imageOption {QStringLiteral("image"), QStringLiteral("Also writes the atlas as an image, to look at it."), QStringLiteral("file")};
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Packs the flag images into one atlas."));
+    parser.addHelpOption();
+    parser.addOptions({outputOption, imageOption});
+    parser.addPositionalArgument(QStringLiteral("images"), QStringLiteral("The flag images."), QStringLiteral("images..."));
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    if(!parser.isSet(outputOption) || parser.positionalArguments().isEmpty())
+    {
+        parser.showHelp(1);
+    }
+
+    QStringList codes;
+    QList<QImage> images;
+    QList<QSize> sizes;
+
+    for(const QString &fileName : parser.positionalArguments())
+    {
+        QImage image {fileName};
+        if(image.isNull())
+        {
+            err << "Could not read " << fileName << Qt::endl;
+            return 1;
+        }
+
+        codes << QFileInfo(fileName).completeBaseName();
+        sizes << image.size();
+        images << image;
+    }
+
+    Utils::AtlasPacker packer;
+    if(!packer.pack(sizes))
+    {
+        err << "The flags don't fit into the atlas." << Qt::endl;
+        return 1;
+    }
+
+    QImage atlas {packer.size(), QImage::Format_ARGB32_Premultiplied};
+    atlas.fill(Qt::transparent);
+
+    QMap<QString, QRect> entries;
+    {
+        QPainter painter {&atlas};
+        for(qsizetype i = 0; i < images.count(); ++i)
+        {
+            painter.drawImage(packer.rects().at(i).topLeft(), images.at(i));
+            entries.insert(codes.at(i), packer.rects().at(i));
+        }
+    }
+
+    QByteArray png;
+    QBuffer buffer {&png};
+    buffer.open(QIODevice::WriteOnly);
+    atlas.save(&buffer, "PNG");
+
+    if(parser.isSet(imageOption))
+    {
+        atlas.save(parser.value(imageOption));
+    }
+
+    QFile output {parser.value(outputOption)};
+    if(!output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(sourceFile(png, entries)) < 0)
+    {
+        err << "Could not write " << output.fileName() << ": " << output.errorString() << Qt::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,324 @@
+/**
+ * @brief Defines the main() method of the leif-collector tool.
+ *
+ * leif-collector receives the fleet reports of many Leif instances (see
+ * FleetReporter), sums them up per country and region and appends a CSV
+ * rollup every interval:
+ *
+ * \code
+ * leif-collector --interval 300 --output fleet.csv
+ * \endcode
+ *
+ * It also generates load for itself, to check what one collector can take:
+ *
+ * \code
+ * leif-collector --seconds 30 &
+ * leif-collector --generate 50000 --hosts 10000 --simulate-regions 500 --seconds 10 127.0.0.1
+ * \endcode
+ *
+ * @sa Utils::FleetAggregator, Utils::FleetReport
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHostAddress>
+#include <QLocale>
+#include <QThread>
+#include <QTimer>
+#include <QTextStream>
+#include <QUdpSocket>
+
+#include <iterator>
+
+#include "utils/fleetaggregator.h"
+#include "utils/fleetreport.h"
+#include "utils/quitonsignals.h"
+
+namespace
+{
+// Bursts must not overflow the kernel buffer between two reads.
+constexpr int ReceiveBufferSize {8 * 1024 * 1024};
+
+// Datagrams read per wake-up, so signals and timers still get through under
+// sustained load.
+constexpr int MaxDatagramsPerRead {1024};
+
+constexpr int MaxDatagramSize {Utils::FleetReport::HeaderSize + Utils::FleetReport::MaxSamples * Utils::FleetReport::SampleSize};
+
+/**
+ * @brief Appends the rollups since the last call to \p output and prints
+ * the counters to stderr.
+ */
+void writeRollups(Utils::FleetAggregator &aggregator, QFile &output, QElapsedTimer &interval)
+{
+    static quint64 lastReports {0};
+
+    const QList<Utils::FleetAggregator::Rollup> rollups = aggregator.takeRollups();
+    output.write(Utils::FleetAggregator::toCsv(QDateTime::currentDateTimeUtc(), rollups));
+    output.flush();
+
+    const quint64 reports = aggregator.reportCount();
+    const double seconds = qMax<qint64>(1, interval.restart()) / 1000.0;
+
+    QTextStream(stderr) << "Reports: " << reports << " (" << qRound64((reports - lastReports) / seconds) << "/s), "
+                        << "regions: " << aggregator.regionCount() << ", "
+                        << "malformed: " << aggregator.malformedCount() << ", "
+                        << "dropped samples: " << aggregator.droppedCount() << Qt::endl;
+
+    lastReports = reports;
+}
+
+/**
+ * @brief Receives reports on \p address and \p port until the application
+ * quits.
+ *
+ * The socket is read on the main thread, the rollups are written by a timer
+ * on a second thread. The aggregator is lock free, so writing never holds up
+ * receiving.
+ */
+int collect(QCoreApplication &app, const QHostAddress &address, quint16 port, int intervalInSeconds,
+            const QString &outputFileName, int capacity)
+{
+    QTextStream err(stderr);
+
+    QFile output {outputFileName};
+    const bool opened = outputFileName.isEmpty() ? output.open(stdout, QIODevice::WriteOnly)
+                                                 : output.open(QIODevice::WriteOnly | QIODevice::Append);
+    if(!opened)
+    {
+        err << "Could not open the output: " << output.errorString() << "\n";
+        return 1;
+    }
+
+    if(output.size() == 0)
+    {
+        output.write(Utils::FleetAggregator::csvHeader());
+    }
+
+    Utils::FleetAggregator aggregator {capacity};
+
+    QUdpSocket socket;
+    if(!socket.bind(address, port))
+    {
+        err << "Could not listen on " << address.toString() << ":" << port << ": " << socket.errorString() << "\n";
+        return 2;
+    }
+
+    socket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, ReceiveBufferSize);
+
+    QByteArray buffer(MaxDatagramSize + 1, Qt::Uninitialized);
+    QObject::connect(&socket, &QUdpSocket::readyRead, &socket, [&]() {
+        // Qt emits readyRead() again for the rest.
+        for(int read = 0; read < MaxDatagramsPerRead && socket.hasPendingDatagrams(); ++read)
+        {
+            const qint64 size = socket.readDatagram(buffer.data(), buffer.size());
+            if(size >= 0)
+            {
+                aggregator.addReport(buffer.constData(), size);
+            }
+        }
+    });
+
+    QElapsedTimer interval;
+    interval.start();
+
+    QThread writer;
+    writer.setObjectName(QStringLiteral("RollupWriter"));
+
+    QTimer timer;
+    timer.setInterval(intervalInSeconds * 1000);
+    timer.moveToThread(&writer);
+
+    QObject::connect(&timer, &QTimer::timeout, &timer, [&]() { writeRollups(aggregator, output, interval); });
+    QObject::connect(&writer, &QThread::started, &timer, qOverload<>(&QTimer::start));
+    writer.start(QThread::LowPriority);
+
+    err << "Collecting on " << address.toString() << ":" << port << ", rollups every " << intervalInSeconds << " s." << Qt::endl;
+
+    const int result = app.exec();
+
+    QMetaObject::invokeMethod(&timer, &QTimer::stop, Qt::BlockingQueuedConnection);
+    writer.quit();
+    writer.wait();
+
+    // The reports since the last rollup.
+    writeRollups(aggregator, output, interval);
+
+    return result;
+}
+
+/**
+ * @brief Sends \p rate reports per second from \p hosts simulated hosts in
+ * \p regions regions to \p address and \p port for \p seconds seconds.
+ *
+ * Every host sends a full batch of samples like a FleetReporter. The totals
+ * are printed, so they can be compared with the rollups of the collector.
+ */
+int generate(const QHostAddress &address, quint16 port, int rate, int hosts, int seconds, int regions)
+{
+    static const QLocale::Country countries[] {QLocale::UnitedKingdom, QLocale::Germany, QLocale::France, QLocale::UnitedStates};
+
+    QList<QByteArray> datagrams;
+    datagrams.reserve(hosts);
+
+    quint64 energyInMilliWattHours {0};
+    quint64 carbonInMilligrams {0};
+    QList<quint64> reportEnergy;
+    QList<quint64> reportCarbon;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    for(int host = 0; host < hosts; ++host)
+    {
+        QList<Utils::FleetReport::Sample> samples;
+        quint64 energy {0};
+        quint64 carbon {0};
+
+        for(int minute = 0; minute < 15; ++minute)
+        {
+            const int region = (host + minute) % regions;
+
+            Utils::FleetReport::Sample sample;
+            sample.timeInMs = now + minute * 60 * 1000;
+            sample.country = static_cast<quint16>(countries[region % std::size(countries)]);
+            sample.setRegionId(QString::number(region));
+            sample.co2PerkWh = static_cast<quint16>(50 + (host * 7 + minute * 13) % 400);
+            sample.energyInMilliWattHours = static_cast<quint32>(200 + host % 1500);
+            sample.carbonInMilligrams = sample.energyInMilliWattHours * sample.co2PerkWh / 1000;
+
+            energy += sample.energyInMilliWattHours;
+            carbon += sample.carbonInMilligrams;
+            samples << sample;
+        }
+
+        Utils::FleetReport::Header header;
+        header.sender = static_cast<quint64>(host) + 1;
+
+        datagrams << Utils::FleetReport::encode(header, samples);
+        reportEnergy << energy;
+        reportCarbon << carbon;
+    }
+
+    QUdpSocket socket;
+
+    const qint64 total = static_cast<qint64>(rate) * seconds;
+    qint64 sent {0};
+    qint64 failed {0};
+
+    QElapsedTimer clock;
+    clock.start();
+
+    while(sent < total)
+    {
+        // Paced by the reports due so far, not by sleeping per report.
+        const qint64 due = qMin(total, clock.nsecsElapsed() * rate / 1000000000);
+        if(sent >= due)
+        {
+            QThread::usleep(100);
+            continue;
+        }
+
+        for(; sent < due; ++sent)
+        {
+            const int host = static_cast<int>(sent % hosts);
+
+            if(socket.writeDatagram(datagrams.at(host), address, port) < 0)
+            {
+                ++failed;
+                continue;
+            }
+
+            energyInMilliWattHours += reportEnergy.at(host);
+            carbonInMilligrams += reportCarbon.at(host);
+        }
+    }
+
+    const double elapsed = qMax<qint64>(1, clock.elapsed()) / 1000.0;
+
+    QTextStream(stdout) << "Sent " << sent - failed << " reports (" << failed << " failed) in " << elapsed << " s, "
+                        << qRound64((sent - failed) / elapsed) << "/s.\n"
+                        << "Energy: " << QString::number(energyInMilliWattHours / 1000.0, 'f', 3) << " Wh, "
+                        << "carbon: " << QString::number(carbonInMilligrams / 1000.0, 'f', 3) << " g\n";
+
+    return failed == 0 ? 0 : 3;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("leif-collector"));
+
+    const QString defaultPort = QString::number(Utils::FleetReport::DefaultPort);
+
+    const QCommandLineOption bindOption {QStringLiteral("bind"), QStringLiteral("The address to listen on."), QStringLiteral("address"), QStringLiteral("0.0.0.0")};
+    const QCommandLineOption portOption {QStringLiteral("port"), QStringLiteral("The UDP port."), QStringLiteral("port"), defaultPort};
+    const QCommandLineOption intervalOption {QStringLiteral("interval"), QStringLiteral("Seconds between two rollups."), QStringLiteral("seconds"), QStringLiteral("60")};
+    const QCommandLineOption outputOption {QStringLiteral("output"), QStringLiteral("Appends the rollups to this CSV file instead of stdout."), QStringLiteral("file")};
+    const QCommandLineOption capacityOption {QStringLiteral("capacity"), QStringLiteral("The most regions to keep apart, samples of further regions are dropped."), QStringLiteral("count"), QString::number(Utils::FleetAggregator::DefaultCapacity)};
+    const QCommandLineOption secondsOption {QStringLiteral("seconds"), QStringLiteral("Stop after this many seconds."), QStringLiteral("seconds")};
+    const QCommandLineOption generateOption {QStringLiteral("generate"), QStringLiteral("Send this many reports per second to the collector given as argument."), QStringLiteral("rate")};
+    const QCommandLineOption hostsOption {QStringLiteral("hosts"), QStringLiteral("The number of hosts to simulate with --generate."), QStringLiteral("count"), QStringLiteral("1000")};
+    const QCommandLineOption simulateRegionsOption {QStringLiteral("simulate-regions"), QStringLiteral("The number of regions to simulate with --generate."), QStringLiteral("count"), QStringLiteral("64")};
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Sums up the fleet reports of many Leif instances."));
+    parser.addHelpOption();
+    parser.addOptions({bindOption, portOption, intervalOption, outputOption, capacityOption, secondsOption, generateOption, hostsOption, simulateRegionsOption});
+    parser.addPositionalArgument(QStringLiteral("collector"), QStringLiteral("The collector address for --generate."), QStringLiteral("[collector]"));
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    bool portOk {false};
+    const uint port = parser.value(portOption).toUInt(&portOk);
+    if(!portOk || port == 0 || port > 65535)
+    {
+        err << "Invalid --port: " << parser.value(portOption) << "\n";
+        return 1;
+    }
+
+    const int seconds = parser.value(secondsOption).toInt();
+
+    if(parser.isSet(generateOption))
+    {
+        const QHostAddress target {parser.positionalArguments().value(0, QStringLiteral("127.0.0.1"))};
+        const int rate = parser.value(generateOption).toInt();
+        const int hosts = parser.value(hostsOption).toInt();
+        const int regions = parser.value(simulateRegionsOption).toInt();
+
+        if(target.isNull() || rate <= 0 || hosts <= 0 || regions <= 0)
+        {
+            err << "--generate needs a positive rate, --hosts and --simulate-regions, and a collector IP address.\n";
+            return 1;
+        }
+
+        return generate(target, static_cast<quint16>(port), rate, hosts, seconds > 0 ? seconds : 10, regions);
+    }
+
+    const QHostAddress address {parser.value(bindOption)};
+    const int interval = parser.value(intervalOption).toInt();
+    const int capacity = parser.value(capacityOption).toInt();
+
+    if(address.isNull() || interval <= 0 || capacity <= 0)
+    {
+        err << "Invalid --bind, --interval or --capacity.\n";
+        return 1;
+    }
+
+    // The last rollup is written on SIGTERM as well.
+    Utils::QuitOnSignals::install(&app);
+
+    if(seconds > 0)
+    {
+        QTimer::singleShot(seconds * 1000, &app, &QCoreApplication::quit);
+    }
+
+    return collect(app, address, static_cast<quint16>(port), interval, parser.value(outputOption), capacity);
+}
@@ -0,0 +1,236 @@
+/**
+ * @brief Defines the main() method of the leif-replay tool.
+ *
+ * leif-replay runs a recorded power and carbon intensity trace through the
+ * CarbonService on a simulated clock, thousands of times faster than real
+ * time. Use it to see how a change to the calculation or the forecasts
+ * behaves over weeks or months of real data:
+ *
+ * \code
+ * leif-replay --csv march.out.csv march.csv
+ * \endcode
+ *
+ * @sa ReplayTrace, Utils::SimulatedClock
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSettings>
+#include <QTextStream>
+
+#include <memory>
+
+#include "replaytrace.h"
+
+#include "interfaces/IDataProvider.h"
+#include "interfaces/IPower.h"
+#include "services/carbonservice.h"
+#include "services/settingsservice.h"
+#include "utils/clock.h"
+
+#include "log/log.h"
+#include "log/consolelogger.h"
+
+namespace
+{
+class TracePower : public IPower
+{
+public:
+    TracePower(const ReplayTrace &trace, const Utils::Clock &clock):
+        m_trace {trace},
+        m_clock {clock}
+    {}
+
+    virtual float powerDrawInWatts() override
+    {
+        return m_trace.powerAt(m_clock.now());
+    }
+
+private:
+    const ReplayTrace &m_trace;
+    const Utils::Clock &m_clock;
+};
+
+class TraceDataProvider : public IDataProvider
+{
+public:
+    using IDataProvider::carbonPerKiloWatt;
+
+    TraceDataProvider(const ReplayTrace &trace, const Utils::Clock &clock):
+        m_trace {trace},
+        m_clock {clock},
+        m_requests {0}
+    {}
+
+    /**
+     * @brief Answers like a carbon API would have at the simulated time.
+     *
+     * The next and later values are taken from the trace 30 and 60 minutes
+     * ahead, as if the forecast had been perfect.
+     */
+    virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override
+    {
+        Q_UNUSED(country)
+        Q_UNUSED(region)
+
+        ++m_requests;
+
+        const QDateTime now = m_clock.now();
+        const int intensity = m_trace.intensityAt(now);
+        if(intensity < 0)
+        {
+            return CarbonData::error(QStringLiteral("The trace has no carbon intensity yet."));
+        }
+
+        const int next = m_trace.intensityAt(now.addSecs(30 * 60));
+        const int later = m_trace.intensityAt(now.addSecs(60 * 60));
+
+        return CarbonData::ok(intensity, next, later, m_trace.intensityChangedAt(now), m_trace.intensityValidTo(now));
+    }
+
+    quint64 requests() const
+    {
+        return m_requests;
+    }
+
+private:
+    const ReplayTrace &m_trace;
+    const Utils::Clock &m_clock;
+    quint64 m_requests;
+};
+
+QString durationString(qint64 seconds)
+{
+    return QString("%1 days %2:%3")
+        .arg(seconds / 86400)
+        .arg((seconds % 86400) / 3600, 2, 10, QLatin1Char('0'))
+        .arg((seconds % 3600) / 60, 2, 10, QLatin1Char('0'));
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // The replay must never touch the settings of the real application.
+    QCoreApplication::setOrganizationName(QStringLiteral("leif-replay"));
+    QCoreApplication::setApplicationName(QStringLiteral("leif-replay"));
+
+    const QCommandLineOption csvOption {QStringLiteral("csv"), QStringLiteral("Write every calculation to <file>."), QStringLiteral("file")};
+    const QCommandLineOption verboseOption {QStringLiteral("verbose"), QStringLiteral("Log the calculations to the console.")};
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Replays a recorded power and carbon intensity trace through the carbon calculation."));
+    parser.addHelpOption();
+    parser.addOptions({csvOption, verboseOption});
+    parser.addPositionalArgument(QStringLiteral("trace"), QStringLiteral("CSV file with time,watts,gco2_per_kwh lines."));
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if(parser.positionalArguments().count() != 1)
+    {
+        err << "Exactly one trace file is required.\n";
+        return 1;
+    }
+
+    QFile traceFile {parser.positionalArguments().constFirst()};
+    if(!traceFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        err << "Could not open " << traceFile.fileName() << ": " << traceFile.errorString() << "\n";
+        return 1;
+    }
+
+    ReplayTrace trace;
+    QString errorString;
+    if(!trace.load(&traceFile, &errorString))
+    {
+        err << traceFile.fileName() << ": " << errorString << "\n";
+        return 1;
+    }
+
+    QFile csvFile;
+    QTextStream csv;
+    if(parser.isSet(csvOption))
+    {
+        csvFile.setFileName(parser.value(csvOption));
+        if(!csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        {
+            err << "Could not write " << csvFile.fileName() << ": " << csvFile.errorString() << "\n";
+            return 1;
+        }
+
+        csv.setDevice(&csvFile);
+        csv << "time,watts,gco2_per_kwh,session_gco2,usage_level,charge_forecast\n";
+    }
+
+    if(parser.isSet(verboseOption))
+        Log::LogSystem::logManager()->registerLogger(new Log::ConsoleLogger);
+
+    Utils::SimulatedClock clock {trace.start()};
+    Utils::Clock::setInstance(&clock);
+
+    SettingsService settings;
+    settings.saveLifetimeCarbon(0);
+
+    TraceDataProvider provider {trace, clock};
+    quint64 calculations {0};
+    double weightedIntensity {0};
+    double energyInWattMinutes {0};
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    {
+        CarbonService service {&settings, std::make_unique<TracePower>(trace, clock), &provider};
+
+        auto record = [&](const CarbonSnapshot &snapshot) {
+            ++calculations;
+
+            if(snapshot.carbon.isValid)
+            {
+                weightedIntensity += snapshot.powerDrawInWatts * snapshot.carbon.co2PerkWhNow;
+                energyInWattMinutes += snapshot.powerDrawInWatts;
+            }
+
+            if(csv.device() != nullptr)
+            {
+                csv << snapshot.timestamp.toString(Qt::ISODate) << ','
+                    << snapshot.powerDrawInWatts << ','
+                    << snapshot.carbon.co2PerkWhNow << ','
+                    << snapshot.sessionCarbon << ','
+                    << static_cast<int>(snapshot.usageLevel) << ','
+                    << static_cast<int>(snapshot.chargeForecast) << '\n';
+            }
+        };
+
+        // The service already calculated once for the start of the trace.
+        record(service.snapshot());
+        QObject::connect(&service, &CarbonService::snapshotChanged, record);
+
+        clock.runUntil(trace.end());
+
+        const qint64 wallTime = qMax<qint64>(1, elapsed.elapsed());
+        const qint64 simulated = trace.start().secsTo(trace.end());
+
+        out << "Replayed " << durationString(simulated) << " of trace in " << wallTime << " ms ("
+            << qRound64(simulated * 1000.0 / wallTime) << "x real time).\n";
+        out << "Calculations: " << calculations << ", carbon data requests: " << provider.requests() << "\n";
+        out << "Session carbon: " << QString::number(service.sessionCarbon(), 'f', 2) << " gCO2e\n";
+        out << "Energy: " << QString::number(energyInWattMinutes / 60 / 1000, 'f', 3) << " kWh\n";
+
+        if(energyInWattMinutes > 0)
+            out << "Average intensity: " << QString::number(weightedIntensity / energyInWattMinutes, 'f', 1) << " gCO2e/kWh\n";
+    }
+
+    Utils::Clock::setInstance(nullptr);
+    QSettings().clear();
+
+    return 0;
+}
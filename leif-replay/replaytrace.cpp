@@ -0,0 +1,199 @@
+/**
+ * @brief Implements the ReplayTrace class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QIODevice>
+
+#include <algorithm>
+#include <limits>
+
+#include "replaytrace.h"
+
+/**
+ * @class ReplayTrace
+ *
+ * @brief A recorded power and carbon intensity trace.
+ *
+ * The trace is a CSV file with the time (ISO 8601), the power draw in watts
+ * and the carbon intensity in gCO2e/kWh:
+ *
+ * \code
+ * # time,watts,gco2_per_kwh
+ * 2026-03-01T00:00:00Z,42.5,187
+ * 2026-03-01T00:05:00Z,40.1,
+ * 2026-03-01T00:30:00Z,,176
+ * \endcode
+ *
+ * An empty field keeps the previous value, so both series can be recorded at
+ * their own rate. Lines starting with \c # and a header line are skipped.
+ */
+
+/**
+ * @brief Reads the trace from \p device.
+ *
+ * @return \arg \c true  The trace was read.
+ *         \arg \c false A line is invalid or out of order, see \p errorString.
+ */
+bool ReplayTrace::load(QIODevice *device, QString *errorString /* = nullptr */)
+{
+    Q_ASSERT(device != nullptr);
+
+    _power.clear();
+    _intensity.clear();
+    _start = 0;
+    _end = 0;
+
+    auto fail = [&](int lineNumber, const QString &reason) {
+        if(errorString != nullptr)
+            *errorString = QString("Line %1: %2").arg(lineNumber).arg(reason);
+
+        _power.clear();
+        _intensity.clear();
+        return false;
+    };
+
+    qint64 last {std::numeric_limits<qint64>::min()};
+    int lineNumber {0};
+
+    while(!device->atEnd())
+    {
+        ++lineNumber;
+        const QByteArray line = device->readLine().trimmed();
+        if(line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        const QList<QByteArray> fields = line.split(',');
+        const QDateTime time = QDateTime::fromString(QString::fromLatin1(fields.value(0).trimmed()), Qt::ISODate);
+        if(!time.isValid())
+        {
+            // The header line of a spreadsheet export.
+            if(_power.isEmpty() && _intensity.isEmpty() && lineNumber == 1)
+                continue;
+
+            return fail(lineNumber, QStringLiteral("Invalid time."));
+        }
+
+        const qint64 msecs = time.toMSecsSinceEpoch();
+        if(msecs < last)
+            return fail(lineNumber, QStringLiteral("The trace must be in time order."));
+
+        const QByteArray watts = fields.value(1).trimmed();
+        if(!watts.isEmpty())
+        {
+            bool ok {false};
+            const float value = watts.toFloat(&ok);
+            if(!ok || value < 0)
+                return fail(lineNumber, QStringLiteral("Invalid power draw."));
+
+            _power.append({msecs, value});
+        }
+
+        const QByteArray intensity = fields.value(2).trimmed();
+        if(!intensity.isEmpty())
+        {
+            bool ok {false};
+            const double value = intensity.toDouble(&ok);
+            if(!ok || value < 0)
+                return fail(lineNumber, QStringLiteral("Invalid carbon intensity."));
+
+            _intensity.append({msecs, qRound(value)});
+        }
+
+        if(last == std::numeric_limits<qint64>::min())
+            _start = msecs;
+
+        last = msecs;
+        _end = msecs;
+    }
+
+    if(isEmpty())
+        return fail(lineNumber, QStringLiteral("The trace is empty."));
+
+    return true;
+}
+
+bool ReplayTrace::isEmpty() const
+{
+    return _power.isEmpty() && _intensity.isEmpty();
+}
+
+QDateTime ReplayTrace::start() const
+{
+    return QDateTime::fromMSecsSinceEpoch(_start);
+}
+
+QDateTime ReplayTrace::end() const
+{
+    return QDateTime::fromMSecsSinceEpoch(_end);
+}
+
+qsizetype ReplayTrace::powerSampleCount() const
+{
+    return _power.count();
+}
+
+qsizetype ReplayTrace::intensitySampleCount() const
+{
+    return _intensity.count();
+}
+
+/**
+ * @brief Returns the power draw in watts at \p time, 0 before the first one.
+ */
+float ReplayTrace::powerAt(const QDateTime &time) const
+{
+    const qsizetype index = indexAt(_power, time.toMSecsSinceEpoch());
+    return index < 0 ? 0 : _power.at(index).value;
+}
+
+/**
+ * @brief Returns the carbon intensity at \p time, -1 before the first one.
+ */
+int ReplayTrace::intensityAt(const QDateTime &time) const
+{
+    const qsizetype index = indexAt(_intensity, time.toMSecsSinceEpoch());
+    return index < 0 ? -1 : _intensity.at(index).value;
+}
+
+/**
+ * @brief Returns when the carbon intensity at \p time was recorded.
+ */
+QDateTime ReplayTrace::intensityChangedAt(const QDateTime &time) const
+{
+    const qsizetype index = indexAt(_intensity, time.toMSecsSinceEpoch());
+    return index < 0 ? QDateTime() : QDateTime::fromMSecsSinceEpoch(_intensity.at(index).time);
+}
+
+/**
+ * @brief Returns until when the carbon intensity at \p time holds.
+ *
+ * That is right before the next recorded value. The last value holds for
+ * DefaultIntensityPeriodInSeconds, like a half hour slot of a carbon API.
+ */
+QDateTime ReplayTrace::intensityValidTo(const QDateTime &time) const
+{
+    const qsizetype index = indexAt(_intensity, time.toMSecsSinceEpoch());
+    if(index < 0)
+        return QDateTime();
+
+    if(index + 1 < _intensity.count())
+        return QDateTime::fromMSecsSinceEpoch(_intensity.at(index + 1).time - 1);
+
+    return QDateTime::fromMSecsSinceEpoch(_intensity.at(index).time).addSecs(DefaultIntensityPeriodInSeconds);
+}
+
+/**
+ * @brief Returns the index of the last sample at or before \p time, or -1.
+ */
+template <class T>
+/* static */
+qsizetype ReplayTrace::indexAt(const QList<Sample<T>> &samples, qint64 time)
+{
+    const auto it = std::upper_bound(samples.cbegin(), samples.cend(), time,
+                                     [](qint64 value, const Sample<T> &sample) { return value < sample.time; });
+
+    return static_cast<qsizetype>(it - samples.cbegin()) - 1;
+}
@@ -0,0 +1,60 @@
+/**
+ * @brief Defines the ReplayTrace class.
+ *
+ * A ReplayTrace holds a recorded power draw and carbon intensity trace for
+ * leif-replay. Both are step functions, a value holds until the next one.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef REPLAYTRACE_H
+#define REPLAYTRACE_H
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+class QIODevice;
+
+class ReplayTrace
+{
+public:
+    ReplayTrace() = default;
+    ~ReplayTrace() = default;
+
+    bool load(QIODevice *device, QString *errorString = nullptr);
+
+    bool isEmpty() const;
+    QDateTime start() const;
+    QDateTime end() const;
+
+    qsizetype powerSampleCount() const;
+    qsizetype intensitySampleCount() const;
+
+    float powerAt(const QDateTime &time) const;
+    int intensityAt(const QDateTime &time) const;
+    QDateTime intensityChangedAt(const QDateTime &time) const;
+    QDateTime intensityValidTo(const QDateTime &time) const;
+
+    static constexpr int DefaultIntensityPeriodInSeconds {30 * 60};
+
+private:
+    template <class T>
+    struct Sample
+    {
+        qint64 time;
+        T value;
+    };
+
+    template <class T>
+    static qsizetype indexAt(const QList<Sample<T>> &samples, qint64 time);
+
+private:
+    QList<Sample<float>> _power;
+    QList<Sample<int>> _intensity;
+    qint64 _start {0};
+    qint64 _end {0};
+};
+
+#endif // REPLAYTRACE_H
@@ -0,0 +1,27 @@
+QT -= gui
+QT += network
+
+TEMPLATE = app
+TARGET = leif-schedule
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+mac:CONFIG += sdk_no_version_check
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    ../leif/utils/carbonscheduler.cpp \
+    main.cpp
+
+HEADERS += \
+    ../leif/utils/carbonscheduler.h
+
+INCLUDEPATH += ../leif ../leif/include
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/leif/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,141 @@
+/**
+ * @brief Defines the main() method of the leif-schedule tool.
+ *
+ * leif-schedule asks the running Leif application when a job should start to
+ * cause the least carbon, e.g. to shift batch jobs into cleaner hours:
+ *
+ * \code
+ * sleep $(leif-schedule --duration 120 --energy 3.5 --deadline 12h --wait) && make -j32
+ * \endcode
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+#include <QTextStream>
+
+#include "utils/carbonscheduler.h"
+
+namespace
+{
+/**
+ * @brief Parses a deadline given as ISO 8601 date/time or as hours from now,
+ * e.g. "12h".
+ */
+QDateTime parseDeadline(const QString &value)
+{
+    if(value.endsWith(QLatin1Char('h')))
+    {
+        bool ok {false};
+        const double hours = value.chopped(1).toDouble(&ok);
+
+        return ok ? QDateTime::currentDateTime().addSecs(static_cast<qint64>(hours * 3600)) : QDateTime();
+    }
+
+    return QDateTime::fromString(value, Qt::ISODate);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("leif-schedule"));
+
+    const QCommandLineOption durationOption {QStringLiteral("duration"), QStringLiteral("The job duration in minutes."), QStringLiteral("minutes")};
+    const QCommandLineOption energyOption {QStringLiteral("energy"), QStringLiteral("The energy the job uses in kWh."), QStringLiteral("kWh"), QStringLiteral("0")};
+    const QCommandLineOption deadlineOption {QStringLiteral("deadline"), QStringLiteral("When the job has to be done, ISO 8601 or hours from now (e.g. 12h)."), QStringLiteral("deadline")};
+    const QCommandLineOption waitOption {QStringLiteral("wait"), QStringLiteral("Only print the seconds to wait until the start.")};
+    const QCommandLineOption jsonOption {QStringLiteral("json"), QStringLiteral("Print the reply of the Leif application as is.")};
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Finds the lowest carbon start time for a job."));
+    parser.addHelpOption();
+    parser.addOptions({durationOption, energyOption, deadlineOption, waitOption, jsonOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    bool durationOk {false};
+    const double minutes = parser.value(durationOption).toDouble(&durationOk);
+    if(!durationOk || minutes <= 0)
+    {
+        err << "A positive --duration in minutes is required.\n";
+        return 1;
+    }
+
+    QJsonObject request {{QStringLiteral("duration"), static_cast<qint64>(minutes * 60)},
+                         {QStringLiteral("energy"), parser.value(energyOption).toDouble()}};
+
+    if(parser.isSet(deadlineOption))
+    {
+        const QDateTime deadline = parseDeadline(parser.value(deadlineOption));
+        if(!deadline.isValid())
+        {
+            err << "Invalid --deadline: " << parser.value(deadlineOption) << "\n";
+            return 1;
+        }
+
+        request.insert(QStringLiteral("deadline"), deadline.toString(Qt::ISODateWithMs));
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(Utils::CarbonScheduler::serverName());
+    if(!socket.waitForConnected(2000))
+    {
+        err << "Could not connect to Leif, is it running? " << socket.errorString() << "\n";
+        return 2;
+    }
+
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+
+    // The application may have to ask the carbon API first.
+    while(!socket.canReadLine() && socket.waitForReadyRead(30000))
+    {}
+
+    if(!socket.canReadLine())
+    {
+        err << "Leif didn't reply: " << socket.errorString() << "\n";
+        return 2;
+    }
+
+    const QByteArray line = socket.readLine().trimmed();
+    const QJsonObject reply = QJsonDocument::fromJson(line).object();
+
+    if(parser.isSet(jsonOption))
+    {
+        out << line << "\n";
+        return reply.value(QStringLiteral("ok")).toBool() ? 0 : 3;
+    }
+
+    if(!reply.value(QStringLiteral("ok")).toBool())
+    {
+        err << "Could not schedule the job: " << reply.value(QStringLiteral("error")).toString() << "\n";
+        return 3;
+    }
+
+    const QDateTime start = QDateTime::fromString(reply.value(QStringLiteral("start")).toString(), Qt::ISODate);
+
+    if(parser.isSet(waitOption))
+    {
+        out << qMax<qint64>(0, QDateTime::currentDateTime().secsTo(start)) << "\n";
+        return 0;
+    }
+
+    out << "Start:     " << start.toLocalTime().toString(Qt::ISODate) << "\n"
+        << "End:       " << QDateTime::fromString(reply.value(QStringLiteral("end")).toString(), Qt::ISODate).toLocalTime().toString(Qt::ISODate) << "\n"
+        << "Intensity: " << qRound(reply.value(QStringLiteral("averageIntensity")).toDouble()) << " g/kWh\n";
+
+    if(reply.value(QStringLiteral("grams")).toDouble() > 0)
+    {
+        out << "Carbon:    " << qRound(reply.value(QStringLiteral("grams")).toDouble()) << " g (now: "
+            << qRound(reply.value(QStringLiteral("gramsIfStartedNow")).toDouble()) << " g)\n";
+    }
+
+    return 0;
+}
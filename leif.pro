@@ -1,6 +1,6 @@
 TEMPLATE = subdirs
 
-SUBDIRS = plugins leif tests
+SUBDIRS = plugins pluginhost flagatlas leif leifd leif-schedule leif-replay leif-collector tests
 
-leif.depends = plugins
+leif.depends = plugins flagatlas
 test.depeds = leif
\ No newline at end of file
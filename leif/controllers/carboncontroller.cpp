@@ -19,12 +19,13 @@ CarbonController::CarbonController(CarbonService *carbonService, QObject *parent
     QObject{parent}
 {
     d.carbonService = carbonService;
+    d.active = true;
+    d.pending = false;
 
     if(d.carbonService != nullptr)
     {
-        connect(d.carbonService, &CarbonService::lifetimeCarbonChanged, this, &CarbonController::lifetimeCarbonChanged);
-        connect(d.carbonService, &CarbonService::sessionCarbonChanged, this, &CarbonController::sessionCarbonChanged);
-        connect(d.carbonService, &CarbonService::carbonUsageLevelChanged, this, &CarbonController::carbonUsageLevelChanged);
+        d.shown = d.carbonService->snapshot();
+        connect(d.carbonService, &CarbonService::snapshotChanged, this, &CarbonController::onSnapshotChanged);
     }
 }
 
@@ -89,6 +90,62 @@ ChargeForecast CarbonController::chargeForecast() const
     return ChargeForecast::ChargeWhenNeeded;
 }
 
+/**
+ * @brief Notifies QML once per calculation.
+ *
+ * All properties share the carbonChanged() signal, so the bindings are
+ * evaluated once per \p snapshot instead of once per changed value. If none
+ * of the values we show changed, QML is not bothered at all.
+ *
+ * \sa setActive()
+ */
+void CarbonController::onSnapshotChanged(const CarbonSnapshot &snapshot)
+{
+    const bool changed = snapshot.sessionCarbon != d.shown.sessionCarbon ||
+                         snapshot.lifetimeCarbon != d.shown.lifetimeCarbon ||
+                         snapshot.usageLevel != d.shown.usageLevel ||
+                         snapshot.chargeForecast != d.shown.chargeForecast;
+
+    d.shown = snapshot;
+
+    if(!changed)
+        return;
+
+    if(d.active)
+        emit carbonChanged();
+    else
+        d.pending = true;
+}
+
+/**
+ * @brief Returns whether QML is notified about changes.
+ */
+bool CarbonController::isActive() const
+{
+    return d.active;
+}
+
+/**
+ * @brief Turns the notifications to QML on or off.
+ *
+ * While the window is hidden nobody sees the values, so there is no need to
+ * evaluate bindings or run animations. Changes are only remembered and
+ * announced once when the controller becomes \p active again.
+ */
+void CarbonController::setActive(bool active)
+{
+    if(d.active == active)
+        return;
+
+    d.active = active;
+
+    if(d.active && d.pending)
+    {
+        d.pending = false;
+        emit carbonChanged();
+    }
+}
+
 /**
  * @brief Clears the stored life time session counter.
  *
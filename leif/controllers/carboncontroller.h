@@ -19,16 +19,17 @@
 
 #include <include/carbonusagelevel.h>
 #include <include/chargeforecast.h>
+#include <include/carbonsnapshot.h>
 
 class CarbonService;
 
 class CarbonController : public QObject
 {
     Q_OBJECT
-    Q_PROPERTY(float sessionCarbon READ sessionCarbon NOTIFY sessionCarbonChanged)
-    Q_PROPERTY(float lifetimeCarbon READ lifetimeCarbon NOTIFY lifetimeCarbonChanged)
-    Q_PROPERTY(CarbonUsageLevel carbonUsageLevel READ carbonUsageLevel NOTIFY carbonUsageLevelChanged)
-    Q_PROPERTY(ChargeForecast chargeForecast READ chargeForecast NOTIFY chargeForecastChanged)
+    Q_PROPERTY(float sessionCarbon READ sessionCarbon NOTIFY carbonChanged)
+    Q_PROPERTY(float lifetimeCarbon READ lifetimeCarbon NOTIFY carbonChanged)
+    Q_PROPERTY(CarbonUsageLevel carbonUsageLevel READ carbonUsageLevel NOTIFY carbonChanged)
+    Q_PROPERTY(ChargeForecast chargeForecast READ chargeForecast NOTIFY carbonChanged)
 
 public:
     explicit CarbonController(CarbonService* carbonService, QObject *parent = nullptr);
@@ -38,19 +39,25 @@ public:
     CarbonUsageLevel carbonUsageLevel() const;
     ChargeForecast chargeForecast() const;
 
+    bool isActive() const;
+    void setActive(bool active);
+
 public slots:
     void clearStats();
 
 signals:
-    void sessionCarbonChanged();
-    void lifetimeCarbonChanged();
-    void carbonUsageLevelChanged();
-    void chargeForecastChanged();
+    void carbonChanged();
+
+private slots:
+    void onSnapshotChanged(const CarbonSnapshot &snapshot);
 
 private:
     struct CarbonModelPrivate
     {
         CarbonService *carbonService;
+        CarbonSnapshot shown;
+        bool active;
+        bool pending;
     } d;
 };
 
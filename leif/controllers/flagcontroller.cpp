@@ -0,0 +1,33 @@
+/**
+ * \brief Implements the FlagController class.
+ *
+ * \author Dariusz Scharsig
+ *
+ * \date 19.10.2026
+ */
+#include "flagcontroller.h"
+
+#include "utils/flagatlas.h"
+
+FlagController::FlagController(QObject *parent /* = nullptr */):
+    QObject{parent}
+{}
+
+/**
+ * @brief Returns the size of the flag atlas in pixels.
+ */
+QSize FlagController::atlasSize() const
+{
+    return Utils::FlagAtlas::size();
+}
+
+/**
+ * @brief Returns where the flag of \p code is in the atlas.
+ *
+ * @param code The flag code, e.g. the country number of the CountryModel.
+ * @return The rect of the flag, or of the fallback flag for unknown codes.
+ */
+QRect FlagController::flagRect(const QVariant &code) const
+{
+    return Utils::FlagAtlas::rect(code.toString());
+}
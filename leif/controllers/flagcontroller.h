@@ -0,0 +1,34 @@
+/**
+ * \brief Defines the FlagController class.
+ *
+ * The FlagController tells QML where a flag is in the flag atlas. It is used
+ * by FlagImage.qml.
+ *
+ * \sa Utils::FlagAtlas
+ *
+ * \author Dariusz Scharsig
+ *
+ * \date 19.10.2026
+ */
+#ifndef FLAGCONTROLLER_H
+#define FLAGCONTROLLER_H
+
+#include <QObject>
+#include <QQmlEngine>
+#include <QRect>
+#include <QSize>
+
+class FlagController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QSize atlasSize READ atlasSize CONSTANT)
+
+public:
+    explicit FlagController(QObject *parent = nullptr);
+
+    QSize atlasSize() const;
+
+    Q_INVOKABLE QRect flagRect(const QVariant &code) const;
+};
+
+#endif // FLAGCONTROLLER_H
@@ -0,0 +1,50 @@
+/**
+ * \brief Implements the SelfMetricsController class.
+ *
+ * \author Dariusz Scharsig
+ *
+ * \date 19.10.2026
+ */
+#include <QLocale>
+
+#include "selfmetricscontroller.h"
+
+#include "utils/selfmetrics.h"
+
+SelfMetricsController::SelfMetricsController(QObject *parent /* = nullptr */):
+    QObject{parent}
+{}
+
+/**
+ * @brief Returns the footprint of Leif as of the last refresh().
+ */
+QString SelfMetricsController::summary() const
+{
+    return m_summary;
+}
+
+/**
+ * @brief Takes a new sample.
+ *
+ * The values are not updated on their own, the About page refreshes them
+ * when it is shown.
+ */
+void SelfMetricsController::refresh()
+{
+    const Utils::SelfMetrics::Sample sample = Utils::SelfMetrics::sample();
+    const QLocale locale;
+
+    const QString cpuTime = sample.cpuTimeInMs >= 0 ? locale.toString(sample.cpuTimeInMs / 1000.0, 'f', 1) + QStringLiteral(" s") : tr("n/a");
+    const QString memory = sample.residentBytes >= 0 ? locale.formattedDataSize(sample.residentBytes) : tr("n/a");
+
+    QString summary = tr("Leif itself: %1 CPU, %2 memory\n%3 wake-ups per hour, %4 logged, %5 network");
+    summary = summary.arg(cpuTime, memory, locale.toString(sample.wakeUpsPerHour(), 'f', 0),
+                          locale.formattedDataSize(static_cast<qint64>(sample.loggedBytes)),
+                          locale.formattedDataSize(static_cast<qint64>(sample.networkBytes)));
+
+    if(summary != m_summary)
+    {
+        m_summary = summary;
+        emit summaryChanged();
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * \brief Defines the SelfMetricsController class.
+ *
+ * The SelfMetricsController shows what Leif itself costs on the About page.
+ *
+ * \sa Utils::SelfMetrics
+ *
+ * \author Dariusz Scharsig
+ *
+ * \date 19.10.2026
+ */
+#ifndef SELFMETRICSCONTROLLER_H
+#define SELFMETRICSCONTROLLER_H
+
+#include <QObject>
+#include <QQmlEngine>
+
+class SelfMetricsController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString summary READ summary NOTIFY summaryChanged)
+
+public:
+    explicit SelfMetricsController(QObject *parent = nullptr);
+
+    QString summary() const;
+
+public slots:
+    void refresh();
+
+signals:
+    void summaryChanged();
+
+private:
+    QString m_summary;
+};
+
+#endif // SELFMETRICSCONTROLLER_H
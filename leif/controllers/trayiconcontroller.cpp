@@ -4,11 +4,16 @@
 #include <services/carbonservice.h>
 
 #include <controllers/carboncontroller.h>
+#include <controllers/flagcontroller.h>
+#include <controllers/selfmetricscontroller.h>
 #include <controllers/settingscontroller.h>
 #include <controllers/trayiconcontroller.h>
 #include <plugin/carbonpluginmanager.h>
+#include <utils/flagimageprovider.h>
 #include <utils/qmlwarninglogger.h>
 
+#include "log/trace.h"
+
 class TrayIconControllerPrivate
 {
 public:
@@ -28,6 +33,7 @@ private:
     QScopedPointer<QQuickWindow> qmlWindow;
     SettingsService* settingsService;
     CarbonService *carbonService;
+    CarbonController *carbonController;
     
     friend class TrayIconController;
 };
@@ -37,13 +43,20 @@ TrayIconControllerPrivate::TrayIconControllerPrivate(SettingsService *settingsSe
     qmlEngine{new QQmlApplicationEngine},
     qmlWindow{nullptr},
     settingsService{settingsService},
-    carbonService{carbonService}
+    carbonService{carbonService},
+    carbonController{new CarbonController {carbonService}}
 {
     SettingsController *settingsController {new SettingsController {settingsService}};
-    CarbonController *carbonController {new CarbonController {carbonService}};
+    FlagController *flagController {new FlagController};
+    SelfMetricsController *selfMetricsController {new SelfMetricsController};
 
     registerQmlController<SettingsController>("SettingsController", settingsController);
     registerQmlController<CarbonController>("CarbonController", carbonController);
+    registerQmlController<FlagController>("FlagController", flagController);
+    registerQmlController<SelfMetricsController>("SelfMetricsController", selfMetricsController);
+
+    // The engine takes ownership of the provider.
+    qmlEngine->addImageProvider(QStringLiteral("flags"), new Utils::FlagImageProvider);
 }
 
 TrayIconController::TrayIconController(SettingsService *settingsService,
@@ -52,19 +65,22 @@ TrayIconController::TrayIconController(SettingsService *settingsService,
     QObject(parent),
     d{new TrayIconControllerPrivate {settingsService, carbonService}}
 {
-    connect(d->carbonService, &CarbonService::sessionCarbonChanged, this, [=]() {emit sessionCarbonChanged(sessionCarbon());});
-    connect(d->carbonService, &CarbonService::lifetimeCarbonChanged, this, [=]() {emit lifetimeCarbonChanged(lifetimeCarbon());});
-    connect(d->carbonService, &CarbonService::carbonUsageLevelChanged, this, [=]() {emit carbonUsageLevelChanged(carbonUsageLevel());});
-    connect(d->carbonService, &CarbonService::chargeForecastChanged, this, [=]() {emit chargeForecastChanged(chargeForecast());});
+    // One delivery per calculation, the snapshot carries all values.
+    if(d->carbonService != nullptr)
+        connect(d->carbonService, &CarbonService::snapshotChanged, this, &TrayIconController::snapshotChanged);
+
     connect(d->settingsService, &SettingsService::countryChanged, this, &TrayIconController::configuredChanged);
     connect(d->settingsService, &SettingsService::regionIdChanged, this, &TrayIconController::configuredChanged);
     connect(d->qmlEngine.get(), &QQmlApplicationEngine::objectCreated, this, &TrayIconController::onObjectCreated);
 
-    if(configured())
+    CarbonPluginManager *manager = CarbonPluginManager::Instance();
+    if(manager != nullptr)
     {
-        CarbonPluginManager *manager = CarbonPluginManager::Instance();
+        // Whether we are configured depends on the regions the plugins know.
+        connect(manager, &CarbonPluginManager::pluginsLoaded, this, &TrayIconController::configuredChanged);
+        connect(manager, &CarbonPluginManager::pluginsLoaded, this, [=]() { if(configured()) onConfiguredChanged(); });
 
-        if(manager != nullptr)
+        if(manager->isReady() && configured())
             manager->loadPlugin(d->settingsService->country());
     }
 
@@ -135,7 +151,10 @@ void TrayIconController::showDialog()
         d->qmlWindow->raise();
     }
     else if(d->qmlEngine != nullptr)
+    {
+        TRACE_SPAN("QML load");
         d->qmlEngine->load("qrc:///qml/main.qml");
+    }
 }
 
 void TrayIconController::onConfiguredChanged()
@@ -155,7 +174,32 @@ void TrayIconController::onObjectCreated(QObject *object, const QUrl &url)
 
     QQuickWindow *qmlWindow = qobject_cast<QQuickWindow*>(object);
     if(qmlWindow != nullptr)
+    {
+        // Let the hidden window give up its graphics resources.
+        qmlWindow->setPersistentGraphics(false);
+        qmlWindow->setPersistentSceneGraph(false);
+
+        connect(qmlWindow, &QQuickWindow::visibleChanged, this, &TrayIconController::onWindowVisibleChanged);
         d->qmlWindow.reset(qmlWindow);
+    }
+}
+
+/**
+ * @brief Suspends the QML updates while the window is hidden.
+ *
+ * The window is only hidden when closed, it stays alive for the next
+ * showDialog(). While it is hidden the controllers don't notify QML and the
+ * scene graph is released. On show the controllers resync from the latest
+ * snapshot.
+ */
+void TrayIconController::onWindowVisibleChanged(bool visible)
+{
+    Q_ASSERT(d != nullptr);
+
+    d->carbonController->setActive(visible);
+
+    if(!visible && d->qmlWindow != nullptr)
+        d->qmlWindow->releaseResources();
 }
 
 bool TrayIconController::configured() const
@@ -169,7 +213,7 @@ bool TrayIconController::configured() const
         return false;
 
     CarbonPluginManager *manager = CarbonPluginManager::Instance();
-    if(manager == nullptr)
+    if(manager == nullptr || !manager->isReady())
         return false;
 
     if(manager->regionIds(d->settingsService->country()).isEmpty())
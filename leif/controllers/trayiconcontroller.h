@@ -16,6 +16,7 @@
 
 #include <include/chargeforecast.h>
 #include <include/carbonusagelevel.h>
+#include <include/carbonsnapshot.h>
 
 class CarbonService;
 class SettingsService;
@@ -24,10 +25,10 @@ class TrayIconControllerPrivate;
 class TrayIconController : public QObject
 {
     Q_OBJECT
-    Q_PROPERTY(float sessionCarbon READ sessionCarbon NOTIFY sessionCarbonChanged)
-    Q_PROPERTY(float lifetimeCarbon READ lifetimeCarbon NOTIFY lifetimeCarbonChanged)
-    Q_PROPERTY(CarbonUsageLevel carbonUsageLevel READ carbonUsageLevel NOTIFY carbonUsageLevelChanged)
-    Q_PROPERTY(ChargeForecast chargeForecast READ chargeForecast NOTIFY chargeForecastChanged)
+    Q_PROPERTY(float sessionCarbon READ sessionCarbon NOTIFY snapshotChanged)
+    Q_PROPERTY(float lifetimeCarbon READ lifetimeCarbon NOTIFY snapshotChanged)
+    Q_PROPERTY(CarbonUsageLevel carbonUsageLevel READ carbonUsageLevel NOTIFY snapshotChanged)
+    Q_PROPERTY(ChargeForecast chargeForecast READ chargeForecast NOTIFY snapshotChanged)
     Q_PROPERTY(bool configured READ configured NOTIFY configuredChanged)
 
 public:
@@ -51,12 +52,10 @@ public Q_SLOTS:
 private Q_SLOTS:
     void onConfiguredChanged();
     void onObjectCreated(QObject *object, const QUrl &url);
+    void onWindowVisibleChanged(bool visible);
 
 signals:
-    void sessionCarbonChanged(float newSessionCarbon);
-    void lifetimeCarbonChanged(float newLifetimeCarbon);
-    void carbonUsageLevelChanged(CarbonUsageLevel newCarbonUsageLevel);
-    void chargeForecastChanged(ChargeForecast newChargeForecast);
+    void snapshotChanged(const CarbonSnapshot &snapshot);
     void configuredChanged();
 
 private:
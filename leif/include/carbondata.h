@@ -4,6 +4,14 @@
  * The CarbonData reply structure contains the cost of a kilowatt hour in
  * grams of CO2 and may contain an error, if there was an issue getting the data.
  *
+ * Plugins may also provide a forecast series, one value per
+ * forecastIntervalInSeconds starting at validFrom. The first three values are
+ * the same as co2PerkWhNow, co2PerkWhNext and co2PerkWhLater.
+ *
+ * A source that answers asynchronously (e.g. the plugin host) may return
+ * pending() data while its request is in flight. That is no valid data, but
+ * no failure either.
+ *
  * \sa IDataProvider
  *
  * \author Dariusz Scharsig
@@ -16,6 +24,7 @@
 #define CARBONDATA_H
 
 #include <QDateTime>
+#include <QList>
 #include <QString>
 
 struct CarbonData
@@ -36,14 +45,18 @@ struct CarbonData
                                 const QDateTime &_validTo);
 
     inline static CarbonData error(const QString &_errorString);
+    inline static CarbonData pending(const QString &_reason);
 
     int co2PerkWhNow;
     int co2PerkWhNext;
     int co2PerkWhLater;
     bool isValid;
+    bool isPending;
     QString errorString;
     QDateTime validFrom;
     QDateTime validTo;
+    QList<int> forecast;
+    int forecastIntervalInSeconds;
 };
 
 CarbonData::CarbonData():
@@ -61,9 +74,11 @@ CarbonData::CarbonData(int _co2Now,
     co2PerkWhNext {_co2Next},
     co2PerkWhLater {_co2Later},
     isValid {_isValid},
+    isPending {false},
     errorString {_errorString},
     validFrom {_validFrom},
-    validTo {_validTo}
+    validTo {_validTo},
+    forecastIntervalInSeconds {0}
 {}
 
 /* static */
@@ -83,4 +98,13 @@ CarbonData CarbonData::error(const QString &_errorString)
     return CarbonData(-1, -1, -1, false, _errorString, QDateTime(), QDateTime());
 }
 
+/* static */
+CarbonData CarbonData::pending(const QString &_reason)
+{
+    CarbonData data = error(_reason);
+    data.isPending = true;
+
+    return data;
+}
+
 #endif // CARBONDATA_H
@@ -0,0 +1,55 @@
+/**
+ * \brief Defines the CarbonSnapshot structure.
+ *
+ * A CarbonSnapshot is the state of the CarbonService after a calculation:
+ * the power draw, the carbon data it was calculated with and the grams
+ * collected so far. It is a plain value, so it can be copied to and read
+ * from any thread.
+ *
+ * \sa CarbonService::snapshot()
+ *
+ * \author Dariusz Scharsig
+ *
+ * \date 19.10.2026
+ */
+#ifndef CARBONSNAPSHOT_H
+#define CARBONSNAPSHOT_H
+
+#include <QDateTime>
+#include <QLocale>
+#include <QMetaType>
+#include <QString>
+
+#include "carbondata.h"
+#include "carbonusagelevel.h"
+#include "chargeforecast.h"
+
+struct CarbonSnapshot
+{
+    inline CarbonSnapshot();
+
+    quint64 sequence;
+    QDateTime timestamp;
+    QLocale::Country country;
+    QString region;
+    float powerDrawInWatts;
+    float sessionCarbon;
+    float lifetimeCarbon;
+    CarbonUsageLevel usageLevel;
+    ChargeForecast chargeForecast;
+    CarbonData carbon;
+};
+
+CarbonSnapshot::CarbonSnapshot():
+    sequence {0},
+    country {QLocale::AnyCountry},
+    powerDrawInWatts {0},
+    sessionCarbon {0},
+    lifetimeCarbon {0},
+    usageLevel {CarbonUsageLevel::VeryHigh},
+    chargeForecast {ChargeForecast::ChargeWhenNeeded}
+{}
+
+Q_DECLARE_METATYPE(CarbonSnapshot)
+
+#endif // CARBONSNAPSHOT_H
@@ -15,17 +15,50 @@
 #ifndef IDATAPROVIDER_H
 #define IDATAPROVIDER_H
 
+#include <QHash>
 #include <QLocale>
 #include <QStringList>
 #include <carbondata.h>
 
-#define IDataProvider_iid "org.leif.DataProvider.IDataProvider/1.0"
+#define IDataProvider_iid "org.leif.DataProvider.IDataProvider/1.2"
 
 class IDataProvider
 {
 public:
     virtual ~IDataProvider() = default;
     virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) = 0;
+
+    /**
+     * \brief Returns the carbon data of several \p regions at once.
+     *
+     * Plugins whose API can answer for all regions in a single request should
+     * override this. They should also fill in the CarbonData::forecast series
+     * for the period from \p from to \p to. The default asks for every
+     * region in turn and ignores \p from and \p to, the single region call
+     * always starts now.
+     *
+     * \return A hash with the region as key. Every requested region has an
+     *         entry, unknown regions get an error CarbonData object.
+     */
+    virtual QHash<QString, CarbonData> carbonPerKiloWatt(const QLocale::Country country,
+                                                         const QStringList &regions,
+                                                         const QDateTime &from,
+                                                         const QDateTime &to)
+    {
+        Q_UNUSED(from)
+        Q_UNUSED(to)
+
+        QHash<QString, CarbonData> result;
+        for(const QString &region : regions)
+        {
+            if(!result.contains(region))
+            {
+                result.insert(region, carbonPerKiloWatt(country, region));
+            }
+        }
+
+        return result;
+    }
 };
 
 Q_DECLARE_INTERFACE(IDataProvider, IDataProvider_iid)
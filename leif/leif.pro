@@ -1,4 +1,4 @@
-QT += quick widgets
+QT += quick widgets concurrent network
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
@@ -6,40 +6,17 @@ QT += quick widgets
 
 SOURCES += \
         controllers/carboncontroller.cpp \
+        controllers/flagcontroller.cpp \
+        controllers/selfmetricscontroller.cpp \
         controllers/settingscontroller.cpp \
-        log/consolelogger.cpp \
-        log/filelogger.cpp \
-        log/iodevicelogger.cpp \
-        log/logfilterbase.cpp \
-        log/logfilterbyfile.cpp \
-        log/loggerbase.cpp \
-        log/logmanager.cpp \
-        log/logsystem.cpp \
-        log/predictivelogger.cpp \
-        models/countrymodel.cpp \
-        models/regionmodel.cpp \
         controllers/trayiconcontroller.cpp \
-        plugin/carbonplugin.cpp \
         main.cpp \
-        plugin/carbonpluginmanager.cpp \
-        powerinfobase.cpp \
-        services/carbonservice.cpp \
-        services/settingsservice.cpp \
+        models/countrymodel.cpp \
+        models/regionmodel.cpp \
         trayicon.cpp \
-        utils/carbonplugindata.cpp \
-        utils/qmlwarninglogger.cpp \
-        utils/territory.cpp \
-        utils/translatedstring.cpp \
-        utils/translation.cpp
-		
-mac: SOURCES += \
-                mac/powerinfo.cpp \
-                mac/powerfactory_mac.cpp
-
-win32: SOURCES += \
-                win/powerinfo.cpp \
-                win/powerfactory_win.cpp
-			      
+        utils/flagatlas.cpp \
+        utils/flagimageprovider.cpp \
+        utils/qmlwarninglogger.cpp
 
 RESOURCES += qml.qrc
 
@@ -68,52 +45,21 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 
 HEADERS += \
     controllers/carboncontroller.h \
+    controllers/flagcontroller.h \
+    controllers/selfmetricscontroller.h \
     controllers/settingscontroller.h \
-    include/carbonusagelevel.h \
-    include/chargeforecast.h \
-    log/consolelogger.h \
-    log/filelogger.h \
-    log/ilogger.h \
-    log/ilogmanager.h \
-    log/iodevicelogger.h \
-    log/log.h \
-    log/log_internal.h \
-    log/logfilterbase.h \
-    log/logfilterbyfile.h \
-    log/loggerbase.h \
-    log/logmanager.h \
-    log/logsystem.h \
-    log/messagetype.h \
-    log/predictivelogger.h \
-    models/countrymodel.h \
-    models/regionmodel.h \
     controllers/trayiconcontroller.h \
-    plugin/carbonplugin.h \
-    include/carbondata.h \
-    include/interfaces/IDataProvider.h \
-    include/interfaces/IPower.h \
     main.h \
-    plugin/carbonpluginmanager.h \
-    powerfactory.h \
-    powerinfobase.h \
-    services/carbonservice.h \
-    services/settingsservice.h \
+    models/countrymodel.h \
+    models/regionmodel.h \
     trayicon.h \
-    utils/carbonplugindata.h \
-    utils/qmlwarninglogger.h \
-    utils/territory.h \
-    utils/translatedstring.h \
-    utils/translation.h
-	
-mac: HEADERS += mac/powerinfo.h
-
-win32: HEADERS += win/powerinfo.h
-
-win32: LIBS *= PowrProf.lib
-
-mac: LIBS += -framework IOKit
-mac: LIBS += -framework CoreFoundation
+    utils/flagatlas.h \
+    utils/flagatlasdata.h \
+    utils/flagimageprovider.h \
+    utils/qmlwarninglogger.h
 
+include('pri/core.pri')
+include('pri/flagatlas.pri')
 include('pri/appinfo.pri')
 win32: include('pri/predeps.pri')
 win32: include('pri/win.pri')
@@ -0,0 +1,23 @@
+/**
+ * @brief Implements the PowerFactory methods.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "settingsservice.h"
+#include "powerfactory.h"
+#include "linux/powerinfo.h"
+
+std::unique_ptr<IPower> PowerFactory::getPowerInterface(SettingsService *settings)
+{
+    if(settings == nullptr)
+        return nullptr;
+
+    auto storeFunc = [=](const Utils::PowerProfile &profile)
+    {
+        settings->savePowerProfile(profile);
+    };
+
+    return std::make_unique<PowerInfo>(settings->powerProfile(), storeFunc);
+}
@@ -0,0 +1,51 @@
+#include "powerinfo.h"
+
+PowerInfo::PowerInfo(const Utils::PowerProfile &profile, std::function<void (const Utils::PowerProfile&)> storeProfileFunc, QObject *parent /* = nullptr */):
+    PowerInfoBase {profile, storeProfileFunc, parent}
+{}
+
+/**
+ * @brief Reads the power supplies and returns whether there is a battery.
+ *
+ * PowerInfoBase always asks this first, the other methods return the values
+ * of this read.
+ */
+bool PowerInfo::hasBattery()
+{
+    m_supply.read();
+
+    return m_supply.hasBattery();
+}
+
+bool PowerInfo::batteryFullyCharged()
+{
+    // Batteries with a charge threshold stop at "Not charging" on AC.
+    return m_supply.status() == PowerSupply::Status::Full ||
+           (m_supply.status() == PowerSupply::Status::NotCharging && m_supply.isOnline());
+}
+
+bool PowerInfo::batteryCharging()
+{
+    return m_supply.status() == PowerSupply::Status::Charging ||
+           (m_supply.status() == PowerSupply::Status::Unknown && m_supply.isOnline());
+}
+
+int PowerInfo::chargeRate()
+{
+    return m_supply.powerInMilliWatts();
+}
+
+int PowerInfo::dischargeRate()
+{
+    return m_supply.powerInMilliWatts();
+}
+
+int PowerInfo::currentCapacity()
+{
+    return m_supply.energyInMilliWattHours();
+}
+
+int PowerInfo::adapterPower()
+{
+    return m_supply.adapterPowerInMilliWatts();
+}
@@ -0,0 +1,27 @@
+#ifndef POWERINFO_H
+#define POWERINFO_H
+
+#include "powerinfobase.h"
+#include "powersupply.h"
+
+class PowerInfo : public PowerInfoBase
+{
+public:
+    explicit PowerInfo(const Utils::PowerProfile &profile, std::function<void(const Utils::PowerProfile&)> storeProfileFunc, QObject *parent = nullptr);
+    virtual ~PowerInfo() = default;
+
+    // PowerInfoBase interface
+protected:
+    virtual bool hasBattery() override;
+    virtual bool batteryFullyCharged() override;
+    virtual bool batteryCharging() override;
+    virtual int chargeRate() override;
+    virtual int dischargeRate() override;
+    virtual int currentCapacity() override;
+    virtual int adapterPower() override;
+
+private:
+    PowerSupply m_supply;
+};
+
+#endif // POWERINFO_H
@@ -0,0 +1,211 @@
+/**
+ * @brief Implements the PowerSupply class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QDir>
+#include <QFile>
+
+#include "powersupply.h"
+
+/**
+ * @class PowerSupply
+ *
+ * @brief Reads the power supplies from \c /sys/class/power_supply.
+ *
+ * Every supply is a directory with one value per file. We use the \c Mains
+ * supplies to tell whether we are on AC power and sum up all system
+ * batteries, some laptops have two. Batteries of devices like mice have the
+ * scope \c Device and are ignored.
+ *
+ * Drivers either report power and energy, or current and charge. The latter
+ * are converted with the current voltage. Only some adapters, mostly USB-C
+ * ones, report what they deliver.
+ *
+ * The values are those of the last read().
+ */
+
+PowerSupply::PowerSupply(const QString &sysfsPath /* = QStringLiteral("/sys/class/power_supply") */):
+    _sysfsPath {sysfsPath},
+    _hasBattery {false},
+    _isOnline {false},
+    _status {Status::Unknown},
+    _powerInMicroWatts {0},
+    _energyInMicroWattHours {0},
+    _adapterPowerInMicroWatts {0}
+{}
+
+/**
+ * @brief Reads the current state of all power supplies.
+ *
+ * @return \arg \c true  The power supplies were read.
+ *         \arg \c false The power supply class is not available.
+ */
+bool PowerSupply::read()
+{
+    _hasBattery = false;
+    _isOnline = false;
+    _status = Status::Unknown;
+    _powerInMicroWatts = 0;
+    _energyInMicroWattHours = 0;
+    _adapterPowerInMicroWatts = 0;
+
+    const QDir dir {_sysfsPath};
+    if(!dir.exists())
+    {
+        return false;
+    }
+
+    for(const QString &name : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name))
+    {
+        const QString path = dir.filePath(name);
+        const QByteArray type = readValue(path, "type");
+
+        if(type == "Mains" || type == "USB")
+        {
+            if(readNumber(path, "online") == 1)
+            {
+                _isOnline = _isOnline || type == "Mains";
+                _adapterPowerInMicroWatts += qMax<qint64>(0, readPower(path));
+            }
+        }
+        else if(type == "Battery" && readValue(path, "scope") != "Device" && readNumber(path, "present") != 0)
+        {
+            readBattery(path);
+        }
+    }
+
+    return true;
+}
+
+bool PowerSupply::hasBattery() const
+{
+    return _hasBattery;
+}
+
+/**
+ * @brief Returns whether an AC adapter is connected.
+ */
+bool PowerSupply::isOnline() const
+{
+    return _isOnline;
+}
+
+PowerSupply::Status PowerSupply::status() const
+{
+    return _status;
+}
+
+/**
+ * @brief Returns the power flowing into or out of the batteries.
+ */
+int PowerSupply::powerInMilliWatts() const
+{
+    return static_cast<int>(_powerInMicroWatts / 1000);
+}
+
+/**
+ * @brief Returns the energy left in the batteries.
+ */
+int PowerSupply::energyInMilliWattHours() const
+{
+    return static_cast<int>(_energyInMicroWattHours / 1000);
+}
+
+/**
+ * @brief Returns the power the online adapters deliver, or 0 if they don't
+ * tell.
+ */
+int PowerSupply::adapterPowerInMilliWatts() const
+{
+    return static_cast<int>(_adapterPowerInMicroWatts / 1000);
+}
+
+void PowerSupply::readBattery(const QString &path)
+{
+    const Status status = statusFromString(readValue(path, "status"));
+    const qint64 voltage = readNumber(path, "voltage_now");
+    const qint64 power = qMax<qint64>(0, readPower(path));
+
+    qint64 energy = readNumber(path, "energy_now");
+    if(energy < 0)
+    {
+        const qint64 charge = readNumber(path, "charge_now");
+        energy = charge >= 0 && voltage > 0 ? charge * voltage / 1000000 : 0;
+    }
+
+    _hasBattery = true;
+    _powerInMicroWatts += power;
+    _energyInMicroWattHours += energy;
+
+    // A charging or discharging battery tells more than a full one.
+    if(_status == Status::Unknown || status == Status::Charging || status == Status::Discharging)
+    {
+        _status = status;
+    }
+}
+
+/**
+ * @brief Returns the power of the supply at \p path in µW, or -1 if it
+ * reports neither power nor current.
+ */
+/* static */
+qint64 PowerSupply::readPower(const QString &path)
+{
+    const qint64 power = readNumber(path, "power_now");
+    if(power >= 0)
+    {
+        return power;
+    }
+
+    const qint64 current = readNumber(path, "current_now");
+    const qint64 voltage = readNumber(path, "voltage_now");
+
+    return current >= 0 && voltage > 0 ? current * voltage / 1000000 : -1;
+}
+
+/* static */
+QByteArray PowerSupply::readValue(const QString &path, const char *name)
+{
+    QFile file {path + QLatin1Char('/') + QLatin1String(name)};
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return QByteArray();
+    }
+
+    return file.read(64).trimmed();
+}
+
+/**
+ * @brief Returns the absolute number in \p name, or -1 if it's not there.
+ *
+ * Some drivers report a negative current while discharging.
+ */
+/* static */
+qint64 PowerSupply::readNumber(const QString &path, const char *name)
+{
+    bool ok {false};
+    const qint64 value = readValue(path, name).toLongLong(&ok);
+
+    return ok ? qAbs(value) : -1;
+}
+
+/* static */
+PowerSupply::Status PowerSupply::statusFromString(const QByteArray &status)
+{
+    if(status == "Charging")
+        return Status::Charging;
+
+    if(status == "Discharging")
+        return Status::Discharging;
+
+    if(status == "Not charging")
+        return Status::NotCharging;
+
+    if(status == "Full")
+        return Status::Full;
+
+    return Status::Unknown;
+}
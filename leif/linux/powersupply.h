@@ -0,0 +1,51 @@
+/**
+ * @brief Defines the PowerSupply class.
+ *
+ * The PowerSupply reads the battery and AC adapter state from the Linux
+ * power supply class in sysfs.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef POWERSUPPLY_H
+#define POWERSUPPLY_H
+
+#include <QString>
+
+class PowerSupply
+{
+public:
+    enum class Status {Unknown, Charging, Discharging, NotCharging, Full};
+
+    explicit PowerSupply(const QString &sysfsPath = QStringLiteral("/sys/class/power_supply"));
+    ~PowerSupply() = default;
+
+    bool read();
+
+    bool hasBattery() const;
+    bool isOnline() const;
+    Status status() const;
+    int powerInMilliWatts() const;
+    int energyInMilliWattHours() const;
+    int adapterPowerInMilliWatts() const;
+
+private:
+    void readBattery(const QString &path);
+
+    static qint64 readPower(const QString &path);
+    static QByteArray readValue(const QString &path, const char *name);
+    static qint64 readNumber(const QString &path, const char *name);
+    static Status statusFromString(const QByteArray &status);
+
+private:
+    QString _sysfsPath;
+    bool _hasBattery;
+    bool _isOnline;
+    Status _status;
+    qint64 _powerInMicroWatts;
+    qint64 _energyInMicroWattHours;
+    qint64 _adapterPowerInMicroWatts;
+};
+
+#endif // POWERSUPPLY_H
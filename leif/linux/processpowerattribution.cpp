@@ -0,0 +1,76 @@
+/**
+ * @brief Implements the ProcessPowerAttribution class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "log/log.h"
+
+#include "processpowerattribution.h"
+
+/**
+ * @class ProcessPowerAttribution
+ *
+ * @brief Attributes the carbon of the session to applications.
+ *
+ * On every sample() the carbon the session gained since the last sample is
+ * split between the applications by the CPU time they used in the same
+ * interval. The scope is the whole computer, the same power draw the session
+ * carbon is based on, so the applications add up to the session. On battery
+ * the session gains nothing and neither do the applications.
+ *
+ * The first sample() only records the baseline, so the constructor does not
+ * walk /proc.
+ */
+
+ProcessPowerAttribution::ProcessPowerAttribution() = default;
+
+/**
+ * @brief Samples the processes and splits \p carbonInGrams between them.
+ *
+ * The processes are sampled even without carbon, so the next interval only
+ * counts the CPU time since this call.
+ *
+ * @param carbonInGrams The carbon the session gained since the last sample.
+ */
+void ProcessPowerAttribution::sample(float carbonInGrams)
+{
+    DBG_CALLED;
+
+    if(!_sampler.sample())
+    {
+        WRN("Could not sample the running processes.");
+        return;
+    }
+
+    const quint64 totalTicks = _sampler.totalTicks();
+    if(totalTicks == 0 || carbonInGrams <= 0)
+        return;
+
+    const double gramsPerTick = static_cast<double>(carbonInGrams) / totalTicks;
+    const QHash<QString, quint64> &ticks = _sampler.applicationTicks();
+
+    for(auto it = ticks.cbegin(); it != ticks.cend(); ++it)
+        _applicationCarbon[it.key()] += static_cast<float>(it.value() * gramsPerTick);
+
+    DBG(QString("Attributed %1g to %2 applications.").arg(carbonInGrams).arg(ticks.count()));
+}
+
+/**
+ * @brief Clears the carbon per application.
+ */
+void ProcessPowerAttribution::clear()
+{
+    _applicationCarbon.clear();
+}
+
+/**
+ * @brief Returns the grams of CO2 per application since the last clear().
+ *
+ * @return A hash with the application name as key and the grams as value.
+ */
+QHash<QString, float> ProcessPowerAttribution::applicationCarbon() const
+{
+    return _applicationCarbon;
+}
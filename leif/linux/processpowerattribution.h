@@ -0,0 +1,36 @@
+/**
+ * @brief Defines the ProcessPowerAttribution class.
+ *
+ * The ProcessPowerAttribution class splits the carbon of the session between
+ * the running applications according to their CPU time.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef PROCESSPOWERATTRIBUTION_H
+#define PROCESSPOWERATTRIBUTION_H
+
+#include <QHash>
+
+#include "processsampler.h"
+
+class ProcessPowerAttribution
+{
+public:
+    ProcessPowerAttribution();
+    ~ProcessPowerAttribution() = default;
+
+    void sample(float carbonInGrams);
+    void clear();
+
+    QHash<QString, float> applicationCarbon() const;
+
+private:
+    Q_DISABLE_COPY_MOVE(ProcessPowerAttribution)
+
+    ProcessSampler _sampler;
+    QHash<QString, float> _applicationCarbon;
+};
+
+#endif // PROCESSPOWERATTRIBUTION_H
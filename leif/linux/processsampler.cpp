@@ -0,0 +1,350 @@
+/**
+ * @brief Implements the ProcessSampler class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QFile>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "processsampler.h"
+
+namespace
+{
+// Fields after the "(comm)" part of /proc/<pid>/stat, counting "state" as 0.
+constexpr int UTimeField {11};
+constexpr int STimeField {12};
+constexpr int StartTimeField {19};
+}
+
+/**
+ * @class ProcessSampler
+ *
+ * @brief Samples the CPU time of all processes from /proc.
+ *
+ * Each call to sample() walks /proc once and reads /proc/<pid>/stat into a
+ * buffer that is reused for every process. Known processes only cost a parse
+ * of that buffer and a hash lookup; the application name (taken from the
+ * systemd cgroup when available, or the process name otherwise) is only
+ * resolved the first time we see a process.
+ */
+
+/**
+ * @brief Creates a sampler reading from \p procPath.
+ *
+ * @param procPath The proc file system mount point. Default: \c /proc.
+ */
+ProcessSampler::ProcessSampler(const QString &procPath /* = QStringLiteral("/proc") */):
+    _procPath {QFile::encodeName(procPath)},
+    _readLength {0},
+    _generation {0},
+    _totalTicks {0}
+{
+    _readBuffer.resize(4096);
+}
+
+/**
+ * @brief Samples all processes.
+ *
+ * After this call applicationTicks() contains the CPU ticks every
+ * application used since the previous call. The very first call only records
+ * the baseline and reports no ticks.
+ *
+ * @return \arg \c true  The processes were sampled.
+ *         \arg \c false The proc file system could not be read.
+ */
+bool ProcessSampler::sample()
+{
+    DIR *dir = opendir(_procPath.constData());
+    if(dir == nullptr)
+        return false;
+
+    ++_generation;
+    _totalTicks = 0;
+
+    for(auto it = _applicationTicks.begin(); it != _applicationTicks.end(); ++it)
+        it.value() = 0;
+
+    while(const dirent *entry = readdir(dir))
+    {
+        char *end = nullptr;
+        const long pid = std::strtol(entry->d_name, &end, 10);
+
+        if(end == entry->d_name || *end != '\0' || pid <= 0)
+            continue;
+
+        sampleProcess(static_cast<int>(pid));
+    }
+
+    closedir(dir);
+
+    // Forget processes that are gone and applications that didn't run.
+    for(auto it = _processes.begin(); it != _processes.end();)
+        it = it.value().generation != _generation ? _processes.erase(it) : std::next(it);
+
+    for(auto it = _applicationTicks.begin(); it != _applicationTicks.end();)
+        it = it.value() == 0 ? _applicationTicks.erase(it) : std::next(it);
+
+    return true;
+}
+
+/**
+ * @brief Returns the CPU ticks per application of the last sample.
+ *
+ * @return A hash with the application name as key and the ticks as value.
+ */
+const QHash<QString, quint64> &ProcessSampler::applicationTicks() const
+{
+    return _applicationTicks;
+}
+
+/**
+ * @brief Returns the sum of all application ticks of the last sample.
+ *
+ * @return The total ticks.
+ */
+quint64 ProcessSampler::totalTicks() const
+{
+    return _totalTicks;
+}
+
+void ProcessSampler::sampleProcess(int pid)
+{
+    char path[PATH_MAX];
+    std::snprintf(path, sizeof(path), "%s/%d/stat", _procPath.constData(), pid);
+
+    if(!readFile(path))
+        return;
+
+    quint64 cpuTicks {0};
+    quint64 startTime {0};
+    const char *comm {nullptr};
+    int commLength {0};
+
+    if(!parseStat(cpuTicks, startTime, comm, commLength))
+        return;
+
+    auto it = _processes.find(pid);
+    quint64 delta {0};
+
+    if(it != _processes.end() && it.value().startTime == startTime)
+    {
+        delta = cpuTicks >= it.value().cpuTicks ? cpuTicks - it.value().cpuTicks : 0;
+    }
+    else
+    {
+        // A new process, or the pid was reused. The process name lives in the
+        // read buffer, so we take it before the cgroup file is read.
+        const QString processName {QString::fromUtf8(comm, commLength)};
+
+        ProcessState state {};
+        state.startTime = startTime;
+        state.application = applicationFromCgroup(pid);
+
+        if(state.application.isEmpty())
+            state.application = processName;
+
+        it = _processes.insert(pid, state);
+
+        // Anything a new process used happened since the last sample.
+        if(_generation > 1)
+            delta = cpuTicks;
+    }
+
+    it.value().cpuTicks = cpuTicks;
+    it.value().generation = _generation;
+
+    if(delta > 0)
+    {
+        _applicationTicks[it.value().application] += delta;
+        _totalTicks += delta;
+    }
+}
+
+bool ProcessSampler::readFile(const char *path)
+{
+    _readLength = 0;
+
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        return false;
+
+    const ssize_t length = ::read(fd, _readBuffer.data(), _readBuffer.size() - 1);
+    ::close(fd);
+
+    if(length <= 0)
+        return false;
+
+    _readLength = static_cast<int>(length);
+    _readBuffer.data()[_readLength] = '\0';
+
+    return true;
+}
+
+/**
+ * @brief Parses the /proc/<pid>/stat content in the read buffer.
+ *
+ * The process name is returned as a pointer into the read buffer, so we don't
+ * allocate anything for processes we already know.
+ */
+bool ProcessSampler::parseStat(quint64 &cpuTicks, quint64 &startTime, const char *&comm, int &commLength) const
+{
+    const char *data = _readBuffer.constData();
+
+    // The process name may contain spaces and parentheses, so we look for the
+    // last closing parenthesis.
+    const char *commBegin = static_cast<const char*>(std::memchr(data, '(', _readLength));
+    const char *commEnd = nullptr;
+
+    for(const char *p = data + _readLength - 1; p > data; --p)
+    {
+        if(*p == ')')
+        {
+            commEnd = p;
+            break;
+        }
+    }
+
+    if(commBegin == nullptr || commEnd == nullptr || commEnd <= commBegin)
+        return false;
+
+    const char *cursor = commEnd + 1;
+    quint64 utime {0};
+    quint64 stime {0};
+
+    for(int field = 0; field <= StartTimeField; ++field)
+    {
+        while(*cursor == ' ')
+            ++cursor;
+
+        if(*cursor == '\0')
+            return false;
+
+        char *end = nullptr;
+        const quint64 value = std::strtoull(cursor, &end, 10);
+
+        if(field == UTimeField)
+            utime = value;
+        else if(field == STimeField)
+            stime = value;
+        else if(field == StartTimeField)
+            startTime = value;
+
+        // The state field is a letter, skip it as a whole.
+        while(*end != ' ' && *end != '\0')
+            ++end;
+
+        cursor = end;
+    }
+
+    cpuTicks = utime + stime;
+    comm = commBegin + 1;
+    commLength = static_cast<int>(commEnd - commBegin - 1);
+
+    return true;
+}
+
+QString ProcessSampler::applicationFromCgroup(int pid)
+{
+    char path[PATH_MAX];
+    std::snprintf(path, sizeof(path), "%s/%d/cgroup", _procPath.constData(), pid);
+
+    if(!readFile(path))
+        return QString();
+
+    // Prefer the unified (v2) hierarchy line "0::/path", else take the first
+    // line's path.
+    const char *data = _readBuffer.constData();
+    const char *line = std::strstr(data, "0::");
+    const char *cgroupPath = nullptr;
+
+    if(line != nullptr && (line == data || line[-1] == '\n'))
+    {
+        cgroupPath = line + 3;
+    }
+    else
+    {
+        const char *firstColon = std::strchr(data, ':');
+        const char *secondColon = firstColon != nullptr ? std::strchr(firstColon + 1, ':') : nullptr;
+
+        if(secondColon == nullptr)
+            return QString();
+
+        cgroupPath = secondColon + 1;
+    }
+
+    const char *lineEnd = std::strchr(cgroupPath, '\n');
+    const int length = lineEnd != nullptr ? static_cast<int>(lineEnd - cgroupPath)
+                                          : static_cast<int>(std::strlen(cgroupPath));
+
+    return applicationFromCgroupPath(cgroupPath, length);
+}
+
+/**
+ * @brief Derives an application name from a systemd cgroup path.
+ *
+ * Services keep their unit name ("cups.service" becomes "cups") and desktop
+ * applications started as "app-<name>-<id>.scope" become "<name>". Anything
+ * else (sessions, terminals, containers) returns an empty string and the
+ * process name is used instead.
+ */
+/* static */
+QString ProcessSampler::applicationFromCgroupPath(const char *path, int length)
+{
+    int begin = length;
+    while(begin > 0 && path[begin - 1] != '/')
+        --begin;
+
+    const char *leaf = path + begin;
+    int leafLength = length - begin;
+
+    auto hasSuffix = [&](const char *suffix, int suffixLength) {
+        return leafLength > suffixLength && std::strncmp(leaf + leafLength - suffixLength, suffix, suffixLength) == 0;
+    };
+
+    const bool isService = hasSuffix(".service", 8);
+    const bool isScope = hasSuffix(".scope", 6);
+    const bool isApp = leafLength > 4 && std::strncmp(leaf, "app-", 4) == 0;
+
+    if(isService)
+    {
+        leafLength -= 8;
+    }
+    else if(isScope && isApp)
+    {
+        leafLength -= 6;
+
+        // Strip the trailing instance id, e.g. "-1234".
+        int idStart = leafLength;
+        while(idStart > 0 && leaf[idStart - 1] >= '0' && leaf[idStart - 1] <= '9')
+            --idStart;
+
+        if(idStart > 1 && idStart < leafLength && leaf[idStart - 1] == '-')
+            leafLength = idStart - 1;
+    }
+    else
+    {
+        return QString();
+    }
+
+    if(isApp)
+    {
+        leaf += 4;
+        leafLength -= 4;
+    }
+
+    // Template instances like "user@1000.service" are no applications.
+    if(leafLength <= 0 || std::memchr(leaf, '@', leafLength) != nullptr)
+        return QString();
+
+    return QString::fromUtf8(leaf, leafLength);
+}
@@ -0,0 +1,56 @@
+/**
+ * @brief Defines the ProcessSampler class.
+ *
+ * The ProcessSampler reads the CPU time of every process from /proc and sums
+ * up how much CPU time each application used since the last sample.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef PROCESSSAMPLER_H
+#define PROCESSSAMPLER_H
+
+#include <QHash>
+#include <QString>
+
+class ProcessSampler
+{
+public:
+    explicit ProcessSampler(const QString &procPath = QStringLiteral("/proc"));
+    ~ProcessSampler() = default;
+
+    bool sample();
+
+    const QHash<QString, quint64> &applicationTicks() const;
+    quint64 totalTicks() const;
+
+private:
+    struct ProcessState
+    {
+        quint64 startTime {0};
+        quint64 cpuTicks {0};
+        quint32 generation {0};
+        QString application;
+    };
+
+    bool readFile(const char *path);
+    bool parseStat(quint64 &cpuTicks, quint64 &startTime, const char *&comm, int &commLength) const;
+    QString applicationFromCgroup(int pid);
+    void sampleProcess(int pid);
+
+    static QString applicationFromCgroupPath(const char *path, int length);
+
+private:
+    Q_DISABLE_COPY_MOVE(ProcessSampler)
+
+    QByteArray _procPath;
+    QByteArray _readBuffer;
+    int _readLength;
+    quint32 _generation;
+    quint64 _totalTicks;
+    QHash<int, ProcessState> _processes;
+    QHash<QString, quint64> _applicationTicks;
+};
+
+#endif // PROCESSSAMPLER_H
@@ -3,6 +3,8 @@
 
 #include <QString>
 
+#include "logrecord.h"
+#include "logsite.h"
 #include "messagetype.h"
 
 namespace Log
@@ -18,6 +20,32 @@ public:
                             const int &codeLine,
                             const MessageType &type,
                             const QString &message) = 0;
+
+    /**
+     * \brief Logs a \p record that may be shared with other loggers.
+     *
+     * Loggers that format the message should override this and use
+     * LogRecord::text(), so the message is only formatted once for all of
+     * them. The default passes the parts on to logMessage().
+     */
+    virtual void logRecord(const LogRecord &record)
+    {
+        logMessage(record.file(), record.methodName(), record.codeLine(), record.type(), record.message());
+    }
+
+    /**
+     * \brief Returns whether the logger wants the messages of \p site.
+     *
+     * The LogManager asks once per site and caches the answer until the next
+     * logger is registered, so this must not depend on the message or the
+     * time. The default accepts everything.
+     */
+    virtual bool accepts(const LogSite &site) const
+    {
+        Q_UNUSED(site)
+
+        return true;
+    }
 };
 
 }
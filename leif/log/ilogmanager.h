@@ -10,6 +10,11 @@ class ILogManager : public ILogger
 public:
     virtual ~ILogManager() = default;
 
+    using ILogger::logMessage;
+
+    virtual bool isEnabled(const LogSite &site) = 0;
+    virtual void logMessage(const LogSite &site, const QString &message) = 0;
+
     virtual void registerLogger(ILogger *logger) = 0;
 };
 }
@@ -3,6 +3,8 @@
 
 #include "iodevicelogger.h"
 
+#include "utils/selfmetrics.h"
+
 class Log::IODeviceLoggerPrivate
 {
 private:
@@ -78,6 +80,13 @@ void Log::IODeviceLogger::writeToTextStream(const QString &message)
 
     if(d->device != nullptr && d->device->isOpen())
     {
+        const qint64 position = d->device->pos();
         d->out << message << Qt::endl;
+
+        // Qt::endl flushes, so the position tells what was written.
+        if(d->device->isSequential())
+            Utils::SelfMetrics::addLoggedBytes(message.size() + 1);
+        else
+            Utils::SelfMetrics::addLoggedBytes(d->device->pos() - position);
     }
 }
@@ -1,8 +1,20 @@
 #ifndef LOG_INTERNAL_H
 #define LOG_INTERNAL_H
 
+#include "logsite.h"
 #include "logsystem.h"
 
-#define LOG(type, message) Log::LogSystem::logManager()->logMessage(__FILE__, __FUNCTION__, __LINE__, type, message)
+// The site is constant initialized, the message is only built if a logger
+// wants it.
+#define LOG(type, message) \
+    do \
+    { \
+        static const Log::LogSite leifLogSite {__FILE__, __FUNCTION__, __LINE__, type}; \
+        if(Log::LogSystem::logManager()->isEnabled(leifLogSite)) \
+        { \
+            Log::LogSystem::logManager()->logMessage(leifLogSite, message); \
+        } \
+    } \
+    while(false)
 
 #endif // LOG_INTERNAL_H
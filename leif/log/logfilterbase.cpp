@@ -23,3 +23,37 @@ void Log::LogFilterBase::logMessage(const QString &file,
 
     m_logger->logMessage(file, methodName, codeLine, type, message);
 }
+
+void Log::LogFilterBase::logRecord(const LogRecord &record)
+{
+    if(m_logger == nullptr)
+    {
+        return;
+    }
+
+    // Records with a site only get here if accepts() said yes.
+    if(record.site() == nullptr
+       && !canLogMessage(record.file(), record.methodName(), record.codeLine(), record.type(), record.message()))
+    {
+        return;
+    }
+
+    m_logger->logRecord(record);
+}
+
+/**
+ * @brief Asks canLogMessage() about \p site, with an empty message.
+ *
+ * The answer is cached per site, filters that look at the message must
+ * override this and logRecord().
+ */
+bool Log::LogFilterBase::accepts(const LogSite &site) const
+{
+    if(m_logger == nullptr)
+    {
+        return false;
+    }
+
+    return canLogMessage(QString::fromUtf8(site.file()), QString::fromLatin1(site.function()), site.line(), site.type(), QString())
+           && m_logger->accepts(site);
+}
@@ -17,6 +17,9 @@ public:
                             const MessageType &type,
                             const QString &message) override;
 
+    virtual void logRecord(const LogRecord &record) override;
+    virtual bool accepts(const LogSite &site) const override;
+
 protected:
     virtual bool canLogMessage(const QString &file,
                                const QString &methodName,
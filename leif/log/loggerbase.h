@@ -17,6 +17,8 @@ public:
                             const MessageType &type,
                             const QString &message) override;
 
+    virtual void logRecord(const LogRecord &record) override;
+
 protected:
     virtual void logDigestedMessage(const QString &digestedMessage) = 0;
 
@@ -25,14 +27,6 @@ protected:
                                const int &codeLine,
                                const MessageType &type,
                                const QString &message);
-
-private:
-    static QString location(const QString &file,
-                            const QString &methodName,
-                            const int &codeLine);
-
-    static QString timeStamp();
-    static QString typeToString(const MessageType &type);
 };
 
 }
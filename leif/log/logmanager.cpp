@@ -1,23 +1,90 @@
 #include <QList>
+#include <QMutex>
+
+#include <atomic>
 
 #include "logmanager.h"
 
+namespace
+{
+// A site caches one bit per logger.
+constexpr int MaxLoggers {64};
+
+// Shared by all managers, a site cached by a deleted manager must not look
+// valid to the next one.
+std::atomic<int> g_generation {0};
+}
+
 class Log::LogManagerPrivate
 {
 private:
-    LogManagerPrivate() = default;
+    LogManagerPrivate();
     ~LogManagerPrivate();
 
+    quint64 acceptingLoggers(const LogSite &site);
+    bool isCached(const LogSite &site) const;
+    void invalidateSites();
+
     QList<ILogger*> logger;
+    std::atomic<int> generation;
+
+    // Messages may come from worker threads (e.g. plugin discovery), the
+    // loggers themselves are not thread safe.
+    QMutex mutex;
+
     friend class LogManager;
 };
 
+Log::LogManagerPrivate::LogManagerPrivate():
+    generation {0}
+{
+    invalidateSites();
+}
+
 Log::LogManagerPrivate::~LogManagerPrivate()
 {
     qDeleteAll(logger);
     logger.clear();
 }
 
+/**
+ * @brief Returns one bit per logger that accepts \p site.
+ *
+ * The loggers are only asked the first time the site is seen and again after
+ * a logger was registered. The mutex must be held.
+ */
+quint64 Log::LogManagerPrivate::acceptingLoggers(const LogSite &site)
+{
+    if(isCached(site))
+    {
+        return site._loggerMask.load(std::memory_order_relaxed);
+    }
+
+    quint64 mask {0};
+    for(int i = 0; i < logger.count(); ++i)
+    {
+        if(logger.at(i)->accepts(site))
+        {
+            mask |= quint64(1) << i;
+        }
+    }
+
+    site._loggerMask.store(mask, std::memory_order_relaxed);
+    site._generation.store(generation.load(std::memory_order_relaxed), std::memory_order_release);
+
+    return mask;
+}
+
+bool Log::LogManagerPrivate::isCached(const LogSite &site) const
+{
+    return site._generation.load(std::memory_order_acquire) == generation.load(std::memory_order_acquire);
+}
+
+void Log::LogManagerPrivate::invalidateSites()
+{
+    generation.store(++g_generation, std::memory_order_release);
+}
+
 Log::LogManager::LogManager():
     d{new LogManagerPrivate}
 {}
@@ -28,6 +95,55 @@ Log::LogManager::~LogManager()
     d = nullptr;
 }
 
+/**
+ * @brief Returns whether any logger wants the messages of \p site.
+ *
+ * Once the site is cached this doesn't lock, LOG() uses it to skip building
+ * messages nobody reads.
+ */
+bool Log::LogManager::isEnabled(const LogSite &site)
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->isCached(site))
+    {
+        return site._loggerMask.load(std::memory_order_relaxed) != 0;
+    }
+
+    QMutexLocker locker(&d->mutex);
+
+    return d->acceptingLoggers(site) != 0;
+}
+
+/**
+ * @brief Passes \p message to the loggers that accept \p site.
+ *
+ * Loggers that turned the site down are not called at all, filters are not
+ * asked again.
+ */
+void Log::LogManager::logMessage(const LogSite &site, const QString &message)
+{
+    Q_ASSERT(d != nullptr);
+
+    QMutexLocker locker(&d->mutex);
+
+    const quint64 mask = d->acceptingLoggers(site);
+    if(mask == 0)
+    {
+        return;
+    }
+
+    const LogRecord record {site, message};
+
+    for(int i = 0; i < d->logger.count(); ++i)
+    {
+        if(mask & (quint64(1) << i))
+        {
+            d->logger.at(i)->logRecord(record);
+        }
+    }
+}
+
 void Log::LogManager::logMessage(const QString &file,
                                  const QString &methodName,
                                  const int &codeLine,
@@ -36,9 +152,19 @@ void Log::LogManager::logMessage(const QString &file,
 {
     Q_ASSERT(d != nullptr);
 
+    QMutexLocker locker(&d->mutex);
+
+    if(d->logger.isEmpty())
+    {
+        return;
+    }
+
+    // One record for all, the first logger that needs the text formats it.
+    const LogRecord record {file, methodName, codeLine, type, message};
+
     for(int i = 0; i < d->logger.count(); ++i)
     {
-        d->logger.at(i)->logMessage(file, methodName, codeLine, type, message);
+        d->logger.at(i)->logRecord(record);
     }
 }
 
@@ -46,8 +172,20 @@ void Log::LogManager::registerLogger(ILogger *logger)
 {
     Q_ASSERT(d != nullptr);
 
-    if(!d->logger.contains(logger))
+    QMutexLocker locker(&d->mutex);
+
+    if(d->logger.contains(logger))
     {
-        d->logger << logger;
+        return;
     }
+
+    if(d->logger.count() >= MaxLoggers)
+    {
+        qWarning("Only %d loggers can be registered.", MaxLoggers);
+        delete logger;
+        return;
+    }
+
+    d->logger << logger;
+    d->invalidateSites();
 }
@@ -13,6 +13,9 @@ public:
     LogManager();
     virtual ~LogManager();
 
+    virtual bool isEnabled(const LogSite &site) override;
+    virtual void logMessage(const LogSite &site, const QString &message) override;
+
     virtual void logMessage(const QString &file,
                             const QString &methodName,
                             const int &codeLine,
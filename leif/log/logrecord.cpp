@@ -0,0 +1,150 @@
+/**
+ * @brief Implements the LogRecord class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "logrecord.h"
+
+/**
+ * @class Log::LogRecord
+ *
+ * @brief A log message and where it came from.
+ *
+ * The record only refers to the site and strings it is given, it must not
+ * outlive the logMessage() call it was created in. Loggers that keep
+ * messages keep the text().
+ *
+ * Records of LOG() statements have a LogSite, records created from the parts
+ * (e.g. by tests or plugins) don't.
+ */
+
+/**
+ * @brief Creates a record of \p message logged at \p site, taking the time
+ * now.
+ */
+Log::LogRecord::LogRecord(const LogSite &site, const QString &message):
+    _site {&site},
+    _file {nullptr},
+    _methodName {nullptr},
+    _codeLine {site.line()},
+    _type {site.type()},
+    _message {message},
+    _time {QDateTime::currentDateTime()}
+{}
+
+/**
+ * @brief Creates a record of \p message, taking the time now.
+ */
+Log::LogRecord::LogRecord(const QString &file,
+                          const QString &methodName,
+                          const int &codeLine,
+                          const MessageType &type,
+                          const QString &message):
+    _site {nullptr},
+    _file {&file},
+    _methodName {&methodName},
+    _codeLine {codeLine},
+    _type {type},
+    _message {message},
+    _time {QDateTime::currentDateTime()}
+{}
+
+/**
+ * @brief Returns the site the message was logged at, or \c nullptr.
+ */
+const Log::LogSite *Log::LogRecord::site() const
+{
+    return _site;
+}
+
+QString Log::LogRecord::file() const
+{
+    return _site != nullptr ? QString::fromUtf8(_site->file()) : *_file;
+}
+
+QString Log::LogRecord::methodName() const
+{
+    return _site != nullptr ? QString::fromLatin1(_site->function()) : *_methodName;
+}
+
+int Log::LogRecord::codeLine() const
+{
+    return _codeLine;
+}
+
+Log::MessageType Log::LogRecord::type() const
+{
+    return _type;
+}
+
+const QString &Log::LogRecord::message() const
+{
+    return _message;
+}
+
+/**
+ * @brief Returns when the message was logged.
+ */
+const QDateTime &Log::LogRecord::time() const
+{
+    return _time;
+}
+
+/**
+ * @brief Returns the formatted line, e.g.
+ * "19102026 12:00:00.000 [INF] (carbonservice.cpp:42/calculateCarbon) - Hi".
+ *
+ * It is formatted by the first logger that asks, all others get the same
+ * string.
+ */
+const QString &Log::LogRecord::text() const
+{
+    if(_text.isNull())
+    {
+        _text = QStringLiteral("%1 [%2] (%3) - %4").arg(_time.toString(QStringLiteral("ddMMyyyy hh:mm:ss.zzz")),
+                                                        typeToString(_type),
+                                                        location(),
+                                                        _message);
+    }
+
+    return _text;
+}
+
+/* static */
+QString Log::LogRecord::typeToString(const MessageType &type)
+{
+    switch(type)
+    {
+    case MessageType::Information:
+        return QStringLiteral("INF");
+
+    case MessageType::Warning:
+        return QStringLiteral("WRN");
+
+    case MessageType::Error:
+        return QStringLiteral("ERR");
+
+    case MessageType::Debug:
+        return QStringLiteral("DBG");
+    }
+
+    return QString();
+}
+
+/**
+ * @brief Returns "file:line/function", with the file name only.
+ */
+QString Log::LogRecord::location() const
+{
+    if(_site != nullptr)
+    {
+        return QString::fromUtf8(_site->baseName()) + QLatin1Char(':') + QString::number(_codeLine)
+             + QLatin1Char('/') + QLatin1String(_site->function());
+    }
+
+    const qsizetype separator = qMax(_file->lastIndexOf(QLatin1Char('/')), _file->lastIndexOf(QLatin1Char('\\')));
+
+    return QStringLiteral("%1:%2/%3").arg(_file->mid(separator + 1), QString::number(_codeLine), *_methodName);
+}
@@ -0,0 +1,66 @@
+/**
+ * @brief Defines the LogRecord class.
+ *
+ * A LogRecord is one message on its way to the loggers. The LogManager
+ * creates it once and hands the same record to every logger, the text is
+ * formatted on first use and then shared.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef LOGRECORD_H
+#define LOGRECORD_H
+
+#include <QDateTime>
+#include <QString>
+
+#include "logsite.h"
+#include "messagetype.h"
+
+namespace Log
+{
+
+class LogRecord
+{
+public:
+    LogRecord(const LogSite &site, const QString &message);
+    LogRecord(const QString &file,
+              const QString &methodName,
+              const int &codeLine,
+              const MessageType &type,
+              const QString &message);
+    ~LogRecord() = default;
+
+    const LogSite *site() const;
+
+    QString file() const;
+    QString methodName() const;
+    int codeLine() const;
+    MessageType type() const;
+    const QString &message() const;
+    const QDateTime &time() const;
+
+    const QString &text() const;
+
+    static QString typeToString(const MessageType &type);
+
+private:
+    Q_DISABLE_COPY_MOVE(LogRecord)
+
+    QString location() const;
+
+    const LogSite *_site;
+    const QString *_file;
+    const QString *_methodName;
+    const int _codeLine;
+    const MessageType _type;
+    const QString &_message;
+    const QDateTime _time;
+
+    mutable QString _text;
+};
+
+}
+
+#endif // LOGRECORD_H
@@ -0,0 +1,84 @@
+/**
+ * @brief Defines the LogSite class.
+ *
+ * A LogSite describes one LOG() statement: the file, function, line and
+ * message type. The LOG() macro creates one static site per statement at
+ * compile time, the LogManager caches per site which loggers want its
+ * messages.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef LOGSITE_H
+#define LOGSITE_H
+
+#include <QtGlobal>
+
+#include <atomic>
+
+#include "messagetype.h"
+
+namespace Log
+{
+
+class LogSite
+{
+public:
+    constexpr LogSite(const char *file, const char *function, int line, MessageType type):
+        _file {file},
+        _baseName {baseNameOf(file)},
+        _function {function},
+        _line {line},
+        _type {type},
+        _generation {0},
+        _loggerMask {0}
+    {}
+    ~LogSite() = default;
+
+    constexpr const char *file() const { return _file; }
+    constexpr const char *baseName() const { return _baseName; }
+    constexpr const char *function() const { return _function; }
+    constexpr int line() const { return _line; }
+    constexpr MessageType type() const { return _type; }
+
+    /**
+     * \brief Returns the file name of \p path, without the directories.
+     *
+     * Both separators are handled, __FILE__ uses backslashes with MSVC.
+     */
+    static constexpr const char *baseNameOf(const char *path)
+    {
+        const char *baseName = path;
+
+        for(const char *c = path; *c != '\0'; ++c)
+        {
+            if(*c == '/' || *c == '\\')
+            {
+                baseName = c + 1;
+            }
+        }
+
+        return baseName;
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(LogSite)
+
+    const char *const _file;
+    const char *const _baseName;
+    const char *const _function;
+    const int _line;
+    const MessageType _type;
+
+    // One bit per registered logger that accepts the site, valid as long as
+    // the generation matches the one of the LogManager. 0 is never used.
+    mutable std::atomic<int> _generation;
+    mutable std::atomic<quint64> _loggerMask;
+
+    friend class LogManagerPrivate;
+};
+
+}
+
+#endif // LOGSITE_H
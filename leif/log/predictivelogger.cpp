@@ -2,6 +2,8 @@
 
 #include "predictivelogger.h"
 
+#include "utils/clock.h"
+
 class Log::PredictiveLoggerPrivate
 {
     PredictiveLoggerPrivate();
@@ -28,11 +30,7 @@ Log::PredictiveLogger::~PredictiveLogger()
     d = nullptr;
 }
 
-void Log::PredictiveLogger::logMessage(const QString &file,
-                                       const QString &methodName,
-                                       const int &codeLine,
-                                       const MessageType &type,
-                                       const QString &message)
+void Log::PredictiveLogger::logRecord(const LogRecord &record)
 {
     Q_ASSERT(d != nullptr);
 
@@ -40,11 +38,11 @@ void Log::PredictiveLogger::logMessage(const QString &file,
 
     if(inErrorMode())
     {
-        FileLogger::logMessage(file, methodName, codeLine, type, message);
+        FileLogger::logRecord(record);
         return;
     }
 
-    storeMessage(makeMessage(file, methodName, codeLine, type, message));
+    storeMessage(record.text());
 }
 
 void Log::PredictiveLogger::onError()
@@ -52,7 +50,7 @@ void Log::PredictiveLogger::onError()
     Q_ASSERT(d != nullptr);
 
     d->errorMode = true;
-    d->errorModeUntill = QDateTime::currentDateTime().addMSecs(1000 * 60 * 5);
+    d->errorModeUntill = Utils::Clock::instance()->now().addMSecs(1000 * 60 * 5);
 
     dumpStoredMessages();
 }
@@ -73,7 +71,7 @@ void Log::PredictiveLogger::checkErrorMode()
         return;
     }
 
-    if(d->errorModeUntill <= QDateTime::currentDateTime())
+    if(d->errorModeUntill <= Utils::Clock::instance()->now())
     {
         d->errorMode = false;
     }
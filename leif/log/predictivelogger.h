@@ -13,9 +13,7 @@ public:
     PredictiveLogger();
     virtual ~PredictiveLogger();
 
-    virtual void logMessage(const QString &file, const QString &methodName,
-                            const int &codeLine, const MessageType &type,
-                            const QString &message) override;
+    virtual void logRecord(const LogRecord &record) override;
 
 private:
     void onError();
@@ -0,0 +1,254 @@
+/**
+ * @brief Implements the Trace class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+
+#include <memory>
+
+#include "trace.h"
+
+namespace
+{
+struct TraceEvent
+{
+    const char *name;
+    const char *category;
+    qint64 start;
+    qint64 duration;
+};
+
+/**
+ * The spans of one thread. Only the owning thread writes, the lock is only
+ * ever contended while a trace is written.
+ */
+struct ThreadBuffer
+{
+    QMutex mutex;
+    QList<TraceEvent> events;
+    qsizetype next {0};
+    int threadId {0};
+    QString threadName;
+};
+
+struct Registry
+{
+    QMutex mutex;
+    QList<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+Registry &registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+/**
+ * The buffer is shared with the registry, so the spans of finished threads
+ * are still in the trace.
+ */
+ThreadBuffer &threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+        auto newBuffer = std::make_shared<ThreadBuffer>();
+
+        QThread *thread = QThread::currentThread();
+        const bool isMainThread = QCoreApplication::instance() != nullptr && thread == QCoreApplication::instance()->thread();
+        newBuffer->threadName = isMainThread ? QStringLiteral("Main") : thread->objectName();
+
+        Registry &reg = registry();
+        QMutexLocker locker(&reg.mutex);
+        newBuffer->threadId = static_cast<int>(reg.buffers.count()) + 1;
+        if(newBuffer->threadName.isEmpty())
+            newBuffer->threadName = QString("Thread %1").arg(newBuffer->threadId);
+
+        reg.buffers.append(newBuffer);
+        return newBuffer;
+    }();
+
+    return *buffer;
+}
+
+const QElapsedTimer &origin()
+{
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+
+    return timer;
+}
+}
+
+std::atomic<bool> Log::Trace::_enabled {false};
+
+/**
+ * @class Log::Trace
+ *
+ * @brief Collects the spans of all threads.
+ *
+ * Every thread records into its own buffer of at most MaxEventsPerThread
+ * spans. When it is full the oldest spans are overwritten, so a long running
+ * trace shows the recent past.
+ */
+
+/**
+ * @brief Turns the recording of spans on or off.
+ *
+ * The spans recorded so far are kept, see clear().
+ */
+/* static */
+void Log::Trace::setEnabled(bool enabled)
+{
+    origin();
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Forgets all recorded spans.
+ */
+/* static */
+void Log::Trace::clear()
+{
+    Registry &reg = registry();
+    QMutexLocker locker(&reg.mutex);
+
+    for(const std::shared_ptr<ThreadBuffer> &buffer : std::as_const(reg.buffers))
+    {
+        QMutexLocker bufferLocker(&buffer->mutex);
+        buffer->events.clear();
+        buffer->next = 0;
+    }
+}
+
+/**
+ * @brief Returns the recorded spans in the Chrome trace event format.
+ */
+/* static */
+QByteArray Log::Trace::toChromeJson()
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+
+    events.append(QJsonObject {
+        {QStringLiteral("name"), QStringLiteral("process_name")},
+        {QStringLiteral("ph"), QStringLiteral("M")},
+        {QStringLiteral("pid"), pid},
+        {QStringLiteral("args"), QJsonObject {{QStringLiteral("name"), QCoreApplication::applicationName()}}}
+    });
+
+    Registry &reg = registry();
+    QMutexLocker locker(&reg.mutex);
+
+    for(const std::shared_ptr<ThreadBuffer> &buffer : std::as_const(reg.buffers))
+    {
+        QMutexLocker bufferLocker(&buffer->mutex);
+
+        events.append(QJsonObject {
+            {QStringLiteral("name"), QStringLiteral("thread_name")},
+            {QStringLiteral("ph"), QStringLiteral("M")},
+            {QStringLiteral("pid"), pid},
+            {QStringLiteral("tid"), buffer->threadId},
+            {QStringLiteral("args"), QJsonObject {{QStringLiteral("name"), buffer->threadName}}}
+        });
+
+        // Oldest first, the ring starts at next once it is full.
+        for(qsizetype i = 0; i < buffer->events.count(); ++i)
+        {
+            const TraceEvent &event = buffer->events.at((buffer->next + i) % buffer->events.count());
+
+            events.append(QJsonObject {
+                {QStringLiteral("name"), QString::fromUtf8(event.name)},
+                {QStringLiteral("cat"), QString::fromUtf8(event.category)},
+                {QStringLiteral("ph"), QStringLiteral("X")},
+                {QStringLiteral("ts"), static_cast<double>(event.start) / 1000},
+                {QStringLiteral("dur"), static_cast<double>(event.duration) / 1000},
+                {QStringLiteral("pid"), pid},
+                {QStringLiteral("tid"), buffer->threadId}
+            });
+        }
+    }
+
+    const QJsonObject root {
+        {QStringLiteral("traceEvents"), events},
+        {QStringLiteral("displayTimeUnit"), QStringLiteral("ms")}
+    };
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+/* static */
+bool Log::Trace::writeChromeJson(QIODevice *device)
+{
+    Q_ASSERT(device != nullptr);
+
+    const QByteArray json = toChromeJson();
+    return device->write(json) == json.size();
+}
+
+/**
+ * @brief Writes the recorded spans to \p fileName.
+ */
+/* static */
+bool Log::Trace::writeChromeJson(const QString &fileName)
+{
+    QFile file {fileName};
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    return writeChromeJson(&file);
+}
+
+/**
+ * @brief Returns the trace file from \c LEIF_TRACE, or an empty string.
+ *
+ * If it is set, the applications trace from the start and write the trace
+ * to this file when they quit.
+ */
+/* static */
+QString Log::Trace::configuredFileName()
+{
+    return qEnvironmentVariable("LEIF_TRACE");
+}
+
+/**
+ * @brief Returns the nanoseconds since tracing was first enabled.
+ */
+/* static */
+qint64 Log::Trace::timestamp()
+{
+    return origin().nsecsElapsed();
+}
+
+/**
+ * @brief Records a span of the current thread, see TraceSpan.
+ */
+/* static */
+void Log::Trace::record(const char *name, const char *category, qint64 start, qint64 end)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    const TraceEvent event {name, category, start, end - start};
+
+    QMutexLocker locker(&buffer.mutex);
+
+    if(buffer.events.count() < MaxEventsPerThread)
+    {
+        buffer.events.append(event);
+        return;
+    }
+
+    buffer.events[buffer.next] = event;
+    buffer.next = (buffer.next + 1) % buffer.events.count();
+}
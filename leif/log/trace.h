@@ -0,0 +1,102 @@
+/**
+ * @brief Defines the Trace and TraceSpan classes.
+ *
+ * Scoped spans record how long hot code paths take, per thread, and can be
+ * written as Chrome trace JSON. Open the file in chrome://tracing or
+ * ui.perfetto.dev. Tracing is off unless Trace::setEnabled() is called, a
+ * disabled span costs one relaxed atomic load and a branch. LEIF_TRACE=<file>
+ * traces from the start and writes the file on exit; at runtime tracing is
+ * switched through the metrics endpoint (POST /trace/start, /trace/stop).
+ *
+ * \code
+ * void CarbonService::calculateCarbon()
+ * {
+ *     TRACE_FUNCTION;
+ *     ...
+ * }
+ * \endcode
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QByteArray>
+#include <QString>
+
+#include <atomic>
+
+class QIODevice;
+
+namespace Log {
+
+class Trace
+{
+public:
+    static inline bool isEnabled();
+    static void setEnabled(bool enabled);
+
+    static void clear();
+    static QByteArray toChromeJson();
+    static bool writeChromeJson(QIODevice *device);
+    static bool writeChromeJson(const QString &fileName);
+
+    static QString configuredFileName();
+
+    static qint64 timestamp();
+    static void record(const char *name, const char *category, qint64 start, qint64 end);
+
+    static constexpr int MaxEventsPerThread {64 * 1024};
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+class TraceSpan
+{
+public:
+    inline TraceSpan(const char *name, const char *category);
+    inline ~TraceSpan();
+
+private:
+    Q_DISABLE_COPY_MOVE(TraceSpan)
+
+    const char *_name;
+    const char *_category;
+    qint64 _start;
+};
+
+bool Trace::isEnabled()
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Starts a span named \p name, it ends with the scope.
+ *
+ * The strings are not copied, they must live forever, like literals and
+ * Q_FUNC_INFO do.
+ */
+TraceSpan::TraceSpan(const char *name, const char *category):
+    _name {name},
+    _category {category},
+    _start {Trace::isEnabled() ? Trace::timestamp() : -1}
+{}
+
+TraceSpan::~TraceSpan()
+{
+    if(_start >= 0)
+        Trace::record(_name, _category, _start, Trace::timestamp());
+}
+
+}
+
+#define TRACE_CONCAT_INTERNAL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INTERNAL(a, b)
+
+#define TRACE_SPAN(name) Log::TraceSpan TRACE_CONCAT(traceSpan, __LINE__) {name, "leif"}
+#define TRACE_FUNCTION TRACE_SPAN(Q_FUNC_INFO)
+
+#endif // TRACE_H
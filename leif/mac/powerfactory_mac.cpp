@@ -21,10 +21,10 @@ std::unique_ptr<IPower> PowerFactory::getPowerInterface(SettingsService *setting
     if(settings == nullptr)
         return nullptr;
 
-    auto storeFunc = [=](int avgDischargeRate)
+    auto storeFunc = [=](const Utils::PowerProfile &profile)
     {
-        settings->saveAverageDischargeRate(avgDischargeRate);
+        settings->savePowerProfile(profile);
     };
 
-    return std::make_unique<PowerInfo>(settings->averageDischargeRate(), storeFunc);
+    return std::make_unique<PowerInfo>(settings->powerProfile(), storeFunc);
 }
@@ -4,8 +4,8 @@
 
 #include "powerinfo.h"
 
-PowerInfo::PowerInfo(int avarageDischargeRate, std::function<void (int)> storeAvarageDischargeRateFunc, QObject *parent /* = nullptr */):
-    PowerInfoBase {avarageDischargeRate, storeAvarageDischargeRateFunc, parent}
+PowerInfo::PowerInfo(const Utils::PowerProfile &profile, std::function<void (const Utils::PowerProfile&)> storeProfileFunc, QObject *parent /* = nullptr */):
+    PowerInfoBase {profile, storeProfileFunc, parent}
 {
     m_service = IOServiceGetMatchingService(kIOMasterPortDefault,
                                             IOServiceNameMatching("AppleSmartBattery"));
@@ -185,6 +185,18 @@ int PowerInfo::chargeRate()
     return adapterPower;
 }
 
+/**
+ * @brief Returns the AdapterPower of the battery data.
+ *
+ * It is what the adapter delivers, so it is also right with a full battery.
+ */
+int PowerInfo::adapterPower()
+{
+    DBG_CALLED;
+
+    return chargeRate();
+}
+
 int PowerInfo::dischargeRate()
 {
     DBG_CALLED;
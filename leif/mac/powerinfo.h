@@ -8,7 +8,7 @@
 class PowerInfo : public PowerInfoBase
 {
 public:
-    explicit PowerInfo(int avarageDischargeRate, std::function<void(int)> storeAvarageDischargeRateFunc, QObject *parent = nullptr);
+    explicit PowerInfo(const Utils::PowerProfile &profile, std::function<void(const Utils::PowerProfile&)> storeProfileFunc, QObject *parent = nullptr);
     virtual ~PowerInfo();
 
     // PowerInfoBase interface
@@ -19,6 +19,7 @@ protected:
     virtual int chargeRate() override;
     virtual int dischargeRate() override;
     virtual int currentCapacity() override;
+    virtual int adapterPower() override;
 
 private:
     io_service_t m_service;
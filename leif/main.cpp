@@ -20,10 +20,18 @@
 #include <controllers/carboncontroller.h>
 
 #include <services/carbonservice.h>
+#include <services/fleetreporter.h>
+#include <services/metricsservice.h>
+#include <services/schedulerservice.h>
 #include <services/settingsservice.h>
 
+#include <plugin/carbonpluginmanager.h>
+
+#include <utils/selfmetrics.h>
+
 #include "log/log.h"
 #include "log/filelogger.h"
+#include "log/trace.h"
 
 #ifdef QT_DEBUG
 #include "log/consolelogger.h"
@@ -34,6 +42,7 @@ int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
     app.setQuitOnLastWindowClosed(false); // Very important with tray apps.
+    Utils::SelfMetrics selfMetrics;
     setApplicationInfo();
 
 #ifdef _WIN32
@@ -51,6 +60,15 @@ int main(int argc, char *argv[])
     INF("Leif application is starting...");
     INF("===============================");
 
+    // Trace from the start if asked to, see Log::Trace.
+    const QString traceFileName = Log::Trace::configuredFileName();
+    if(!traceFileName.isEmpty())
+        Log::Trace::setEnabled(true);
+
+    // Start the plugin discovery as early as possible, it runs in the
+    // background while the services are set up.
+    CarbonPluginManager::Instance();
+
     /*
     QScopedPointer<QTranslator> translator(new QTranslator);
     loadTranslations(translator.data());
@@ -58,6 +76,9 @@ int main(int argc, char *argv[])
     
     QScopedPointer<SettingsService> settingsService(new SettingsService);
     QScopedPointer<CarbonService> carbonService(new CarbonService(settingsService.get()));
+    QScopedPointer<SchedulerService> schedulerService(new SchedulerService(settingsService.get()));
+    QScopedPointer<MetricsService> metricsService(new MetricsService(carbonService.get()));
+    QScopedPointer<FleetReporter> fleetReporter(new FleetReporter(carbonService.get()));
     QScopedPointer<TrayIconController> trayController(new TrayIconController(settingsService.get(), carbonService.get()));
     QScopedPointer<TrayIcon> tray(new TrayIcon(trayController.get()));
     tray->show();
@@ -67,6 +88,10 @@ int main(int argc, char *argv[])
     INF("==================================");
     INF("Leif application is shutting down.");
     INF("==================================");
+    INF(Utils::SelfMetrics::toString(Utils::SelfMetrics::sample()));
+
+    if(!traceFileName.isEmpty() && !Log::Trace::writeChromeJson(traceFileName))
+        WRN(QString("Could not write the trace to %1.").arg(traceFileName));
 
     return result;
 }
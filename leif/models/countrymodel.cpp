@@ -3,7 +3,16 @@
 
 CountryModel::CountryModel(QObject *parent /* = nullptr */):
     QAbstractListModel(parent)
-{}
+{
+    CarbonPluginManager *manager = CarbonPluginManager::Instance();
+    if(manager != nullptr)
+    {
+        connect(manager, &CarbonPluginManager::pluginsLoaded, this, [this]() {
+            beginResetModel();
+            endResetModel();
+        });
+    }
+}
 
 int CountryModel::rowCount(const QModelIndex &parent) const
 {
@@ -4,7 +4,16 @@
 RegionModel::RegionModel(QObject *parent)
     : QAbstractListModel{parent},
       m_country{QLocale::AnyCountry}
-{}
+{
+    CarbonPluginManager *manager = CarbonPluginManager::Instance();
+    if(manager != nullptr)
+    {
+        connect(manager, &CarbonPluginManager::pluginsLoaded, this, [this]() {
+            beginResetModel();
+            endResetModel();
+        });
+    }
+}
 
 int RegionModel::rowCount(const QModelIndex &parent) const
 {
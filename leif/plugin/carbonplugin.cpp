@@ -1,9 +1,17 @@
+#include <memory>
+
 #include <QDir>
+#include <QFileInfo>
 #include <QPluginLoader>
+#include <QSet>
+#include <QtConcurrent>
 
 #include "log/log.h"
+#include "log/trace.h"
 
 #include "carbonplugin.h"
+#include "pluginmetadatacache.h"
+#include "remotecarbonplugin.h"
 
 class CarbonPluginPrivate
 {
@@ -12,9 +20,15 @@ public:
 
 private:
     CarbonPluginPrivate(const QString &fileName);
+    CarbonPluginPrivate(const QString &fileName, const Utils::CarbonPluginData &data);
+
+    QPluginLoader *pluginLoader();
+    IDataProvider *dataProvider();
 
     // DATA
+    QString fileName;
     QScopedPointer<QPluginLoader> loader;
+    QScopedPointer<RemoteCarbonPlugin> remote;
     IDataProvider *pluginInterface;
     Utils::CarbonPluginData pluginData;
 
@@ -22,10 +36,45 @@ private:
 };
 
 CarbonPluginPrivate::CarbonPluginPrivate(const QString &fileName):
-    loader {new QPluginLoader {fileName}},
+    fileName {fileName},
     pluginInterface {nullptr}
 {
-    pluginData = Utils::CarbonPluginData::fromJson(loader->metaData().value(QStringLiteral("MetaData")));
+    // Reading the metadata doesn't load the library. We may be on a
+    // discovery thread here, so the actual loader is created later, in the
+    // thread that loads the plugin.
+    const QPluginLoader metaDataLoader {fileName};
+    pluginData = Utils::CarbonPluginData::fromJson(metaDataLoader.metaData().value(QStringLiteral("MetaData")));
+}
+
+CarbonPluginPrivate::CarbonPluginPrivate(const QString &fileName, const Utils::CarbonPluginData &data):
+    fileName {fileName},
+    pluginInterface {nullptr},
+    pluginData {data}
+{}
+
+/**
+ * @brief Returns the plugin loader, creating it on first use.
+ *
+ * Plugins created from cached metadata don't need a loader until they are
+ * actually loaded.
+ */
+QPluginLoader *CarbonPluginPrivate::pluginLoader()
+{
+    if(!loader)
+        loader.reset(new QPluginLoader {fileName});
+
+    return loader.get();
+}
+
+IDataProvider *CarbonPluginPrivate::dataProvider()
+{
+    if(remote)
+        return remote->isRunning() ? remote.get() : nullptr;
+
+    if(pluginInterface == nullptr && loader && loader->isLoaded())
+        pluginInterface = qobject_cast<IDataProvider*>(loader->instance());
+
+    return pluginInterface;
 }
 
 CarbonPluginPrivate::~CarbonPluginPrivate()
@@ -40,6 +89,10 @@ CarbonPlugin::CarbonPlugin(const QString &fileName):
     d {new CarbonPluginPrivate {fileName}}
 {}
 
+CarbonPlugin::CarbonPlugin(const QString &fileName, const Utils::CarbonPluginData &pluginData):
+    d {new CarbonPluginPrivate {fileName, pluginData}}
+{}
+
 CarbonPlugin::~CarbonPlugin()
 {}
 
@@ -61,24 +114,44 @@ QString CarbonPlugin::fileName() const
 
 bool CarbonPlugin::isLoaded() const
 {
-    Q_ASSERT(d->loader != nullptr);
+    if(d->remote)
+        return d->remote->isRunning();
 
-    return d->loader->isLoaded();
+    return d->loader && d->loader->isLoaded();
 }
 
+/**
+ * @brief Loads the plugin library.
+ *
+ * If the plugin host is enabled (see RemoteCarbonPlugin::isEnabled()) the
+ * library is loaded by a plugin host process instead of this one.
+ */
 bool CarbonPlugin::load()
 {
-    Q_ASSERT(d->loader != nullptr);
+    if(RemoteCarbonPlugin::isEnabled())
+    {
+        if(!d->remote)
+            d->remote.reset(new RemoteCarbonPlugin {d->fileName});
+
+        return d->remote->start();
+    }
 
-    return d->loader->load();
+    return d->pluginLoader()->load();
 }
 
 bool CarbonPlugin::unload()
 {
-    Q_ASSERT(d->loader != nullptr);
-
     d->pluginInterface = nullptr;
 
+    if(d->remote)
+    {
+        d->remote->stop();
+        return true;
+    }
+
+    if(!d->loader)
+        return true;
+
     return d->loader->unload();
 }
 
@@ -89,25 +162,35 @@ Utils::CarbonPluginData CarbonPlugin::pluginData() const
 
 CarbonData CarbonPlugin::carbonPerKiloWatt(const QLocale::Country country, const QString &region)
 {
-    Q_ASSERT(d->loader != nullptr);
-
     if(!isLoaded())
         return CarbonData::error(tr("The plugin for the country: '%1' is not loade yet.")
                                  .arg(QLocale::countryToString(country)));
 
-    if(d->pluginInterface == nullptr)
-        d->pluginInterface = qobject_cast<IDataProvider*>(d->loader->instance());
-
-    if(d->pluginInterface == nullptr)
+    IDataProvider *provider = d->dataProvider();
+    if(provider == nullptr)
         return CarbonData::error(tr("The plugin for the country: '%1' seems not "
                                     "to be a valid carbon data provider plugin.")
                                  .arg(QLocale::countryToString(country)));
 
-    return d->pluginInterface->carbonPerKiloWatt(country, region);
+    return provider->carbonPerKiloWatt(country, region);
+}
+
+QHash<QString, CarbonData> CarbonPlugin::carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                           const QDateTime &from, const QDateTime &to)
+{
+    IDataProvider *provider = d->dataProvider();
+
+    // The default implementation reports our load errors for every region.
+    if(provider == nullptr)
+        return IDataProvider::carbonPerKiloWatt(country, regions, from, to);
+
+    return provider->carbonPerKiloWatt(country, regions, from, to);
 }
 
 QList<CarbonPlugin *> CarbonPlugin::getPlugins()
 {
+    TRACE_FUNCTION;
+
     QStringList pluginPaths;
     pluginPaths << QCoreApplication::applicationDirPath() + QStringLiteral("/plugins");
 
@@ -132,26 +215,58 @@ QList<CarbonPlugin *> CarbonPlugin::getPlugins()
     auto isLibrary {[](const QString &filePath) { return QLibrary::isLibrary(filePath); }};
     std::copy_if(std::begin(filePaths), std::end(filePaths), std::back_inserter(libraryFilePaths), isLibrary);
 
-    QList<CarbonPlugin*> plugins;
+    // Unchanged plugins are created from the cached metadata without
+    // opening the library, the others are read in parallel.
+    PluginMetadataCache cache;
+    cache.load();
 
-    auto makePlugin {[&](const QString &filePath) {
-        DBG(QString("Loading plugin: '%1'.").arg(filePath));
-        std::unique_ptr<CarbonPlugin> plugin = std::make_unique<CarbonPlugin>(filePath);
+    struct Discovered
+    {
+        CarbonPlugin *plugin;
+        bool fromCache;
+    };
 
-        QString pluginName = plugin->pluginData().name();
+    auto discover {[&cache](const QString &filePath) -> Discovered {
+        Utils::CarbonPluginData pluginData;
 
-        struct HasName
-        {
-            const QString &_name;
-            HasName(const QString &name): _name{name} {}
-            bool operator()(const CarbonPlugin *p) const {return p->pluginData().name() == _name; }
-        };
+        if(cache.lookup(QFileInfo {filePath}, pluginData))
+            return Discovered {new CarbonPlugin {filePath, pluginData}, true};
 
-        if(std::none_of(std::begin(plugins), std::end(plugins), HasName(pluginName)))
-            plugins << plugin.release();
+        return Discovered {new CarbonPlugin {filePath}, false};
     }};
 
-    std::for_each(std::begin(libraryFilePaths), std::end(libraryFilePaths), makePlugin);
+    const QList<Discovered> discovered = QtConcurrent::blockingMapped<QList<Discovered>>(libraryFilePaths, discover);
+
+    QList<CarbonPlugin*> plugins;
+    QSet<QString> pluginNames;
+
+    for(int i = 0; i < discovered.count(); ++i)
+    {
+        const QString &filePath {libraryFilePaths.at(i)};
+        std::unique_ptr<CarbonPlugin> plugin {discovered.at(i).plugin};
+
+        if(discovered.at(i).fromCache)
+        {
+            DBG(QString("Using cached metadata for plugin: '%1'.").arg(filePath));
+        }
+        else
+        {
+            DBG(QString("Read metadata of plugin: '%1'.").arg(filePath));
+            cache.insert(QFileInfo {filePath}, plugin->pluginData());
+        }
+
+        // The first plugin with a given name wins.
+        const QString pluginName {plugin->pluginData().name()};
+        if(pluginNames.contains(pluginName))
+            continue;
+
+        pluginNames.insert(pluginName);
+        plugins << plugin.release();
+    }
+
+    cache.retain(libraryFilePaths);
+    if(!cache.save())
+        WRN("Could not write the plugin metadata cache.");
 
     return plugins;
 }
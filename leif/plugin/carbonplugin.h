@@ -14,6 +14,7 @@ class CarbonPlugin : public IDataProvider
     Q_DECLARE_TR_FUNCTIONS(CarbonPlugin)
 public:
     CarbonPlugin(const QString &fileName);
+    CarbonPlugin(const QString &fileName, const Utils::CarbonPluginData &pluginData);
     virtual ~CarbonPlugin();
 
     //QString errorString() const;
@@ -24,6 +25,8 @@ public:
     Utils::CarbonPluginData pluginData() const;
 
     virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override;
+    virtual QHash<QString, CarbonData> carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                         const QDateTime &from, const QDateTime &to) override;
 
     static QList<CarbonPlugin*> getPlugins();
 
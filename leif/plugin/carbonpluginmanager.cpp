@@ -6,8 +6,16 @@
  * @date 28.09.2022
  * @copyright Tim Stone
  */
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include "log/log.h"
+#include "log/trace.h"
+#include "utils/clock.h"
+
 #include "carbonplugin.h"
 #include "carbonpluginmanager.h"
+#include "fetchpolicy.h"
 
 class CarbonPluginManagerPrivate
 {
@@ -15,24 +23,44 @@ class CarbonPluginManagerPrivate
     ~CarbonPluginManagerPrivate();
     void initPluginMap();
     CarbonPlugin *pluginForTerritory(const QLocale::Country territory) const;
+    CarbonPlugin *acquirePlugin(const QLocale::Country territory);
+    void evictPlugins();
+    CarbonData fallback(const QString &key, const QDateTime &nextAttempt, const QString &reason) const;
+
+    static QString sourceKey(const QLocale::Country country, const QString &region);
 
     // DATA
     CarbonPlugin *currentPlugin;
+    bool ready;
+    QFutureWatcher<QList<CarbonPlugin*>> discovery;
     QList<CarbonPlugin*> plugins;
+    QList<CarbonPlugin*> loadedPlugins; // Most recently used first.
     QHash<QLocale::Country, int> pluginMap;
+    QHash<QString, FetchPolicy> fetchPolicies;
+    QHash<QString, CarbonData> lastKnownGood;
     static CarbonPluginManager *Instance;
+    static constexpr int MaxLoadedPlugins {4};
 
     friend class CarbonPluginManager;
 };
 
 
 CarbonPluginManagerPrivate::CarbonPluginManagerPrivate():
-    currentPlugin{nullptr}
+    currentPlugin{nullptr},
+    ready{false}
 {}
 
 CarbonPluginManagerPrivate::~CarbonPluginManagerPrivate()
 {
     currentPlugin = nullptr;
+    loadedPlugins.clear();
+
+    // The discovery may still be running, we own its result either way.
+    discovery.waitForFinished();
+    if(!ready && discovery.future().resultCount() > 0)
+    {
+        qDeleteAll(discovery.result());
+    }
 
     qDeleteAll(plugins);
     plugins.clear();
@@ -73,6 +101,93 @@ CarbonPlugin *CarbonPluginManagerPrivate::pluginForTerritory(const QLocale::Coun
     return plugins.at(index);
 }
 
+/**
+ * @brief Returns the loaded plugin for \p territory.
+ *
+ * The plugin is loaded if necessary and becomes the most recently used one.
+ * Loading a plugin may unload the least recently used one, see
+ * evictPlugins().
+ *
+ * @return The plugin or \c nullptr if there is none or it can't be loaded.
+ */
+CarbonPlugin *CarbonPluginManagerPrivate::acquirePlugin(const QLocale::Country territory)
+{
+    CarbonPlugin *plugin = pluginForTerritory(territory);
+    if(plugin == nullptr)
+    {
+        return nullptr;
+    }
+
+    if(loadedPlugins.removeOne(plugin) && plugin->isLoaded())
+    {
+        loadedPlugins.prepend(plugin);
+        return plugin;
+    }
+
+    if(!plugin->load())
+    {
+        WRN(QString("Could not load the plugin for %1.").arg(QLocale::territoryToString(territory)));
+        return nullptr;
+    }
+
+    DBG(QString("Loaded the plugin for %1.").arg(QLocale::territoryToString(territory)));
+
+    loadedPlugins.prepend(plugin);
+    evictPlugins();
+
+    return plugin;
+}
+
+/**
+ * @brief Unloads the least recently used plugins above MaxLoadedPlugins.
+ *
+ * The current plugin is never unloaded, it is the one we query every minute.
+ */
+void CarbonPluginManagerPrivate::evictPlugins()
+{
+    for(int i = loadedPlugins.count() - 1; i >= 0 && loadedPlugins.count() > MaxLoadedPlugins; --i)
+    {
+        CarbonPlugin *plugin = loadedPlugins.at(i);
+        if(plugin == currentPlugin)
+        {
+            continue;
+        }
+
+        loadedPlugins.removeAt(i);
+        plugin->unload();
+
+        DBG(QString("Unloaded the plugin '%1'.").arg(plugin->pluginData().name()));
+    }
+}
+
+/**
+ * @brief Returns the last known good data of source \p key, if still usable.
+ *
+ * The data expires at \p nextAttempt at the latest, so we ask the plugin again
+ * as soon as the policy allows it. If the forecast has run out as well, the
+ * error carries the \p reason the fresh data is missing.
+ */
+CarbonData CarbonPluginManagerPrivate::fallback(const QString &key, const QDateTime &nextAttempt, const QString &reason) const
+{
+    const QDateTime now = Utils::Clock::instance()->now();
+    const CarbonData data = FetchPolicy::lastKnownForecast(lastKnownGood.value(key), now, nextAttempt);
+
+    if(!data.isValid)
+    {
+        return CarbonData::error(QString("%1 %2").arg(reason, data.errorString));
+    }
+
+    INF(QString("Using the last known forecast for %1 until %2.").arg(key, data.validTo.toString()));
+
+    return data;
+}
+
+/* static */
+QString CarbonPluginManagerPrivate::sourceKey(const QLocale::Country country, const QString &region)
+{
+    return QString("%1/%2").arg(QLocale::territoryToCode(country), region);
+}
+
 CarbonPluginManager * CarbonPluginManagerPrivate::Instance = nullptr;
 
 
@@ -95,6 +210,37 @@ void CarbonPluginManager::Destroy()
     }
 }
 
+/**
+ * @brief Returns whether the plugin discovery has finished.
+ *
+ * Until then the manager behaves as if there were no plugins.
+ */
+bool CarbonPluginManager::isReady() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->ready;
+}
+
+/**
+ * @brief Blocks until the plugin discovery has finished.
+ *
+ * Only meant for callers that can't wait for pluginsLoaded(), the signal is
+ * emitted before this method returns if the plugins weren't loaded yet.
+ */
+void CarbonPluginManager::waitForPlugins()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->ready)
+    {
+        return;
+    }
+
+    d->discovery.waitForFinished();
+    onPluginsDiscovered();
+}
+
 bool CarbonPluginManager::hasPlugins() const
 {
     Q_ASSERT(d != nullptr);
@@ -174,6 +320,12 @@ QString CarbonPluginManager::translatedRegion(const QLocale::Country country, co
     return plugin->pluginData().translatedRegionId(country, regionId);
 }
 
+/**
+ * @brief Makes the plugin for \p country the current plugin.
+ *
+ * Plugins used before stay loaded (up to MaxLoadedPlugins), so switching
+ * back and forth between countries doesn't reload them.
+ */
 bool CarbonPluginManager::loadPlugin(const QLocale::Country country)
 {
     Q_ASSERT(d != nullptr);
@@ -183,28 +335,15 @@ bool CarbonPluginManager::loadPlugin(const QLocale::Country country)
         return false;
     }
 
-    CarbonPlugin *plugin = d->pluginForTerritory(country);
+    CarbonPlugin *plugin = d->acquirePlugin(country);
     if(plugin == nullptr)
     {
         return false;
     }
 
-    if(plugin->isLoaded())
-    {
-        return true;
-    }
-
-    if(d->currentPlugin != plugin)
-    {
-        if(d->currentPlugin != nullptr)
-        {
-            d->currentPlugin->unload();
-        }
-
-        d->currentPlugin = plugin;
-    }
+    d->currentPlugin = plugin;
 
-    return plugin->load();
+    return true;
 }
 
 bool CarbonPluginManager::hasCurrentPlugin() const
@@ -223,6 +362,7 @@ CarbonPlugin *CarbonPluginManager::currentPlugin() const
 
 CarbonData CarbonPluginManager::carbonPerKiloWatt(const QLocale::Country country, const QString &region)
 {
+    TRACE_FUNCTION;
     Q_ASSERT(d != nullptr);
 
     if(!hasCurrentPlugin() && !loadPlugin(country))
@@ -230,14 +370,162 @@ CarbonData CarbonPluginManager::carbonPerKiloWatt(const QLocale::Country country
         return CarbonData::error("No country/region selected yet.");
     }
 
-    return currentPlugin()->carbonPerKiloWatt(country, region);
+    // Any territory can be queried, not just the current one. Its plugin is
+    // routed to by territory and stays loaded for the next query.
+    CarbonPlugin *plugin = d->acquirePlugin(country);
+    if(plugin == nullptr)
+    {
+        return CarbonData::error(QString("No carbon plugin available for %1.").arg(QLocale::territoryToString(country)));
+    }
+
+    // Every country/region is a separate source with its own backoff.
+    const QString key = CarbonPluginManagerPrivate::sourceKey(country, region);
+    FetchPolicy &policy = d->fetchPolicies[key];
+
+    if(!policy.allowRequest(Utils::Clock::instance()->now()))
+    {
+        DBG(QString("Skipping request for %1 until %2.").arg(key, policy.nextAttempt().toString()));
+        return d->fallback(key, policy.nextAttempt(), QStringLiteral("Carbon data source is backing off."));
+    }
+
+    CarbonData data;
+    {
+        // The plugin's own request, e.g. Utilities::requestCarbonData().
+        TRACE_SPAN("CarbonPlugin::carbonPerKiloWatt");
+        data = plugin->carbonPerKiloWatt(country, region);
+    }
+
+    const QDateTime now = Utils::Clock::instance()->now();
+    policy.record(data, now);
+
+    if(data.isValid)
+    {
+        d->lastKnownGood.insert(key, data);
+
+        return data;
+    }
+
+    if(data.isPending)
+    {
+        // Nothing failed, ask again at the next calculation.
+        DBG(QString("Request for %1 is pending: %2").arg(key, data.errorString));
+
+        CarbonData fallback = d->fallback(key, now, data.errorString);
+        fallback.isPending = !fallback.isValid;
+        return fallback;
+    }
+
+    WRN(QString("Request for %1 failed %2 time(s), next attempt at %3: %4")
+        .arg(key).arg(policy.failureCount()).arg(policy.nextAttempt().toString(), data.errorString));
+
+    return d->fallback(key, policy.nextAttempt(), data.errorString);
+}
+
+void CarbonPluginManager::onPluginsDiscovered()
+{
+    Q_ASSERT(d != nullptr);
+
+    // waitForPlugins() may have been faster than the watcher.
+    if(d->ready)
+    {
+        return;
+    }
+
+    d->plugins = d->discovery.result();
+    d->initPluginMap();
+    d->ready = true;
+
+    INF(QString("Discovered %1 carbon plugin(s).").arg(d->plugins.count()));
+
+    emit pluginsLoaded();
+}
+
+/**
+ * @brief Returns the carbon data of several \p regions of \p country.
+ *
+ * This is meant for overviews like a region picker. Plugins that support it
+ * answer with a single request. The results don't go through the fetch
+ * policy and aren't kept as last known good data, they may be for another
+ * period than now.
+ */
+QHash<QString, CarbonData> CarbonPluginManager::carbonPerKiloWatt(const QLocale::Country country,
+                                                                  const QStringList &regions,
+                                                                  const QDateTime &from,
+                                                                  const QDateTime &to)
+{
+    Q_ASSERT(d != nullptr);
+
+    CarbonPlugin *plugin = hasPlugins() ? d->acquirePlugin(country) : nullptr;
+    if(plugin == nullptr)
+    {
+        QHash<QString, CarbonData> result;
+        const CarbonData error = CarbonData::error(QString("No carbon plugin available for %1.").arg(QLocale::territoryToString(country)));
+
+        for(const QString &region : regions)
+        {
+            result.insert(region, error);
+        }
+
+        return result;
+    }
+
+    return plugin->carbonPerKiloWatt(country, regions, from, to);
+}
+
+/**
+ * @brief Returns the forecast of \p region in \p country from \p from to
+ * \p to.
+ *
+ * Unlike the batch request the forecast is a request for the source the
+ * CarbonService polls as well, so it goes through the same fetch policy and
+ * is skipped while the source is backing off. It isn't kept as last known
+ * good data.
+ */
+CarbonData CarbonPluginManager::forecast(const QLocale::Country country, const QString &region,
+                                         const QDateTime &from, const QDateTime &to)
+{
+    TRACE_FUNCTION;
+    Q_ASSERT(d != nullptr);
+
+    CarbonPlugin *plugin = hasPlugins() ? d->acquirePlugin(country) : nullptr;
+    if(plugin == nullptr)
+    {
+        return CarbonData::error(QString("No carbon plugin available for %1.").arg(QLocale::territoryToString(country)));
+    }
+
+    const QString key = CarbonPluginManagerPrivate::sourceKey(country, region);
+    FetchPolicy &policy = d->fetchPolicies[key];
+
+    if(!policy.allowRequest(Utils::Clock::instance()->now()))
+    {
+        DBG(QString("Skipping forecast for %1 until %2.").arg(key, policy.nextAttempt().toString()));
+        return CarbonData::error(QString("Carbon data source is backing off until %1.").arg(policy.nextAttempt().toString()));
+    }
+
+    CarbonData data;
+    {
+        TRACE_SPAN("CarbonPlugin::carbonPerKiloWatt");
+        data = plugin->carbonPerKiloWatt(country, QStringList {region}, from, to).value(region);
+    }
+
+    policy.record(data, Utils::Clock::instance()->now());
+
+    if(!data.isValid && !data.isPending)
+    {
+        WRN(QString("Forecast for %1 failed %2 time(s), next attempt at %3: %4")
+            .arg(key).arg(policy.failureCount()).arg(policy.nextAttempt().toString(), data.errorString));
+    }
+
+    return data;
 }
 
 CarbonPluginManager::CarbonPluginManager():
     d{new CarbonPluginManagerPrivate}
 {
-    d->plugins = CarbonPlugin::getPlugins();
-    d->initPluginMap();
+    // Reading the plugin metadata can take a while on a cold start, so the
+    // tray doesn't wait for it.
+    connect(&d->discovery, &QFutureWatcher<QList<CarbonPlugin*>>::finished, this, &CarbonPluginManager::onPluginsDiscovered);
+    d->discovery.setFuture(QtConcurrent::run(&CarbonPlugin::getPlugins));
 }
 
 CarbonPluginManager::~CarbonPluginManager()
@@ -2,7 +2,8 @@
  * @brief Defines the CarbonPluginManager class.
  *
  * The CarbonPluginManager class allows us to get information on all available
- * plugins.
+ * plugins. The plugins are discovered in the background, pluginsLoaded() is
+ * emitted once they are available.
  *
  * @author Dariusz Scharsig
  *
@@ -12,17 +13,24 @@
 #ifndef CARBONPLUGINMANAGER_H
 #define CARBONPLUGINMANAGER_H
 
+#include <QObject>
+
 #include <interfaces/IDataProvider.h>
 
 class CarbonPlugin;
 class CarbonPluginManagerPrivate;
 
-class CarbonPluginManager : public IDataProvider
+class CarbonPluginManager : public QObject, public IDataProvider
 {
+    Q_OBJECT
+
 public:
     static CarbonPluginManager *Instance();
     static void Destroy();
 
+    bool isReady() const;
+    void waitForPlugins();
+
     bool hasPlugins() const;
     QList<QLocale::Country> territories() const;
     QStringList territoryNames() const;
@@ -34,6 +42,16 @@ public:
     CarbonPlugin * currentPlugin() const;
 
     virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override;
+    virtual QHash<QString, CarbonData> carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                         const QDateTime &from, const QDateTime &to) override;
+
+    CarbonData forecast(const QLocale::Country country, const QString &region, const QDateTime &from, const QDateTime &to);
+
+signals:
+    void pluginsLoaded();
+
+private slots:
+    void onPluginsDiscovered();
 
 private:
     CarbonPluginManager();
@@ -0,0 +1,240 @@
+/**
+ * @brief Implements the FetchPolicy class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "fetchpolicy.h"
+
+/**
+ * @class FetchPolicy
+ *
+ * @brief Backoff and circuit breaker for one carbon data source.
+ *
+ * After every failure the next request is delayed by an exponentially growing
+ * amount (BaseDelayInSeconds, doubled per failure, capped at
+ * MaxDelayInSeconds). The delay is jittered between half and the full value,
+ * so many clients don't retry in lockstep once the API comes back.
+ *
+ * After FailureThreshold consecutive failures the breaker opens and refuses
+ * all requests until the delay is over. Then it lets a single probe through
+ * (half open); a success closes the breaker, a failure opens it again with a
+ * longer delay.
+ *
+ * The policy doesn't read the clock itself, the caller passes \c now in. This
+ * keeps it deterministic for tests.
+ */
+
+/**
+ * @brief Creates a closed policy.
+ *
+ * @param seed The seed of the jitter. Default: a random seed.
+ */
+FetchPolicy::FetchPolicy(quint32 seed /* = QRandomGenerator::global()->generate() */):
+    _state {State::Closed},
+    _failureCount {0},
+    _random {seed}
+{}
+
+/**
+ * @brief Checks if a request may be sent \p now.
+ *
+ * \remark If the breaker is open and the delay is over, this switches to
+ * State::HalfOpen and allows exactly one request.
+ *
+ * @param now The current time.
+ * @return \arg \c true  The request may be sent.
+ *         \arg \c false Don't send the request, use the fallback.
+ */
+bool FetchPolicy::allowRequest(const QDateTime &now)
+{
+    switch(_state)
+    {
+    case State::Closed:
+        return !_nextAttempt.isValid() || now >= _nextAttempt;
+    case State::Open:
+        if(now < _nextAttempt)
+        {
+            return false;
+        }
+
+        _state = State::HalfOpen;
+        return true;
+    case State::HalfOpen:
+        // The probe is still running.
+        return false;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Records a successful request and closes the breaker.
+ */
+void FetchPolicy::recordSuccess()
+{
+    _state = State::Closed;
+    _failureCount = 0;
+    _nextAttempt = QDateTime();
+}
+
+/**
+ * @brief Records a failed request at \p now and schedules the next attempt.
+ *
+ * @param now The time the request failed.
+ */
+void FetchPolicy::recordFailure(const QDateTime &now)
+{
+    ++_failureCount;
+
+    if(_state == State::HalfOpen || _failureCount >= FailureThreshold)
+    {
+        _state = State::Open;
+    }
+
+    _nextAttempt = now.addSecs(backoffDelay());
+}
+
+/**
+ * @brief Records a request whose reply is still outstanding.
+ *
+ * Neither a success nor a failure. A probe of the half open breaker is let
+ * through again, so the next request can pick up the reply.
+ */
+void FetchPolicy::recordPending()
+{
+    if(_state == State::HalfOpen)
+    {
+        _state = State::Open;
+    }
+}
+
+/**
+ * @brief Records the \p result of a request at \p now.
+ *
+ * Valid data is a success, pending data (see CarbonData::pending()) is
+ * neither, anything else is a failure.
+ */
+void FetchPolicy::record(const CarbonData &result, const QDateTime &now)
+{
+    if(result.isValid)
+    {
+        recordSuccess();
+    }
+    else if(result.isPending)
+    {
+        recordPending();
+    }
+    else
+    {
+        recordFailure(now);
+    }
+}
+
+/**
+ * @brief Returns the breaker state.
+ *
+ * @return The state.
+ */
+FetchPolicy::State FetchPolicy::state() const
+{
+    return _state;
+}
+
+/**
+ * @brief Returns the number of consecutive failures.
+ *
+ * @return The failure count.
+ */
+int FetchPolicy::failureCount() const
+{
+    return _failureCount;
+}
+
+/**
+ * @brief Returns the earliest time of the next request.
+ *
+ * @return The time, or an invalid QDateTime if there is no delay.
+ */
+QDateTime FetchPolicy::nextAttempt() const
+{
+    return _nextAttempt;
+}
+
+/**
+ * @brief Derives the current carbon data from an older forecast.
+ *
+ * The API reports the intensity of the current half hour and forecasts for the
+ * next two. If \p data has expired, this moves the forecast forward by the
+ * number of slots that passed, so "next" becomes "now" and so on.
+ *
+ * The result is valid until the end of its slot, but no longer than
+ * \p validUntil, so the caller asks again once a request is allowed.
+ *
+ * @param data The last valid carbon data.
+ * @param now The current time.
+ * @param validUntil The time the result should expire at the latest.
+ * @return The carbon data for \p now, or an error if the forecast doesn't
+ *         reach that far.
+ */
+/* static */
+CarbonData FetchPolicy::lastKnownForecast(const CarbonData &data, const QDateTime &now, const QDateTime &validUntil)
+{
+    if(!data.isValid)
+    {
+        return CarbonData::error(QStringLiteral("No carbon data known yet."));
+    }
+
+    qint64 slotLength = data.validFrom.secsTo(data.validTo);
+    if(slotLength <= 0)
+    {
+        slotLength = 30 * 60;
+    }
+
+    const qint64 passed = data.validFrom.secsTo(now);
+    const qint64 slots = passed > 0 ? passed / slotLength : 0;
+
+    const int forecast[] = {data.co2PerkWhNow, data.co2PerkWhNext, data.co2PerkWhLater};
+    constexpr qint64 forecastCount = sizeof(forecast) / sizeof(forecast[0]);
+
+    if(slots >= forecastCount || forecast[slots] < 0)
+    {
+        return CarbonData::error(QStringLiteral("The last known forecast has run out."));
+    }
+
+    const auto at = [&](qint64 offset) { return slots + offset < forecastCount ? forecast[slots + offset] : -1; };
+
+    const QDateTime from = data.validFrom.addSecs(slots * slotLength);
+    QDateTime to = from.addSecs(slotLength);
+
+    if(validUntil.isValid() && validUntil < to)
+    {
+        to = qMax(validUntil, now);
+    }
+
+    CarbonData shifted = CarbonData::ok(at(0), at(1), at(2), from, to);
+
+    // Past the end of the forecast we repeat the last value, which makes the
+    // charge forecast neutral instead of guessing.
+    if(shifted.co2PerkWhNext < 0)
+    {
+        shifted.co2PerkWhNext = shifted.co2PerkWhNow;
+    }
+
+    if(shifted.co2PerkWhLater < 0)
+    {
+        shifted.co2PerkWhLater = shifted.co2PerkWhNext;
+    }
+
+    return shifted;
+}
+
+qint64 FetchPolicy::backoffDelay()
+{
+    const int exponent = qMin(_failureCount - 1, 16);
+    const qint64 delay = qMin<qint64>(static_cast<qint64>(BaseDelayInSeconds) << exponent, MaxDelayInSeconds);
+
+    // Jitter between half and the full delay.
+    return delay / 2 + _random.bounded(static_cast<int>(delay / 2) + 1);
+}
@@ -0,0 +1,61 @@
+/**
+ * @brief Defines the FetchPolicy class.
+ *
+ * The FetchPolicy decides when carbon data may be fetched from a plugin again
+ * after a failure. It combines a jittered exponential backoff with a circuit
+ * breaker, so an API outage doesn't cost a blocking request every minute.
+ *
+ * @sa CarbonPluginManager
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FETCHPOLICY_H
+#define FETCHPOLICY_H
+
+#include <QDateTime>
+#include <QRandomGenerator>
+
+#include <carbondata.h>
+
+class FetchPolicy
+{
+public:
+    enum class State
+    {
+        Closed,     //!< Requests are allowed, maybe after a backoff delay.
+        Open,       //!< Requests are refused until the delay is over.
+        HalfOpen    //!< A single probe request is allowed.
+    };
+
+    explicit FetchPolicy(quint32 seed = QRandomGenerator::global()->generate());
+    ~FetchPolicy() = default;
+
+    bool allowRequest(const QDateTime &now);
+    void recordSuccess();
+    void recordFailure(const QDateTime &now);
+    void recordPending();
+    void record(const CarbonData &result, const QDateTime &now);
+
+    State state() const;
+    int failureCount() const;
+    QDateTime nextAttempt() const;
+
+    static CarbonData lastKnownForecast(const CarbonData &data, const QDateTime &now, const QDateTime &validUntil);
+
+    static constexpr int BaseDelayInSeconds {30};
+    static constexpr int MaxDelayInSeconds {30 * 60};
+    static constexpr int FailureThreshold {3};
+
+private:
+    qint64 backoffDelay();
+
+private:
+    State _state;
+    int _failureCount;
+    QDateTime _nextAttempt;
+    QRandomGenerator _random;
+};
+
+#endif // FETCHPOLICY_H
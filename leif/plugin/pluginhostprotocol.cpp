@@ -0,0 +1,189 @@
+/**
+ * @brief Implements the plugin host protocol.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QDataStream>
+#include <QIODevice>
+
+#include "pluginhostprotocol.h"
+
+namespace
+{
+constexpr QDataStream::Version StreamVersion {QDataStream::Qt_6_0};
+
+void writeCarbonData(QDataStream &stream, const CarbonData &data)
+{
+    stream << qint32(data.co2PerkWhNow) << qint32(data.co2PerkWhNext) << qint32(data.co2PerkWhLater)
+           << data.isValid << data.errorString << data.validFrom << data.validTo
+           << data.forecast << qint32(data.forecastIntervalInSeconds);
+}
+
+void readCarbonData(QDataStream &stream, CarbonData &data)
+{
+    qint32 now {-1};
+    qint32 next {-1};
+    qint32 later {-1};
+    qint32 interval {0};
+
+    stream >> now >> next >> later >> data.isValid >> data.errorString >> data.validFrom >> data.validTo
+           >> data.forecast >> interval;
+
+    data.co2PerkWhNow = now;
+    data.co2PerkWhNext = next;
+    data.co2PerkWhLater = later;
+    data.forecastIntervalInSeconds = interval;
+}
+}
+
+namespace PluginHost
+{
+/**
+ * @brief Writes a length prefixed \p frame to \p device.
+ */
+void writeFrame(QIODevice *device, const QByteArray &frame)
+{
+    QDataStream stream(device);
+    stream.setVersion(StreamVersion);
+    stream << frame;
+}
+
+/**
+ * @brief Reads the next frame from \p device, if it arrived completely.
+ *
+ * @return \arg \c true  A \p frame was read.
+ *         \arg \c false Not enough data yet, nothing was consumed.
+ */
+bool readFrame(QIODevice *device, QByteArray &frame)
+{
+    QDataStream stream(device);
+    stream.setVersion(StreamVersion);
+
+    stream.startTransaction();
+    stream >> frame;
+
+    return stream.commitTransaction();
+}
+
+QByteArray encodeRequest(const Request &request)
+{
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+
+    stream << quint8(request.type) << request.id << qint32(request.country);
+
+    if(request.type == RequestType::Carbon)
+        stream << request.region;
+    else
+        stream << request.regions << request.from << request.to;
+
+    return frame;
+}
+
+bool decodeRequest(const QByteArray &frame, Request &request)
+{
+    QDataStream stream(frame);
+    stream.setVersion(StreamVersion);
+
+    quint8 type {0};
+    qint32 country {0};
+
+    stream >> type >> request.id >> country;
+
+    request.type = static_cast<RequestType>(type);
+    request.country = static_cast<QLocale::Country>(country);
+
+    if(request.type == RequestType::Carbon)
+        stream >> request.region;
+    else if(request.type == RequestType::CarbonBatch)
+        stream >> request.regions >> request.from >> request.to;
+    else
+        return false;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+QByteArray encodeReply(const Reply &reply)
+{
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+
+    stream << reply.id << reply.errorString << reply.result;
+
+    return frame;
+}
+
+bool decodeReply(const QByteArray &frame, Reply &reply)
+{
+    QDataStream stream(frame);
+    stream.setVersion(StreamVersion);
+
+    stream >> reply.id >> reply.errorString >> reply.result;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+QByteArray encodeResult(const CarbonData &data)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+
+    writeCarbonData(stream, data);
+
+    return payload;
+}
+
+QByteArray encodeResult(const QHash<QString, CarbonData> &data)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(StreamVersion);
+
+    stream << quint32(data.count());
+    for(auto it = data.cbegin(); it != data.cend(); ++it)
+    {
+        stream << it.key();
+        writeCarbonData(stream, it.value());
+    }
+
+    return payload;
+}
+
+bool decodeResult(const QByteArray &payload, CarbonData &data)
+{
+    QDataStream stream(payload);
+    stream.setVersion(StreamVersion);
+
+    readCarbonData(stream, data);
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool decodeResult(const QByteArray &payload, QHash<QString, CarbonData> &data)
+{
+    QDataStream stream(payload);
+    stream.setVersion(StreamVersion);
+
+    quint32 count {0};
+    stream >> count;
+
+    data.clear();
+    for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString region;
+        CarbonData regionData;
+
+        stream >> region;
+        readCarbonData(stream, regionData);
+
+        data.insert(region, regionData);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+}
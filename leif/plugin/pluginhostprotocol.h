@@ -0,0 +1,68 @@
+/**
+ * @brief Defines the messages between the application and the plugin host.
+ *
+ * Requests and replies are small QDataStream frames sent over a local socket.
+ * A reply carries the encoded result of its request.
+ *
+ * @sa RemoteCarbonPlugin
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef PLUGINHOSTPROTOCOL_H
+#define PLUGINHOSTPROTOCOL_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QLocale>
+#include <QStringList>
+
+#include <carbondata.h>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+namespace PluginHost
+{
+enum class RequestType : quint8
+{
+    Carbon = 1,     //!< A single region, see IDataProvider::carbonPerKiloWatt().
+    CarbonBatch = 2 //!< Several regions and a time range.
+};
+
+struct Request
+{
+    RequestType type {RequestType::Carbon};
+    quint32 id {0};
+    QLocale::Country country {QLocale::AnyCountry};
+    QString region;
+    QStringList regions;
+    QDateTime from;
+    QDateTime to;
+};
+
+struct Reply
+{
+    quint32 id {0};
+    QString errorString;    //!< Empty unless the request failed.
+    QByteArray result;      //!< See encodeResult().
+};
+
+void writeFrame(QIODevice *device, const QByteArray &frame);
+bool readFrame(QIODevice *device, QByteArray &frame);
+
+QByteArray encodeRequest(const Request &request);
+bool decodeRequest(const QByteArray &frame, Request &request);
+
+QByteArray encodeReply(const Reply &reply);
+bool decodeReply(const QByteArray &frame, Reply &reply);
+
+QByteArray encodeResult(const CarbonData &data);
+QByteArray encodeResult(const QHash<QString, CarbonData> &data);
+bool decodeResult(const QByteArray &payload, CarbonData &data);
+bool decodeResult(const QByteArray &payload, QHash<QString, CarbonData> &data);
+}
+
+#endif // PLUGINHOSTPROTOCOL_H
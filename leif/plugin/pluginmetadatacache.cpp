@@ -0,0 +1,248 @@
+/**
+ * @brief Implements the PluginMetadataCache class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+
+#include "utils/localeid.h"
+
+#include "pluginmetadatacache.h"
+
+namespace
+{
+constexpr quint32 Magic {0x4C464D43}; // "LFMC"
+constexpr quint16 FormatVersion {1};
+constexpr QDataStream::Version StreamVersion {QDataStream::Qt_6_0};
+}
+
+/**
+ * @class PluginMetadataCache
+ *
+ * @brief A binary cache for the parsed plugin metadata.
+ *
+ * Every entry is keyed by the plugin's file path and remembers the file size
+ * and modification time it was created from. As long as both are unchanged
+ * lookup() returns the stored Utils::CarbonPluginData and the plugin doesn't
+ * need to be opened at all.
+ *
+ * The region names in the metadata are already translated, so the whole
+ * cache is dropped if the system locale changed since it was written.
+ */
+
+/**
+ * @brief Creates an empty cache that is stored in \p fileName.
+ *
+ * @param fileName The cache file. Default: defaultFileName().
+ */
+PluginMetadataCache::PluginMetadataCache(const QString &fileName /* = defaultFileName() */):
+    _fileName {fileName},
+    _dirty {false}
+{}
+
+/**
+ * @brief Loads the cache file.
+ *
+ * A missing, corrupt or outdated file (other format version or locale) leaves
+ * the cache empty.
+ *
+ * @return \arg \c true  The cache was loaded.
+ *         \arg \c false The cache is empty.
+ */
+bool PluginMetadataCache::load()
+{
+    _entries.clear();
+    _dirty = false;
+
+    QFile file(_fileName);
+    if(_fileName.isEmpty() || !file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(StreamVersion);
+
+    quint32 magic {0};
+    quint16 version {0};
+    quint64 localeId {0};
+
+    stream >> magic >> version >> localeId;
+
+    if(magic != Magic || version != FormatVersion || localeId != currentLocaleId())
+        return false;
+
+    quint32 count {0};
+    stream >> count;
+
+    QHash<QString, Entry> entries;
+    entries.reserve(static_cast<int>(qMin<quint32>(count, 1024)));
+
+    for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString path;
+        Entry entry;
+
+        stream >> path >> entry.size >> entry.lastModified >> entry.data;
+        entries.insert(path, entry);
+    }
+
+    if(stream.status() != QDataStream::Ok)
+        return false;
+
+    _entries = entries;
+
+    return true;
+}
+
+/**
+ * @brief Writes the cache file, if anything changed since load().
+ *
+ * @return \arg \c true  The cache file is up to date.
+ *         \arg \c false The cache file could not be written.
+ */
+bool PluginMetadataCache::save()
+{
+    if(!_dirty)
+        return true;
+
+    if(_fileName.isEmpty())
+        return false;
+
+    QDir().mkpath(QFileInfo(_fileName).absolutePath());
+
+    QSaveFile file(_fileName);
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(StreamVersion);
+
+    stream << Magic << FormatVersion << currentLocaleId() << static_cast<quint32>(_entries.count());
+
+    for(auto it = _entries.cbegin(); it != _entries.cend(); ++it)
+        stream << it.key() << it.value().size << it.value().lastModified << it.value().data;
+
+    if(stream.status() != QDataStream::Ok || !file.commit())
+        return false;
+
+    _dirty = false;
+
+    return true;
+}
+
+/**
+ * @brief Returns \c true if the cache has no entries.
+ *
+ * @return \arg \c true  The cache is empty.
+ *         \arg \c false The cache has entries.
+ */
+bool PluginMetadataCache::isEmpty() const
+{
+    return _entries.isEmpty();
+}
+
+/**
+ * @brief Returns \c true if the cache changed since it was loaded or saved.
+ *
+ * @return \arg \c true  The cache needs to be saved.
+ *         \arg \c false The cache file is up to date.
+ */
+bool PluginMetadataCache::isDirty() const
+{
+    return _dirty;
+}
+
+/**
+ * @brief Looks up the metadata of \p plugin.
+ *
+ * @param plugin The plugin file.
+ * @param data Receives the metadata on a hit.
+ * @return \arg \c true  The plugin is unchanged and \p data was set.
+ *         \arg \c false The plugin is unknown or was changed.
+ */
+bool PluginMetadataCache::lookup(const QFileInfo &plugin, Utils::CarbonPluginData &data) const
+{
+    const auto it = _entries.constFind(plugin.absoluteFilePath());
+    if(it == _entries.constEnd())
+        return false;
+
+    if(it.value().size != plugin.size() ||
+       it.value().lastModified != plugin.lastModified().toMSecsSinceEpoch())
+        return false;
+
+    data = it.value().data;
+
+    return true;
+}
+
+/**
+ * @brief Stores the metadata \p data of \p plugin.
+ *
+ * @param plugin The plugin file.
+ * @param data The parsed metadata.
+ */
+void PluginMetadataCache::insert(const QFileInfo &plugin, const Utils::CarbonPluginData &data)
+{
+    Entry entry;
+    entry.size = plugin.size();
+    entry.lastModified = plugin.lastModified().toMSecsSinceEpoch();
+    entry.data = data;
+
+    _entries.insert(plugin.absoluteFilePath(), entry);
+    _dirty = true;
+}
+
+/**
+ * @brief Removes all entries except the ones for \p pluginPaths.
+ *
+ * Call this after a plugin scan to forget plugins that were removed.
+ *
+ * @param pluginPaths The paths of the plugins that still exist.
+ */
+void PluginMetadataCache::retain(const QStringList &pluginPaths)
+{
+    QSet<QString> keep;
+    for(const QString &path : pluginPaths)
+        keep.insert(QFileInfo(path).absoluteFilePath());
+
+    for(auto it = _entries.begin(); it != _entries.end();)
+    {
+        if(keep.contains(it.key()))
+        {
+            ++it;
+            continue;
+        }
+
+        it = _entries.erase(it);
+        _dirty = true;
+    }
+}
+
+/**
+ * @brief Returns the default cache file in the application's cache location.
+ *
+ * @return The file path, or an empty string if there is no cache location.
+ */
+/* static */
+QString PluginMetadataCache::defaultFileName()
+{
+    const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if(cacheLocation.isEmpty())
+        return QString();
+
+    return cacheLocation + QStringLiteral("/plugins.cache");
+}
+
+/* static */
+quint64 PluginMetadataCache::currentLocaleId()
+{
+    return Utils::LocaleId {QLocale()}.value();
+}
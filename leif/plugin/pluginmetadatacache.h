@@ -0,0 +1,60 @@
+/**
+ * @brief Defines the PluginMetadataCache class.
+ *
+ * The PluginMetadataCache keeps the parsed metadata of all carbon plugins in a
+ * small binary file, so we don't need to read and parse the plugin JSON on
+ * every start.
+ *
+ * @sa CarbonPlugin
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef PLUGINMETADATACACHE_H
+#define PLUGINMETADATACACHE_H
+
+#include <QHash>
+#include <QString>
+
+#include "utils/carbonplugindata.h"
+
+QT_BEGIN_NAMESPACE
+class QFileInfo;
+QT_END_NAMESPACE
+
+class PluginMetadataCache
+{
+public:
+    explicit PluginMetadataCache(const QString &fileName = defaultFileName());
+    ~PluginMetadataCache() = default;
+
+    bool load();
+    bool save();
+
+    bool isEmpty() const;
+    bool isDirty() const;
+
+    bool lookup(const QFileInfo &plugin, Utils::CarbonPluginData &data) const;
+    void insert(const QFileInfo &plugin, const Utils::CarbonPluginData &data);
+    void retain(const QStringList &pluginPaths);
+
+    static QString defaultFileName();
+
+private:
+    struct Entry
+    {
+        qint64 size {-1};
+        qint64 lastModified {0};
+        Utils::CarbonPluginData data;
+    };
+
+    static quint64 currentLocaleId();
+
+private:
+    QString _fileName;
+    QHash<QString, Entry> _entries;
+    bool _dirty;
+};
+
+#endif // PLUGINMETADATACACHE_H
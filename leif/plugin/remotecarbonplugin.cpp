@@ -0,0 +1,505 @@
+/**
+ * @brief Implements the RemoteCarbonPlugin class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QAtomicInteger>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QProcess>
+#include <QTimer>
+
+#include <utility>
+
+#include "log/log.h"
+#include "utils/clock.h"
+
+#include "pluginhostprotocol.h"
+#include "remotecarbonplugin.h"
+
+class RemoteCarbonPluginPrivate
+{
+public:
+    ~RemoteCarbonPluginPrivate() = default;
+
+private:
+    struct Result
+    {
+        QByteArray payload;
+        QString errorString;
+    };
+
+    RemoteCarbonPluginPrivate(const QString &fileName);
+
+    void send(PluginHost::Request &request, const QString &key);
+    bool lastResult(const QString &key, Result &result) const;
+
+    static QString uniqueName();
+    static QString batchKey(const QLocale::Country country, const QStringList &regions,
+                            const QDateTime &from, const QDateTime &to);
+
+    // DATA
+    QString fileName;
+    QObject context;            // Receives the signals of the host.
+    QLocalServer server;
+    QPointer<QProcess> process;
+    QPointer<QLocalSocket> socket;
+    QTimer timeout;
+    quint32 lastRequestId;
+    QHash<quint32, QString> pending;    // Request id -> result key.
+    QHash<QString, Result> results;     // The last reply per result key.
+    QString errorString;
+
+    // Batch queries of the region picker each get their own key.
+    static constexpr int MaxResults {32};
+
+    friend class RemoteCarbonPlugin;
+};
+
+RemoteCarbonPluginPrivate::RemoteCarbonPluginPrivate(const QString &fileName):
+    fileName {fileName},
+    lastRequestId {0}
+{
+    timeout.setSingleShot(true);
+}
+
+/**
+ * @brief Sends the \p request for the result \p key to the host.
+ *
+ * Nothing is sent if the host is not connected yet or the same result is
+ * still being requested. Writing to the socket doesn't block, the data is
+ * sent by the event loop.
+ */
+void RemoteCarbonPluginPrivate::send(PluginHost::Request &request, const QString &key)
+{
+    if(socket.isNull() || socket->state() != QLocalSocket::ConnectedState)
+    {
+        return;
+    }
+
+    for(const QString &pendingKey : std::as_const(pending))
+    {
+        if(pendingKey == key)
+        {
+            return;
+        }
+    }
+
+    request.id = ++lastRequestId;
+    pending.insert(request.id, key);
+
+    PluginHost::writeFrame(socket, PluginHost::encodeRequest(request));
+    socket->flush();
+
+    if(!timeout.isActive())
+    {
+        timeout.start(RemoteCarbonPlugin::RequestTimeoutInMilliseconds);
+    }
+}
+
+/**
+ * @brief Returns the last reply for \p key, if there is one.
+ *
+ * Without one, \p result holds the reason.
+ */
+bool RemoteCarbonPluginPrivate::lastResult(const QString &key, Result &result) const
+{
+    if(results.contains(key))
+    {
+        result = results.value(key);
+        return true;
+    }
+
+    if(!errorString.isEmpty())
+    {
+        result.errorString = errorString;
+    }
+    else if(socket.isNull())
+    {
+        result.errorString = QStringLiteral("The plugin host is starting.");
+    }
+    else
+    {
+        result.errorString = QStringLiteral("Waiting for the plugin host.");
+    }
+
+    return false;
+}
+
+/* static */
+QString RemoteCarbonPluginPrivate::uniqueName()
+{
+    static QAtomicInteger<quint32> counter {0};
+
+    return QString("leif-pluginhost-%1-%2").arg(QCoreApplication::applicationPid()).arg(++counter);
+}
+
+/* static */
+QString RemoteCarbonPluginPrivate::batchKey(const QLocale::Country country, const QStringList &regions,
+                                            const QDateTime &from, const QDateTime &to)
+{
+    return QString("%1/%2/%3/%4").arg(QLocale::territoryToCode(country), regions.join(QLatin1Char(',')),
+                                      from.toUTC().toString(Qt::ISODate), to.toUTC().toString(Qt::ISODate));
+}
+
+/**
+ * @class RemoteCarbonPlugin
+ *
+ * @brief Queries a carbon plugin that runs in the plugin host process.
+ *
+ * The host is started with start() and loads the plugin \p fileName. Every
+ * request and its result is a small message over a local socket.
+ *
+ * Nothing here blocks the caller. A query sends a request to the host and
+ * returns the last reply for the same query right away. While there is none
+ * yet, or the last one has expired, the query returns CarbonData::pending().
+ * The CarbonPluginManager then falls back to the last known forecast, without
+ * counting a failure, until the next query picks up the fresh reply.
+ *
+ * A host that doesn't connect within StartTimeoutInMilliseconds or doesn't
+ * reply within RequestTimeoutInMilliseconds is killed. The plugin then no
+ * longer counts as loaded, so the next CarbonPlugin::load() starts a new one.
+ *
+ * The host is used if the \c LEIF_PLUGIN_HOST environment variable is set.
+ */
+
+/**
+ * @brief Creates the remote plugin for the plugin library \p fileName.
+ *
+ * The host is not started yet, see start().
+ */
+RemoteCarbonPlugin::RemoteCarbonPlugin(const QString &fileName):
+    d {new RemoteCarbonPluginPrivate {fileName}}
+{
+    QObject::connect(&d->server, &QLocalServer::newConnection, &d->context, [this]() { onConnected(); });
+    QObject::connect(&d->timeout, &QTimer::timeout, &d->context, [this]() {
+        fail(d->socket.isNull() ? QStringLiteral("The plugin host didn't connect in time.")
+                                : QStringLiteral("The plugin host didn't reply in time."));
+    });
+}
+
+RemoteCarbonPlugin::~RemoteCarbonPlugin()
+{
+    stop();
+}
+
+/**
+ * @brief Starts the plugin host.
+ *
+ * This only launches the host, it connects back later. Until then queries
+ * return an error.
+ *
+ * @return \arg \c true  The host is starting or running.
+ *         \arg \c false The host could not be started, see errorString().
+ */
+bool RemoteCarbonPlugin::start()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(isRunning())
+    {
+        return true;
+    }
+
+    stop();
+    d->errorString.clear();
+
+    const QString name {RemoteCarbonPluginPrivate::uniqueName()};
+
+    QLocalServer::removeServer(name);
+    d->server.setSocketOptions(QLocalServer::UserAccessOption);
+    if(!d->server.listen(name))
+    {
+        d->errorString = d->server.errorString();
+        WRN(QString("Could not listen for the plugin host: %1").arg(d->errorString));
+        return false;
+    }
+
+    d->process = new QProcess;
+    d->process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+    QObject::connect(d->process, &QProcess::errorOccurred, &d->context, [this](QProcess::ProcessError error) {
+        if(error == QProcess::FailedToStart)
+        {
+            fail(d->process->errorString());
+        }
+    });
+    QObject::connect(d->process, &QProcess::finished, &d->context, [this](int exitCode) {
+        fail(QString("The plugin host quit with exit code %1.").arg(exitCode));
+    });
+
+    d->process->start(hostExecutable(), {QStringLiteral("--plugin"), d->fileName,
+                                         QStringLiteral("--server"), d->server.fullServerName()});
+
+    // A missing executable may fail right away.
+    if(d->process.isNull())
+    {
+        return false;
+    }
+
+    d->timeout.start(StartTimeoutInMilliseconds);
+
+    INF(QString("Starting the plugin host for '%1'.").arg(d->fileName));
+
+    return true;
+}
+
+/**
+ * @brief Stops the plugin host.
+ *
+ * The host quits once we disconnect. If it doesn't within a second, it is
+ * killed. Neither is waited for.
+ */
+void RemoteCarbonPlugin::stop()
+{
+    Q_ASSERT(d != nullptr);
+
+    d->timeout.stop();
+    d->server.close();
+    d->pending.clear();
+
+    if(!d->socket.isNull())
+    {
+        QObject::disconnect(d->socket, nullptr, &d->context, nullptr);
+        d->socket->abort();
+        d->socket->deleteLater();
+        d->socket = nullptr;
+    }
+
+    if(!d->process.isNull())
+    {
+        QProcess *process = d->process;
+        d->process = nullptr;
+
+        QObject::disconnect(process, nullptr, &d->context, nullptr);
+
+        if(process->state() == QProcess::NotRunning)
+        {
+            process->deleteLater();
+        }
+        else
+        {
+            QObject::connect(process, &QProcess::finished, process, &QObject::deleteLater);
+            QTimer::singleShot(1000, process, &QProcess::kill);
+        }
+    }
+}
+
+/**
+ * @brief Returns whether the host is starting or running.
+ */
+bool RemoteCarbonPlugin::isRunning() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return !d->process.isNull();
+}
+
+/**
+ * @brief Returns whether the host has connected and takes requests.
+ */
+bool RemoteCarbonPlugin::isConnected() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return !d->socket.isNull() && d->socket->state() == QLocalSocket::ConnectedState;
+}
+
+QString RemoteCarbonPlugin::errorString() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->errorString;
+}
+
+CarbonData RemoteCarbonPlugin::carbonPerKiloWatt(const QLocale::Country country, const QString &region)
+{
+    Q_ASSERT(d != nullptr);
+
+    const QString key = QString("%1/%2").arg(QLocale::territoryToCode(country), region);
+
+    PluginHost::Request request;
+    request.type = PluginHost::RequestType::Carbon;
+    request.country = country;
+    request.region = region;
+    d->send(request, key);
+
+    RemoteCarbonPluginPrivate::Result result;
+    if(!d->lastResult(key, result))
+    {
+        return d->errorString.isEmpty() ? CarbonData::pending(result.errorString) : CarbonData::error(result.errorString);
+    }
+
+    if(!result.errorString.isEmpty())
+    {
+        return CarbonData::error(result.errorString);
+    }
+
+    CarbonData data;
+    if(!PluginHost::decodeResult(result.payload, data))
+    {
+        return CarbonData::error(QStringLiteral("The plugin host sent a corrupt result."));
+    }
+
+    // The fresh reply is on its way.
+    if(data.isValid && data.validTo <= Utils::Clock::instance()->now())
+    {
+        return CarbonData::pending(QStringLiteral("Waiting for the plugin host to refresh the carbon data."));
+    }
+
+    return data;
+}
+
+QHash<QString, CarbonData> RemoteCarbonPlugin::carbonPerKiloWatt(const QLocale::Country country,
+                                                                 const QStringList &regions,
+                                                                 const QDateTime &from,
+                                                                 const QDateTime &to)
+{
+    Q_ASSERT(d != nullptr);
+
+    const QString key = RemoteCarbonPluginPrivate::batchKey(country, regions, from, to);
+
+    PluginHost::Request request;
+    request.type = PluginHost::RequestType::CarbonBatch;
+    request.country = country;
+    request.regions = regions;
+    request.from = from;
+    request.to = to;
+    d->send(request, key);
+
+    RemoteCarbonPluginPrivate::Result result;
+    QHash<QString, CarbonData> data;
+    const bool replied = d->lastResult(key, result);
+
+    if(replied && result.errorString.isEmpty())
+    {
+        if(PluginHost::decodeResult(result.payload, data))
+        {
+            return data;
+        }
+
+        result.errorString = QStringLiteral("The plugin host sent a corrupt result.");
+        data.clear();
+    }
+
+    const CarbonData error = !replied && d->errorString.isEmpty() ? CarbonData::pending(result.errorString)
+                                                                  : CarbonData::error(result.errorString);
+
+    for(const QString &region : regions)
+    {
+        data.insert(region, error);
+    }
+
+    return data;
+}
+
+/**
+ * @brief Returns whether plugins should run in the plugin host.
+ *
+ * This is the case if \c LEIF_PLUGIN_HOST is set to anything but \c 0.
+ */
+/* static */
+bool RemoteCarbonPlugin::isEnabled()
+{
+    const QString value = qEnvironmentVariable("LEIF_PLUGIN_HOST");
+
+    return !value.isEmpty() && value != QStringLiteral("0");
+}
+
+/**
+ * @brief Returns the path of the plugin host executable.
+ *
+ * If \c LEIF_PLUGIN_HOST names an executable, that one is used. Otherwise we
+ * expect \c leif-pluginhost next to the application.
+ */
+/* static */
+QString RemoteCarbonPlugin::hostExecutable()
+{
+    const QFileInfo configured {qEnvironmentVariable("LEIF_PLUGIN_HOST")};
+    if(configured.isFile() && configured.isExecutable())
+    {
+        return configured.absoluteFilePath();
+    }
+
+#ifdef Q_OS_WIN
+    return QCoreApplication::applicationDirPath() + QStringLiteral("/leif-pluginhost.exe");
+#else
+    return QCoreApplication::applicationDirPath() + QStringLiteral("/leif-pluginhost");
+#endif
+}
+
+/**
+ * @brief Stops the host because of \p errorString.
+ */
+void RemoteCarbonPlugin::fail(const QString &errorString)
+{
+    Q_ASSERT(d != nullptr);
+
+    WRN(QString("Stopping the plugin host for '%1': %2").arg(d->fileName, errorString));
+
+    stop();
+    d->errorString = errorString;
+}
+
+void RemoteCarbonPlugin::onConnected()
+{
+    Q_ASSERT(d != nullptr);
+
+    QLocalSocket *socket = d->server.nextPendingConnection();
+    if(socket == nullptr || !d->socket.isNull())
+    {
+        return;
+    }
+
+    // One host serves exactly one connection.
+    socket->setParent(nullptr);
+    d->server.close();
+    d->timeout.stop();
+    d->socket = socket;
+
+    QObject::connect(socket, &QLocalSocket::readyRead, &d->context, [this]() { onReadyRead(); });
+    QObject::connect(socket, &QLocalSocket::disconnected, &d->context, [this]() {
+        fail(QStringLiteral("The plugin host quit unexpectedly."));
+    });
+
+    INF(QString("The plugin host for '%1' connected (pid %2).").arg(d->fileName)
+        .arg(d->process.isNull() ? 0 : d->process->processId()));
+}
+
+/**
+ * @brief Stores the replies that arrived.
+ */
+void RemoteCarbonPlugin::onReadyRead()
+{
+    Q_ASSERT(d != nullptr);
+
+    QByteArray frame;
+
+    while(!d->socket.isNull() && PluginHost::readFrame(d->socket, frame))
+    {
+        PluginHost::Reply reply;
+        if(!PluginHost::decodeReply(frame, reply) || !d->pending.contains(reply.id))
+        {
+            continue;
+        }
+
+        const QString key = d->pending.take(reply.id);
+        if(d->results.count() >= RemoteCarbonPluginPrivate::MaxResults && !d->results.contains(key))
+        {
+            d->results.clear();
+        }
+
+        d->results.insert(key, RemoteCarbonPluginPrivate::Result {reply.result, reply.errorString});
+    }
+
+    // Every reply gives the next one the full time.
+    if(d->pending.isEmpty())
+        d->timeout.stop();
+    else
+        d->timeout.start(RequestTimeoutInMilliseconds);
+}
@@ -0,0 +1,55 @@
+/**
+ * @brief Defines the RemoteCarbonPlugin class.
+ *
+ * The RemoteCarbonPlugin runs a carbon plugin in a separate plugin host
+ * process. A plugin that blocks, leaks or crashes can't take the tray
+ * application with it.
+ *
+ * @sa CarbonPlugin
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef REMOTECARBONPLUGIN_H
+#define REMOTECARBONPLUGIN_H
+
+#include <QScopedPointer>
+
+#include <interfaces/IDataProvider.h>
+
+class RemoteCarbonPluginPrivate;
+
+class RemoteCarbonPlugin : public IDataProvider
+{
+public:
+    explicit RemoteCarbonPlugin(const QString &fileName);
+    virtual ~RemoteCarbonPlugin();
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+    bool isConnected() const;
+    QString errorString() const;
+
+    virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override;
+    virtual QHash<QString, CarbonData> carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                         const QDateTime &from, const QDateTime &to) override;
+
+    static bool isEnabled();
+    static QString hostExecutable();
+
+    static constexpr int StartTimeoutInMilliseconds {5000};
+    static constexpr int RequestTimeoutInMilliseconds {10000};
+
+private:
+    void fail(const QString &errorString);
+    void onConnected();
+    void onReadyRead();
+
+private:
+    Q_DISABLE_COPY_MOVE(RemoteCarbonPlugin)
+    QScopedPointer<RemoteCarbonPluginPrivate> d;
+};
+
+#endif // REMOTECARBONPLUGIN_H
@@ -0,0 +1,82 @@
+/**
+ * @brief Implements the SharedDataProvider class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "shareddataprovider.h"
+
+#include "utils/clock.h"
+#include "utils/hostcache.h"
+
+#include "log/log.h"
+
+/**
+ * @class SharedDataProvider
+ *
+ * @brief Fetches carbon data once per host instead of once per user.
+ *
+ * Data in the cache that is still valid is returned as is. Once it runs out,
+ * the first instance to ask takes the lease of the region, fetches from the
+ * source and publishes. The others keep the old data until then, but only
+ * for as long as the lease lasts. If the leader is gone or the cache has no
+ * room for the region, every instance fetches on its own as before.
+ *
+ * Neither the source nor the cache are owned.
+ */
+
+SharedDataProvider::SharedDataProvider(IDataProvider *source, Utils::HostCache *cache):
+    _source {source},
+    _cache {cache}
+{
+    Q_ASSERT(_source != nullptr);
+    Q_ASSERT(_cache != nullptr);
+}
+
+CarbonData SharedDataProvider::carbonPerKiloWatt(const QLocale::Country country, const QString &region)
+{
+    const QDateTime now = Utils::Clock::instance()->now();
+
+    CarbonData shared;
+    const bool hasShared = _cache->readCarbon(country, region, &shared);
+
+    if(hasShared && now <= shared.validTo)
+    {
+        DBG("Using the carbon data of the host cache.");
+        return shared;
+    }
+
+    if(_cache->leadCarbon(country, region))
+    {
+        DBG("Fetching the carbon data for the host cache.");
+
+        const CarbonData data = _source->carbonPerKiloWatt(country, region);
+        if(data.isValid && !_cache->publishCarbon(country, region, data))
+        {
+            WRN("Could not publish the carbon data to the host cache.");
+        }
+
+        return data;
+    }
+
+    // Someone else is fetching, the old data does for a little longer.
+    if(hasShared && now <= shared.validTo.addMSecs(_cache->leaseInMs()))
+    {
+        DBG("Waiting for the host cache leader, using the last carbon data.");
+        return shared;
+    }
+
+    DBG("No host cache leader for the region, fetching on our own.");
+    return _source->carbonPerKiloWatt(country, region);
+}
+
+/**
+ * @brief Asks the source directly, forecasts for several regions are not
+ * shared.
+ */
+QHash<QString, CarbonData> SharedDataProvider::carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                                 const QDateTime &from, const QDateTime &to)
+{
+    return _source->carbonPerKiloWatt(country, regions, from, to);
+}
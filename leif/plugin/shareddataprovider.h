@@ -0,0 +1,39 @@
+/**
+ * @brief Defines the SharedDataProvider class.
+ *
+ * The SharedDataProvider puts a Utils::HostCache in front of another carbon
+ * data source, so the instances on one host fetch the same region only once.
+ *
+ * @sa Utils::HostCache, SharedPower
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef SHAREDDATAPROVIDER_H
+#define SHAREDDATAPROVIDER_H
+
+#include <interfaces/IDataProvider.h>
+
+namespace Utils {
+class HostCache;
+}
+
+class SharedDataProvider : public IDataProvider
+{
+public:
+    SharedDataProvider(IDataProvider *source, Utils::HostCache *cache);
+    virtual ~SharedDataProvider() = default;
+
+    virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override;
+    virtual QHash<QString, CarbonData> carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                         const QDateTime &from, const QDateTime &to) override;
+
+private:
+    Q_DISABLE_COPY_MOVE(SharedDataProvider)
+
+    IDataProvider *_source;
+    Utils::HostCache *_cache;
+};
+
+#endif // SHAREDDATAPROVIDER_H
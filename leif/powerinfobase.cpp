@@ -1,7 +1,8 @@
-#include <QTimer>
-
 #include "powerinfobase.h"
 #include "log/log.h"
+#include "log/trace.h"
+
+#include "utils/clock.h"
 
 class PowerInfoBasePrivate
 {
@@ -9,9 +10,10 @@ public:
     ~PowerInfoBasePrivate() = default;
 
 private:
-    PowerInfoBasePrivate(int _avarageDischargeRate, std::function<void (int)> _storeAvarageDischargeRateFunc);
+    PowerInfoBasePrivate(const Utils::PowerProfile &_profile, std::function<void (const Utils::PowerProfile&)> _storeProfileFunc);
 
-    void updateAvarageDischargeRate(int newAvarageDischargeRate);
+    void addSample(Utils::PowerProfile::Mode mode, int milliWatts);
+    void storeProfile(bool force);
 
     // DATA
     int checkIntervalInMinutes;
@@ -19,47 +21,62 @@ private:
     int currentCapacity;
     int currentChargeRate;
     int currentDischargeRate;
-    int avarageDischargeRate;
+    Utils::PowerProfile profile;
     PowerInfoBase::State state;
-    std::function<void(int)> storeAvarageDischargeRateFunc;
+    std::function<void(const Utils::PowerProfile&)> storeProfileFunc;
 
     friend class PowerInfoBase;
 };
 
-PowerInfoBasePrivate::PowerInfoBasePrivate(int _avarageDischargeRate, std::function<void(int)> _storeAvarageDischargeRateFunc):
+PowerInfoBasePrivate::PowerInfoBasePrivate(const Utils::PowerProfile &_profile, std::function<void(const Utils::PowerProfile&)> _storeProfileFunc):
     checkIntervalInMinutes {5},
     lastCapacity {0},
     currentCapacity {0},
     currentChargeRate {0},
     currentDischargeRate {0},
-    avarageDischargeRate {_avarageDischargeRate},
+    profile {_profile},
     state {PowerInfoBase::Unknown},
-    storeAvarageDischargeRateFunc(_storeAvarageDischargeRateFunc)
+    storeProfileFunc(_storeProfileFunc)
 {}
 
-void PowerInfoBasePrivate::updateAvarageDischargeRate(int newAvarageDischargeRate)
+void PowerInfoBasePrivate::addSample(Utils::PowerProfile::Mode mode, int milliWatts)
+{
+    profile.addSample(mode, milliWatts, checkIntervalInMinutes * 60);
+    storeProfile(false);
+}
+
+/**
+ * @brief Stores the power profile, but only every so often.
+ *
+ * Unless \p force is set, the profile is only handed to the store function
+ * when PowerProfile::needsPersisting() says so.
+ */
+void PowerInfoBasePrivate::storeProfile(bool force)
 {
-    avarageDischargeRate = newAvarageDischargeRate;
+    const QDateTime now = Utils::Clock::instance()->now();
+
+    if(force ? !profile.isDirty() : !profile.needsPersisting(now))
+        return;
+
+    if(storeProfileFunc != nullptr)
+        storeProfileFunc(profile);
 
-    if(storeAvarageDischargeRateFunc != nullptr)
-        storeAvarageDischargeRateFunc(newAvarageDischargeRate);
+    profile.markPersisted(now);
 }
 
-PowerInfoBase::PowerInfoBase(int avarageDischargeRage,
-                             std::function<void(int)> storeAvarageDischargeRateFunc,
+PowerInfoBase::PowerInfoBase(const Utils::PowerProfile &profile,
+                             std::function<void(const Utils::PowerProfile&)> storeProfileFunc,
                              QObject *parent /* = nullptr */):
     QObject(parent),
-    d {new PowerInfoBasePrivate {avarageDischargeRage, storeAvarageDischargeRateFunc}}
+    d {new PowerInfoBasePrivate {profile, storeProfileFunc}}
 {
-    QTimer *checkTimer = new QTimer(this);
-    checkTimer->setInterval(d->checkIntervalInMinutes * 1000 * 60);
-    checkTimer->setSingleShot(false);
-    connect(checkTimer, &QTimer::timeout, this, &PowerInfoBase::checkLevels);
-    checkTimer->start();
+    Utils::Clock::instance()->repeat(d->checkIntervalInMinutes * 1000 * 60, this, [this]() { checkLevels(); });
 }
 
 PowerInfoBase::~PowerInfoBase()
-{}
+{
+    d->storeProfile(true);
+}
 
 PowerInfoBase::State PowerInfoBase::state() const
 {
@@ -68,6 +85,13 @@ PowerInfoBase::State PowerInfoBase::state() const
     return d->state;
 }
 
+Utils::PowerProfile PowerInfoBase::powerProfile() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->profile;
+}
+
 float PowerInfoBase::powerDrawInWatts()
 {
     DBG_CALLED;
@@ -90,10 +114,10 @@ float PowerInfoBase::powerDrawInWatts()
         break;
 
     case(PowerInfoBase::FullyCharged):
-        // There is no live data. We need to return the last discharge value
-        // as it is the most accurate power consumption value we have.
-        INF("Fully charged. Returning last discharge value.");
-        consumption = avarageDischargeConsumption();
+        // There is no live battery data. We return what we learned about
+        // this state, or the avarage discharge value if we know nothing yet.
+        INF("Fully charged. Returning learned consumption.");
+        consumption = fullyChargedConsumption();
         break;
 
     case(PowerInfoBase::Charging):
@@ -120,39 +144,86 @@ void PowerInfoBase::checkLevels()
 
     updateState();
 
-    if(state() == PowerInfoBase::Discharging)
+    switch(state())
+    {
+    case(PowerInfoBase::Discharging):
+        sampleDischarge();
+        return;
+
+    case(PowerInfoBase::Charging):
+        if(d->currentChargeRate > 0)
+            sampleAdapterPower(Utils::PowerProfile::Mode::Charging, static_cast<int>(chargeConsumption()));
+
+        break;
+
+    case(PowerInfoBase::FullyCharged):
+        // Nothing flows into a full battery, only the adapter knows the draw.
+        sampleAdapterPower(Utils::PowerProfile::Mode::FullyCharged, adapterPower());
+        break;
+
+    default:
+        break;
+    }
+
+    // A capacity measured before charging would spoil the next discharge rate.
+    d->lastCapacity = 0;
+}
+
+/**
+ * @brief Returns the power drawn from the AC adapter in mW.
+ *
+ * Only some platforms can tell. The default returns 0, so nothing is
+ * learned for the fully charged state and its estimate stays the discharge
+ * average.
+ */
+int PowerInfoBase::adapterPower()
+{
+    return 0;
+}
+
+void PowerInfoBase::sampleDischarge()
+{
+    DBG_CALLED;
+
+    Q_ASSERT(d != nullptr);
+
+    if(d->currentDischargeRate > 0)
     {
-        DBG("Discharging. Checking discharge rate.");
-        if(d->currentDischargeRate <= 0)
-        {
-            DBG("Discharge rate not available. Calculating...");
-            if(d->lastCapacity > 0)
-            {
-                DBG(QString("Last capacity greater than zero (%1).").arg(d->lastCapacity));
-                int dischargeRate = ((d->lastCapacity - d->currentCapacity) * 60) / d->checkIntervalInMinutes;
-
-                if(d->avarageDischargeRate == 0)
-                {
-                    d->updateAvarageDischargeRate(dischargeRate);
-                }
-                else
-                {
-                    d->updateAvarageDischargeRate((d->avarageDischargeRate + dischargeRate) / 2);
-                }
-
-                DBG(QString("AVG DischargeRate = %1 - %2").arg(d->lastCapacity).arg(d->currentCapacity));
-                DBG(QString("AVG DischargeRate = %1mWh").arg(d->avarageDischargeRate));
-
-                DBG(QString("AVG. discharge conspumption is: %1W").arg(d->avarageDischargeRate / 1000));
-            }
-            else
-            {
-                DBG("Last capacity not set yet. Saving now.");
-            }
-
-            d->lastCapacity = d->currentCapacity;
-        }
+        DBG(QString("Discharge rate available (%1mW).").arg(d->currentDischargeRate));
+        d->addSample(Utils::PowerProfile::Mode::Battery, d->currentDischargeRate);
     }
+    else if(d->lastCapacity > 0)
+    {
+        DBG(QString("Last capacity greater than zero (%1).").arg(d->lastCapacity));
+        int dischargeRate = ((d->lastCapacity - d->currentCapacity) * 60) / d->checkIntervalInMinutes;
+
+        DBG(QString("DischargeRate = %1 - %2 = %3mW").arg(d->lastCapacity).arg(d->currentCapacity).arg(dischargeRate));
+        d->addSample(Utils::PowerProfile::Mode::Battery, dischargeRate);
+    }
+    else
+    {
+        DBG("Last capacity not set yet. Saving now.");
+    }
+
+    d->lastCapacity = d->currentCapacity;
+
+    DBG(QString("AVG. discharge consumption is: %1W").arg(avarageDischargeConsumption() / 1000));
+}
+
+void PowerInfoBase::sampleAdapterPower(Utils::PowerProfile::Mode mode, int milliWatts)
+{
+    DBG_CALLED;
+
+    Q_ASSERT(d != nullptr);
+
+    if(milliWatts <= 0)
+    {
+        DBG("No adapter power available.");
+        return;
+    }
+
+    DBG(QString("Adapter power: %1mW.").arg(milliWatts));
+    d->addSample(mode, milliWatts);
 }
 
 /**
@@ -160,6 +231,7 @@ void PowerInfoBase::checkLevels()
  */
 void PowerInfoBase::updateState()
 {
+    TRACE_FUNCTION;
     DBG_CALLED;
 
     Q_ASSERT(d != nullptr);
@@ -203,8 +275,22 @@ float PowerInfoBase::avarageDischargeConsumption()
 
     Q_ASSERT(d != nullptr);
 
-    DBG(QString("Returning avarage discharge rate: %1.").arg(d->avarageDischargeRate));
-    return d->avarageDischargeRate;
+    float consumption = d->profile.estimate(Utils::PowerProfile::Mode::Battery);
+
+    DBG(QString("Returning avarage discharge rate: %1.").arg(consumption));
+    return consumption;
+}
+
+float PowerInfoBase::fullyChargedConsumption()
+{
+    DBG_CALLED;
+
+    Q_ASSERT(d != nullptr);
+
+    float consumption = d->profile.estimate(Utils::PowerProfile::Mode::FullyCharged);
+
+    DBG(QString("Returning fully charged consumption: %1mW.").arg(consumption));
+    return consumption;
 }
 
 float PowerInfoBase::chargeConsumption()
@@ -4,6 +4,8 @@
 #include <QObject>
 #include <interfaces/IPower.h>
 
+#include "utils/powerprofile.h"
+
 class PowerInfoBasePrivate;
 
 class PowerInfoBase : public QObject, public IPower
@@ -15,10 +17,11 @@ public:
     Q_ENUM(State)
     Q_INTERFACES(IPower)
 
-    explicit PowerInfoBase(int avarageDischargeRate, std::function<void(int)> storeAvarageDischargeRateFunc, QObject *parent = nullptr);
+    explicit PowerInfoBase(const Utils::PowerProfile &profile, std::function<void(const Utils::PowerProfile&)> storeProfileFunc, QObject *parent = nullptr);
     virtual ~PowerInfoBase();
 
     State state() const;
+    Utils::PowerProfile powerProfile() const;
     virtual float powerDrawInWatts() override;
 
 protected:
@@ -28,13 +31,17 @@ protected:
     virtual int chargeRate() = 0;
     virtual int dischargeRate() = 0;
     virtual int currentCapacity() = 0;
+    virtual int adapterPower();
 
 private slots:
     void checkLevels();
 
 private:
     void updateState();
+    void sampleDischarge();
+    void sampleAdapterPower(Utils::PowerProfile::Mode mode, int milliWatts);
     float avarageDischargeConsumption();
+    float fullyChargedConsumption();
     float chargeConsumption();
 
     static float noBatteryPowerEstimate();
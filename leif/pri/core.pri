@@ -0,0 +1,132 @@
+# Everything the carbon tracking needs without a GUI. Used by the tray
+# application (leif.pro) and the headless daemon (leifd.pro).
+
+LEIF_SRC = $$clean_path($$PWD/..)
+
+SOURCES += \
+        $$LEIF_SRC/log/consolelogger.cpp \
+        $$LEIF_SRC/log/filelogger.cpp \
+        $$LEIF_SRC/log/iodevicelogger.cpp \
+        $$LEIF_SRC/log/logfilterbase.cpp \
+        $$LEIF_SRC/log/logfilterbyfile.cpp \
+        $$LEIF_SRC/log/loggerbase.cpp \
+        $$LEIF_SRC/log/logmanager.cpp \
+        $$LEIF_SRC/log/logrecord.cpp \
+        $$LEIF_SRC/log/logsystem.cpp \
+        $$LEIF_SRC/log/predictivelogger.cpp \
+        $$LEIF_SRC/log/trace.cpp \
+        $$LEIF_SRC/plugin/carbonplugin.cpp \
+        $$LEIF_SRC/plugin/carbonpluginmanager.cpp \
+        $$LEIF_SRC/plugin/fetchpolicy.cpp \
+        $$LEIF_SRC/plugin/pluginhostprotocol.cpp \
+        $$LEIF_SRC/plugin/pluginmetadatacache.cpp \
+        $$LEIF_SRC/plugin/remotecarbonplugin.cpp \
+        $$LEIF_SRC/plugin/shareddataprovider.cpp \
+        $$LEIF_SRC/powerinfobase.cpp \
+        $$LEIF_SRC/services/carbonservice.cpp \
+        $$LEIF_SRC/services/fleetreporter.cpp \
+        $$LEIF_SRC/services/metricsservice.cpp \
+        $$LEIF_SRC/services/schedulerservice.cpp \
+        $$LEIF_SRC/services/settingsservice.cpp \
+        $$LEIF_SRC/sharedpower.cpp \
+        $$LEIF_SRC/utils/carbonplugindata.cpp \
+        $$LEIF_SRC/utils/carbonscheduler.cpp \
+        $$LEIF_SRC/utils/clock.cpp \
+        $$LEIF_SRC/utils/fleetreport.cpp \
+        $$LEIF_SRC/utils/hostcache.cpp \
+        $$LEIF_SRC/utils/localeid.cpp \
+        $$LEIF_SRC/utils/metricsformat.cpp \
+        $$LEIF_SRC/utils/powerprofile.cpp \
+        $$LEIF_SRC/utils/quitonsignals.cpp \
+        $$LEIF_SRC/utils/selfmetrics.cpp \
+        $$LEIF_SRC/utils/territory.cpp \
+        $$LEIF_SRC/utils/translatedstring.cpp \
+        $$LEIF_SRC/utils/translation.cpp
+
+mac: SOURCES += \
+                $$LEIF_SRC/mac/powerinfo.cpp \
+                $$LEIF_SRC/mac/powerfactory_mac.cpp
+
+win32: SOURCES += \
+                $$LEIF_SRC/win/powerinfo.cpp \
+                $$LEIF_SRC/win/powerfactory_win.cpp
+
+linux: SOURCES += \
+                $$LEIF_SRC/linux/powerfactory_linux.cpp \
+                $$LEIF_SRC/linux/powerinfo.cpp \
+                $$LEIF_SRC/linux/powersupply.cpp \
+                $$LEIF_SRC/linux/processpowerattribution.cpp \
+                $$LEIF_SRC/linux/processsampler.cpp
+
+HEADERS += \
+    $$LEIF_SRC/include/carbondata.h \
+    $$LEIF_SRC/include/carbonsnapshot.h \
+    $$LEIF_SRC/include/carbonusagelevel.h \
+    $$LEIF_SRC/include/chargeforecast.h \
+    $$LEIF_SRC/include/interfaces/IDataProvider.h \
+    $$LEIF_SRC/include/interfaces/IPower.h \
+    $$LEIF_SRC/log/consolelogger.h \
+    $$LEIF_SRC/log/filelogger.h \
+    $$LEIF_SRC/log/ilogger.h \
+    $$LEIF_SRC/log/ilogmanager.h \
+    $$LEIF_SRC/log/iodevicelogger.h \
+    $$LEIF_SRC/log/log.h \
+    $$LEIF_SRC/log/log_internal.h \
+    $$LEIF_SRC/log/logfilterbase.h \
+    $$LEIF_SRC/log/logfilterbyfile.h \
+    $$LEIF_SRC/log/loggerbase.h \
+    $$LEIF_SRC/log/logmanager.h \
+    $$LEIF_SRC/log/logrecord.h \
+    $$LEIF_SRC/log/logsite.h \
+    $$LEIF_SRC/log/logsystem.h \
+    $$LEIF_SRC/log/messagetype.h \
+    $$LEIF_SRC/log/predictivelogger.h \
+    $$LEIF_SRC/log/trace.h \
+    $$LEIF_SRC/plugin/carbonplugin.h \
+    $$LEIF_SRC/plugin/carbonpluginmanager.h \
+    $$LEIF_SRC/plugin/fetchpolicy.h \
+    $$LEIF_SRC/plugin/pluginhostprotocol.h \
+    $$LEIF_SRC/plugin/pluginmetadatacache.h \
+    $$LEIF_SRC/plugin/remotecarbonplugin.h \
+    $$LEIF_SRC/plugin/shareddataprovider.h \
+    $$LEIF_SRC/powerfactory.h \
+    $$LEIF_SRC/powerinfobase.h \
+    $$LEIF_SRC/services/carbonservice.h \
+    $$LEIF_SRC/services/fleetreporter.h \
+    $$LEIF_SRC/services/metricsservice.h \
+    $$LEIF_SRC/services/schedulerservice.h \
+    $$LEIF_SRC/services/settingsservice.h \
+    $$LEIF_SRC/sharedpower.h \
+    $$LEIF_SRC/utils/carbonplugindata.h \
+    $$LEIF_SRC/utils/carbonscheduler.h \
+    $$LEIF_SRC/utils/clock.h \
+    $$LEIF_SRC/utils/fleetreport.h \
+    $$LEIF_SRC/utils/hostcache.h \
+    $$LEIF_SRC/utils/localeid.h \
+    $$LEIF_SRC/utils/metricsformat.h \
+    $$LEIF_SRC/utils/powerprofile.h \
+    $$LEIF_SRC/utils/quitonsignals.h \
+    $$LEIF_SRC/utils/selfmetrics.h \
+    $$LEIF_SRC/utils/territory.h \
+    $$LEIF_SRC/utils/translatedstring.h \
+    $$LEIF_SRC/utils/translation.h
+
+mac: HEADERS += $$LEIF_SRC/mac/powerinfo.h
+
+win32: HEADERS += $$LEIF_SRC/win/powerinfo.h
+
+linux: HEADERS += \
+                $$LEIF_SRC/linux/powerinfo.h \
+                $$LEIF_SRC/linux/powersupply.h \
+                $$LEIF_SRC/linux/processpowerattribution.h \
+                $$LEIF_SRC/linux/processsampler.h
+
+INCLUDEPATH += $$LEIF_SRC $$LEIF_SRC/include $$LEIF_SRC/services
+
+win32: LIBS *= PowrProf.lib Psapi.lib Advapi32.lib
+
+# shm_open() for the host cache, part of libc since glibc 2.34.
+linux: LIBS += -lrt
+
+mac: LIBS += -framework IOKit
+mac: LIBS += -framework CoreFoundation
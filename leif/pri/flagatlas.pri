@@ -0,0 +1,24 @@
+# Packs img/flags/*.png into one atlas at build time. The flagatlas tool
+# (../flagatlas) writes the atlas and its lookup table into flagatlas_data.cpp,
+# which is compiled into the application, see Utils::FlagAtlas.
+
+FLAGATLAS_DIR = $$shadowed($$PWD/../../flagatlas)
+
+win32 {
+    CONFIG(debug, debug|release): FLAGATLAS_TOOL = $$FLAGATLAS_DIR/debug/flagatlas.exe
+    else: FLAGATLAS_TOOL = $$FLAGATLAS_DIR/release/flagatlas.exe
+} else {
+    FLAGATLAS_TOOL = $$FLAGATLAS_DIR/flagatlas
+}
+
+FLAG_IMAGES = $$files($$PWD/../img/flags/*.png)
+
+flagatlas.name = Packing the flag atlas
+flagatlas.input = FLAG_IMAGES
+flagatlas.output = $$OUT_PWD/flagatlas_data.cpp
+flagatlas.commands = $$shell_path($$FLAGATLAS_TOOL) --output ${QMAKE_FILE_OUT} ${QMAKE_FILE_IN}
+flagatlas.depends = $$FLAGATLAS_TOOL
+flagatlas.variable_out = SOURCES
+flagatlas.CONFIG += combine target_predeps
+
+QMAKE_EXTRA_COMPILERS += flagatlas
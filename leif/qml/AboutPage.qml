@@ -1,10 +1,14 @@
 import QtQuick
 import QtQuick.Window
 import QtQuick.Controls
+import Leif.Controllers 1.0
 
 BasePage {
     stateShownIn: "ABOUT"
 
+    // Sampled when shown, not while nobody looks.
+    onVisibleChanged: if(visible) SelfMetricsController.refresh()
+
     Column {
         anchors.centerIn: parent
         spacing: 20
@@ -28,5 +32,12 @@ BasePage {
         CenteredText {
             text: "Copyright © Tim Stone 2022"
         }
+
+        CenteredText {
+            text: SelfMetricsController.summary
+            font.pointSize: 10
+            opacity: 0.7
+            horizontalAlignment: Text.AlignHCenter
+        }
     }
 }
@@ -11,15 +11,30 @@ LeifComboBox {
     valueRole: "code"
 
     delegate: ItemDelegate {
+        id: countryDelegate
+
         width: control.width
         height: control.height
         palette.text: control.palette.buttonText
         font: control.font
         text: name
         highlighted: control.highlightedIndex === index
-        icon.source: "../img/flags/" + code + ".png"
-        icon.color: "transparent"
         spacing: control.spacing
+        contentItem: Row {
+            spacing: countryDelegate.spacing
+
+            FlagImage {
+                code: model.code
+                anchors.verticalCenter: parent.verticalCenter
+            }
+
+            Text {
+                text: countryDelegate.text
+                font: countryDelegate.font
+                color: countryDelegate.highlighted ? countryDelegate.palette.highlightedText : countryDelegate.palette.text
+                anchors.verticalCenter: parent.verticalCenter
+            }
+        }
         indicator: Image {
             visible: control.currentIndex === index
             source: control.highlightedIndex === index ? "../img/check_black.png" : "../img/check_white.png"
@@ -0,0 +1,27 @@
+import QtQuick
+import Leif.Controllers 1.0
+
+// Shows one flag of the flag atlas. All flags share the texture of the atlas,
+// the item only clips the part of the flag.
+Item {
+    id: root
+
+    property var code
+    readonly property rect flagRect: FlagController.flagRect(code)
+
+    implicitWidth: 24
+    implicitHeight: flagRect.width > 0 ? implicitWidth * flagRect.height / flagRect.width : implicitWidth
+    clip: true
+
+    Image {
+        readonly property real scaleX: root.flagRect.width > 0 ? root.width / root.flagRect.width : 1
+        readonly property real scaleY: root.flagRect.height > 0 ? root.height / root.flagRect.height : 1
+
+        source: "image://flags/atlas"
+        x: -root.flagRect.x * scaleX
+        y: -root.flagRect.y * scaleY
+        width: FlagController.atlasSize.width * scaleX
+        height: FlagController.atlasSize.height * scaleY
+        smooth: true
+    }
+}
@@ -42,11 +42,22 @@ ComboBox {
         leftPadding: 20
         rightPadding: control.indicator.width + control.spacing
 
-        Image {
-            source: control.currentIndex >= 0 ? "../img/flags/" + control.currentValue + ".png" : control.defaultIcon
+        Item {
             width: 24
             height: 24
             anchors.verticalCenter: parent.verticalCenter
+
+            FlagImage {
+                visible: control.currentIndex >= 0
+                code: control.currentValue
+                anchors.centerIn: parent
+            }
+
+            Image {
+                visible: control.currentIndex < 0
+                source: control.defaultIcon
+                anchors.fill: parent
+            }
         }
 
         Text {
@@ -5,12 +5,18 @@ import Leif 1.0
 import Leif.Controllers 1.0
 
 BasePage {
+    id: page
+
     stateShownIn: "STATUS"
 
     property real sessionDisplay: CarbonController.sessionCarbon
     property real lifetimeDisplay: CarbonController.lifetimeCarbon
 
+    // Only animate what can be seen. The attached Window property has to be
+    // read from the page, the Behavior itself is not an item in a window.
     Behavior on sessionDisplay {
+        enabled: page.visible && page.Window.visibility !== Window.Hidden
+
         NumberAnimation {
             duration: 1000
             easing.type: Easing.InOutQuad
@@ -18,6 +24,8 @@ BasePage {
     }
 
     Behavior on lifetimeDisplay {
+        enabled: page.visible && page.Window.visibility !== Window.Hidden
+
         NumberAnimation {
             duration: 1000
             easing.type: Easing.InOutQuad
@@ -1,52 +1,127 @@
-#include <QTimer>
+#include <QMutex>
 #include <QDebug>
 
 #include "carbonservice.h"
 #include "settingsservice.h"
 #include "powerfactory.h"
+#include "sharedpower.h"
 
 #include "plugin/carbonpluginmanager.h"
+#include "plugin/shareddataprovider.h"
+
+#include "utils/clock.h"
+#include "utils/hostcache.h"
 
 #include "interfaces/IPower.h"
 
 #include "log/log.h"
+#include "log/trace.h"
+
+#ifdef Q_OS_LINUX
+#include "linux/processpowerattribution.h"
+#endif
 
 class CarbonServicePrivate
 {
+public:
+    ~CarbonServicePrivate() = default;
+
 private:
+    CarbonServicePrivate(SettingsService *settings, std::unique_ptr<IPower> powerInfo, IDataProvider *dataProvider);
+
+    void shareSources(Utils::HostCache *hostCache);
+
     float session;
     float lifetime;
     CarbonUsageLevel usageLevel;
     ChargeForecast chargeForecast;
     QScopedPointer<IPower> powerInfo;
+    IDataProvider *dataProvider;
+    QScopedPointer<SharedDataProvider> sharedDataProvider;
     SettingsService *settings;
     CarbonData cachedData;
 
+    // Read by the metrics server thread, see snapshot().
+    mutable QMutex snapshotMutex;
+    CarbonSnapshot snapshot;
+
+#ifdef Q_OS_LINUX
+    // Only the session of the real machine is attributed.
+    QScopedPointer<ProcessPowerAttribution> attribution;
+#endif
+
     QTimer calculateTimer;
     
     friend class CarbonService;
 };
 
+CarbonServicePrivate::CarbonServicePrivate(SettingsService *settings, std::unique_ptr<IPower> powerInfo, IDataProvider *dataProvider):
+    session {0.0},
+    lifetime {0.0},
+    usageLevel {CarbonUsageLevel::VeryHigh},
+    chargeForecast {ChargeForecast::ChargeWhenNeeded},
+    powerInfo {powerInfo.release()},
+    dataProvider {dataProvider},
+    settings {settings}
+{}
+
+/**
+ * @brief Shares the power and carbon sources with the other instances on the
+ * machine through \p hostCache.
+ */
+void CarbonServicePrivate::shareSources(Utils::HostCache *hostCache)
+{
+    if(hostCache == nullptr || dataProvider == nullptr || powerInfo.isNull())
+    {
+        return;
+    }
+
+    sharedDataProvider.reset(new SharedDataProvider {dataProvider, hostCache});
+    dataProvider = sharedDataProvider.get();
+    powerInfo.reset(new SharedPower {std::unique_ptr<IPower> {powerInfo.take()}, hostCache});
+}
+
+/**
+ * @brief Creates a CarbonService with the platform power backend and the
+ * CarbonPluginManager.
+ *
+ * If the host cache is on, both sources are shared with the other instances
+ * on the machine, see Utils::HostCache. On Linux the carbon is attributed to
+ * the running applications as well.
+ */
 CarbonService::CarbonService(SettingsService *settings, QObject *parent)
     : QObject{parent},
-      d{new CarbonServicePrivate}
+      d{new CarbonServicePrivate {settings, PowerFactory::getPowerInterface(settings), CarbonPluginManager::Instance()}}
 {
-    d->session = 0.0;
-    d->lifetime = 0.0;
-    d->usageLevel = CarbonUsageLevel::VeryHigh;
-    d->chargeForecast = ChargeForecast::ChargeWhenNeeded;
-    d->powerInfo.reset(PowerFactory::getPowerInterface(settings).release());
-    d->settings = settings;
+    // On a terminal server one instance fetches and measures for all users.
+    d->shareSources(Utils::HostCache::instance());
 
-    if(d->settings != nullptr)
-        setLifetimeCarbon(settings->lifeTimeCarbon());
-
-    QTimer *checkTimer = new QTimer(this);
-    checkTimer->setInterval(1000 * 60);
-    checkTimer->setSingleShot(false);
-    connect(checkTimer, &QTimer::timeout, this, &CarbonService::calculateCarbon);
-    checkTimer->start();
-    calculateCarbon();
+#ifdef Q_OS_LINUX
+    d->attribution.reset(new ProcessPowerAttribution);
+#endif
+
+    start();
+}
+
+/**
+ * @brief Creates a CarbonService with the given power and carbon sources.
+ *
+ * The other constructor uses the platform power backend and the
+ * CarbonPluginManager. This one allows tests and benchmarks to use their own.
+ * They are used as they are, neither shared through the host cache nor is
+ * the carbon attributed to the processes of the machine running them.
+ *
+ * @param settings The settings with the location and the lifetime carbon.
+ * @param powerInfo The power draw source, the service takes ownership.
+ * @param dataProvider The carbon data source, not owned by the service.
+ * @param parent The QObject parent.
+ */
+CarbonService::CarbonService(SettingsService *settings, std::unique_ptr<IPower> powerInfo,
+                             IDataProvider *dataProvider, QObject *parent)
+    : QObject{parent},
+      d{new CarbonServicePrivate {settings, std::move(powerInfo), dataProvider}}
+{
+    start();
 }
 
 CarbonService::~CarbonService()
@@ -57,6 +132,27 @@ CarbonService::~CarbonService()
     d->settings = nullptr;
 }
 
+/**
+ * @brief Reads the lifetime carbon and starts the calculation every minute.
+ */
+void CarbonService::start()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->settings != nullptr)
+        setLifetimeCarbon(d->settings->lifeTimeCarbon());
+
+    // Every calculation adds the carbon of one minute.
+    Utils::Clock::instance()->repeat(1000 * 60, this, [this]() { calculateCarbon(); });
+
+    // Without plugins there is nothing to calculate yet.
+    CarbonPluginManager *manager = dynamic_cast<CarbonPluginManager*>(d->dataProvider);
+    if(manager != nullptr && !manager->isReady())
+        connect(manager, &CarbonPluginManager::pluginsLoaded, this, &CarbonService::calculateCarbon, Qt::SingleShotConnection);
+    else
+        calculateCarbon();
+}
+
 float CarbonService::sessionCarbon() const
 {
     Q_ASSERT(d != nullptr);
@@ -85,14 +181,58 @@ ChargeForecast CarbonService::chargeForecast() const
     return d->chargeForecast;
 }
 
+/**
+ * @brief Returns the grams of CO2 per application since the session started.
+ *
+ * \remark Only available on Linux, other platforms return an empty hash.
+ *
+ * @return A hash with the application name as key and the grams as value.
+ */
+QHash<QString, float> CarbonService::applicationCarbon() const
+{
+    Q_ASSERT(d != nullptr);
+
+#ifdef Q_OS_LINUX
+    if(!d->attribution.isNull())
+        return d->attribution->applicationCarbon();
+#endif
+
+    return QHash<QString, float>();
+}
+
+/**
+ * @brief Returns the state of the last calculation.
+ *
+ * This method is thread safe. It only copies the snapshot, so it can be
+ * called from other threads as often as needed without waiting for the
+ * calculation.
+ */
+CarbonSnapshot CarbonService::snapshot() const
+{
+    Q_ASSERT(d != nullptr);
+
+    QMutexLocker locker(&d->snapshotMutex);
+    return d->snapshot;
+}
+
 void CarbonService::clearStats()
 {
     setSessionCarbon(0);
     setLifetimeCarbon(0);
+    publishSnapshot(d->snapshot.powerDrawInWatts, d->cachedData);
+
+#ifdef Q_OS_LINUX
+    if(!d->attribution.isNull())
+    {
+        d->attribution->clear();
+        emit applicationCarbonChanged();
+    }
+#endif
 }
 
 void CarbonService::calculateCarbon()
 {
+    TRACE_FUNCTION;
     DBG_CALLED;
     Q_ASSERT(d != nullptr);
 
@@ -102,10 +242,15 @@ void CarbonService::calculateCarbon()
         return;
     }
 
-    CarbonPluginManager *manager = CarbonPluginManager::Instance();
-    if(manager == nullptr)
+    if(d->dataProvider == nullptr)
+    {
+        ERR("Can't calculate carbon, no carbon data provider available.");
+        return;
+    }
+
+    if(d->powerInfo.isNull())
     {
-        ERR("Can't calcuate carbon, CarbonPluginManager not available.");
+        ERR("Can't calculate carbon, no power information available.");
         return;
     }
 
@@ -120,7 +265,7 @@ void CarbonService::calculateCarbon()
     if(isOutOfDate(data))
     {
         DBG("Cached expired or invalid. Retrieving carbon data from plugin.");
-        data = manager->carbonPerKiloWatt(d->settings->country(), d->settings->regionId());
+        data = d->dataProvider->carbonPerKiloWatt(d->settings->country(), d->settings->regionId());
     }
 
     INF(QString("Current power draw: %1.").arg(powerDraw));
@@ -146,11 +291,30 @@ void CarbonService::calculateCarbon()
         setCarbonUsageLevel(calculateUsageLevel(data.co2PerkWhNow));
         setChargeForecast(calculateChargeForecast(data));
         d->cachedData = data;
+
+#ifdef Q_OS_LINUX
+        if(!d->attribution.isNull())
+        {
+            d->attribution->sample(carbon);
+            emit applicationCarbonChanged();
+        }
+#endif
     }
     else
     {
-        ERR(QString("Carbon data error: %1").arg(data.errorString));
+        if(data.isPending)
+            DBG(QString("Carbon data is pending: %1").arg(data.errorString));
+        else
+            ERR(QString("Carbon data error: %1").arg(data.errorString));
+
+#ifdef Q_OS_LINUX
+        // The session gains nothing, neither may the next interval.
+        if(!d->attribution.isNull())
+            d->attribution->sample(0);
+#endif
     }
+
+    publishSnapshot(powerDraw, data);
 }
 
 CarbonUsageLevel CarbonService::calculateUsageLevel(int co2PerkWh)
@@ -231,13 +395,50 @@ void CarbonService::setChargeForecast(ChargeForecast newChargeForecast)
     }
 }
 
+/**
+ * @brief Stores the current state in the snapshot and announces it.
+ *
+ * Only the calculation writes the snapshot, so we can read our own members
+ * without the lock.
+ *
+ * The single value changed signals may fire several times per calculation,
+ * snapshotChanged() fires exactly once. UI layers should use the latter.
+ */
+void CarbonService::publishSnapshot(float powerDraw, const CarbonData &data)
+{
+    Q_ASSERT(d != nullptr);
+
+    CarbonSnapshot snapshot;
+    snapshot.sequence = d->snapshot.sequence + 1;
+    snapshot.timestamp = Utils::Clock::instance()->now().toUTC();
+    snapshot.powerDrawInWatts = powerDraw;
+    snapshot.sessionCarbon = d->session;
+    snapshot.lifetimeCarbon = d->lifetime;
+    snapshot.usageLevel = d->usageLevel;
+    snapshot.chargeForecast = d->chargeForecast;
+    snapshot.carbon = data;
+
+    if(d->settings != nullptr)
+    {
+        snapshot.country = d->settings->country();
+        snapshot.region = d->settings->regionId();
+    }
+
+    {
+        QMutexLocker locker(&d->snapshotMutex);
+        d->snapshot = snapshot;
+    }
+
+    emit snapshotChanged(snapshot);
+}
+
 /* static */
 bool CarbonService::isOutOfDate(const CarbonData &data)
 {
     if(!data.isValid)
         return true;
 
-    return QDateTime::currentDateTime() > data.validTo;
+    return Utils::Clock::instance()->now() > data.validTo;
 }
 
 /* static */
@@ -1,13 +1,19 @@
 #ifndef CARBONSERVICE_H
 #define CARBONSERVICE_H
 
+#include <QHash>
 #include <QObject>
 
+#include <memory>
+
 #include <include/carbonusagelevel.h>
 #include <include/carbondata.h>
 #include <include/chargeforecast.h>
+#include <include/carbonsnapshot.h>
 
 class CarbonServicePrivate;
+class IDataProvider;
+class IPower;
 class SettingsService;
 
 class CarbonService : public QObject
@@ -15,12 +21,16 @@ class CarbonService : public QObject
     Q_OBJECT
 public:
     explicit CarbonService(SettingsService *settings, QObject *parent = nullptr);
+    CarbonService(SettingsService *settings, std::unique_ptr<IPower> powerInfo,
+                  IDataProvider *dataProvider, QObject *parent = nullptr);
     virtual ~CarbonService();
 
     float sessionCarbon() const;
     float lifetimeCarbon() const;
     CarbonUsageLevel carbonUsageLevel() const;
     ChargeForecast chargeForecast() const;
+    QHash<QString, float> applicationCarbon() const;
+    CarbonSnapshot snapshot() const;
 
 public slots:
     void clearStats();
@@ -30,16 +40,20 @@ signals:
     void lifetimeCarbonChanged();
     void carbonUsageLevelChanged();
     void chargeForecastChanged();
+    void applicationCarbonChanged();
+    void snapshotChanged(const CarbonSnapshot &snapshot);
 
 private slots:
     void calculateCarbon();
     CarbonUsageLevel calculateUsageLevel(int co2PerkWh);
 
 private:
+    void start();
     void setSessionCarbon(float newSessionCarbon);
     void setLifetimeCarbon(float newLifetimeCarbon);
     void setCarbonUsageLevel(CarbonUsageLevel newLevel);
     void setChargeForecast(ChargeForecast newChargeForecast);
+    void publishSnapshot(float powerDraw, const CarbonData &data);
     static bool isOutOfDate(const CarbonData &data);
     static ChargeForecast calculateChargeForecast(const CarbonData &data);
 
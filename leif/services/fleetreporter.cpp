@@ -0,0 +1,245 @@
+/**
+ * @brief Implements the FleetReporter class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QHostInfo>
+#include <QRandomGenerator>
+#include <QSysInfo>
+#include <QUdpSocket>
+#include <QUrl>
+
+#include "carbonservice.h"
+#include "fleetreporter.h"
+
+#include "utils/fleetreport.h"
+#include "utils/selfmetrics.h"
+
+#include "log/log.h"
+
+class FleetReporterPrivate
+{
+public:
+    ~FleetReporterPrivate() = default;
+
+private:
+    FleetReporterPrivate();
+
+    QUdpSocket socket;
+    QHostAddress address;
+    quint16 port;
+    bool enabled;
+
+    quint64 sender;
+    quint32 sequence;
+    QDateTime lastSnapshot;
+    QList<Utils::FleetReport::Sample> batch;
+
+    // The region of the location and the id it is reported with.
+    QString region;
+    QString reportedRegion;
+
+    friend class FleetReporter;
+};
+
+FleetReporterPrivate::FleetReporterPrivate():
+    port {Utils::FleetReport::DefaultPort},
+    enabled {false},
+    sender {FleetReporter::senderId()},
+    sequence {0}
+{}
+
+/**
+ * @class FleetReporter
+ *
+ * @brief Reports the carbon of this machine to a fleet collector.
+ *
+ * Every snapshot of the CarbonService becomes a sample. Its energy is the
+ * power draw over the time since the previous snapshot, capped at
+ * MaxSampleIntervalInSeconds so a suspended machine doesn't report the
+ * night. Snapshots without valid carbon data are skipped.
+ *
+ * The samples are sent as one UDP datagram every BatchSize calculations,
+ * about every quarter of an hour, and on shutdown. Reports are fire and
+ * forget, a lost one only leaves a gap in the rollups.
+ *
+ * \c LEIF_FLEET_COLLECTOR is the collector as \c host, \c host:port or
+ * \c [v6address]:port, the default port is Utils::FleetReport::DefaultPort.
+ */
+
+FleetReporter::FleetReporter(CarbonService *carbonService, QObject *parent /* = nullptr */):
+    QObject {parent},
+    d {new FleetReporterPrivate}
+{
+    const QString collector = configuredCollector();
+
+    if(collector.isEmpty() || carbonService == nullptr)
+    {
+        DBG("Fleet reporting is disabled.");
+        return;
+    }
+
+    // The scheme only makes QUrl split host and port, IPv6 needs brackets.
+    const QUrl url {QStringLiteral("udp://") + collector};
+    const QString host = url.host();
+    const int port = url.port(Utils::FleetReport::DefaultPort);
+
+    if(!url.isValid() || host.isEmpty() || port <= 0)
+    {
+        WRN(QString("Invalid fleet collector: %1").arg(collector));
+        return;
+    }
+
+    d->port = static_cast<quint16>(port);
+    d->enabled = true;
+    connect(carbonService, &CarbonService::snapshotChanged, this, &FleetReporter::onSnapshotChanged);
+
+    // Resolve once and don't block the start, samples wait in the batch.
+    QHostInfo::lookupHost(host, this, [this, host](const QHostInfo &info) {
+        if(info.error() != QHostInfo::NoError || info.addresses().isEmpty())
+        {
+            WRN(QString("Could not resolve the fleet collector %1: %2").arg(host, info.errorString()));
+            return;
+        }
+
+        d->address = info.addresses().constFirst();
+        INF(QString("Reporting to the fleet collector %1:%2.").arg(d->address.toString()).arg(d->port));
+    });
+}
+
+FleetReporter::~FleetReporter()
+{
+    flush();
+}
+
+bool FleetReporter::isEnabled() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->enabled;
+}
+
+/**
+ * @brief Returns the number of samples waiting for the next report.
+ */
+int FleetReporter::pendingSamples() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return static_cast<int>(d->batch.count());
+}
+
+/**
+ * @brief Returns \c LEIF_FLEET_COLLECTOR, or an empty string.
+ */
+/* static */
+QString FleetReporter::configuredCollector()
+{
+    return qEnvironmentVariable("LEIF_FLEET_COLLECTOR").trimmed();
+}
+
+/**
+ * @brief Returns the id this machine reports with.
+ *
+ * A hash of the machine id, the collector doesn't need the real one. Random
+ * if the platform has no machine id.
+ */
+/* static */
+quint64 FleetReporter::senderId()
+{
+    const QByteArray machineId = QSysInfo::machineUniqueId();
+    if(machineId.isEmpty())
+    {
+        return QRandomGenerator::system()->generate64();
+    }
+
+    quint64 hash {14695981039346656037ull};
+    for(const char c : machineId)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+void FleetReporter::onSnapshotChanged(const CarbonSnapshot &snapshot)
+{
+    Q_ASSERT(d != nullptr);
+
+    const qint64 seconds = d->lastSnapshot.isValid() ? d->lastSnapshot.secsTo(snapshot.timestamp) : 60;
+    d->lastSnapshot = snapshot.timestamp;
+
+    if(!snapshot.carbon.isValid || seconds <= 0)
+    {
+        return;
+    }
+
+    const double energyInMilliWattHours = qMax(0.0f, snapshot.powerDrawInWatts) * 1000.0
+                                        * qMin<qint64>(seconds, MaxSampleIntervalInSeconds) / 3600.0;
+
+    Utils::FleetReport::Sample sample;
+    sample.timeInMs = snapshot.timestamp.toMSecsSinceEpoch();
+    sample.country = static_cast<quint16>(snapshot.country);
+    sample.co2PerkWh = static_cast<quint16>(qBound(0, snapshot.carbon.co2PerkWhNow, 0xffff));
+    sample.energyInMilliWattHours = static_cast<quint32>(qRound64(energyInMilliWattHours));
+    sample.carbonInMilligrams = static_cast<quint32>(qRound64(energyInMilliWattHours * sample.co2PerkWh / 1000.0));
+
+    // Checked once per location, not per snapshot.
+    if(snapshot.region != d->region || d->reportedRegion.isNull())
+    {
+        d->region = snapshot.region;
+        d->reportedRegion = Utils::FleetReport::fittingRegionId(snapshot.region);
+
+        if(d->reportedRegion != d->region)
+        {
+            INF(QString("Region id %1 doesn't fit into the fleet report, reporting it as %2.").arg(d->region, d->reportedRegion));
+        }
+    }
+
+    sample.setRegionId(d->reportedRegion);
+
+    d->batch << sample;
+
+    // Don't grow while the collector can't be resolved.
+    if(d->batch.count() > Utils::FleetReport::MaxSamples)
+    {
+        d->batch.removeFirst();
+    }
+
+    if(d->batch.count() >= BatchSize)
+    {
+        flush();
+    }
+}
+
+/**
+ * @brief Sends the batch as one report.
+ */
+void FleetReporter::flush()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->batch.isEmpty() || d->address.isNull())
+    {
+        return;
+    }
+
+    Utils::FleetReport::Header header;
+    header.sender = d->sender;
+    header.sequence = d->sequence++;
+
+    const QByteArray datagram = Utils::FleetReport::encode(header, d->batch);
+    const qint64 written = d->socket.writeDatagram(datagram, d->address, d->port);
+
+    if(written < 0)
+    {
+        WRN(QString("Could not send the fleet report: %1").arg(d->socket.errorString()));
+        return;
+    }
+
+    Utils::SelfMetrics::addNetworkBytes(written);
+    d->batch.clear();
+}
@@ -0,0 +1,52 @@
+/**
+ * @brief Defines the FleetReporter class.
+ *
+ * The FleetReporter sends the energy, carbon intensity and carbon of every
+ * calculation in batches to a fleet collector, so the numbers of many
+ * machines can be summed up. It is off unless LEIF_FLEET_COLLECTOR is set.
+ *
+ * @sa Utils::FleetReport, leif-collector
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FLEETREPORTER_H
+#define FLEETREPORTER_H
+
+#include <QObject>
+#include <QScopedPointer>
+
+#include <carbonsnapshot.h>
+
+class CarbonService;
+class FleetReporterPrivate;
+
+class FleetReporter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FleetReporter(CarbonService *carbonService, QObject *parent = nullptr);
+    virtual ~FleetReporter();
+
+    bool isEnabled() const;
+    int pendingSamples() const;
+
+    static QString configuredCollector();
+    static quint64 senderId();
+
+    static constexpr int BatchSize {15};
+    static constexpr int MaxSampleIntervalInSeconds {5 * 60};
+
+private slots:
+    void onSnapshotChanged(const CarbonSnapshot &snapshot);
+
+private:
+    void flush();
+
+private:
+    Q_DISABLE_COPY_MOVE(FleetReporter)
+    QScopedPointer<FleetReporterPrivate> d;
+};
+
+#endif // FLEETREPORTER_H
@@ -0,0 +1,287 @@
+/**
+ * @brief Implements the MetricsService class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+
+#include "carbonservice.h"
+#include "metricsservice.h"
+
+#include "utils/metricsformat.h"
+#include "utils/selfmetrics.h"
+
+#include "log/log.h"
+#include "log/trace.h"
+
+namespace
+{
+// A request line longer than this is not a scrape.
+constexpr qint64 MaxRequestLineSize {1024};
+
+QByteArray httpResponse(const QByteArray &status, const char *contentType, const QByteArray &body, bool withBody)
+{
+    QByteArray response;
+    response.reserve(128 + body.size());
+
+    response += "HTTP/1.1 " + status + "\r\n";
+    response += "Content-Type: ";
+    response += contentType;
+    response += "\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+
+    if(withBody)
+    {
+        response += body;
+    }
+
+    return response;
+}
+}
+
+class MetricsServicePrivate
+{
+public:
+    ~MetricsServicePrivate() = default;
+
+private:
+    MetricsServicePrivate(CarbonService *carbonService);
+
+    void onNewConnection();
+    void onReadyRead(QTcpSocket *socket);
+    void updateCache();
+
+    CarbonService *carbonService;
+    QThread thread;
+    QTcpServer *server;
+    quint16 port;
+    bool listening;
+
+    // Only used in the server thread.
+    quint64 cachedSequence;
+    QByteArray cachedPrometheus;
+    QByteArray cachedJson;
+
+    friend class MetricsService;
+};
+
+MetricsServicePrivate::MetricsServicePrivate(CarbonService *carbonService):
+    carbonService {carbonService},
+    server {nullptr},
+    port {0},
+    listening {false},
+    cachedSequence {0}
+{}
+
+void MetricsServicePrivate::onNewConnection()
+{
+    while(QTcpSocket *socket = server->nextPendingConnection())
+    {
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() { onReadyRead(socket); });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+/**
+ * @brief Answers the request on \p socket.
+ *
+ * We only look at the request line, the headers don't change the answer. The
+ * connection is closed after every response.
+ */
+void MetricsServicePrivate::onReadyRead(QTcpSocket *socket)
+{
+    if(socket->state() != QAbstractSocket::ConnectedState)
+    {
+        return;
+    }
+
+    if(!socket->canReadLine())
+    {
+        if(socket->bytesAvailable() > MaxRequestLineSize)
+        {
+            socket->abort();
+        }
+
+        return;
+    }
+
+    const QByteArray line = socket->readLine(MaxRequestLineSize);
+    Utils::SelfMetrics::addNetworkBytes(line.size() + socket->readAll().size());
+
+    const QList<QByteArray> requestLine = line.trimmed().split(' ');
+
+    const QByteArray method = requestLine.value(0);
+    const QByteArray path = requestLine.value(1).split('?').value(0);
+    const bool withBody = method != "HEAD";
+
+    QByteArray response;
+
+    if(path == "/trace/start" || path == "/trace/stop")
+    {
+        // These change the state, so they are no GETs a browser might repeat.
+        if(method != "POST")
+        {
+            response = httpResponse("405 Method Not Allowed", "text/plain", "Use POST.\n", withBody);
+        }
+        else if(path == "/trace/start")
+        {
+            Log::Trace::clear();
+            Log::Trace::setEnabled(true);
+            INF("Tracing was started through the metrics endpoint.");
+
+            response = httpResponse("200 OK", "text/plain", "Tracing started.\n", withBody);
+        }
+        else
+        {
+            Log::Trace::setEnabled(false);
+            INF("Tracing was stopped through the metrics endpoint.");
+
+            response = httpResponse("200 OK", "text/plain", "Tracing stopped, the spans are at /trace.json.\n", withBody);
+        }
+    }
+    else if(method != "GET" && method != "HEAD")
+    {
+        response = httpResponse("405 Method Not Allowed", "text/plain", "Method not allowed.\n", withBody);
+    }
+    else if(path == "/metrics")
+    {
+        updateCache();
+        response = httpResponse("200 OK", Utils::MetricsFormat::PrometheusContentType, cachedPrometheus, withBody);
+    }
+    else if(path == "/metrics.json")
+    {
+        updateCache();
+        response = httpResponse("200 OK", Utils::MetricsFormat::JsonContentType, cachedJson, withBody);
+    }
+    else if(path == "/trace.json")
+    {
+        // Not cached, the spans keep coming.
+        response = httpResponse("200 OK", "application/json", Log::Trace::toChromeJson(), withBody);
+    }
+    else
+    {
+        response = httpResponse("404 Not Found", "text/plain", "Try /metrics or /metrics.json.\n", withBody);
+    }
+
+    Utils::SelfMetrics::addNetworkBytes(socket->write(response));
+    socket->disconnectFromHost();
+}
+
+/**
+ * @brief Formats the current snapshot, unless it is already formatted.
+ *
+ * The snapshot changes once per calculation, scrapes in between are served
+ * from the cache.
+ */
+void MetricsServicePrivate::updateCache()
+{
+    const CarbonSnapshot snapshot = carbonService->snapshot();
+
+    if(snapshot.sequence == cachedSequence && !cachedPrometheus.isEmpty())
+    {
+        return;
+    }
+
+    cachedSequence = snapshot.sequence;
+    cachedPrometheus = Utils::MetricsFormat::prometheus(snapshot);
+    cachedJson = Utils::MetricsFormat::json(snapshot);
+}
+
+/**
+ * @class MetricsService
+ *
+ * @brief Serves CarbonService::snapshot() over HTTP on localhost.
+ *
+ * \arg \c /metrics      Prometheus text exposition format.
+ * \arg \c /metrics.json The same values as JSON.
+ * \arg \c /trace.json   The spans recorded so far, see Log::Trace.
+ * \arg \c /trace/start  POST: forgets the spans so far and starts tracing.
+ * \arg \c /trace/stop   POST: stops tracing, the spans stay at /trace.json.
+ *
+ * The server runs in its own thread and only reads the thread safe snapshot,
+ * so scrapes never wait for or wake up the GUI thread.
+ *
+ * The endpoint is opt-in, it is only started if \c LEIF_METRICS_PORT is set
+ * to a port number. It only listens on the loopback interface.
+ */
+
+MetricsService::MetricsService(CarbonService *carbonService, QObject *parent /* = nullptr */):
+    QObject {parent},
+    d {new MetricsServicePrivate {carbonService}}
+{
+    d->port = configuredPort();
+
+    if(d->port == 0 || carbonService == nullptr)
+    {
+        DBG("Metrics endpoint is disabled.");
+        return;
+    }
+
+    d->server = new QTcpServer;
+    d->server->moveToThread(&d->thread);
+
+    connect(&d->thread, &QThread::finished, d->server, &QObject::deleteLater);
+    connect(d->server, &QTcpServer::newConnection, d->server, [this]() { d->onNewConnection(); });
+
+    d->thread.setObjectName(QStringLiteral("MetricsServer"));
+    d->thread.start(QThread::LowPriority);
+
+    QString errorString;
+    QMetaObject::invokeMethod(d->server, [&]() {
+        d->listening = d->server->listen(QHostAddress::LocalHost, d->port);
+        errorString = d->server->errorString();
+    }, Qt::BlockingQueuedConnection);
+
+    if(d->listening)
+    {
+        INF(QString("Metrics endpoint is listening on http://127.0.0.1:%1/metrics.").arg(d->port));
+    }
+    else
+    {
+        WRN(QString("Metrics endpoint could not listen on port %1: %2").arg(d->port).arg(errorString));
+    }
+}
+
+MetricsService::~MetricsService()
+{
+    if(d->thread.isRunning())
+    {
+        d->thread.quit();
+        d->thread.wait();
+    }
+}
+
+bool MetricsService::isListening() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->listening;
+}
+
+quint16 MetricsService::port() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->port;
+}
+
+/**
+ * @brief Returns the port from \c LEIF_METRICS_PORT, or 0 if it isn't set.
+ */
+/* static */
+quint16 MetricsService::configuredPort()
+{
+    bool ok {false};
+    const uint port = qEnvironmentVariable("LEIF_METRICS_PORT").toUInt(&ok);
+
+    if(!ok || port > 65535)
+    {
+        return 0;
+    }
+
+    return static_cast<quint16>(port);
+}
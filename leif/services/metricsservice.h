@@ -0,0 +1,40 @@
+/**
+ * @brief Defines the MetricsService class.
+ *
+ * The MetricsService serves the live carbon and power data of the
+ * CarbonService on a local HTTP endpoint, for Prometheus and other monitoring
+ * tools. It is off unless LEIF_METRICS_PORT is set.
+ *
+ * @sa Utils::MetricsFormat
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef METRICSSERVICE_H
+#define METRICSSERVICE_H
+
+#include <QObject>
+#include <QScopedPointer>
+
+class CarbonService;
+class MetricsServicePrivate;
+
+class MetricsService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MetricsService(CarbonService *carbonService, QObject *parent = nullptr);
+    virtual ~MetricsService();
+
+    bool isListening() const;
+    quint16 port() const;
+
+    static quint16 configuredPort();
+
+private:
+    Q_DISABLE_COPY_MOVE(MetricsService)
+    QScopedPointer<MetricsServicePrivate> d;
+};
+
+#endif // METRICSSERVICE_H
@@ -0,0 +1,309 @@
+/**
+ * @brief Implements the SchedulerService class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QTimer>
+
+#include <utility>
+
+#include "schedulerservice.h"
+#include "settingsservice.h"
+
+#include "plugin/carbonpluginmanager.h"
+#include "utils/carbonscheduler.h"
+#include "utils/clock.h"
+#include "utils/selfmetrics.h"
+
+#include "log/log.h"
+#include "log/trace.h"
+
+namespace
+{
+// Requests are a single line of JSON, anything longer is not ours.
+constexpr qint64 MaxRequestSize {4096};
+
+// The API forecasts two days ahead and updates every half hour.
+constexpr int ForecastDays {2};
+constexpr qint64 RefreshIntervalInSeconds {30 * 60};
+
+QJsonObject errorReply(const QString &errorString)
+{
+    return QJsonObject {{QStringLiteral("ok"), false}, {QStringLiteral("error"), errorString}};
+}
+
+void writeReply(QLocalSocket *socket, const QJsonObject &reply)
+{
+    Utils::SelfMetrics::addNetworkBytes(socket->write(QJsonDocument(reply).toJson(QJsonDocument::Compact) + '\n'));
+    socket->disconnectFromServer();
+}
+}
+
+class SchedulerServicePrivate
+{
+public:
+    ~SchedulerServicePrivate() = default;
+
+private:
+    SchedulerServicePrivate(SettingsService *settings);
+
+    bool needsRefresh(const QDateTime &now) const;
+
+    SettingsService *settings;
+    QLocalServer server;
+
+    CarbonData forecast;
+    QString forecastError;
+    QLocale::Country forecastCountry {QLocale::AnyCountry};
+    QString forecastRegion;
+    QDateTime fetchedAt;
+
+    // Requests that wait for the next refresh.
+    QList<QPair<QPointer<QLocalSocket>, QJsonObject>> pending;
+    bool refreshScheduled {false};
+
+    friend class SchedulerService;
+};
+
+SchedulerServicePrivate::SchedulerServicePrivate(SettingsService *settings):
+    settings {settings}
+{}
+
+/**
+ * @brief Returns true if the cached forecast is missing, older than the
+ * refresh interval or for another location than the configured one.
+ */
+bool SchedulerServicePrivate::needsRefresh(const QDateTime &now) const
+{
+    if(settings != nullptr && (settings->country() != forecastCountry || settings->regionId() != forecastRegion))
+    {
+        return true;
+    }
+
+    return !forecast.isValid || !fetchedAt.isValid() || fetchedAt.secsTo(now) >= RefreshIntervalInSeconds;
+}
+
+/**
+ * @class SchedulerService
+ *
+ * @brief Serves the local scheduling API.
+ *
+ * Clients connect to Utils::CarbonScheduler::serverName() and send one line
+ * of JSON:
+ *
+ * \code
+ * {"duration": 7200, "energy": 3.5, "deadline": "2026-10-20T08:00:00Z"}
+ * \endcode
+ *
+ * \c duration is in seconds, \c energy in kWh. \c deadline and
+ * \c earliestStart (ISO 8601) are optional. The reply is one line of JSON
+ * with \c ok and either the schedule or an \c error.
+ *
+ * Requests are answered from the cached forecast. Only if it is missing or
+ * older than half an hour, the request waits for a refresh. The refresh is
+ * done once for all waiting requests, after the socket handler returned,
+ * through CarbonPluginManager::forecast(), so it backs off like the
+ * CarbonService does.
+ */
+
+SchedulerService::SchedulerService(SettingsService *settings, QObject *parent /* = nullptr */):
+    QObject {parent},
+    d {new SchedulerServicePrivate {settings}}
+{
+    const QString name {Utils::CarbonScheduler::serverName()};
+
+    // A previous instance may have crashed and left its socket behind.
+    QLocalServer::removeServer(name);
+    d->server.setSocketOptions(QLocalServer::UserAccessOption);
+
+    if(d->server.listen(name))
+    {
+        INF(QString("Scheduler API is listening on '%1'.").arg(d->server.fullServerName()));
+    }
+    else
+    {
+        WRN(QString("Scheduler API could not listen on '%1': %2").arg(name, d->server.errorString()));
+    }
+
+    connect(&d->server, &QLocalServer::newConnection, this, &SchedulerService::onNewConnection);
+}
+
+SchedulerService::~SchedulerService()
+{
+    d->server.close();
+}
+
+bool SchedulerService::isListening() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->server.isListening();
+}
+
+/**
+ * @brief Schedules the job described by \p request.
+ *
+ * The job is scheduled with the cached forecast of the configured location,
+ * this never requests carbon data.
+ *
+ * @return The JSON reply, see the class description.
+ */
+QJsonObject SchedulerService::schedule(const QJsonObject &request)
+{
+    Q_ASSERT(d != nullptr);
+
+    const qint64 duration = request.value(QStringLiteral("duration")).toInteger(-1);
+    const double energy = request.value(QStringLiteral("energy")).toDouble(0);
+    const QDateTime now = Utils::Clock::instance()->now();
+
+    QDateTime earliestStart = QDateTime::fromString(request.value(QStringLiteral("earliestStart")).toString(), Qt::ISODate);
+    if(!earliestStart.isValid() || earliestStart < now)
+    {
+        earliestStart = now;
+    }
+
+    QDateTime deadline = QDateTime::fromString(request.value(QStringLiteral("deadline")).toString(), Qt::ISODate);
+    if(!deadline.isValid())
+    {
+        deadline = earliestStart.addDays(ForecastDays);
+    }
+
+    if(duration <= 0)
+    {
+        return errorReply(QStringLiteral("A positive duration in seconds is required."));
+    }
+
+    if(!d->forecast.isValid)
+    {
+        return errorReply(d->forecastError.isEmpty() ? QStringLiteral("No forecast available yet, try again shortly.")
+                                                     : d->forecastError);
+    }
+
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(d->forecast, earliestStart, duration, energy, deadline);
+    if(!schedule.isValid())
+    {
+        return errorReply(schedule.errorString());
+    }
+
+    INF(QString("Scheduled a %1s job at %2 (%3 g/kWh).").arg(duration).arg(schedule.start().toString(Qt::ISODate)).arg(schedule.averageIntensity()));
+
+    return QJsonObject {{QStringLiteral("ok"), true},
+                        {QStringLiteral("start"), schedule.start().toString(Qt::ISODate)},
+                        {QStringLiteral("end"), schedule.end().toString(Qt::ISODate)},
+                        {QStringLiteral("averageIntensity"), schedule.averageIntensity()},
+                        {QStringLiteral("grams"), schedule.grams()},
+                        {QStringLiteral("gramsIfStartedNow"), schedule.gramsIfStartedNow()}};
+}
+
+void SchedulerService::onNewConnection()
+{
+    Q_ASSERT(d != nullptr);
+
+    while(QLocalSocket *socket = d->server.nextPendingConnection())
+    {
+        connect(socket, &QLocalSocket::readyRead, this, [=]() { onReadyRead(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+    }
+}
+
+void SchedulerService::onReadyRead(QLocalSocket *socket)
+{
+    if(!socket->canReadLine())
+    {
+        if(socket->bytesAvailable() > MaxRequestSize)
+        {
+            socket->abort();
+        }
+
+        return;
+    }
+
+    const QByteArray line = socket->readLine(MaxRequestSize);
+    Utils::SelfMetrics::addNetworkBytes(line.size());
+
+    QJsonParseError parseError;
+    const QJsonDocument request = QJsonDocument::fromJson(line, &parseError);
+
+    if(!request.isObject())
+    {
+        writeReply(socket, errorReply(QString("Invalid request: %1").arg(parseError.errorString())));
+        return;
+    }
+
+    if(!d->needsRefresh(Utils::Clock::instance()->now()))
+    {
+        writeReply(socket, schedule(request.object()));
+        return;
+    }
+
+    // The plugin may take a while, so the refresh is not done in here.
+    d->pending.append({QPointer<QLocalSocket> {socket}, request.object()});
+
+    if(!d->refreshScheduled)
+    {
+        d->refreshScheduled = true;
+        QTimer::singleShot(0, this, &SchedulerService::refreshForecast);
+    }
+}
+
+/**
+ * @brief Refreshes the cached forecast and answers the waiting requests.
+ *
+ * If the refresh fails, a still valid cached forecast of the same location is
+ * kept.
+ */
+void SchedulerService::refreshForecast()
+{
+    TRACE_FUNCTION;
+    Q_ASSERT(d != nullptr);
+
+    d->refreshScheduled = false;
+
+    CarbonPluginManager *manager = CarbonPluginManager::Instance();
+    const QDateTime now = Utils::Clock::instance()->now();
+
+    if(manager == nullptr || !manager->isReady())
+    {
+        d->forecastError = QStringLiteral("The carbon plugins are not loaded yet.");
+    }
+    else if(d->settings == nullptr || d->settings->country() == QLocale::AnyCountry)
+    {
+        d->forecastError = QStringLiteral("No location configured.");
+    }
+    else
+    {
+        const QLocale::Country country {d->settings->country()};
+        const QString region {d->settings->regionId()};
+
+        if(country != d->forecastCountry || region != d->forecastRegion)
+        {
+            d->forecast = CarbonData {};
+            d->forecastCountry = country;
+            d->forecastRegion = region;
+        }
+
+        const CarbonData forecast = manager->forecast(country, region, now, now.addDays(ForecastDays));
+        if(forecast.isValid)
+        {
+            d->forecast = forecast;
+            d->fetchedAt = now;
+        }
+
+        d->forecastError = forecast.errorString;
+    }
+
+    const auto pending = std::exchange(d->pending, {});
+    for(const auto &[socket, request] : pending)
+    {
+        if(!socket.isNull() && socket->state() == QLocalSocket::ConnectedState)
+        {
+            writeReply(socket, schedule(request));
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * @brief Defines the SchedulerService class.
+ *
+ * The SchedulerService answers scheduling requests of local tools (e.g. the
+ * leif-schedule command line tool) with the lowest carbon start time for a
+ * job, based on the forecast for the configured location. The forecast is
+ * cached, requests never wait for the carbon plugin unless it has run out.
+ *
+ * @sa Utils::CarbonScheduler
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef SCHEDULERSERVICE_H
+#define SCHEDULERSERVICE_H
+
+#include <QJsonObject>
+#include <QObject>
+#include <QScopedPointer>
+
+QT_BEGIN_NAMESPACE
+class QLocalSocket;
+QT_END_NAMESPACE
+
+class SettingsService;
+class SchedulerServicePrivate;
+
+class SchedulerService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SchedulerService(SettingsService *settings, QObject *parent = nullptr);
+    virtual ~SchedulerService();
+
+    bool isListening() const;
+
+    QJsonObject schedule(const QJsonObject &request);
+
+private slots:
+    void onNewConnection();
+    void onReadyRead(QLocalSocket *socket);
+    void refreshForecast();
+
+private:
+    Q_DISABLE_COPY_MOVE(SchedulerService)
+    QScopedPointer<SchedulerServicePrivate> d;
+};
+
+#endif // SCHEDULERSERVICE_H
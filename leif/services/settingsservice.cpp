@@ -9,6 +9,7 @@ class LeifSettingsPrivate
     constexpr static const char* RegionKey {"REGION"};
     constexpr static const char* LifeTimeCarbonKey {"LIFECARBON"};
     constexpr static const char* AvgDischargeRateKey {"AVGDISCHARGERATE"};
+    constexpr static const char* PowerProfileKey {"POWERPROFILE"};
 
     static int toInt(const QVariant &value, int defaultValue);
     static float toFloat(const QVariant &value, float defaultValue);
@@ -79,6 +80,12 @@ void SettingsService::saveAverageDischargeRate(int averageDischargeRate)
     emit averageDischargeRateChanged(averageDischargeRate);
 }
 
+void SettingsService::savePowerProfile(const Utils::PowerProfile &profile)
+{
+    QSettings settings;
+    settings.setValue(LeifSettingsPrivate::PowerProfileKey, profile.toByteArray());
+}
+
 QLocale::Country SettingsService::country() const
 {
     QSettings settings;
@@ -101,6 +108,20 @@ int SettingsService::averageDischargeRate() const
     return settings.value(LeifSettingsPrivate::AvgDischargeRateKey).toInt();
 }
 
+Utils::PowerProfile SettingsService::powerProfile() const
+{
+    QSettings settings;
+
+    QByteArray data = settings.value(LeifSettingsPrivate::PowerProfileKey).toByteArray();
+    Utils::PowerProfile profile = Utils::PowerProfile::fromByteArray(data);
+
+    // Older versions only knew the avarage discharge rate. Take it over.
+    if(profile.isEmpty())
+        profile = Utils::PowerProfile::fromAverageDischargeRate(averageDischargeRate());
+
+    return profile;
+}
+
 void SettingsService::saveLifetimeCarbon(float lifeTime)
 {
     QSettings settings;
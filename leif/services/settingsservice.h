@@ -4,6 +4,8 @@
 #include <QLocale>
 #include <QObject>
 
+#include "utils/powerprofile.h"
+
 class SettingsService : public QObject
 {
     Q_OBJECT
@@ -15,10 +17,12 @@ public:
     void saveCountry(const QLocale::Country &country);
     void saveRegionId(const QString &regionId);
     void saveAverageDischargeRate(int averageDischargeRate);
+    void savePowerProfile(const Utils::PowerProfile &profile);
 
     QLocale::Country country() const;
     QString regionId() const;
     int averageDischargeRate() const;
+    Utils::PowerProfile powerProfile() const;
 
     void saveLifetimeCarbon(float lifeTime);
     float lifeTimeCarbon() const;
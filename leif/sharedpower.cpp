@@ -0,0 +1,62 @@
+/**
+ * @brief Implements the SharedPower class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "sharedpower.h"
+
+#include "utils/clock.h"
+#include "utils/hostcache.h"
+
+#include "log/log.h"
+
+/**
+ * @class SharedPower
+ *
+ * @brief Measures the power draw once per host instead of once per user.
+ *
+ * The instance holding the power lease measures and publishes, renewing the
+ * lease every time. The others read the published value as long as it is
+ * younger than the lease. If the leader stops measuring, the lease runs out
+ * and the next instance to ask takes over.
+ *
+ * The power draw is a value of the machine, it is the same for every user.
+ * The source is owned, the cache is not.
+ */
+
+SharedPower::SharedPower(std::unique_ptr<IPower> source, Utils::HostCache *cache):
+    _source {std::move(source)},
+    _cache {cache}
+{
+    Q_ASSERT(_source != nullptr);
+    Q_ASSERT(_cache != nullptr);
+}
+
+float SharedPower::powerDrawInWatts()
+{
+    if(_cache->leadPower())
+    {
+        const float watts = qMax(0.0f, _source->powerDrawInWatts());
+        if(!_cache->publishPower(watts))
+        {
+            WRN("Could not publish the power draw to the host cache.");
+        }
+
+        return watts;
+    }
+
+    float watts {0};
+    QDateTime sampledAt;
+
+    if(_cache->readPower(&watts, &sampledAt)
+       && sampledAt.msecsTo(Utils::Clock::instance()->now()) < _cache->leaseInMs())
+    {
+        DBG("Using the power draw of the host cache.");
+        return watts;
+    }
+
+    DBG("No recent power draw in the host cache, measuring on our own.");
+    return _source->powerDrawInWatts();
+}
@@ -0,0 +1,39 @@
+/**
+ * @brief Defines the SharedPower class.
+ *
+ * The SharedPower puts a Utils::HostCache in front of the power backend, so
+ * only one instance on a host measures the power draw of the machine.
+ *
+ * @sa Utils::HostCache, SharedDataProvider
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef SHAREDPOWER_H
+#define SHAREDPOWER_H
+
+#include <memory>
+
+#include <interfaces/IPower.h>
+
+namespace Utils {
+class HostCache;
+}
+
+class SharedPower : public IPower
+{
+public:
+    SharedPower(std::unique_ptr<IPower> source, Utils::HostCache *cache);
+    virtual ~SharedPower() = default;
+
+    virtual float powerDrawInWatts() override;
+
+private:
+    Q_DISABLE_COPY_MOVE(SharedPower)
+
+    std::unique_ptr<IPower> _source;
+    Utils::HostCache *_cache;
+};
+
+#endif // SHAREDPOWER_H
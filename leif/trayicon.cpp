@@ -37,6 +37,8 @@ private:
     QAction *totalCarbonAction;
     QAction *carbonUsageLevelAction;
     QAction *chargeForecastAction;
+    CarbonUsageLevel usageLevel;
+    bool labelsOutdated;
 
     friend class TrayIcon;
 };
@@ -47,7 +49,9 @@ TrayIconPrivate::TrayIconPrivate(TrayIconController *_controller):
     sessionCarbonAction {nullptr},
     totalCarbonAction {nullptr},
     carbonUsageLevelAction {nullptr},
-    chargeForecastAction {nullptr}
+    chargeForecastAction {nullptr},
+    usageLevel {CarbonUsageLevel::VeryHigh},
+    labelsOutdated {false}
 {}
 
 QString TrayIconPrivate::co2Unit()
@@ -250,12 +254,41 @@ void TrayIcon::onCarbonUsageLevelChanged(CarbonUsageLevel newCarbonUsageLevel)
 {
     Q_ASSERT(d != nullptr);
 
+    d->usageLevel = newCarbonUsageLevel;
     d->carbonUsageLevelAction->setText(TrayIconPrivate::intensityLabel(newCarbonUsageLevel));
 
     // Also set the icon
     setIcon(QIcon(TrayIconPrivate::iconName(newCarbonUsageLevel, TrayIconPrivate::currentContrastMode())));
 }
 
+/**
+ * @brief Shows the values of a new \p snapshot.
+ *
+ * The icon is always visible, so it changes right away, but only if the
+ * usage level did. The menu labels are only updated while the menu is open,
+ * otherwise they are refreshed the next time it is shown.
+ */
+void TrayIcon::onSnapshotChanged(const CarbonSnapshot &snapshot)
+{
+    Q_ASSERT(d != nullptr);
+
+    if(snapshot.usageLevel != d->usageLevel)
+        onCarbonUsageLevelChanged(snapshot.usageLevel);
+
+    if(contextMenu() != nullptr && contextMenu()->isVisible())
+        updateCarbonLabels();
+    else
+        d->labelsOutdated = true;
+}
+
+void TrayIcon::onMenuAboutToShow()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->labelsOutdated)
+        updateCarbonLabels();
+}
+
 void TrayIcon::onResetStatsClicked()
 {
     Q_ASSERT(d != nullptr);
@@ -307,6 +340,8 @@ void TrayIcon::setupMenu()
     d->chargeForecastAction->setDisabled(true);
     d->chargeForecastAction->setText(TrayIconPrivate::chargeForecastLabel(d->controller->chargeForecast()));
 
+    connect(menu, &QMenu::aboutToShow, this, &TrayIcon::onMenuAboutToShow);
+
     menu->addAction(tr("Preferences..."), this, [=](){d->controller->showDialog();});
     menu->addAction(tr("Reset stats"), Qt::Key_R, this, &TrayIcon::onResetStatsClicked);
 
@@ -320,9 +355,16 @@ void TrayIcon::connectModel()
 {
     Q_ASSERT(d != nullptr);
     
-    connect(d->controller, &TrayIconController::sessionCarbonChanged, this, [=](float sessionCarbon){d->sessionCarbonAction->setText(TrayIconPrivate::sessionCarbonLabel(sessionCarbon));});
-    connect(d->controller, &TrayIconController::lifetimeCarbonChanged, this, [=](float totalCarbon){d->totalCarbonAction->setText(TrayIconPrivate::totalCarbonLabel(totalCarbon));});
-    connect(d->controller, &TrayIconController::carbonUsageLevelChanged, this, &TrayIcon::onCarbonUsageLevelChanged);
-    connect(d->controller, &TrayIconController::chargeForecastChanged, this, [=](ChargeForecast newChargeForecast){d->chargeForecastAction->setText(TrayIconPrivate::chargeForecastLabel(newChargeForecast));});
+    connect(d->controller, &TrayIconController::snapshotChanged, this, &TrayIcon::onSnapshotChanged);
     connect(d->controller, &TrayIconController::configuredChanged, this, [=](){d->notConfiguredAction->setVisible(!d->controller->configured());});
 }
+
+void TrayIcon::updateCarbonLabels()
+{
+    Q_ASSERT(d != nullptr);
+
+    d->sessionCarbonAction->setText(TrayIconPrivate::sessionCarbonLabel(d->controller->sessionCarbon()));
+    d->totalCarbonAction->setText(TrayIconPrivate::totalCarbonLabel(d->controller->lifetimeCarbon()));
+    d->chargeForecastAction->setText(TrayIconPrivate::chargeForecastLabel(d->controller->chargeForecast()));
+    d->labelsOutdated = false;
+}
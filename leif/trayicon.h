@@ -4,6 +4,7 @@
 #include <QSystemTrayIcon>
 
 #include <include/carbonusagelevel.h>
+#include <include/carbonsnapshot.h>
 
 class TrayIconController;
 class TrayIconPrivate;
@@ -18,11 +19,14 @@ public:
 
 private slots:
     void onCarbonUsageLevelChanged(CarbonUsageLevel newCarbonUsageLevel);
+    void onSnapshotChanged(const CarbonSnapshot &snapshot);
+    void onMenuAboutToShow();
     void onResetStatsClicked();
     void doCheckConfigured();
 
 private:
     void setupMenu();
+    void updateCarbonLabels();
     void connectModel();
 
 private:
@@ -0,0 +1,102 @@
+/**
+ * @brief Implements the AtlasPacker class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "atlaspacker.h"
+
+/**
+ * @class Utils::AtlasPacker
+ *
+ * @brief Packs images into shelves.
+ *
+ * The images are sorted by height and placed left to right into rows
+ * (shelves) no wider than the maximum width. Flags are mostly of the same
+ * size, so this wastes next to nothing and keeps the atlas stable when a
+ * flag is added.
+ *
+ * Every image keeps \c padding transparent pixels to its neighbours, so
+ * scaled flags don't bleed into each other.
+ */
+
+/**
+ * @brief Creates a packer for atlases up to \p maximumWidth pixels wide.
+ */
+Utils::AtlasPacker::AtlasPacker(int maximumWidth /* = 256 */, int padding /* = 1 */):
+    _maximumWidth {maximumWidth},
+    _padding {qMax(0, padding)}
+{}
+
+/**
+ * @brief Places images of the given \p sizes.
+ *
+ * @return \arg \c true  All images were placed, see rects() and size().
+ *         \arg \c false An image is invalid or wider than the maximum width.
+ */
+bool Utils::AtlasPacker::pack(const QList<QSize> &sizes)
+{
+    _rects.clear();
+    _size = QSize();
+
+    QList<qsizetype> order(sizes.count());
+    std::iota(order.begin(), order.end(), 0);
+
+    // Stable, so images of the same height keep their input order.
+    std::stable_sort(order.begin(), order.end(), [&](qsizetype lhs, qsizetype rhs) {
+        return sizes.at(lhs).height() > sizes.at(rhs).height();
+    });
+
+    QList<QRect> rects(sizes.count());
+    int x {_padding};
+    int y {_padding};
+    int shelfHeight {0};
+    int width {0};
+
+    for(qsizetype index : order)
+    {
+        const QSize size = sizes.at(index);
+        if(size.isEmpty() || size.width() + 2 * _padding > _maximumWidth)
+        {
+            return false;
+        }
+
+        if(x + size.width() + _padding > _maximumWidth)
+        {
+            x = _padding;
+            y += shelfHeight + _padding;
+            shelfHeight = 0;
+        }
+
+        rects[index] = QRect(QPoint(x, y), size);
+
+        x += size.width() + _padding;
+        width = qMax(width, x);
+        shelfHeight = qMax(shelfHeight, size.height());
+    }
+
+    _rects = rects;
+    _size = sizes.isEmpty() ? QSize() : QSize(width, y + shelfHeight + _padding);
+
+    return true;
+}
+
+/**
+ * @brief Returns the place of every image, in the order they were given.
+ */
+QList<QRect> Utils::AtlasPacker::rects() const
+{
+    return _rects;
+}
+
+/**
+ * @brief Returns the size of the atlas.
+ */
+QSize Utils::AtlasPacker::size() const
+{
+    return _size;
+}
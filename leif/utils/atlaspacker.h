@@ -0,0 +1,42 @@
+/**
+ * @brief Defines the AtlasPacker class.
+ *
+ * The AtlasPacker places a number of images into one atlas image. It is used
+ * by the flagatlas build tool to pack the country flags.
+ *
+ * @sa FlagAtlas
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef ATLASPACKER_H
+#define ATLASPACKER_H
+
+#include <QList>
+#include <QRect>
+#include <QSize>
+
+namespace Utils {
+
+class AtlasPacker
+{
+public:
+    explicit AtlasPacker(int maximumWidth = 256, int padding = 1);
+    ~AtlasPacker() = default;
+
+    bool pack(const QList<QSize> &sizes);
+
+    QList<QRect> rects() const;
+    QSize size() const;
+
+private:
+    int _maximumWidth;
+    int _padding;
+    QList<QRect> _rects;
+    QSize _size;
+};
+
+}
+
+#endif // ATLASPACKER_H
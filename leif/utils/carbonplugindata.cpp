@@ -6,6 +6,7 @@
  *
  * @copyright Tim Stone 2022
  */
+#include <QDataStream>
 #include <QJsonObject>
 #include <QJsonArray>
 
@@ -248,3 +249,33 @@ Utils::CarbonPluginData Utils::CarbonPluginData::fromJson(const QJsonValue &json
 
     return CarbonPluginData {name, description, territories};
 }
+
+namespace Utils {
+
+/**
+ * @brief Writes the plugin \p data to \p stream.
+ *
+ * \sa PluginMetadataCache
+ *
+ * @param stream The data stream.
+ * @param data The plugin data to write.
+ * @return The \p stream.
+ */
+QDataStream &operator<<(QDataStream &stream, const CarbonPluginData &data)
+{
+    return stream << data._name << data._description << data._territories;
+}
+
+/**
+ * @brief Reads the plugin \p data from \p stream.
+ *
+ * @param stream The data stream.
+ * @param data The plugin data to read into.
+ * @return The \p stream.
+ */
+QDataStream &operator>>(QDataStream &stream, CarbonPluginData &data)
+{
+    return stream >> data._name >> data._description >> data._territories;
+}
+
+}
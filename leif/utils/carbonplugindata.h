@@ -44,6 +44,9 @@ private:
     QString _name;
     QString _description;
     QList<Territory> _territories;
+
+    friend QDataStream &operator<<(QDataStream &stream, const CarbonPluginData &data);
+    friend QDataStream &operator>>(QDataStream &stream, CarbonPluginData &data);
 };
 }
 
@@ -0,0 +1,276 @@
+/**
+ * @brief Implements the CarbonSchedule and CarbonScheduler classes.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QtGlobal>
+
+#include "carbonscheduler.h"
+
+/**
+ * @class Utils::CarbonSchedule
+ *
+ * @brief The result of CarbonScheduler::findWindow().
+ *
+ * If the job couldn't be scheduled, isValid() is \c false and errorString()
+ * tells why.
+ */
+
+Utils::CarbonSchedule::CarbonSchedule():
+    _isValid {false},
+    _averageIntensity {-1},
+    _grams {-1},
+    _gramsIfStartedNow {-1}
+{}
+
+bool Utils::CarbonSchedule::isValid() const
+{
+    return _isValid;
+}
+
+QString Utils::CarbonSchedule::errorString() const
+{
+    return _errorString;
+}
+
+/**
+ * @brief Returns when the job should start.
+ */
+QDateTime Utils::CarbonSchedule::start() const
+{
+    return _start;
+}
+
+/**
+ * @brief Returns when the job will be done, if started at start().
+ */
+QDateTime Utils::CarbonSchedule::end() const
+{
+    return _end;
+}
+
+/**
+ * @brief Returns the average carbon intensity while the job runs.
+ *
+ * @return The intensity in grams of CO2 per kWh.
+ */
+double Utils::CarbonSchedule::averageIntensity() const
+{
+    return _averageIntensity;
+}
+
+/**
+ * @brief Returns the grams of CO2 the job emits, if started at start().
+ */
+double Utils::CarbonSchedule::grams() const
+{
+    return _grams;
+}
+
+/**
+ * @brief Returns the grams of CO2 the job would emit if started right away.
+ *
+ * This is what the scheduling saves compared to grams().
+ */
+double Utils::CarbonSchedule::gramsIfStartedNow() const
+{
+    return _gramsIfStartedNow;
+}
+
+/* static */
+Utils::CarbonSchedule Utils::CarbonSchedule::error(const QString &errorString)
+{
+    CarbonSchedule schedule;
+    schedule._errorString = errorString;
+
+    return schedule;
+}
+
+/**
+ * @class Utils::CarbonScheduler
+ *
+ * @brief Finds the lowest carbon window in a forecast.
+ *
+ * The forecast is a step function, one intensity per forecast interval. The
+ * carbon of a job starting at \c s is the integral of that function over
+ * <tt>[s, s + duration]</tt>. With prefix sums over the series every such
+ * integral costs O(1).
+ *
+ * The integral changes linearly while neither end of the window crosses a
+ * slot boundary, so the minimum is at a start where one of them does. There
+ * are at most two such starts per slot, which makes the search O(n) in the
+ * length of the forecast.
+ */
+
+/**
+ * @brief Returns the lowest carbon start for a job.
+ *
+ * @param forecast The carbon forecast, see CarbonData::forecast.
+ * @param earliestStart The job can't start before this, usually now.
+ * @param durationInSeconds How long the job runs.
+ * @param energyInKiloWattHours The energy the job uses, for the grams.
+ * @param deadline The job has to be done by then. If invalid, the end of the
+ *        forecast is the deadline.
+ * @return The schedule, invalid if the job doesn't fit into the forecast.
+ */
+/* static */
+Utils::CarbonSchedule Utils::CarbonScheduler::findWindow(const CarbonData &forecast,
+                                                         const QDateTime &earliestStart,
+                                                         qint64 durationInSeconds,
+                                                         double energyInKiloWattHours,
+                                                         const QDateTime &deadline)
+{
+    const QList<int> series = forecastSeries(forecast);
+    const qint64 interval = forecastInterval(forecast);
+
+    if(!forecast.isValid || series.isEmpty() || interval <= 0)
+    {
+        return CarbonSchedule::error(QStringLiteral("No carbon forecast available."));
+    }
+
+    if(durationInSeconds <= 0)
+    {
+        return CarbonSchedule::error(QStringLiteral("The job duration must be positive."));
+    }
+
+    // All times are offsets in seconds from the start of the forecast.
+    const qint64 slotCount = series.count();
+    const qint64 earliest = qMax<qint64>(0, forecast.validFrom.secsTo(earliestStart));
+
+    qint64 latestEnd = slotCount * interval;
+    if(deadline.isValid())
+    {
+        latestEnd = qMin(latestEnd, forecast.validFrom.secsTo(deadline));
+    }
+
+    const qint64 latestStart = latestEnd - durationInSeconds;
+    if(latestStart < earliest)
+    {
+        return CarbonSchedule::error(QString("The job doesn't fit between %1 and %2.")
+                                     .arg(forecast.validFrom.addSecs(earliest).toString(Qt::ISODate),
+                                          forecast.validFrom.addSecs(latestEnd).toString(Qt::ISODate)));
+    }
+
+    QList<double> prefix(slotCount + 1, 0.0);
+    for(qint64 i = 0; i < slotCount; ++i)
+    {
+        prefix[i + 1] = prefix[i] + double(series.at(i)) * interval;
+    }
+
+    const auto integral = [&](qint64 offset) {
+        const qint64 slot = offset / interval;
+        if(slot >= slotCount)
+        {
+            return prefix[slotCount];
+        }
+
+        return prefix[slot] + double(series.at(slot)) * (offset - slot * interval);
+    };
+
+    const auto average = [&](qint64 start) {
+        return (integral(start + durationInSeconds) - integral(start)) / durationInSeconds;
+    };
+
+    qint64 bestStart = earliest;
+    double bestAverage = average(earliest);
+
+    const auto consider = [&](qint64 start) {
+        if(start < earliest || start > latestStart)
+        {
+            return;
+        }
+
+        const double candidate = average(start);
+
+        // On a tie the earlier start wins.
+        if(candidate < bestAverage - 1e-9 || (qAbs(candidate - bestAverage) <= 1e-9 && start < bestStart))
+        {
+            bestAverage = candidate;
+            bestStart = start;
+        }
+    };
+
+    consider(latestStart);
+    for(qint64 boundary = 0; boundary <= slotCount * interval; boundary += interval)
+    {
+        consider(boundary);
+        consider(boundary - durationInSeconds);
+    }
+
+    CarbonSchedule schedule;
+    schedule._isValid = true;
+    schedule._start = forecast.validFrom.addSecs(bestStart);
+    schedule._end = schedule._start.addSecs(durationInSeconds);
+    schedule._averageIntensity = bestAverage;
+    schedule._grams = bestAverage * energyInKiloWattHours;
+    schedule._gramsIfStartedNow = average(earliest) * energyInKiloWattHours;
+
+    return schedule;
+}
+
+/**
+ * @brief Returns the usable forecast series of \p forecast.
+ *
+ * Plugins without a series only provide the now, next and later values. The
+ * series ends at the first unknown (negative) value.
+ */
+/* static */
+QList<int> Utils::CarbonScheduler::forecastSeries(const CarbonData &forecast)
+{
+    const QList<int> values = !forecast.forecast.isEmpty()
+                              ? forecast.forecast
+                              : QList<int> {forecast.co2PerkWhNow, forecast.co2PerkWhNext, forecast.co2PerkWhLater};
+
+    QList<int> series;
+    for(int value : values)
+    {
+        if(value < 0)
+        {
+            break;
+        }
+
+        series << value;
+    }
+
+    return series;
+}
+
+/**
+ * @brief Returns the length of one forecast value in seconds.
+ *
+ * Falls back to the validity period if the plugin didn't set an interval.
+ */
+/* static */
+int Utils::CarbonScheduler::forecastInterval(const CarbonData &forecast)
+{
+    if(forecast.forecastIntervalInSeconds > 0)
+    {
+        return forecast.forecastIntervalInSeconds;
+    }
+
+    if(!forecast.validFrom.isValid() || !forecast.validTo.isValid())
+    {
+        return 0;
+    }
+
+    return static_cast<int>(forecast.validFrom.secsTo(forecast.validTo));
+}
+
+/**
+ * @brief Returns the local server name of the scheduler API.
+ *
+ * The name contains the user name, every user has their own tray application.
+ */
+/* static */
+QString Utils::CarbonScheduler::serverName()
+{
+    QString user = qEnvironmentVariable("USER");
+    if(user.isEmpty())
+    {
+        user = qEnvironmentVariable("USERNAME");
+    }
+
+    return QStringLiteral("leif-scheduler-") + user;
+}
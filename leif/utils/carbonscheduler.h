@@ -0,0 +1,70 @@
+/**
+ * @brief Defines the CarbonSchedule and CarbonScheduler classes.
+ *
+ * The CarbonScheduler finds the start time with the lowest carbon intensity
+ * for a job of a known duration and energy that has to be done by a deadline.
+ * The result is a CarbonSchedule.
+ *
+ * @sa SchedulerService
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef CARBONSCHEDULER_H
+#define CARBONSCHEDULER_H
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+#include <carbondata.h>
+
+namespace Utils {
+
+class CarbonSchedule
+{
+public:
+    CarbonSchedule();
+    ~CarbonSchedule() = default;
+
+    bool isValid() const;
+    QString errorString() const;
+
+    QDateTime start() const;
+    QDateTime end() const;
+    double averageIntensity() const;
+    double grams() const;
+    double gramsIfStartedNow() const;
+
+    static CarbonSchedule error(const QString &errorString);
+
+private:
+    bool _isValid;
+    QString _errorString;
+    QDateTime _start;
+    QDateTime _end;
+    double _averageIntensity;
+    double _grams;
+    double _gramsIfStartedNow;
+
+    friend class CarbonScheduler;
+};
+
+class CarbonScheduler
+{
+public:
+    static CarbonSchedule findWindow(const CarbonData &forecast,
+                                     const QDateTime &earliestStart,
+                                     qint64 durationInSeconds,
+                                     double energyInKiloWattHours,
+                                     const QDateTime &deadline);
+
+    static QList<int> forecastSeries(const CarbonData &forecast);
+    static int forecastInterval(const CarbonData &forecast);
+    static QString serverName();
+};
+
+}
+
+#endif // CARBONSCHEDULER_H
@@ -0,0 +1,220 @@
+/**
+ * @brief Implements the Clock and SimulatedClock classes.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QTimer>
+
+#include <atomic>
+
+#include "clock.h"
+
+namespace
+{
+std::atomic<Utils::Clock*> installedClock {nullptr};
+}
+
+/**
+ * @class Utils::Clock
+ *
+ * @brief The system clock.
+ *
+ * Code that needs the time or a periodic timer asks Clock::instance()
+ * instead of QDateTime and QTimer, so a replay or a test can swap the clock.
+ */
+
+/**
+ * @brief Returns the current local time.
+ */
+QDateTime Utils::Clock::now() const
+{
+    return QDateTime::currentDateTime();
+}
+
+/**
+ * @brief Calls \p callback every \p intervalInMs milliseconds.
+ *
+ * The timer lives as long as the \p context object and the callback runs in
+ * its thread.
+ */
+void Utils::Clock::repeat(int intervalInMs, QObject *context, std::function<void()> callback)
+{
+    Q_ASSERT(context != nullptr);
+
+    QTimer *timer = new QTimer(context);
+    timer->setInterval(intervalInMs);
+    timer->setSingleShot(false);
+    QObject::connect(timer, &QTimer::timeout, context, callback);
+    timer->start();
+}
+
+/**
+ * @brief Returns the installed clock, or the system clock if there is none.
+ */
+/* static */
+Utils::Clock *Utils::Clock::instance()
+{
+    static Clock systemClock;
+
+    Clock *clock = installedClock.load(std::memory_order_acquire);
+    return clock != nullptr ? clock : &systemClock;
+}
+
+/**
+ * @brief Installs \p clock for everybody, \c nullptr restores the system clock.
+ *
+ * Install the clock before creating the services, their timers are set up
+ * in the constructors. The caller keeps the ownership.
+ */
+/* static */
+void Utils::Clock::setInstance(Clock *clock)
+{
+    installedClock.store(clock, std::memory_order_release);
+}
+
+/**
+ * @class Utils::SimulatedClock
+ *
+ * @brief A clock that only moves when told so.
+ *
+ * advance() and runUntil() move the time forward and call every timer that
+ * becomes due on the way, in the order of their due times. While a callback
+ * runs, now() is its due time. No event loop is needed, a day of one minute
+ * timers takes a few milliseconds.
+ *
+ * now() may be called from any thread, the timers only run in the thread
+ * that advances the clock.
+ */
+
+/**
+ * @brief Creates a simulated clock standing at \p start.
+ */
+Utils::SimulatedClock::SimulatedClock(const QDateTime &start):
+    _now {start.toMSecsSinceEpoch()},
+    _nextId {0},
+    _fired {0}
+{}
+
+Utils::SimulatedClock::~SimulatedClock()
+{
+    if(Clock::instance() == this)
+    {
+        Clock::setInstance(nullptr);
+    }
+}
+
+QDateTime Utils::SimulatedClock::now() const
+{
+    QMutexLocker locker(&_mutex);
+    return QDateTime::fromMSecsSinceEpoch(_now);
+}
+
+/**
+ * @brief Calls \p callback every \p intervalInMs simulated milliseconds.
+ *
+ * Like the system clock the timer is dropped with its \p context.
+ */
+void Utils::SimulatedClock::repeat(int intervalInMs, QObject *context, std::function<void()> callback)
+{
+    Q_ASSERT(context != nullptr);
+    Q_ASSERT(intervalInMs > 0);
+
+    QMutexLocker locker(&_mutex);
+    _timers.append(Timer {_nextId++, qMax(1, intervalInMs), _now + qMax(1, intervalInMs), context, std::move(callback)});
+}
+
+/**
+ * @brief Moves the clock \p milliSeconds forward.
+ */
+void Utils::SimulatedClock::advance(qint64 milliSeconds)
+{
+    runUntil(now().addMSecs(qMax<qint64>(0, milliSeconds)));
+}
+
+/**
+ * @brief Moves the clock forward to \p end, running all timers due until then.
+ */
+void Utils::SimulatedClock::runUntil(const QDateTime &end)
+{
+    const qint64 until = end.toMSecsSinceEpoch();
+
+    forever
+    {
+        std::function<void()> callback;
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            const qsizetype index = nextTimer(until);
+            if(index < 0)
+            {
+                _now = qMax(_now, until);
+                return;
+            }
+
+            Timer &timer = _timers[index];
+            _now = timer.due;
+            timer.due += timer.intervalInMs;
+            callback = timer.callback;
+            ++_fired;
+        }
+
+        // Without the lock, the callback may ask for the time or add timers.
+        callback();
+    }
+}
+
+/**
+ * @brief Returns the number of live timers.
+ */
+qsizetype Utils::SimulatedClock::timerCount() const
+{
+    QMutexLocker locker(&_mutex);
+
+    qsizetype count {0};
+    for(const Timer &timer : _timers)
+    {
+        if(!timer.context.isNull())
+            ++count;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns how often timers fired since the clock was created.
+ */
+quint64 Utils::SimulatedClock::firedCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _fired;
+}
+
+/**
+ * @brief Returns the index of the next timer due until \p until, or -1.
+ *
+ * Timers due at the same time fire in the order they were added. Timers of
+ * destroyed contexts are removed on the way.
+ */
+qsizetype Utils::SimulatedClock::nextTimer(qint64 until)
+{
+    _timers.removeIf([](const Timer &timer) { return timer.context.isNull(); });
+
+    qsizetype next {-1};
+    for(qsizetype i = 0; i < _timers.count(); ++i)
+    {
+        const Timer &timer = _timers.at(i);
+        if(timer.due > until)
+            continue;
+
+        if(next < 0 || timer.due < _timers.at(next).due ||
+           (timer.due == _timers.at(next).due && timer.id < _timers.at(next).id))
+        {
+            next = i;
+        }
+    }
+
+    return next;
+}
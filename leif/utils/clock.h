@@ -0,0 +1,79 @@
+/**
+ * @brief Defines the Clock and SimulatedClock classes.
+ *
+ * The Clock tells the time and runs the periodic timers of the services. The
+ * default clock is the system clock with real QTimers. A SimulatedClock can
+ * be installed instead, to run days of recorded data in milliseconds.
+ *
+ * @sa CarbonService, PowerInfoBase
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <QDateTime>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
+
+#include <functional>
+
+namespace Utils {
+
+class Clock
+{
+public:
+    Clock() = default;
+    virtual ~Clock() = default;
+
+    virtual QDateTime now() const;
+    virtual void repeat(int intervalInMs, QObject *context, std::function<void()> callback);
+
+    static Clock *instance();
+    static void setInstance(Clock *clock);
+
+private:
+    Q_DISABLE_COPY_MOVE(Clock)
+};
+
+class SimulatedClock : public Clock
+{
+public:
+    explicit SimulatedClock(const QDateTime &start);
+    virtual ~SimulatedClock();
+
+    virtual QDateTime now() const override;
+    virtual void repeat(int intervalInMs, QObject *context, std::function<void()> callback) override;
+
+    void advance(qint64 milliSeconds);
+    void runUntil(const QDateTime &end);
+
+    qsizetype timerCount() const;
+    quint64 firedCount() const;
+
+private:
+    struct Timer
+    {
+        quint64 id;
+        qint64 intervalInMs;
+        qint64 due;
+        QPointer<QObject> context;
+        std::function<void()> callback;
+    };
+
+    qsizetype nextTimer(qint64 until);
+
+private:
+    mutable QMutex _mutex;
+    qint64 _now;
+    QList<Timer> _timers;
+    quint64 _nextId;
+    quint64 _fired;
+};
+
+}
+
+#endif // CLOCK_H
@@ -0,0 +1,81 @@
+/**
+ * @brief Implements the FlagAtlas class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "flagatlas.h"
+#include "flagatlasdata.h"
+
+#include "log/log.h"
+
+/**
+ * @class Utils::FlagAtlas
+ *
+ * @brief Gives access to the flag atlas generated at build time.
+ *
+ * The atlas is decoded once, on first use. Flags are looked up by their code,
+ * which is the file name of the flag image, e.g. the QLocale::Country number.
+ * Unknown codes get the flag of FallbackCode.
+ *
+ * All methods are thread safe, the image provider is called from the QML
+ * image loader thread.
+ */
+
+Utils::FlagAtlas::FlagAtlas()
+{
+    if(!_image.loadFromData(FlagAtlasData::png, FlagAtlasData::pngSize, "PNG"))
+    {
+        ERR("Could not decode the flag atlas.");
+    }
+
+    _rects.reserve(FlagAtlasData::entryCount);
+    for(int i = 0; i < FlagAtlasData::entryCount; ++i)
+    {
+        const FlagAtlasData::Entry &entry = FlagAtlasData::entries[i];
+        _rects.insert(QString::fromUtf8(entry.code), QRect(entry.x, entry.y, entry.width, entry.height));
+    }
+}
+
+/* static */
+const Utils::FlagAtlas &Utils::FlagAtlas::instance()
+{
+    static const FlagAtlas atlas;
+
+    return atlas;
+}
+
+/**
+ * @brief Returns the atlas with all flags.
+ */
+/* static */
+QImage Utils::FlagAtlas::image()
+{
+    return instance()._image;
+}
+
+/* static */
+QSize Utils::FlagAtlas::size()
+{
+    return instance()._image.size();
+}
+
+/* static */
+bool Utils::FlagAtlas::contains(const QString &code)
+{
+    return instance()._rects.contains(code);
+}
+
+/**
+ * @brief Returns where the flag of \p code is in the atlas.
+ *
+ * If there is no flag for \p code, the fallback flag is returned.
+ */
+/* static */
+QRect Utils::FlagAtlas::rect(const QString &code)
+{
+    const FlagAtlas &atlas = instance();
+
+    return atlas._rects.value(code, atlas._rects.value(QString::fromLatin1(FallbackCode)));
+}
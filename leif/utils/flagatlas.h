@@ -0,0 +1,49 @@
+/**
+ * @brief Defines the FlagAtlas class.
+ *
+ * The FlagAtlas holds all country flags in a single image. QML shows a flag
+ * by clipping the atlas, see FlagImage.qml, so the country list decodes and
+ * uploads one texture instead of one per flag.
+ *
+ * @sa FlagImageProvider
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FLAGATLAS_H
+#define FLAGATLAS_H
+
+#include <QHash>
+#include <QImage>
+#include <QRect>
+#include <QString>
+
+namespace Utils {
+
+class FlagAtlas
+{
+public:
+    static QImage image();
+    static QSize size();
+    static bool contains(const QString &code);
+    static QRect rect(const QString &code);
+
+    static constexpr const char *FallbackCode {"undefined"};
+
+private:
+    FlagAtlas();
+    ~FlagAtlas() = default;
+
+    static const FlagAtlas &instance();
+
+private:
+    Q_DISABLE_COPY_MOVE(FlagAtlas)
+
+    QImage _image;
+    QHash<QString, QRect> _rects;
+};
+
+}
+
+#endif // FLAGATLAS_H
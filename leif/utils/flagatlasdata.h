@@ -0,0 +1,34 @@
+/**
+ * @brief Declares the flag atlas data.
+ *
+ * The data is generated at build time by the flagatlas tool from the images
+ * in img/flags, see pri/flagatlas.pri.
+ *
+ * @sa Utils::FlagAtlas
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FLAGATLASDATA_H
+#define FLAGATLASDATA_H
+
+namespace FlagAtlasData
+{
+struct Entry
+{
+    const char *code;
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+extern const unsigned char png[];
+extern const int pngSize;
+
+extern const Entry entries[];
+extern const int entryCount;
+}
+
+#endif // FLAGATLASDATA_H
@@ -0,0 +1,43 @@
+/**
+ * @brief Implements the FlagImageProvider class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include "flagatlas.h"
+#include "flagimageprovider.h"
+
+/**
+ * @class Utils::FlagImageProvider
+ *
+ * @brief Serves the flag atlas and the flags in it.
+ *
+ * Lists should show flags with FlagImage.qml, which clips the whole atlas.
+ * All of them share the one texture of \c image://flags/atlas. Single flags
+ * are cut out of the decoded atlas, for places where a plain image source is
+ * needed, e.g. an icon.
+ */
+
+Utils::FlagImageProvider::FlagImageProvider():
+    QQuickImageProvider {QQuickImageProvider::Image}
+{}
+
+QImage Utils::FlagImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    const QImage image = id == QLatin1String(AtlasId)
+                         ? FlagAtlas::image()
+                         : FlagAtlas::image().copy(FlagAtlas::rect(id));
+
+    if(size != nullptr)
+    {
+        *size = image.size();
+    }
+
+    if(requestedSize.isValid() && requestedSize != image.size())
+    {
+        return image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return image;
+}
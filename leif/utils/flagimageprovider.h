@@ -0,0 +1,33 @@
+/**
+ * @brief Defines the FlagImageProvider class.
+ *
+ * The FlagImageProvider serves the flag atlas to QML as
+ * \c image://flags/atlas and single flags as \c image://flags/<code>.
+ *
+ * @sa Utils::FlagAtlas
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FLAGIMAGEPROVIDER_H
+#define FLAGIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+namespace Utils {
+
+class FlagImageProvider : public QQuickImageProvider
+{
+public:
+    FlagImageProvider();
+    virtual ~FlagImageProvider() = default;
+
+    virtual QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+    static constexpr const char *AtlasId {"atlas"};
+};
+
+}
+
+#endif // FLAGIMAGEPROVIDER_H
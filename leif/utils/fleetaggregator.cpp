@@ -0,0 +1,326 @@
+/**
+ * @brief Implements the FleetAggregator class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QLocale>
+
+#include <cstring>
+
+#include "fleetaggregator.h"
+
+namespace
+{
+/*
+ * FNV-1a over the country and the region bytes. 0 marks a free slot.
+ */
+quint64 keyOf(const Utils::FleetReport::Sample &sample)
+{
+    quint64 hash {14695981039346656037ull};
+
+    const auto mix = [&hash](unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+
+    mix(static_cast<unsigned char>(sample.country & 0xff));
+    mix(static_cast<unsigned char>(sample.country >> 8));
+
+    for(const char c : sample.region)
+    {
+        mix(static_cast<unsigned char>(c));
+    }
+
+    return hash != 0 ? hash : 1;
+}
+
+int roundUpToPowerOfTwo(int value)
+{
+    int result {1};
+    while(result < value)
+    {
+        result <<= 1;
+    }
+
+    return result;
+}
+}
+
+/*
+ * The name is written once by the thread that claimed the slot, the counters
+ * may be added to before it is ready.
+ */
+struct Utils::FleetAggregator::Slot
+{
+    std::atomic<quint64> key {0};
+    std::atomic<bool> ready {false};
+    quint16 country {0};
+    char region[FleetReport::RegionSize] {};
+
+    std::atomic<quint64> samples {0};
+    std::atomic<quint64> energyInMilliWattHours {0};
+    std::atomic<quint64> carbonInMilligrams {0};
+    std::atomic<quint64> co2Sum {0};
+};
+
+double Utils::FleetAggregator::Rollup::averageCo2PerkWh() const
+{
+    return samples > 0 ? static_cast<double>(co2Sum) / static_cast<double>(samples) : 0.0;
+}
+
+/**
+ * @class Utils::FleetAggregator
+ *
+ * @brief Lock free counters per country and region.
+ *
+ * The regions live in an open addressing table of twice \p capacity slots,
+ * rounded up to a power of two. A new region claims a free slot with a
+ * compare and swap of its key, after that every sample is four relaxed
+ * additions. At most \p capacity regions are kept, samples of further
+ * regions are dropped and counted. As the table is never more than half
+ * full, looking up an unknown region ends at the next free slot.
+ *
+ * takeRollups() swaps the counters for zero one by one. A sample added at
+ * the same moment may be split between two rollups, the totals stay right.
+ *
+ * Regions are told apart by a 64 bit hash, a collision would merge two
+ * regions.
+ */
+
+Utils::FleetAggregator::FleetAggregator(int capacity /* = DefaultCapacity */):
+    _slots {new Slot[static_cast<size_t>(roundUpToPowerOfTwo(2 * qMax(capacity, 1)))]},
+    _mask {static_cast<quint64>(roundUpToPowerOfTwo(2 * qMax(capacity, 1)) - 1)},
+    _capacity {qMax(capacity, 1)},
+    _reports {0},
+    _malformed {0},
+    _dropped {0},
+    _regions {0}
+{}
+
+Utils::FleetAggregator::~FleetAggregator() = default;
+
+/**
+ * @brief Adds \p sample to the counters of its region.
+ *
+ * Thread safe and lock free.
+ *
+ * @return \arg \c true  The sample was counted.
+ *         \arg \c false The table is full, the sample was dropped.
+ */
+bool Utils::FleetAggregator::add(const FleetReport::Sample &sample)
+{
+    Slot *slot = find(sample);
+    if(slot == nullptr)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    slot->samples.fetch_add(1, std::memory_order_relaxed);
+    slot->energyInMilliWattHours.fetch_add(sample.energyInMilliWattHours, std::memory_order_relaxed);
+    slot->carbonInMilligrams.fetch_add(sample.carbonInMilligrams, std::memory_order_relaxed);
+    slot->co2Sum.fetch_add(sample.co2PerkWh, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Decodes the datagram \p data of \p size bytes and adds its samples.
+ *
+ * A report with an invalid region id in any sample is not counted at all.
+ *
+ * @return The number of samples counted, or -1 if it is not a valid report.
+ */
+int Utils::FleetAggregator::addReport(const char *data, qint64 size)
+{
+    FleetReport::Header header;
+    if(!FleetReport::decodeHeader(data, size, &header))
+    {
+        _malformed.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    FleetReport::Sample samples[FleetReport::MaxSamples];
+    for(int i = 0; i < header.sampleCount; ++i)
+    {
+        samples[i] = FleetReport::decodeSample(data, i);
+        if(!samples[i].hasValidRegionId())
+        {
+            _malformed.fetch_add(1, std::memory_order_relaxed);
+            return -1;
+        }
+    }
+
+    _reports.fetch_add(1, std::memory_order_relaxed);
+
+    int added {0};
+    for(int i = 0; i < header.sampleCount; ++i)
+    {
+        if(add(samples[i]))
+        {
+            ++added;
+        }
+    }
+
+    return added;
+}
+
+/**
+ * @brief Returns the counters of every region with samples since the last
+ * call and resets them.
+ */
+QList<Utils::FleetAggregator::Rollup> Utils::FleetAggregator::takeRollups()
+{
+    QList<Rollup> rollups;
+
+    for(quint64 i = 0; i <= _mask; ++i)
+    {
+        Slot &slot = _slots[i];
+        if(!slot.ready.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        Rollup rollup;
+        rollup.samples = slot.samples.exchange(0, std::memory_order_relaxed);
+        if(rollup.samples == 0)
+        {
+            continue;
+        }
+
+        rollup.country = slot.country;
+        rollup.region = QString::fromUtf8(slot.region, qstrnlen(slot.region, FleetReport::RegionSize));
+        rollup.energyInMilliWattHours = slot.energyInMilliWattHours.exchange(0, std::memory_order_relaxed);
+        rollup.carbonInMilligrams = slot.carbonInMilligrams.exchange(0, std::memory_order_relaxed);
+        rollup.co2Sum = slot.co2Sum.exchange(0, std::memory_order_relaxed);
+
+        rollups << rollup;
+    }
+
+    return rollups;
+}
+
+quint64 Utils::FleetAggregator::reportCount() const
+{
+    return _reports.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the number of datagrams that were not valid reports.
+ */
+quint64 Utils::FleetAggregator::malformedCount() const
+{
+    return _malformed.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the number of samples dropped because the table was full.
+ */
+quint64 Utils::FleetAggregator::droppedCount() const
+{
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+int Utils::FleetAggregator::regionCount() const
+{
+    return _regions.load(std::memory_order_relaxed);
+}
+
+/* static */
+QByteArray Utils::FleetAggregator::csvHeader()
+{
+    return QByteArrayLiteral("time,country,region,samples,energy_wh,carbon_g,avg_gco2_per_kwh\n");
+}
+
+/**
+ * @brief Returns one CSV line per rollup, see csvHeader().
+ */
+/* static */
+QByteArray Utils::FleetAggregator::toCsv(const QDateTime &time, const QList<Rollup> &rollups)
+{
+    const QByteArray timestamp = time.toUTC().toString(Qt::ISODate).toUtf8();
+
+    QByteArray csv;
+    csv.reserve(rollups.count() * 64);
+
+    for(const Rollup &rollup : rollups)
+    {
+        const QString country = QLocale::territoryToCode(static_cast<QLocale::Territory>(rollup.country));
+
+        csv += timestamp + ',' + country.toUtf8() + ',' + rollup.region.toUtf8() + ','
+             + QByteArray::number(rollup.samples) + ','
+             + QByteArray::number(static_cast<double>(rollup.energyInMilliWattHours) / 1000.0, 'f', 3) + ','
+             + QByteArray::number(static_cast<double>(rollup.carbonInMilligrams) / 1000.0, 'f', 3) + ','
+             + QByteArray::number(rollup.averageCo2PerkWh(), 'f', 1) + '\n';
+    }
+
+    return csv;
+}
+
+/**
+ * @brief Returns the slot of the region of \p sample, claiming a free one if
+ * needed, or \c nullptr if the table is full.
+ */
+Utils::FleetAggregator::Slot *Utils::FleetAggregator::find(const FleetReport::Sample &sample)
+{
+    const quint64 key = keyOf(sample);
+
+    for(quint64 probe = 0; probe <= _mask; ++probe)
+    {
+        Slot &slot = _slots[(key + probe) & _mask];
+
+        quint64 slotKey = slot.key.load(std::memory_order_acquire);
+        if(slotKey == key)
+        {
+            return &slot;
+        }
+
+        if(slotKey == 0)
+        {
+            // A new region, unless the table is full.
+            if(!reserveRegion())
+            {
+                return nullptr;
+            }
+
+            if(slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel))
+            {
+                slot.country = sample.country;
+                std::memcpy(slot.region, sample.region, FleetReport::RegionSize);
+                slot.ready.store(true, std::memory_order_release);
+
+                return &slot;
+            }
+
+            _regions.fetch_sub(1, std::memory_order_relaxed);
+
+            // Someone else was faster, maybe with the same region.
+            if(slotKey == key)
+            {
+                return &slot;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Counts a new region, unless there are capacity regions already.
+ */
+bool Utils::FleetAggregator::reserveRegion()
+{
+    int regions = _regions.load(std::memory_order_relaxed);
+
+    do
+    {
+        if(regions >= _capacity)
+        {
+            return false;
+        }
+    }
+    while(!_regions.compare_exchange_weak(regions, regions + 1, std::memory_order_relaxed));
+
+    return true;
+}
@@ -0,0 +1,82 @@
+/**
+ * @brief Defines the FleetAggregator class.
+ *
+ * The FleetAggregator sums up the samples of the fleet reports per country
+ * and region. Adding is lock free, the collector receives on one thread and
+ * writes the rollups on another.
+ *
+ * @sa Utils::FleetReport
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FLEETAGGREGATOR_H
+#define FLEETAGGREGATOR_H
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+#include "fleetreport.h"
+
+namespace Utils {
+
+class FleetAggregator
+{
+public:
+    struct Rollup
+    {
+        quint16 country {0};
+        QString region;
+        quint64 samples {0};
+        quint64 energyInMilliWattHours {0};
+        quint64 carbonInMilligrams {0};
+        quint64 co2Sum {0};
+
+        double averageCo2PerkWh() const;
+    };
+
+    explicit FleetAggregator(int capacity = DefaultCapacity);
+    ~FleetAggregator();
+
+    bool add(const FleetReport::Sample &sample);
+    int addReport(const char *data, qint64 size);
+
+    QList<Rollup> takeRollups();
+
+    quint64 reportCount() const;
+    quint64 malformedCount() const;
+    quint64 droppedCount() const;
+    int regionCount() const;
+
+    static QByteArray csvHeader();
+    static QByteArray toCsv(const QDateTime &time, const QList<Rollup> &rollups);
+
+    static constexpr int DefaultCapacity {4096};
+
+private:
+    struct Slot;
+
+    Slot *find(const FleetReport::Sample &sample);
+    bool reserveRegion();
+
+private:
+    Q_DISABLE_COPY_MOVE(FleetAggregator)
+
+    std::unique_ptr<Slot[]> _slots;
+    const quint64 _mask;
+    const int _capacity;
+
+    std::atomic<quint64> _reports;
+    std::atomic<quint64> _malformed;
+    std::atomic<quint64> _dropped;
+    std::atomic<int> _regions;
+};
+
+}
+
+#endif // FLEETAGGREGATOR_H
@@ -0,0 +1,226 @@
+/**
+ * @brief Implements the FleetReport class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QtEndian>
+
+#include <cstring>
+
+#include "fleetreport.h"
+
+/**
+ * @class Utils::FleetReport
+ *
+ * @brief Encodes and decodes the datagrams of the fleet reporting.
+ *
+ * \code
+ * Header (20 bytes)           Sample (32 bytes)
+ *  0  u32 magic "LFR1"         0  i64 time in ms since the epoch
+ *  4  u16 version              8  u16 country (QLocale::Country)
+ *  6  u16 sample count        10  u16 gCO2 per kWh
+ *  8  u64 sender              12  u32 energy in mWh
+ * 16  u32 sequence            16  u32 carbon in mg
+ *                             20  char[12] region id, NUL padded
+ * \endcode
+ *
+ * At most MaxSamples samples fit in a report, which keeps a datagram below
+ * the usual MTU. Region ids only use the characters [A-Za-z0-9_-], a report
+ * with any other is malformed. The sequence counts the reports of a sender, so the
+ * collector could tell lost reports from quiet senders.
+ */
+
+/**
+ * @brief Returns the region id, which may use all RegionSize bytes.
+ */
+QString Utils::FleetReport::Sample::regionId() const
+{
+    return QString::fromUtf8(region, qstrnlen(region, RegionSize));
+}
+
+/**
+ * @brief Sets the region id, unless it is longer than RegionSize bytes or
+ * uses other characters than [A-Za-z0-9_-].
+ */
+bool Utils::FleetReport::Sample::setRegionId(const QString &regionId)
+{
+    const QByteArray utf8 = regionId.toUtf8();
+    if(utf8.size() > RegionSize)
+    {
+        return false;
+    }
+
+    Sample checked;
+    std::memcpy(checked.region, utf8.constData(), utf8.size());
+    if(!checked.hasValidRegionId())
+    {
+        return false;
+    }
+
+    std::memcpy(region, checked.region, RegionSize);
+    return true;
+}
+
+/**
+ * @brief Returns true if the region id only uses the characters
+ * [A-Za-z0-9_-] and is NUL padded.
+ *
+ * The collector writes region ids as they are, e.g. into CSV files, so
+ * anything else is refused.
+ */
+bool Utils::FleetReport::Sample::hasValidRegionId() const
+{
+    const qsizetype length = qstrnlen(region, RegionSize);
+
+    for(qsizetype i = 0; i < length; ++i)
+    {
+        const char c = region[i];
+        const bool valid = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+
+        if(!valid)
+        {
+            return false;
+        }
+    }
+
+    for(qsizetype i = length; i < RegionSize; ++i)
+    {
+        if(region[i] != '\0')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns \p regionId, or a short id for it if it doesn't fit a
+ * Sample.
+ *
+ * The short id is the first characters of \p regionId, with every character
+ * outside [A-Za-z0-9_-] replaced by '_', a '-' and a hash of the whole id in
+ * hex. The same region always gets the same short id, so the collector can
+ * still tell the regions apart.
+ */
+/* static */
+QString Utils::FleetReport::fittingRegionId(const QString &regionId)
+{
+    Sample sample;
+    if(sample.setRegionId(regionId))
+    {
+        return regionId;
+    }
+
+    quint64 hash {14695981039346656037ull};
+    for(const char c : regionId.toUtf8())
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    constexpr int HashSize {8};
+    QString prefix = regionId.left(RegionSize - HashSize - 1);
+
+    for(QChar &c : prefix)
+    {
+        const bool valid = (c >= u'A' && c <= u'Z') || (c >= u'a' && c <= u'z') || (c >= u'0' && c <= u'9') || c == u'_' || c == u'-';
+        if(!valid)
+        {
+            c = u'_';
+        }
+    }
+
+    return QString("%1-%2").arg(prefix).arg(static_cast<quint32>(hash ^ (hash >> 32)), HashSize, 16, QLatin1Char('0'));
+}
+
+/**
+ * @brief Returns the datagram of \p header and \p samples.
+ *
+ * The sample count of the header is ignored, only the first MaxSamples
+ * samples are encoded.
+ */
+/* static */
+QByteArray Utils::FleetReport::encode(const Header &header, const QList<Sample> &samples)
+{
+    const int count = static_cast<int>(qMin<qsizetype>(samples.count(), MaxSamples));
+
+    QByteArray datagram(HeaderSize + count * SampleSize, Qt::Uninitialized);
+    char *out = datagram.data();
+
+    qToLittleEndian<quint32>(Magic, out);
+    qToLittleEndian<quint16>(Version, out + 4);
+    qToLittleEndian<quint16>(static_cast<quint16>(count), out + 6);
+    qToLittleEndian<quint64>(header.sender, out + 8);
+    qToLittleEndian<quint32>(header.sequence, out + 16);
+
+    for(int i = 0; i < count; ++i)
+    {
+        const Sample &sample = samples.at(i);
+        char *record = out + HeaderSize + i * SampleSize;
+
+        qToLittleEndian<qint64>(sample.timeInMs, record);
+        qToLittleEndian<quint16>(sample.country, record + 8);
+        qToLittleEndian<quint16>(sample.co2PerkWh, record + 10);
+        qToLittleEndian<quint32>(sample.energyInMilliWattHours, record + 12);
+        qToLittleEndian<quint32>(sample.carbonInMilligrams, record + 16);
+        std::memcpy(record + 20, sample.region, RegionSize);
+    }
+
+    return datagram;
+}
+
+/**
+ * @brief Reads the header of the datagram \p data of \p size bytes.
+ *
+ * @return \arg \c true  It is a report of this version and the size matches
+ *                       the sample count.
+ *         \arg \c false It is not, drop it.
+ */
+/* static */
+bool Utils::FleetReport::decodeHeader(const char *data, qint64 size, Header *header)
+{
+    Q_ASSERT(header != nullptr);
+
+    if(data == nullptr || size < HeaderSize)
+    {
+        return false;
+    }
+
+    if(qFromLittleEndian<quint32>(data) != Magic || qFromLittleEndian<quint16>(data + 4) != Version)
+    {
+        return false;
+    }
+
+    const quint16 count = qFromLittleEndian<quint16>(data + 6);
+    if(count > MaxSamples || size != HeaderSize + count * SampleSize)
+    {
+        return false;
+    }
+
+    header->sampleCount = count;
+    header->sender = qFromLittleEndian<quint64>(data + 8);
+    header->sequence = qFromLittleEndian<quint32>(data + 16);
+    return true;
+}
+
+/**
+ * @brief Reads sample \p index of a datagram whose header was decoded.
+ */
+/* static */
+Utils::FleetReport::Sample Utils::FleetReport::decodeSample(const char *data, int index)
+{
+    const char *record = data + HeaderSize + index * SampleSize;
+
+    Sample sample;
+    sample.timeInMs = qFromLittleEndian<qint64>(record);
+    sample.country = qFromLittleEndian<quint16>(record + 8);
+    sample.co2PerkWh = qFromLittleEndian<quint16>(record + 10);
+    sample.energyInMilliWattHours = qFromLittleEndian<quint32>(record + 12);
+    sample.carbonInMilligrams = qFromLittleEndian<quint32>(record + 16);
+    std::memcpy(sample.region, record + 20, RegionSize);
+
+    return sample;
+}
@@ -0,0 +1,65 @@
+/**
+ * @brief Defines the FleetReport class.
+ *
+ * A FleetReport is the datagram a Leif instance sends to the fleet
+ * collector: a batch of per-minute samples of energy, carbon intensity and
+ * carbon. The format is fixed size little endian, so the collector can
+ * decode it without allocating.
+ *
+ * @sa FleetReporter, Utils::FleetAggregator
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef FLEETREPORT_H
+#define FLEETREPORT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+namespace Utils {
+
+class FleetReport
+{
+public:
+    static constexpr quint32 Magic {0x3152464c}; // "LFR1"
+    static constexpr quint16 Version {1};
+    static constexpr int HeaderSize {20};
+    static constexpr int SampleSize {32};
+    static constexpr int RegionSize {12};
+    static constexpr int MaxSamples {32};
+    static constexpr quint16 DefaultPort {47810};
+
+    struct Header
+    {
+        quint64 sender {0};
+        quint32 sequence {0};
+        quint16 sampleCount {0};
+    };
+
+    struct Sample
+    {
+        qint64 timeInMs {0};
+        quint16 country {0};
+        quint16 co2PerkWh {0};
+        quint32 energyInMilliWattHours {0};
+        quint32 carbonInMilligrams {0};
+        char region[RegionSize] {};
+
+        QString regionId() const;
+        bool setRegionId(const QString &regionId);
+        bool hasValidRegionId() const;
+    };
+
+    static QString fittingRegionId(const QString &regionId);
+
+    static QByteArray encode(const Header &header, const QList<Sample> &samples);
+    static bool decodeHeader(const char *data, qint64 size, Header *header);
+    static Sample decodeSample(const char *data, int index);
+};
+
+}
+
+#endif // FLEETREPORT_H
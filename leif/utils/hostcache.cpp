@@ -0,0 +1,807 @@
+/**
+ * @brief Implements the HostCache class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCoreApplication>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QThread>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <sddl.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "clock.h"
+#include "hostcache.h"
+
+#include "log/log.h"
+
+namespace
+{
+// A new layout needs a new name, old instances keep using the old segment.
+const char DefaultName[] {"leif-host-cache-1"};
+
+// Readers give up after this many torn reads and work on their own.
+constexpr int MaxReadAttempts {64};
+
+// Anything outside is not a real value, see HostCache about trust.
+constexpr qint32 MaxCo2PerkWh {5000};
+constexpr float MaxPowerDrawInWatts {100000.0f};
+
+struct Lease
+{
+    std::atomic<quint64> owner;
+    std::atomic<qint64> until;
+};
+
+struct CarbonValues
+{
+    qint32 country;
+    char region[Utils::HostCache::MaxRegionSize + 1];
+    qint32 co2PerkWhNow;
+    qint32 co2PerkWhNext;
+    qint32 co2PerkWhLater;
+    qint64 validFrom;
+    qint64 validTo;
+    qint32 forecastIntervalInSeconds;
+    qint32 forecastCount;
+    qint32 forecast[Utils::HostCache::MaxForecastValues];
+};
+
+struct PowerValues
+{
+    float watts;
+    qint64 sampledAt;
+};
+
+/*
+ * One value protected by a seqlock. The sequence is odd while a writer is
+ * busy. The key and the end of validity are kept outside of the values, so
+ * instances can find and claim slots without a locked read.
+ */
+template<typename T>
+struct Slot
+{
+    std::atomic<quint64> sequence;
+    std::atomic<quint64> key;
+    std::atomic<qint64> validTo;
+    Lease lease;
+    T values;
+};
+
+// The segment starts zero filled, which is an empty cache.
+struct Segment
+{
+    Slot<CarbonValues> carbon[Utils::HostCache::CarbonSlotCount];
+    Slot<PowerValues> power;
+};
+
+static_assert(std::atomic<quint64>::is_always_lock_free, "The atomics must work across processes.");
+static_assert(std::atomic<qint64>::is_always_lock_free, "The atomics must work across processes.");
+static_assert(std::is_trivially_copyable_v<CarbonValues> && std::is_trivially_copyable_v<PowerValues>);
+
+qint64 currentTime()
+{
+    return Utils::Clock::instance()->now().toMSecsSinceEpoch();
+}
+
+/*
+ * FNV-1a, qHash() is seeded per process.
+ */
+quint64 keyOf(QLocale::Country country, const QByteArray &region)
+{
+    quint64 hash {14695981039346656037ull};
+
+    const QByteArray key = QByteArray::number(static_cast<int>(country)) + '/' + region;
+    for(const char c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    // 0 marks a free slot.
+    return hash != 0 ? hash : 1;
+}
+
+bool isHeld(const Lease &lease, qint64 now)
+{
+    return lease.owner.load(std::memory_order_acquire) != 0 && lease.until.load(std::memory_order_acquire) > now;
+}
+
+/*
+ * Takes or renews the lease. Two instances may both think they hold it for a
+ * moment, their writes are still consistent and the next renewal sorts it
+ * out.
+ */
+bool acquire(Lease &lease, quint64 id, qint64 now, int leaseInMs)
+{
+    quint64 owner = lease.owner.load(std::memory_order_acquire);
+
+    if(owner != id)
+    {
+        if(owner != 0 && lease.until.load(std::memory_order_acquire) > now)
+        {
+            return false;
+        }
+
+        if(!lease.owner.compare_exchange_strong(owner, id, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+    }
+
+    lease.until.store(now + leaseInMs, std::memory_order_release);
+    return true;
+}
+
+void releaseLease(Lease &lease, quint64 id)
+{
+    if(lease.owner.load(std::memory_order_acquire) != id)
+    {
+        return;
+    }
+
+    // Expire first, the next owner must not see our zero until.
+    lease.until.store(0, std::memory_order_release);
+
+    quint64 owner = id;
+    lease.owner.compare_exchange_strong(owner, 0, std::memory_order_acq_rel);
+}
+
+/*
+ * The values are copied while a writer may change them, the sequence tells
+ * whether the copy is torn. This is the usual seqlock read.
+ */
+template<typename T>
+bool readSlot(const Slot<T> &slot, T *values)
+{
+    for(int attempt = 0; attempt < MaxReadAttempts; ++attempt)
+    {
+        const quint64 before = slot.sequence.load(std::memory_order_acquire);
+        if(before & 1)
+        {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+
+        std::memcpy(values, &slot.values, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if(slot.sequence.load(std::memory_order_relaxed) == before)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * A sequence that stays odd belongs to a writer that died half way. We take
+ * over if we see the same odd sequence on two writes in a row, a write takes
+ * microseconds and we write once per calculation.
+ */
+template<typename T>
+bool writeSlot(Slot<T> &slot, const T &values, quint64 *stuckSequence)
+{
+    quint64 sequence = slot.sequence.load(std::memory_order_acquire);
+    quint64 begin = sequence + 1;
+
+    if(sequence & 1)
+    {
+        if(sequence != *stuckSequence)
+        {
+            *stuckSequence = sequence;
+            return false;
+        }
+
+        begin = sequence + 2;
+    }
+
+    if(!slot.sequence.compare_exchange_strong(sequence, begin, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.values, &values, sizeof(T));
+    slot.sequence.store(begin + 1, std::memory_order_release);
+
+    *stuckSequence = 0;
+    return true;
+}
+
+bool isPlausible(qint32 co2PerkWh)
+{
+    return co2PerkWh >= 0 && co2PerkWh <= MaxCo2PerkWh;
+}
+}
+
+class Utils::HostCachePrivate
+{
+public:
+    ~HostCachePrivate() = default;
+
+private:
+    HostCachePrivate(const QString &name, int leaseInMs);
+
+    bool attach();
+    void detach();
+
+    Slot<CarbonValues> *ownCarbonSlot(quint64 key);
+
+    static QString nativeName(const QString &name);
+
+    QString name;
+    int leaseInMs;
+    quint64 id;
+    Segment *segment;
+
+    quint64 stuckCarbon[HostCache::CarbonSlotCount];
+    quint64 stuckPower;
+
+#ifdef Q_OS_WIN
+    HANDLE mapping;
+#endif
+
+    friend class HostCache;
+};
+
+Utils::HostCachePrivate::HostCachePrivate(const QString &name, int leaseInMs):
+    name {name},
+    leaseInMs {leaseInMs},
+    id {0},
+    segment {nullptr},
+    stuckCarbon {},
+    stuckPower {0}
+#ifdef Q_OS_WIN
+    , mapping {nullptr}
+#endif
+{
+    // Unique on the host, the pid alone could be reused by the next process.
+    while(id == 0)
+    {
+        id = (static_cast<quint64>(QCoreApplication::applicationPid()) << 32) ^ QRandomGenerator::system()->generate64();
+    }
+}
+
+/**
+ * @brief Opens or creates the shared segment and maps it.
+ *
+ * The segment must be writable by every user. On Unix we set the mode
+ * explicitly, the umask would keep the other users out. On Windows the
+ * segment lives in the global namespace. Its DACL lets authenticated users
+ * read and write it, but nobody but the owner can change its ACL or take it
+ * over. Creating it there needs SeCreateGlobalPrivilege, so on terminal
+ * servers leifd running as a service should start first; the user instances
+ * only open it.
+ */
+bool Utils::HostCachePrivate::attach()
+{
+    const QString native = nativeName(name);
+
+#ifdef Q_OS_WIN
+    // Generic read and write for authenticated users, nothing else.
+    PSECURITY_DESCRIPTOR descriptor {nullptr};
+    if(!ConvertStringSecurityDescriptorToSecurityDescriptorW(L"D:(A;;GRGW;;;AU)", SDDL_REVISION_1, &descriptor, nullptr))
+    {
+        WRN(QString("Could not create the security descriptor of the host cache: %1").arg(qt_error_string(static_cast<int>(GetLastError()))));
+        return false;
+    }
+
+    SECURITY_ATTRIBUTES attributes {sizeof(attributes), descriptor, FALSE};
+
+    mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, &attributes, PAGE_READWRITE, 0, sizeof(Segment),
+                                 reinterpret_cast<LPCWSTR>(native.utf16()));
+    LocalFree(descriptor);
+
+    if(mapping == nullptr)
+    {
+        mapping = OpenFileMappingW(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, reinterpret_cast<LPCWSTR>(native.utf16()));
+    }
+
+    if(mapping == nullptr)
+    {
+        WRN(QString("Could not open the host cache %1: %2").arg(native, qt_error_string(static_cast<int>(GetLastError()))));
+        return false;
+    }
+
+    void *memory = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, sizeof(Segment));
+    if(memory == nullptr)
+    {
+        WRN(QString("Could not map the host cache %1: %2").arg(native, qt_error_string(static_cast<int>(GetLastError()))));
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return false;
+    }
+#else
+    const QByteArray fileName = QFile::encodeName(native);
+
+    const int fd = ::shm_open(fileName.constData(), O_RDWR | O_CREAT, 0666);
+    if(fd < 0)
+    {
+        WRN(QString("Could not open the host cache %1: %2").arg(native, qt_error_string(errno)));
+        return false;
+    }
+
+    // Fails if another user created it, then it is already shared.
+    [[maybe_unused]] const int changed = ::fchmod(fd, 0666);
+
+    struct stat info {};
+    if(::fstat(fd, &info) == 0 && info.st_size == 0)
+    {
+        // May fail on macOS if another instance was faster, we check below.
+        [[maybe_unused]] const int truncated = ::ftruncate(fd, sizeof(Segment));
+    }
+
+    if(::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Segment)))
+    {
+        WRN(QString("The host cache %1 has an unexpected size.").arg(native));
+        ::close(fd);
+        return false;
+    }
+
+    void *memory = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if(memory == MAP_FAILED)
+    {
+        WRN(QString("Could not map the host cache %1: %2").arg(native, qt_error_string(errno)));
+        return false;
+    }
+#endif
+
+    segment = static_cast<Segment*>(memory);
+    return true;
+}
+
+void Utils::HostCachePrivate::detach()
+{
+    if(segment == nullptr)
+    {
+        return;
+    }
+
+#ifdef Q_OS_WIN
+    UnmapViewOfFile(segment);
+    CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    ::munmap(segment, sizeof(Segment));
+#endif
+
+    segment = nullptr;
+}
+
+/**
+ * @brief Returns the slot of \p key whose lease we hold, or \c nullptr.
+ */
+Slot<CarbonValues> *Utils::HostCachePrivate::ownCarbonSlot(quint64 key)
+{
+    for(Slot<CarbonValues> &slot : segment->carbon)
+    {
+        if(slot.key.load(std::memory_order_acquire) == key && slot.lease.owner.load(std::memory_order_acquire) == id)
+        {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+/* static */
+QString Utils::HostCachePrivate::nativeName(const QString &name)
+{
+#ifdef Q_OS_WIN
+    return QStringLiteral("Global\\") + name;
+#else
+    return QLatin1Char('/') + name;
+#endif
+}
+
+/**
+ * @class Utils::HostCache
+ *
+ * @brief Shares carbon data and power readings between the instances on a
+ * host.
+ *
+ * The segment has CarbonSlotCount slots for carbon data, one per country and
+ * region, and one slot for the power reading of the machine. Every slot has
+ * a lease. Whoever holds the lease fetches or measures and publishes, the
+ * others read. A lease runs out after leaseInMs() unless it is renewed, so
+ * if the leading instance dies or logs out another one takes over. A normal
+ * shutdown releases the leases right away.
+ *
+ * Reads and writes use a seqlock, readers never block the writer and never
+ * wait for a lock held by a dead process. A reader that only sees torn
+ * copies gives up and the caller works on its own.
+ *
+ * Every local user can write the segment. The values are range checked, but
+ * a user can still make the others show wrong numbers. That is why the cache
+ * is opt-in, for machines whose users trust each other.
+ *
+ * All methods return \c false if the segment is not attached, the callers
+ * then work like without the cache.
+ */
+
+/**
+ * @brief Opens the segment \p name, creating it if needed.
+ *
+ * @param name The name of the segment, the same for all instances on the
+ *        host.
+ * @param leaseInMs How long a lease lasts without renewal. Default: three
+ *        calculations.
+ */
+Utils::HostCache::HostCache(const QString &name, int leaseInMs /* = DefaultLeaseInMs */):
+    d {new HostCachePrivate {name, leaseInMs}}
+{
+    d->attach();
+}
+
+Utils::HostCache::~HostCache()
+{
+    release();
+    d->detach();
+}
+
+bool Utils::HostCache::isAttached() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->segment != nullptr;
+}
+
+/**
+ * @brief Returns the id of this instance in the leases.
+ */
+quint64 Utils::HostCache::id() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->id;
+}
+
+int Utils::HostCache::leaseInMs() const
+{
+    Q_ASSERT(d != nullptr);
+
+    return d->leaseInMs;
+}
+
+/**
+ * @brief Reads the carbon data of \p country and \p region into \p data.
+ *
+ * The data may be out of date, the caller decides whether it is still good
+ * enough.
+ *
+ * @return \arg \c true  There was plausible data.
+ *         \arg \c false There was none, or it couldn't be read.
+ */
+bool Utils::HostCache::readCarbon(QLocale::Country country, const QString &region, CarbonData *data) const
+{
+    Q_ASSERT(d != nullptr);
+    Q_ASSERT(data != nullptr);
+
+    const QByteArray regionId = region.toUtf8();
+    if(d->segment == nullptr || regionId.size() > MaxRegionSize)
+    {
+        return false;
+    }
+
+    const quint64 key = keyOf(country, regionId);
+
+    // After a race two slots may have the same key, the newer data wins.
+    CarbonValues best {};
+    bool found {false};
+
+    for(const Slot<CarbonValues> &slot : d->segment->carbon)
+    {
+        CarbonValues values;
+        if(slot.key.load(std::memory_order_acquire) != key || !readSlot(slot, &values))
+        {
+            continue;
+        }
+
+        values.region[MaxRegionSize] = '\0';
+
+        if(values.country != static_cast<qint32>(country) || regionId != values.region
+           || values.validTo <= values.validFrom
+           || !isPlausible(values.co2PerkWhNow) || !isPlausible(values.co2PerkWhNext) || !isPlausible(values.co2PerkWhLater))
+        {
+            continue;
+        }
+
+        if(!found || values.validTo > best.validTo)
+        {
+            best = values;
+            found = true;
+        }
+    }
+
+    if(!found)
+    {
+        return false;
+    }
+
+    *data = CarbonData::ok(best.co2PerkWhNow, best.co2PerkWhNext, best.co2PerkWhLater,
+                           QDateTime::fromMSecsSinceEpoch(best.validFrom), QDateTime::fromMSecsSinceEpoch(best.validTo));
+
+    data->forecastIntervalInSeconds = qMax(0, best.forecastIntervalInSeconds);
+
+    const int forecastCount = qBound(0, best.forecastCount, MaxForecastValues);
+    data->forecast.reserve(forecastCount);
+
+    for(int i = 0; i < forecastCount; ++i)
+    {
+        if(!isPlausible(best.forecast[i]))
+        {
+            data->forecast.clear();
+            break;
+        }
+
+        data->forecast << best.forecast[i];
+    }
+
+    return true;
+}
+
+/**
+ * @brief Tries to become the instance that fetches for \p country and
+ * \p region.
+ *
+ * Succeeds if we already lead, or nobody holds a live lease on the slot of
+ * the region. Without a slot for the region we claim one that nobody leads
+ * and whose data ran out.
+ *
+ * @return \arg \c true  We lead, fetch and publishCarbon().
+ *         \arg \c false Someone else leads, or there is no slot left.
+ */
+bool Utils::HostCache::leadCarbon(QLocale::Country country, const QString &region)
+{
+    Q_ASSERT(d != nullptr);
+
+    const QByteArray regionId = region.toUtf8();
+    if(d->segment == nullptr || regionId.size() > MaxRegionSize)
+    {
+        return false;
+    }
+
+    const quint64 key = keyOf(country, regionId);
+    const qint64 now = currentTime();
+
+    for(Slot<CarbonValues> &slot : d->segment->carbon)
+    {
+        if(slot.key.load(std::memory_order_acquire) == key)
+        {
+            return acquire(slot.lease, d->id, now, d->leaseInMs);
+        }
+    }
+
+    for(Slot<CarbonValues> &slot : d->segment->carbon)
+    {
+        const quint64 slotKey = slot.key.load(std::memory_order_acquire);
+        const bool unused = slotKey == 0 || slot.validTo.load(std::memory_order_acquire) + d->leaseInMs < now;
+
+        if(!unused || isHeld(slot.lease, now) || !acquire(slot.lease, d->id, now, d->leaseInMs))
+        {
+            continue;
+        }
+
+        slot.validTo.store(0, std::memory_order_release);
+        slot.key.store(key, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Publishes \p data for \p country and \p region.
+ *
+ * Only the leader publishes, see leadCarbon(). Invalid data is not shared,
+ * the others keep the last good data until they fetch themselves.
+ */
+bool Utils::HostCache::publishCarbon(QLocale::Country country, const QString &region, const CarbonData &data)
+{
+    Q_ASSERT(d != nullptr);
+
+    const QByteArray regionId = region.toUtf8();
+    if(d->segment == nullptr || !data.isValid || regionId.size() > MaxRegionSize)
+    {
+        return false;
+    }
+
+    const quint64 key = keyOf(country, regionId);
+
+    Slot<CarbonValues> *slot = d->ownCarbonSlot(key);
+    if(slot == nullptr)
+    {
+        return false;
+    }
+
+    CarbonValues values {};
+    values.country = static_cast<qint32>(country);
+    std::memcpy(values.region, regionId.constData(), regionId.size());
+    values.co2PerkWhNow = data.co2PerkWhNow;
+    values.co2PerkWhNext = data.co2PerkWhNext;
+    values.co2PerkWhLater = data.co2PerkWhLater;
+    values.validFrom = data.validFrom.toMSecsSinceEpoch();
+    values.validTo = data.validTo.toMSecsSinceEpoch();
+    values.forecastIntervalInSeconds = data.forecastIntervalInSeconds;
+    values.forecastCount = static_cast<qint32>(qMin<qsizetype>(data.forecast.count(), MaxForecastValues));
+
+    for(int i = 0; i < values.forecastCount; ++i)
+    {
+        values.forecast[i] = data.forecast.at(i);
+    }
+
+    const int index = static_cast<int>(slot - d->segment->carbon);
+    if(!writeSlot(*slot, values, &d->stuckCarbon[index]))
+    {
+        return false;
+    }
+
+    slot->validTo.store(values.validTo, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Reads the last power reading of the machine.
+ *
+ * @param watts Receives the power draw.
+ * @param sampledAt Receives when it was measured.
+ */
+bool Utils::HostCache::readPower(float *watts, QDateTime *sampledAt) const
+{
+    Q_ASSERT(d != nullptr);
+    Q_ASSERT(watts != nullptr);
+    Q_ASSERT(sampledAt != nullptr);
+
+    PowerValues values;
+    if(d->segment == nullptr || !readSlot(d->segment->power, &values))
+    {
+        return false;
+    }
+
+    if(values.sampledAt <= 0 || !(values.watts >= 0.0f && values.watts <= MaxPowerDrawInWatts))
+    {
+        return false;
+    }
+
+    *watts = values.watts;
+    *sampledAt = QDateTime::fromMSecsSinceEpoch(values.sampledAt);
+    return true;
+}
+
+/**
+ * @brief Tries to become the instance that measures the power draw.
+ *
+ * The leader renews the lease with every measurement.
+ */
+bool Utils::HostCache::leadPower()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->segment == nullptr)
+    {
+        return false;
+    }
+
+    return acquire(d->segment->power.lease, d->id, currentTime(), d->leaseInMs);
+}
+
+bool Utils::HostCache::publishPower(float watts)
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->segment == nullptr || d->segment->power.lease.owner.load(std::memory_order_acquire) != d->id)
+    {
+        return false;
+    }
+
+    const PowerValues values {watts, currentTime()};
+    return writeSlot(d->segment->power, values, &d->stuckPower);
+}
+
+/**
+ * @brief Gives up all leases, so others take over without waiting.
+ */
+void Utils::HostCache::release()
+{
+    Q_ASSERT(d != nullptr);
+
+    if(d->segment == nullptr)
+    {
+        return;
+    }
+
+    for(Slot<CarbonValues> &slot : d->segment->carbon)
+    {
+        releaseLease(slot.lease, d->id);
+    }
+
+    releaseLease(d->segment->power.lease, d->id);
+}
+
+/**
+ * @brief Returns the cache of the application, or \c nullptr if it is off.
+ *
+ * The cache is created on first use with configuredName(). If the segment
+ * can't be attached the application works without it.
+ */
+/* static */
+Utils::HostCache *Utils::HostCache::instance()
+{
+    static const std::unique_ptr<HostCache> cache = []() -> std::unique_ptr<HostCache> {
+        const QString name = configuredName();
+        if(name.isEmpty())
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<HostCache> created = std::make_unique<HostCache>(name);
+        if(!created->isAttached())
+        {
+            WRN("Host cache is not available, fetching on our own.");
+            return nullptr;
+        }
+
+        INF(QString("Sharing carbon data and power readings through the host cache %1.").arg(name));
+        return created;
+    }();
+
+    return cache.get();
+}
+
+/**
+ * @brief Returns the segment name if \c LEIF_HOST_CACHE is set, or an empty
+ * string.
+ *
+ * \c LEIF_HOST_CACHE=1 uses the default name, any other value except \c 0 is
+ * taken as the name, e.g. to separate groups of users.
+ */
+/* static */
+QString Utils::HostCache::configuredName()
+{
+    const QString value = qEnvironmentVariable("LEIF_HOST_CACHE").trimmed();
+
+    if(value.isEmpty() || value == QStringLiteral("0"))
+    {
+        return QString();
+    }
+
+    return value == QStringLiteral("1") ? QString::fromLatin1(DefaultName) : value;
+}
+
+/**
+ * @brief Removes the segment \p name, e.g. after tests.
+ *
+ * Instances that have it mapped keep working on their copy. On Windows the
+ * segment goes away with the last instance, there is nothing to remove.
+ */
+/* static */
+bool Utils::HostCache::remove(const QString &name)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(name)
+
+    return true;
+#else
+    return ::shm_unlink(QFile::encodeName(HostCachePrivate::nativeName(name)).constData()) == 0;
+#endif
+}
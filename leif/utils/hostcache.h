@@ -0,0 +1,65 @@
+/**
+ * @brief Defines the HostCache class.
+ *
+ * The HostCache lets all Leif instances on one machine, e.g. the users of a
+ * terminal server, share the carbon data and the power reading through
+ * shared memory. One instance fetches or measures, the others read. It is
+ * off unless LEIF_HOST_CACHE is set.
+ *
+ * @sa SharedDataProvider, SharedPower
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef HOSTCACHE_H
+#define HOSTCACHE_H
+
+#include <QDateTime>
+#include <QLocale>
+#include <QScopedPointer>
+#include <QString>
+
+#include <carbondata.h>
+
+namespace Utils {
+
+class HostCachePrivate;
+
+class HostCache
+{
+public:
+    explicit HostCache(const QString &name, int leaseInMs = DefaultLeaseInMs);
+    ~HostCache();
+
+    bool isAttached() const;
+    quint64 id() const;
+    int leaseInMs() const;
+
+    bool readCarbon(QLocale::Country country, const QString &region, CarbonData *data) const;
+    bool leadCarbon(QLocale::Country country, const QString &region);
+    bool publishCarbon(QLocale::Country country, const QString &region, const CarbonData &data);
+
+    bool readPower(float *watts, QDateTime *sampledAt) const;
+    bool leadPower();
+    bool publishPower(float watts);
+
+    void release();
+
+    static HostCache *instance();
+    static QString configuredName();
+    static bool remove(const QString &name);
+
+    static constexpr int DefaultLeaseInMs {3 * 60 * 1000};
+    static constexpr int CarbonSlotCount {8};
+    static constexpr int MaxRegionSize {63};
+    static constexpr int MaxForecastValues {96};
+
+private:
+    Q_DISABLE_COPY_MOVE(HostCache)
+    QScopedPointer<HostCachePrivate> d;
+};
+
+}
+
+#endif // HOSTCACHE_H
@@ -0,0 +1,154 @@
+/**
+ * @brief Implements the LocaleId class.
+ *
+ * @sa LocaleId
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QHash>
+#include <QMutex>
+
+#include "localeid.h"
+
+namespace
+{
+constexpr int LanguageShift {32};
+constexpr int ScriptShift {16};
+constexpr quint64 FieldMask {0xFFFF};
+}
+
+/**
+ * @class Utils::LocaleId
+ *
+ * @brief Identifies a locale by its language, script and territory.
+ *
+ * The three enum values are packed into one integer, so comparing two ids
+ * is a single integer comparison. Ids made from a locale name with only a
+ * language (e.g. "de") keep AnyTerritory, so they can be told apart from
+ * "de_DE" when we look for the best translation.
+ *
+ * \remark fromName() interns the names it has seen, so loading many
+ * translations with the same locale names parses each name only once.
+ */
+
+/**
+ * @brief Creates the id of \p locale.
+ *
+ * @param locale The locale.
+ */
+Utils::LocaleId::LocaleId(const QLocale &locale):
+    LocaleId {locale.language(), locale.script(), locale.territory()}
+{}
+
+/**
+ * @brief Creates the id of a \p language, \p script and \p territory.
+ *
+ * @param language The language.
+ * @param script The script, may be QLocale::AnyScript.
+ * @param territory The territory, may be QLocale::AnyTerritory.
+ */
+Utils::LocaleId::LocaleId(QLocale::Language language, QLocale::Script script, QLocale::Territory territory):
+    _value {(static_cast<quint64>(language) << LanguageShift) |
+            (static_cast<quint64>(script) << ScriptShift) |
+            static_cast<quint64>(territory)}
+{}
+
+/**
+ * @brief Returns the language.
+ *
+ * @return The language as a QLocale::Language value.
+ */
+QLocale::Language Utils::LocaleId::language() const
+{
+    return static_cast<QLocale::Language>((_value >> LanguageShift) & FieldMask);
+}
+
+/**
+ * @brief Returns the script.
+ *
+ * @return The script as a QLocale::Script value.
+ */
+QLocale::Script Utils::LocaleId::script() const
+{
+    return static_cast<QLocale::Script>((_value >> ScriptShift) & FieldMask);
+}
+
+/**
+ * @brief Returns the territory.
+ *
+ * @return The territory as a QLocale::Territory value.
+ */
+QLocale::Territory Utils::LocaleId::territory() const
+{
+    return static_cast<QLocale::Territory>(_value & FieldMask);
+}
+
+/**
+ * @brief Returns \c true if this id names a territory.
+ *
+ * @return \arg \c true The id has a territory, e.g. "de_AT".
+ *         \arg \c false The id only names a language, e.g. "de".
+ */
+bool Utils::LocaleId::hasTerritory() const
+{
+    return territory() != QLocale::AnyTerritory;
+}
+
+/**
+ * @brief Returns \c true if \p other has the same language as this id.
+ *
+ * @param other The id to compare with.
+ * @return \arg \c true Both ids have the same language.
+ *         \arg \c false The languages differ.
+ */
+bool Utils::LocaleId::isSameLanguage(const LocaleId &other) const
+{
+    return ((_value ^ other._value) >> LanguageShift) == 0;
+}
+
+/**
+ * @brief Returns the locale this id identifies.
+ *
+ * For ids without a territory Qt picks the most likely one, like it does for
+ * QLocale("de").
+ *
+ * @return The locale as a QLocale object.
+ */
+QLocale Utils::LocaleId::toLocale() const
+{
+    return QLocale {language(), script(), territory()};
+}
+
+/**
+ * @brief Returns the id of the locale \p name.
+ *
+ * The \p name has the same format QLocale accepts, e.g. "en_GB" or "de". A
+ * name without a territory gives an id without a territory.
+ *
+ * @param name The locale name.
+ * @return The locale id.
+ */
+/* static */
+Utils::LocaleId Utils::LocaleId::fromName(const QString &name)
+{
+    static QMutex mutex;
+    static QHash<QString, LocaleId> interned;
+
+    QMutexLocker locker(&mutex);
+
+    const auto it = interned.constFind(name);
+    if(it != interned.constEnd())
+        return it.value();
+
+    const QLocale locale {name};
+    const bool hasTerritory {name.contains(QLatin1Char('_')) || name.contains(QLatin1Char('-'))};
+
+    const LocaleId id {hasTerritory ? LocaleId {locale}
+                                    : LocaleId {locale.language(), QLocale::AnyScript, QLocale::AnyTerritory}};
+
+    interned.insert(name, id);
+
+    return id;
+}
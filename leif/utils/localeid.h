@@ -0,0 +1,49 @@
+/**
+ * @brief Defines the LocaleId class.
+ *
+ * The LocaleId utility class is a compact, integer identifier for a locale. It
+ * lets us compare the locales of translations without building locale name
+ * strings.
+ *
+ * @sa Translation
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef LOCALEID_H
+#define LOCALEID_H
+
+#include <QLocale>
+
+namespace Utils {
+
+class LocaleId
+{
+public:
+    constexpr LocaleId() = default;
+    explicit LocaleId(const QLocale &locale);
+    LocaleId(QLocale::Language language, QLocale::Script script, QLocale::Territory territory);
+
+    QLocale::Language language() const;
+    QLocale::Script script() const;
+    QLocale::Territory territory() const;
+
+    bool hasTerritory() const;
+    bool isSameLanguage(const LocaleId &other) const;
+
+    QLocale toLocale() const;
+
+    constexpr quint64 value() const { return _value; }
+
+    constexpr bool operator==(const LocaleId &other) const { return _value == other._value; }
+    constexpr bool operator!=(const LocaleId &other) const { return _value != other._value; }
+
+    static LocaleId fromName(const QString &name);
+
+private:
+    quint64 _value {0};
+};
+}
+
+#endif // LOCALEID_H
@@ -0,0 +1,190 @@
+/**
+ * @brief Implements the MetricsFormat class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "carbonscheduler.h"
+#include "metricsformat.h"
+
+namespace
+{
+void appendHeader(QByteArray &out, const char *name, const char *help)
+{
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += " gauge\n";
+}
+
+void appendSample(QByteArray &out, const char *name, const QByteArray &labels, double value)
+{
+    out += name;
+    if(!labels.isEmpty())
+    {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    out += QByteArray::number(value, 'g', 12);
+    out += '\n';
+}
+}
+
+/**
+ * @class Utils::MetricsFormat
+ *
+ * @brief Formats a CarbonSnapshot for the metrics endpoint.
+ *
+ * All metrics are gauges, even the grams, because the user can clear them.
+ * Intensities are only reported while the carbon data is valid, so a scraper
+ * sees missing values instead of stale ones.
+ */
+
+/**
+ * @brief Returns \p snapshot in the Prometheus text exposition format.
+ */
+/* static */
+QByteArray Utils::MetricsFormat::prometheus(const CarbonSnapshot &snapshot)
+{
+    const QByteArray location = "country=\"" + escapeLabel(countryCode(snapshot.country)) +
+                                "\",region=\"" + escapeLabel(snapshot.region) + '"';
+    const CarbonData &carbon = snapshot.carbon;
+
+    QByteArray out;
+    out.reserve(2048);
+
+    appendHeader(out, "leif_power_draw_watts", "Power draw of the machine in watts.");
+    appendSample(out, "leif_power_draw_watts", QByteArray(), snapshot.powerDrawInWatts);
+
+    appendHeader(out, "leif_session_carbon_grams", "Grams of CO2 emitted since the application started.");
+    appendSample(out, "leif_session_carbon_grams", QByteArray(), snapshot.sessionCarbon);
+
+    appendHeader(out, "leif_lifetime_carbon_grams", "Grams of CO2 emitted since the statistics were cleared.");
+    appendSample(out, "leif_lifetime_carbon_grams", QByteArray(), snapshot.lifetimeCarbon);
+
+    appendHeader(out, "leif_carbon_data_valid", "Whether the last carbon data was valid.");
+    appendSample(out, "leif_carbon_data_valid", location, carbon.isValid ? 1 : 0);
+
+    if(carbon.isValid)
+    {
+        appendHeader(out, "leif_carbon_intensity_grams_per_kwh", "Current carbon intensity in grams of CO2 per kWh.");
+        appendSample(out, "leif_carbon_intensity_grams_per_kwh", location, carbon.co2PerkWhNow);
+
+        appendHeader(out, "leif_carbon_usage_level", "Carbon usage level, from 0 (very low) to 4 (very high).");
+        appendSample(out, "leif_carbon_usage_level", location, static_cast<int>(snapshot.usageLevel));
+
+        const QList<int> series = CarbonScheduler::forecastSeries(carbon);
+        const int interval = CarbonScheduler::forecastInterval(carbon);
+
+        if(!series.isEmpty() && interval > 0 && carbon.validFrom.isValid())
+        {
+            appendHeader(out, "leif_carbon_forecast_start_timestamp_seconds", "Start of the carbon forecast.");
+            appendSample(out, "leif_carbon_forecast_start_timestamp_seconds", location,
+                         carbon.validFrom.toSecsSinceEpoch());
+
+            appendHeader(out, "leif_carbon_forecast_grams_per_kwh", "Forecast carbon intensity, by seconds after the forecast start.");
+            for(qsizetype i = 0; i < series.count(); ++i)
+            {
+                const QByteArray labels = location + ",offset_seconds=\"" + QByteArray::number(i * interval) + '"';
+                appendSample(out, "leif_carbon_forecast_grams_per_kwh", labels, series.at(i));
+            }
+        }
+    }
+
+    if(snapshot.timestamp.isValid())
+    {
+        appendHeader(out, "leif_snapshot_timestamp_seconds", "When these values were calculated.");
+        appendSample(out, "leif_snapshot_timestamp_seconds", QByteArray(), snapshot.timestamp.toSecsSinceEpoch());
+    }
+
+    return out;
+}
+
+/**
+ * @brief Returns \p snapshot as a compact JSON object.
+ */
+/* static */
+QByteArray Utils::MetricsFormat::json(const CarbonSnapshot &snapshot)
+{
+    const CarbonData &carbon = snapshot.carbon;
+
+    QJsonObject object {
+        {QStringLiteral("timestamp"), snapshot.timestamp.toString(Qt::ISODate)},
+        {QStringLiteral("country"), countryCode(snapshot.country)},
+        {QStringLiteral("region"), snapshot.region},
+        {QStringLiteral("powerDrawWatts"), snapshot.powerDrawInWatts},
+        {QStringLiteral("sessionCarbonGrams"), snapshot.sessionCarbon},
+        {QStringLiteral("lifetimeCarbonGrams"), snapshot.lifetimeCarbon},
+        {QStringLiteral("valid"), carbon.isValid}
+    };
+
+    if(carbon.isValid)
+    {
+        QJsonArray values;
+        for(int value : CarbonScheduler::forecastSeries(carbon))
+        {
+            values.append(value);
+        }
+
+        object.insert(QStringLiteral("intensity"), carbon.co2PerkWhNow);
+        object.insert(QStringLiteral("usageLevel"), static_cast<int>(snapshot.usageLevel));
+        object.insert(QStringLiteral("forecast"), QJsonObject {
+            {QStringLiteral("from"), carbon.validFrom.toString(Qt::ISODate)},
+            {QStringLiteral("intervalSeconds"), CarbonScheduler::forecastInterval(carbon)},
+            {QStringLiteral("values"), values}
+        });
+    }
+    else
+    {
+        object.insert(QStringLiteral("error"), carbon.errorString);
+    }
+
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Returns the two letter code of \p country, or an empty string.
+ */
+/* static */
+QString Utils::MetricsFormat::countryCode(QLocale::Country country)
+{
+    if(country == QLocale::AnyCountry)
+    {
+        return QString();
+    }
+
+    return QLocale::territoryToCode(country);
+}
+
+/**
+ * @brief Escapes \p value for a Prometheus label value.
+ */
+/* static */
+QByteArray Utils::MetricsFormat::escapeLabel(const QString &value)
+{
+    QByteArray escaped;
+    escaped.reserve(value.size());
+
+    for(char c : value.toUtf8())
+    {
+        switch(c)
+        {
+        case '\\': escaped += "\\\\"; break;
+        case '"':  escaped += "\\\""; break;
+        case '\n': escaped += "\\n"; break;
+        default:   escaped += c;
+        }
+    }
+
+    return escaped;
+}
@@ -0,0 +1,38 @@
+/**
+ * @brief Defines the MetricsFormat class.
+ *
+ * The MetricsFormat turns a CarbonSnapshot into the payloads of the metrics
+ * endpoint, the Prometheus text exposition format and JSON.
+ *
+ * @sa MetricsService
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef METRICSFORMAT_H
+#define METRICSFORMAT_H
+
+#include <QByteArray>
+#include <QString>
+
+#include <carbonsnapshot.h>
+
+namespace Utils {
+
+class MetricsFormat
+{
+public:
+    static QByteArray prometheus(const CarbonSnapshot &snapshot);
+    static QByteArray json(const CarbonSnapshot &snapshot);
+
+    static QString countryCode(QLocale::Country country);
+    static QByteArray escapeLabel(const QString &value);
+
+    static constexpr const char *PrometheusContentType {"text/plain; version=0.0.4; charset=utf-8"};
+    static constexpr const char *JsonContentType {"application/json"};
+};
+
+}
+
+#endif // METRICSFORMAT_H
@@ -0,0 +1,259 @@
+/**
+ * @brief Implements the PowerProfile class.
+ *
+ * @sa PowerProfile
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QDataStream>
+#include <QtMath>
+
+#include <limits>
+
+#include "powerprofile.h"
+
+namespace
+{
+constexpr quint8 ProfileFormatVersion {1};
+}
+
+/**
+ * @class Utils::PowerProfile
+ *
+ * @brief Learns the power consumption per power state.
+ *
+ * Every measurement is added with addSample() together with the time span it
+ * covers. Longer measurements move the average more than short ones, so the
+ * result does not depend on how often we happen to measure. The averages can
+ * be stored compactly with toByteArray() and should only be persisted when
+ * needsPersisting() says so, which keeps us from writing the settings on
+ * every measurement.
+ */
+
+/**
+ * @brief Creates an empty power profile without any samples.
+ */
+Utils::PowerProfile::PowerProfile():
+    _dirty {false}
+{}
+
+/**
+ * @brief Returns \c true if no mode has any samples yet.
+ *
+ * @return \arg \c true  The profile has not learned anything yet.
+ *         \arg \c false At least one mode has samples.
+ */
+bool Utils::PowerProfile::isEmpty() const
+{
+    return !hasSamples(Mode::Battery) &&
+           !hasSamples(Mode::Charging) &&
+           !hasSamples(Mode::FullyCharged);
+}
+
+/**
+ * @brief Returns \c true if the \p mode has at least one sample.
+ *
+ * @param mode The power mode to check.
+ * @return \arg \c true  There is an average for this mode.
+ *         \arg \c false Nothing was measured in this mode yet.
+ */
+bool Utils::PowerProfile::hasSamples(Mode mode) const
+{
+    return sampleCount(mode) > 0;
+}
+
+/**
+ * @brief Adds a measurement of \p milliWatts for the given \p mode.
+ *
+ * The weight of the sample depends on the \p intervalInSeconds it covers: a
+ * measurement spanning the whole TimeConstantInSeconds replaces about 63% of
+ * the previous average. The first sample of a mode is taken as is.
+ *
+ * Negative values and non-positive intervals are ignored.
+ *
+ * @param mode The power mode the measurement was taken in.
+ * @param milliWatts The measured consumption in mW.
+ * @param intervalInSeconds The time span the measurement represents.
+ */
+void Utils::PowerProfile::addSample(Mode mode, float milliWatts, int intervalInSeconds)
+{
+    if(milliWatts < 0 || intervalInSeconds <= 0)
+        return;
+
+    Average &average = _averages[static_cast<int>(mode)];
+
+    if(average.samples == 0)
+    {
+        average.value = milliWatts;
+    }
+    else
+    {
+        const float alpha = 1.0f - qExp(-static_cast<float>(intervalInSeconds) / TimeConstantInSeconds);
+        average.value += alpha * (milliWatts - average.value);
+    }
+
+    if(average.samples < std::numeric_limits<quint32>::max())
+        ++average.samples;
+
+    _dirty = true;
+}
+
+/**
+ * @brief Returns the learned average for \p mode in mW.
+ *
+ * @param mode The power mode.
+ * @return The average in mW or \c 0 if there are no samples.
+ */
+float Utils::PowerProfile::average(Mode mode) const
+{
+    return _averages[static_cast<int>(mode)].value;
+}
+
+/**
+ * @brief Returns how many samples were added for \p mode.
+ *
+ * @param mode The power mode.
+ * @return The sample count.
+ */
+quint32 Utils::PowerProfile::sampleCount(Mode mode) const
+{
+    return _averages[static_cast<int>(mode)].samples;
+}
+
+/**
+ * @brief Returns the best consumption estimate for \p mode in mW.
+ *
+ * If the \p mode has no samples yet, we fall back to what the computer draws
+ * on battery, as this is the closest thing we know about.
+ *
+ * @param mode The power mode.
+ * @return The estimated consumption in mW.
+ */
+float Utils::PowerProfile::estimate(Mode mode) const
+{
+    if(hasSamples(mode))
+        return average(mode);
+
+    return average(Mode::Battery);
+}
+
+/**
+ * @brief Returns \c true if the profile changed since it was last persisted.
+ *
+ * @return \arg \c true  There are unsaved samples.
+ *         \arg \c false The stored profile is up to date.
+ */
+bool Utils::PowerProfile::isDirty() const
+{
+    return _dirty;
+}
+
+/**
+ * @brief Returns \c true if the profile changed and should be stored now.
+ *
+ * We only ask for persisting once every PersistIntervalInSeconds, so the
+ * settings are not written on every measurement.
+ *
+ * @param now The current date and time.
+ * @return \arg \c true  Store the profile and call markPersisted().
+ *         \arg \c false Nothing to do yet.
+ */
+bool Utils::PowerProfile::needsPersisting(const QDateTime &now) const
+{
+    if(!isDirty())
+        return false;
+
+    if(!_lastPersisted.isValid())
+        return true;
+
+    return _lastPersisted.secsTo(now) >= PersistIntervalInSeconds;
+}
+
+/**
+ * @brief Remembers that the profile was stored at \p now.
+ *
+ * @param now The date and time the profile was persisted.
+ */
+void Utils::PowerProfile::markPersisted(const QDateTime &now)
+{
+    _dirty = false;
+    _lastPersisted = now;
+}
+
+/**
+ * @brief Serializes the profile into a compact binary representation.
+ *
+ * @sa fromByteArray()
+ *
+ * @return The serialized profile as a QByteArray.
+ */
+QByteArray Utils::PowerProfile::toByteArray() const
+{
+    QByteArray data;
+    QDataStream out {&data, QIODevice::WriteOnly};
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    out << ProfileFormatVersion;
+    for(const Average &average : _averages)
+        out << average.value << average.samples;
+
+    return data;
+}
+
+/**
+ * @brief Creates a PowerProfile from its binary representation.
+ *
+ * \remark
+ * If the \p data is empty, corrupt or of an unknown version, an empty profile
+ * will be returned.
+ *
+ * @sa toByteArray()
+ *
+ * @param data The serialized profile.
+ * @return The PowerProfile object.
+ */
+Utils::PowerProfile Utils::PowerProfile::fromByteArray(const QByteArray &data)
+{
+    PowerProfile profile {};
+
+    if(data.isEmpty())
+        return profile;
+
+    QDataStream in {data};
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint8 version {0};
+    in >> version;
+
+    if(version != ProfileFormatVersion)
+        return PowerProfile {};
+
+    for(Average &average : profile._averages)
+        in >> average.value >> average.samples;
+
+    if(in.status() != QDataStream::Ok)
+        return PowerProfile {};
+
+    return profile;
+}
+
+/**
+ * @brief Creates a PowerProfile from the legacy average discharge rate.
+ *
+ * Older versions only stored a single average discharge rate. We use it to
+ * seed the battery average so the learned value isn't lost on update.
+ *
+ * @param averageDischargeRate The legacy average discharge rate in mW.
+ * @return The seeded PowerProfile object.
+ */
+Utils::PowerProfile Utils::PowerProfile::fromAverageDischargeRate(int averageDischargeRate)
+{
+    PowerProfile profile {};
+
+    if(averageDischargeRate > 0)
+        profile.addSample(Mode::Battery, averageDischargeRate, TimeConstantInSeconds);
+
+    return profile;
+}
@@ -0,0 +1,72 @@
+/**
+ * @brief Defines the PowerProfile class.
+ *
+ * The PowerProfile utility class learns how much power the computer draws in
+ * the different power states (on battery, charging, fully charged) and keeps
+ * a time-weighted exponential moving average for each of them.
+ *
+ * @sa PowerInfoBase
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef POWERPROFILE_H
+#define POWERPROFILE_H
+
+#include <QByteArray>
+#include <QDateTime>
+
+namespace Utils {
+
+class PowerProfile
+{
+public:
+    enum class Mode
+    {
+        Battery,
+        Charging,
+        FullyCharged
+    };
+
+    PowerProfile();
+    ~PowerProfile() = default;
+
+    bool isEmpty() const;
+    bool hasSamples(Mode mode) const;
+
+    void addSample(Mode mode, float milliWatts, int intervalInSeconds);
+
+    float average(Mode mode) const;
+    quint32 sampleCount(Mode mode) const;
+    float estimate(Mode mode) const;
+
+    bool isDirty() const;
+    bool needsPersisting(const QDateTime &now) const;
+    void markPersisted(const QDateTime &now);
+
+    QByteArray toByteArray() const;
+
+    static PowerProfile fromByteArray(const QByteArray &data);
+    static PowerProfile fromAverageDischargeRate(int averageDischargeRate);
+
+    static constexpr int TimeConstantInSeconds {2 * 60 * 60};
+    static constexpr int PersistIntervalInSeconds {60 * 60};
+
+private:
+    static constexpr int ModeCount {3};
+
+    struct Average
+    {
+        float value {0};
+        quint32 samples {0};
+    };
+
+    Average _averages[ModeCount];
+    bool _dirty;
+    QDateTime _lastPersisted;
+};
+
+}
+
+#endif // POWERPROFILE_H
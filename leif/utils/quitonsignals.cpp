@@ -0,0 +1,84 @@
+/**
+ * @brief Implements the QuitOnSignals class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCoreApplication>
+
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "quitonsignals.h"
+
+namespace
+{
+#ifdef Q_OS_UNIX
+int signalSockets[2] {-1, -1};
+
+void onSignal(int)
+{
+    const char signal {1};
+    [[maybe_unused]] const ssize_t written = ::write(signalSockets[0], &signal, sizeof(signal));
+}
+#endif
+}
+
+/**
+ * @class Utils::QuitOnSignals
+ *
+ * @brief Quits the application on SIGTERM and SIGINT.
+ *
+ * The handler only writes to a socket, the application quits from the event
+ * loop. This way the services shut down normally, e.g. the lifetime carbon
+ * is saved and the last rollup is written.
+ */
+
+/**
+ * @brief Installs the handlers, which quit \p app.
+ *
+ * Call it once, before the event loop runs.
+ *
+ * @return \arg \c true  The signals quit \p app.
+ *         \arg \c false The socket pair could not be created, or this is not
+ *                       a Unix system. The signals still kill the process.
+ */
+/* static */
+bool Utils::QuitOnSignals::install(QCoreApplication *app)
+{
+    Q_ASSERT(app != nullptr);
+
+#ifdef Q_OS_UNIX
+    if(::socketpair(AF_UNIX, SOCK_STREAM, 0, signalSockets) != 0)
+    {
+        return false;
+    }
+
+    QSocketNotifier *notifier = new QSocketNotifier(signalSockets[1], QSocketNotifier::Read, app);
+    QObject::connect(notifier, &QSocketNotifier::activated, app, [=]() {
+        char signal {0};
+        [[maybe_unused]] const ssize_t read = ::read(signalSockets[1], &signal, sizeof(signal));
+
+        app->quit();
+    });
+
+    struct sigaction action {};
+    action.sa_handler = onSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGINT, &action, nullptr);
+
+    return true;
+#else
+    Q_UNUSED(app);
+    return false;
+#endif
+}
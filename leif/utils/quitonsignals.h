@@ -0,0 +1,30 @@
+/**
+ * @brief Defines the QuitOnSignals class.
+ *
+ * The daemons (leifd, leif-collector) quit their event loop on SIGTERM and
+ * SIGINT instead of being killed, so they can save their state first.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef QUITONSIGNALS_H
+#define QUITONSIGNALS_H
+
+#include <QtGlobal>
+
+QT_BEGIN_NAMESPACE
+class QCoreApplication;
+QT_END_NAMESPACE
+
+namespace Utils {
+
+class QuitOnSignals
+{
+public:
+    static bool install(QCoreApplication *app);
+};
+
+}
+
+#endif // QUITONSIGNALS_H
@@ -0,0 +1,210 @@
+/**
+ * @brief Implements the SelfMetrics class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+
+#include <atomic>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "clock.h"
+#include "selfmetrics.h"
+
+#include "log/log.h"
+
+namespace
+{
+std::atomic<quint64> wakeUps {0};
+std::atomic<quint64> loggedBytes {0};
+std::atomic<quint64> networkBytes {0};
+
+const QElapsedTimer &uptime()
+{
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+
+    return timer;
+}
+}
+
+/**
+ * @class Utils::SelfMetrics
+ *
+ * @brief Measures the footprint of Leif itself.
+ *
+ * The counters are process wide. The loggers report the bytes they write
+ * with addLoggedBytes(), the local endpoints the bytes they send and
+ * receive with addNetworkBytes().
+ *
+ * A SelfMetrics object counts the timer events of the main thread, every
+ * one of them is a wake-up of the process, and logs a sample every hour.
+ * Create one right after the application object.
+ */
+
+/**
+ * @brief Starts counting the wake-ups of the main thread.
+ */
+Utils::SelfMetrics::SelfMetrics(QObject *parent /* = nullptr */):
+    QObject {parent}
+{
+    uptime();
+
+    if(QCoreApplication::instance() != nullptr)
+        QCoreApplication::instance()->installEventFilter(this);
+
+    // One more wake-up an hour, and it is counted as well.
+    Utils::Clock::instance()->repeat(LogIntervalInMs, this, [this]() { logSample(); });
+}
+
+/**
+ * @brief Returns the current values.
+ *
+ * The CPU time and memory are -1 if the platform doesn't tell.
+ */
+/* static */
+Utils::SelfMetrics::Sample Utils::SelfMetrics::sample()
+{
+    Sample sample;
+    sample.uptimeInSeconds = uptime().elapsed() / 1000;
+    sample.cpuTimeInMs = cpuTimeInMs();
+    sample.residentBytes = residentBytes();
+    sample.wakeUps = wakeUps.load(std::memory_order_relaxed);
+    sample.loggedBytes = loggedBytes.load(std::memory_order_relaxed);
+    sample.networkBytes = networkBytes.load(std::memory_order_relaxed);
+
+    return sample;
+}
+
+/**
+ * @brief Returns \p sample as one line for the log.
+ */
+/* static */
+QString Utils::SelfMetrics::toString(const Sample &sample)
+{
+    return QString("Self metrics: uptime %1 s, CPU %2 ms, RSS %3 kB, %4 wake-ups/h, %5 bytes logged, %6 bytes network.")
+        .arg(sample.uptimeInSeconds)
+        .arg(sample.cpuTimeInMs)
+        .arg(sample.residentBytes >= 0 ? sample.residentBytes / 1024 : -1)
+        .arg(sample.wakeUpsPerHour(), 0, 'f', 1)
+        .arg(sample.loggedBytes)
+        .arg(sample.networkBytes);
+}
+
+/* static */
+void Utils::SelfMetrics::addLoggedBytes(qint64 bytes)
+{
+    if(bytes > 0)
+        loggedBytes.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed);
+}
+
+/* static */
+void Utils::SelfMetrics::addNetworkBytes(qint64 bytes)
+{
+    if(bytes > 0)
+        networkBytes.fetch_add(static_cast<quint64>(bytes), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the user and system CPU time of the process so far.
+ */
+/* static */
+qint64 Utils::SelfMetrics::cpuTimeInMs()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if(!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return -1;
+
+    // Both are in 100ns steps.
+    auto toMs = [](const FILETIME &time) {
+        return ((static_cast<qint64>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10000;
+    };
+
+    return toMs(kernel) + toMs(user);
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#endif
+}
+
+/**
+ * @brief Returns the memory of the process that is currently in RAM.
+ */
+/* static */
+qint64 Utils::SelfMetrics::residentBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return -1;
+
+    return static_cast<qint64>(counters.WorkingSetSize);
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count {MACH_TASK_BASIC_INFO_COUNT};
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return -1;
+
+    return static_cast<qint64>(info.resident_size);
+#else
+    // The second value is the resident set in pages.
+    QFile statm {QStringLiteral("/proc/self/statm")};
+    if(!statm.open(QIODevice::ReadOnly))
+        return -1;
+
+    bool ok {false};
+    const qint64 pages = statm.readLine().split(' ').value(1).toLongLong(&ok);
+
+    return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+#endif
+}
+
+/**
+ * @brief Counts the timer events of the main thread.
+ */
+bool Utils::SelfMetrics::eventFilter(QObject *watched, QEvent *event)
+{
+    if(event->type() == QEvent::Timer)
+        wakeUps.fetch_add(1, std::memory_order_relaxed);
+
+    return QObject::eventFilter(watched, event);
+}
+
+void Utils::SelfMetrics::logSample()
+{
+    INF(toString(sample()));
+}
+
+/**
+ * @brief Returns the timer wake-ups per hour of uptime.
+ */
+double Utils::SelfMetrics::Sample::wakeUpsPerHour() const
+{
+    if(uptimeInSeconds <= 0)
+        return 0;
+
+    return static_cast<double>(wakeUps) * 3600 / uptimeInSeconds;
+}
@@ -0,0 +1,62 @@
+/**
+ * @brief Defines the SelfMetrics class.
+ *
+ * The SelfMetrics keep track of what Leif itself costs: CPU time, memory,
+ * timer wake-ups, log output and socket traffic. They are logged every hour
+ * and shown on the About page.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef SELFMETRICS_H
+#define SELFMETRICS_H
+
+#include <QObject>
+#include <QString>
+
+namespace Utils {
+
+class SelfMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    struct Sample
+    {
+        qint64 uptimeInSeconds {0};
+        qint64 cpuTimeInMs {-1};
+        qint64 residentBytes {-1};
+        quint64 wakeUps {0};
+        quint64 loggedBytes {0};
+        quint64 networkBytes {0};
+
+        double wakeUpsPerHour() const;
+    };
+
+    explicit SelfMetrics(QObject *parent = nullptr);
+    virtual ~SelfMetrics() = default;
+
+    static Sample sample();
+    static QString toString(const Sample &sample);
+
+    static void addLoggedBytes(qint64 bytes);
+    static void addNetworkBytes(qint64 bytes);
+
+    static qint64 cpuTimeInMs();
+    static qint64 residentBytes();
+
+    static constexpr int LogIntervalInMs {60 * 60 * 1000};
+
+protected:
+    virtual bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void logSample();
+
+private:
+    Q_DISABLE_COPY_MOVE(SelfMetrics)
+};
+
+}
+
+#endif // SELFMETRICS_H
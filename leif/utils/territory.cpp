@@ -7,6 +7,7 @@
  *
  * @date 22.09.2022
  */
+#include <QDataStream>
 #include <QJsonArray>
 #include <QJsonObject>
 
@@ -193,3 +194,35 @@ QList<Utils::Territory> Utils::Territory::fromJsonArray(const QJsonValue &json)
 
     return validTerritories;
 }
+
+namespace Utils {
+
+/**
+ * @brief Writes the \p territory and its regions to \p stream.
+ *
+ * @param stream The data stream.
+ * @param territory The territory to write.
+ * @return The \p stream.
+ */
+QDataStream &operator<<(QDataStream &stream, const Territory &territory)
+{
+    return stream << static_cast<quint16>(territory._territory) << territory._description << territory._regions;
+}
+
+/**
+ * @brief Reads a \p territory and its regions from \p stream.
+ *
+ * @param stream The data stream.
+ * @param territory The territory to read into.
+ * @return The \p stream.
+ */
+QDataStream &operator>>(QDataStream &stream, Territory &territory)
+{
+    quint16 code {0};
+    stream >> code >> territory._description >> territory._regions;
+    territory._territory = static_cast<QLocale::Territory>(code);
+
+    return stream;
+}
+
+}
@@ -42,6 +42,9 @@ private:
     QLocale::Country _territory;
     QString _description;
     QList<TranslatedString> _regions;
+
+    friend QDataStream &operator<<(QDataStream &stream, const Territory &territory);
+    friend QDataStream &operator>>(QDataStream &stream, Territory &territory);
 };
 
 }
@@ -8,6 +8,7 @@
  * @date 22.09.2022
  */
 
+#include <QDataStream>
 #include <QJsonArray>
 #include <QJsonObject>
 
@@ -98,28 +99,67 @@ QString Utils::TranslatedString::translatedId() const
  * @brief Returns the correct translation.
  *
  * This \c static helper method recieves a list with \p translations, and
- * attempts to find the one, which has the same locale as the system. If it
- * does find it, its string will be returned and can be used to set the
- * translated ID of this string.
+ * attempts to find the one that fits the system locale best. In order of
+ * preference that is:
+ *
+ * 1. the same locale (de_AT for de_AT),
+ * 2. the same language without a country (de for de_AT),
+ * 3. the same language in another country (de_DE for de_AT),
+ * 4. English.
+ *
+ * If several translations fit equally well, the first one wins. If none fits,
+ * an empty string is returned.
+ *
+ * \remark The system locale is resolved once per call and the translations
+ * are compared by their Utils::LocaleId, so no strings are built.
  *
  * @param translations A list with translation objects.
  * @return The translation string as a QString.
  */
 QString Utils::TranslatedString::translate(const QList<Translation> &translations)
 {
-    auto localeFits = [](const Utils::Translation &translation) -> bool {
-        if(translation.isEmpty()) return false;
+    enum Match
+    {
+        NoMatch,
+        English,
+        OtherCountry,
+        SameLanguage,
+        SameLocale
+    };
 
-        auto trLocaleName {translation.locale().name()};
-        auto localeName {QLocale().name()};
+    const LocaleId systemLocale {QLocale()};
+    const LocaleId english {QLocale::English, QLocale::AnyScript, QLocale::AnyTerritory};
 
-        return trLocaleName == localeName;
-    };
+    const Translation *best {nullptr};
+    Match bestMatch {NoMatch};
+
+    for(const Translation &translation : translations)
+    {
+        if(translation.isEmpty())
+            continue;
+
+        const LocaleId id {translation.localeId()};
+        Match match {NoMatch};
 
-    auto result = std::find_if(std::begin(translations), std::end(translations), localeFits);
+        if(id == systemLocale)
+            match = SameLocale;
+        else if(id.isSameLanguage(systemLocale))
+            match = id.hasTerritory() ? OtherCountry : SameLanguage;
+        else if(id.isSameLanguage(english))
+            match = English;
 
-    if(result != std::end(translations))
-        return result->string();
+        if(match > bestMatch)
+        {
+            best = &translation;
+            bestMatch = match;
+
+            if(match == SameLocale)
+                break;
+        }
+    }
+
+    if(best != nullptr)
+        return best->string();
 
     return QString {};
 }
@@ -219,3 +259,34 @@ QList<Utils::TranslatedString> Utils::TranslatedString::fromJsonArray(const QJso
 
     return validStrings;
 }
+
+namespace Utils {
+
+/**
+ * @brief Writes the translated \p string to \p stream.
+ *
+ * Only the id and the already translated id are written, the translations
+ * themselves are not needed anymore.
+ *
+ * @param stream The data stream.
+ * @param string The translated string to write.
+ * @return The \p stream.
+ */
+QDataStream &operator<<(QDataStream &stream, const TranslatedString &string)
+{
+    return stream << string._id << string._translatedId;
+}
+
+/**
+ * @brief Reads a translated \p string from \p stream.
+ *
+ * @param stream The data stream.
+ * @param string The translated string to read into.
+ * @return The \p stream.
+ */
+QDataStream &operator>>(QDataStream &stream, TranslatedString &string)
+{
+    return stream >> string._id >> string._translatedId;
+}
+
+}
@@ -20,6 +20,10 @@
 
 #include "translation.h"
 
+QT_BEGIN_NAMESPACE
+class QDataStream;
+QT_END_NAMESPACE
+
 namespace Utils {
 class TranslatedString
 {
@@ -40,6 +44,9 @@ public:
 private:
     QString _id;
     QString _translatedId;
+
+    friend QDataStream &operator<<(QDataStream &stream, const TranslatedString &string);
+    friend QDataStream &operator>>(QDataStream &stream, TranslatedString &string);
 };
 }
 
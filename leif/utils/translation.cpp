@@ -22,6 +22,9 @@
  * language and a country selection (we need both, as some languages are spoken
  * in several countries, with subtle differences, and some countries speak
  * several languages).
+ *
+ * The locale is kept as a LocaleId, which is cheap to compare when we look
+ * for the translation matching the system locale.
  */
 
 /**
@@ -36,12 +39,14 @@ Utils::Translation::Translation():
  *
  * The \p localeName needs to be in following format: $LANGUAGE_$COUNTRY. Where
  * \c $LANGUAGE is for example \b en or \b de and $COUNTRY is \b US or \b DE.
+ * The country may be left out, then the translation is used for every
+ * country speaking that language (unless there is a better match).
  *
  * @param string The string to be translated.
  * @param localeName The name of the locale for this translation.
  */
 Utils::Translation::Translation(const QString &string, const QString &localeName):
-    Translation {string, QLocale{localeName}}
+    _string {string}, _localeId {LocaleId::fromName(localeName)}
 {}
 
 /**
@@ -51,7 +56,7 @@ Utils::Translation::Translation(const QString &string, const QString &localeName
  * @param locale The locale for this translation.
  */
 Utils::Translation::Translation(const QString &string, const QLocale &locale):
-    _string {string}, _locale{locale}
+    _string {string}, _localeId {locale}
 {}
 
 /**
@@ -111,7 +116,7 @@ void Utils::Translation::setString(const QString &string)
  */
 QLocale Utils::Translation::locale() const
 {
-    return _locale;
+    return _localeId.toLocale();
 }
 
 /**
@@ -125,7 +130,19 @@ QLocale Utils::Translation::locale() const
  */
 void Utils::Translation::setLocale(const QLocale &locale)
 {
-    _locale = locale;
+    _localeId = LocaleId {locale};
+}
+
+/**
+ * @brief Returns the id of the set locale.
+ *
+ * @sa locale()
+ *
+ * @return The locale id as a Utils::LocaleId object.
+ */
+Utils::LocaleId Utils::Translation::localeId() const
+{
+    return _localeId;
 }
 
 /**
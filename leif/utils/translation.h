@@ -16,6 +16,8 @@
 
 #include <QLocale>
 
+#include "localeid.h"
+
 namespace Utils {
 
 class Translation
@@ -34,12 +36,14 @@ public:
     QLocale locale() const;
     void setLocale(const QLocale &locale);
 
+    LocaleId localeId() const;
+
     static Translation fromJson(const QJsonValue &json);
     static QList<Utils::Translation> fromJsonArray(const QJsonValue &json);
 
 private:
     QString _string;
-    QLocale _locale;
+    LocaleId _localeId;
 };
 }
 
@@ -56,8 +56,8 @@ bool PowerInfoHelper::batteryFullyCharged(PSYSTEM_BATTERY_STATE pBatteryState)
 }
 
 
-PowerInfo::PowerInfo(int avarageDischargeRate, std::function<void (int)> storeAvarageDischargeRateFunc, QObject *parent /* = nullptr */):
-    PowerInfoBase {avarageDischargeRate, storeAvarageDischargeRateFunc, parent}
+PowerInfo::PowerInfo(const Utils::PowerProfile &profile, std::function<void (const Utils::PowerProfile&)> storeProfileFunc, QObject *parent /* = nullptr */):
+    PowerInfoBase {profile, storeProfileFunc, parent}
 {}
 
 bool PowerInfo::hasBattery()
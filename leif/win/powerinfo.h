@@ -6,7 +6,7 @@
 class PowerInfo : public PowerInfoBase
 {
 public:
-    explicit PowerInfo(int avarageDischargeRate, std::function<void(int)> storeAvarageDischargeRateFunc, QObject *parent = nullptr);
+    explicit PowerInfo(const Utils::PowerProfile &profile, std::function<void(const Utils::PowerProfile&)> storeProfileFunc, QObject *parent = nullptr);
     virtual ~PowerInfo() = default;
 
     // PowerInfoBase interface
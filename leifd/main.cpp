@@ -0,0 +1,128 @@
+/**
+ * @brief Defines the main() method of the leifd daemon.
+ *
+ * leifd tracks the carbon of a machine without a desktop, e.g. a server or a
+ * CI runner. It runs the same services as the tray application on a
+ * QCoreApplication, without Qt Widgets, Qt Quick or a tray icon. The data is
+ * available through the scheduler API (leif-schedule) and, if enabled, the
+ * metrics endpoint.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QLocale>
+#include <QScopedPointer>
+#include <QTextStream>
+
+#include "plugin/carbonpluginmanager.h"
+#include "services/carbonservice.h"
+#include "services/fleetreporter.h"
+#include "services/metricsservice.h"
+#include "services/schedulerservice.h"
+#include "services/settingsservice.h"
+#include "utils/quitonsignals.h"
+#include "utils/selfmetrics.h"
+
+#include "log/log.h"
+#include "log/consolelogger.h"
+#include "log/filelogger.h"
+#include "log/trace.h"
+
+namespace
+{
+void setApplicationInfo()
+{
+    QString ver = QStringLiteral("%1.%2.%3.%4");
+    ver = ver.arg(QM_MAJOR_VERSION).arg(QM_MINOR_VERSION).arg(QM_PATCH_VERSION).arg(QM_BUILD_VERSION);
+
+    // The same names as the tray application, so both share the settings.
+    QCoreApplication::setApplicationVersion(ver);
+    QCoreApplication::setOrganizationName(QStringLiteral("leif"));
+    QCoreApplication::setOrganizationDomain(QStringLiteral("leif.support"));
+    QCoreApplication::setApplicationName(QStringLiteral("leif carbon tracker"));
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    Utils::SelfMetrics selfMetrics;
+    setApplicationInfo();
+
+    const QCommandLineOption countryOption {QStringLiteral("country"), QStringLiteral("Saves the location to this country, e.g. GB."), QStringLiteral("code")};
+    const QCommandLineOption regionOption {QStringLiteral("region"), QStringLiteral("Saves the location to this region id of the country."), QStringLiteral("id")};
+    const QCommandLineOption consoleOption {QStringLiteral("console"), QStringLiteral("Logs to the console as well, e.g. for the system journal.")};
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Tracks the carbon of this machine without a desktop."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({countryOption, regionOption, consoleOption});
+    parser.process(app);
+
+    Log::LogSystem::logManager()->registerLogger(new Log::FileLogger);
+
+    if(parser.isSet(consoleOption))
+    {
+        Log::LogSystem::logManager()->registerLogger(new Log::ConsoleLogger);
+    }
+
+    INF("===========================");
+    INF("Leif daemon is starting...");
+    INF("===========================");
+
+    // Trace from the start if asked to, see Log::Trace.
+    const QString traceFileName = Log::Trace::configuredFileName();
+    if(!traceFileName.isEmpty())
+        Log::Trace::setEnabled(true);
+
+    // Start the plugin discovery while the services are set up.
+    CarbonPluginManager::Instance();
+
+    QScopedPointer<SettingsService> settingsService(new SettingsService);
+
+    if(parser.isSet(countryOption))
+    {
+        const QLocale::Country country = QLocale::codeToTerritory(parser.value(countryOption));
+        if(country == QLocale::AnyCountry)
+        {
+            QTextStream(stderr) << "Unknown country code: " << parser.value(countryOption) << Qt::endl;
+            return 1;
+        }
+
+        settingsService->saveLocation(country, parser.value(regionOption));
+    }
+
+    if(settingsService->country() == QLocale::AnyCountry)
+    {
+        WRN("No location configured, use --country and --region.");
+    }
+
+#ifdef Q_OS_UNIX
+    // Quitting from the event loop saves the lifetime carbon.
+    if(!Utils::QuitOnSignals::install(&app))
+    {
+        WRN("Could not create the signal socket pair, signals will kill leifd.");
+    }
+#endif
+
+    QScopedPointer<CarbonService> carbonService(new CarbonService(settingsService.get()));
+    QScopedPointer<SchedulerService> schedulerService(new SchedulerService(settingsService.get()));
+    QScopedPointer<MetricsService> metricsService(new MetricsService(carbonService.get()));
+    QScopedPointer<FleetReporter> fleetReporter(new FleetReporter(carbonService.get()));
+
+    int result = app.exec();
+
+    INF("===============================");
+    INF("Leif daemon is shutting down.");
+    INF("===============================");
+    INF(Utils::SelfMetrics::toString(Utils::SelfMetrics::sample()));
+
+    if(!traceFileName.isEmpty() && !Log::Trace::writeChromeJson(traceFileName))
+        WRN(QString("Could not write the trace to %1.").arg(traceFileName));
+
+    return result;
+}
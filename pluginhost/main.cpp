@@ -0,0 +1,43 @@
+/**
+ * @brief Defines the main() method of the plugin host.
+ *
+ * The plugin host is started by the Leif application (see RemoteCarbonPlugin)
+ * to run one carbon plugin outside of the application process.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include "pluginhostserver.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("leif-pluginhost"));
+
+    const QCommandLineOption pluginOption {QStringLiteral("plugin"), QStringLiteral("The plugin library to load."), QStringLiteral("file")};
+    const QCommandLineOption serverOption {QStringLiteral("server"), QStringLiteral("The local server to connect to."), QStringLiteral("name")};
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Runs a Leif carbon plugin out of process."));
+    parser.addHelpOption();
+    parser.addOptions({pluginOption, serverOption});
+    parser.process(app);
+
+    if(!parser.isSet(pluginOption) || !parser.isSet(serverOption))
+    {
+        parser.showHelp(1);
+    }
+
+    PluginHostServer host {parser.value(pluginOption)};
+    if(!host.start(parser.value(serverOption)))
+    {
+        qCritical("Plugin host failed to start: %s", qPrintable(host.errorString()));
+        return 2;
+    }
+
+    return app.exec();
+}
@@ -0,0 +1,108 @@
+/**
+ * @brief Implements the PluginHostServer class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QCoreApplication>
+
+#include <interfaces/IDataProvider.h>
+
+#include "plugin/pluginhostprotocol.h"
+
+#include "pluginhostserver.h"
+
+/**
+ * @class PluginHostServer
+ *
+ * @brief Serves the requests of one application connection.
+ *
+ * Despite its name the host connects to the application, which listens for
+ * exactly one connection. Every request is answered by the plugin, the reply
+ * carries the result. Once the application disconnects the host quits.
+ */
+
+PluginHostServer::PluginHostServer(const QString &pluginFileName, QObject *parent /* = nullptr */):
+    QObject(parent),
+    m_loader {pluginFileName},
+    m_provider {nullptr}
+{
+    connect(&m_socket, &QLocalSocket::readyRead, this, &PluginHostServer::onReadyRead);
+    connect(&m_socket, &QLocalSocket::disconnected, qApp, &QCoreApplication::quit);
+}
+
+PluginHostServer::~PluginHostServer()
+{
+    m_provider = nullptr;
+}
+
+/**
+ * @brief Loads the plugin and connects to \p serverName.
+ *
+ * @return \arg \c true  The host is ready to serve requests.
+ *         \arg \c false Something failed, see errorString().
+ */
+bool PluginHostServer::start(const QString &serverName)
+{
+    if(!m_loader.load())
+    {
+        m_errorString = m_loader.errorString();
+        return false;
+    }
+
+    m_provider = qobject_cast<IDataProvider*>(m_loader.instance());
+    if(m_provider == nullptr)
+    {
+        m_errorString = QString("'%1' is no carbon data provider plugin.").arg(m_loader.fileName());
+        return false;
+    }
+
+    m_socket.connectToServer(serverName);
+    if(!m_socket.waitForConnected(5000))
+    {
+        m_errorString = m_socket.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+QString PluginHostServer::errorString() const
+{
+    return m_errorString;
+}
+
+void PluginHostServer::onReadyRead()
+{
+    QByteArray frame;
+
+    while(PluginHost::readFrame(&m_socket, frame))
+    {
+        PluginHost::Request request;
+        PluginHost::Reply reply;
+
+        if(!PluginHost::decodeRequest(frame, request))
+        {
+            reply.errorString = QStringLiteral("The plugin host received an invalid request.");
+        }
+        else
+        {
+            reply.id = request.id;
+            reply.result = handleRequest(request);
+        }
+
+        PluginHost::writeFrame(&m_socket, PluginHost::encodeReply(reply));
+        m_socket.flush();
+    }
+}
+
+QByteArray PluginHostServer::handleRequest(const PluginHost::Request &request)
+{
+    Q_ASSERT(m_provider != nullptr);
+
+    if(request.type == PluginHost::RequestType::CarbonBatch)
+        return PluginHost::encodeResult(m_provider->carbonPerKiloWatt(request.country, request.regions, request.from, request.to));
+
+    return PluginHost::encodeResult(m_provider->carbonPerKiloWatt(request.country, request.region));
+}
@@ -0,0 +1,53 @@
+/**
+ * @brief Defines the PluginHostServer class.
+ *
+ * The PluginHostServer runs a single carbon plugin on behalf of the Leif
+ * application and answers its requests.
+ *
+ * @sa RemoteCarbonPlugin
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef PLUGINHOSTSERVER_H
+#define PLUGINHOSTSERVER_H
+
+#include <QObject>
+#include <QPluginLoader>
+#include <QLocalSocket>
+
+class IDataProvider;
+
+namespace PluginHost
+{
+struct Request;
+}
+
+class PluginHostServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PluginHostServer(const QString &pluginFileName, QObject *parent = nullptr);
+    virtual ~PluginHostServer();
+
+    bool start(const QString &serverName);
+    QString errorString() const;
+
+private slots:
+    void onReadyRead();
+
+private:
+    QByteArray handleRequest(const PluginHost::Request &request);
+
+private:
+    Q_DISABLE_COPY_MOVE(PluginHostServer)
+
+    QPluginLoader m_loader;
+    IDataProvider *m_provider;
+    QLocalSocket m_socket;
+    QString m_errorString;
+};
+
+#endif // PLUGINHOSTSERVER_H
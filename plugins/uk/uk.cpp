@@ -9,10 +9,10 @@
  */
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QNetworkProxyFactory>
 #include <QHash>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QStandardPaths>
 
 #ifdef _DEBUG
 #include <QtDebug>
@@ -29,12 +29,20 @@ private:
 
     QHash<QString, int> regionHash;
     QNetworkAccessManager *network;
+    QUrl baseUrl;
     friend class Uk;
 };
 
 UkPrivate::UkPrivate()
 {
-    network = new QNetworkAccessManager;
+    QString cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if(!cacheDirectory.isEmpty())
+    {
+        cacheDirectory += QStringLiteral("/network/uk");
+    }
+
+    network = Utilities::createNetworkAccessManager(cacheDirectory);
+    baseUrl = Utilities::defaultBaseUrl();
 }
 
 UkPrivate::~UkPrivate()
@@ -104,10 +112,120 @@ CarbonData Uk::carbonPerKiloWatt(const QLocale::Country country, const QString &
                                          "region: '%1'. It is unknown.").arg(region));
     }
 
-    QDateTime from = QDateTime::currentDateTimeUtc();
-    QDateTime to = from.addSecs(90 * 60);
+    // The API works in half hour slots. Starting the request at the current
+    // slot keeps the URL the same for the whole slot, so repeated requests
+    // can be answered by the network cache.
+    const qint64 slotLength = 30 * 60;
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QDateTime from = QDateTime::fromSecsSinceEpoch(now.toSecsSinceEpoch() / slotLength * slotLength, Qt::UTC);
+    const QDateTime to = from.addSecs(90 * 60);
+
+    return Utilities::requestCarbonData(d->network, d->baseUrl, regionCode(region), from, to);
+}
+
+/**
+ * @brief Returns the carbon data of several \p regions with one request.
+ *
+ * The API has an endpoint returning all regions at once, so this costs a
+ * single request no matter how many \p regions are asked for. Unknown
+ * regions get an error CarbonData object. The results contain the forecast
+ * series for the whole period.
+ *
+ * \remark
+ * This method blocks the execution until the data is available and read.
+ *
+ * @param country The country (always United Kingdrom).
+ * @param regions The region names, see carbonPerKiloWatt().
+ * @param from The start of the requested period.
+ * @param to The end of the requested period.
+ * @return A hash with the region name as key.
+ */
+QHash<QString, CarbonData> Uk::carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                 const QDateTime &from, const QDateTime &to)
+{
+    Q_ASSERT(d != nullptr);
+
+    QHash<QString, CarbonData> result;
+
+    if(country != QLocale::UnitedKingdom)
+    {
+        const CarbonData error = CarbonData::error(QString("This plugin can only provide data for "
+                                                           "the United Kingdom, but %1 was "
+                                                           "requested.").arg(QLocale::countryToString(country)));
+        for(const QString &region : regions)
+        {
+            result.insert(region, error);
+        }
+
+        return result;
+    }
+
+    // A single region has its own, much smaller, endpoint. That's what the
+    // scheduler asks for, with a long period.
+    if(regions.count() == 1 && hasRegion(regions.first()))
+    {
+        result.insert(regions.first(), Utilities::requestCarbonData(d->network, d->baseUrl, regionCode(regions.first()),
+                                                                    from.toUTC(), to.toUTC()));
+        return result;
+    }
+
+    QString errorString;
+    const QHash<int, CarbonData> regionalData = Utilities::requestRegionalCarbonData(d->network, d->baseUrl,
+                                                                                     from.toUTC(), to.toUTC(),
+                                                                                     errorString);
+
+    for(const QString &region : regions)
+    {
+        if(!hasRegion(region))
+        {
+            result.insert(region, CarbonData::error(QString("Can't provide the data for the "
+                                                            "region: '%1'. It is unknown.").arg(region)));
+        }
+        else if(regionalData.isEmpty())
+        {
+            result.insert(region, CarbonData::error(errorString));
+        }
+        else
+        {
+            result.insert(region, regionalData.value(regionCode(region),
+                                                     CarbonData::error(QString("The API sent no data for the "
+                                                                               "region: '%1'.").arg(region))));
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the API base URL this plugin talks to.
+ *
+ * \sa setBaseUrl()
+ *
+ * @return The base URL as a QUrl object.
+ */
+QUrl Uk::baseUrl() const
+{
+    Q_ASSERT(d != nullptr);
 
-    return Utilities::requestCarbonData(d->network, regionCode(region), from, to);
+    return d->baseUrl;
+}
+
+/**
+ * @brief Sets the API base URL this plugin talks to.
+ *
+ * This is meant for tests and local API stand-ins. An invalid or empty
+ * \p baseUrl restores the default National Grid URL.
+ *
+ * \remark The initial URL can also be set with the \c LEIF_UK_API_URL
+ * environment variable.
+ *
+ * @param baseUrl The new base URL, e.g. \c http://127.0.0.1:8080.
+ */
+void Uk::setBaseUrl(const QUrl &baseUrl)
+{
+    Q_ASSERT(d != nullptr);
+
+    d->baseUrl = baseUrl.isValid() && !baseUrl.isEmpty() ? baseUrl : Utilities::defaultBaseUrl();
 }
 
 /**
@@ -119,7 +237,11 @@ void Uk::initialize()
 {
     Q_ASSERT(d != nullptr);
 
-    QNetworkProxyFactory::setUseSystemConfiguration(true);
+    const QString apiUrl = qEnvironmentVariable("LEIF_UK_API_URL");
+    if(!apiUrl.isEmpty())
+    {
+        setBaseUrl(QUrl(apiUrl));
+    }
 
     if(!d->regionHash.isEmpty())
     {
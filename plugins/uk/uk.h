@@ -11,6 +11,7 @@
 #define UK_H
 
 #include <QObject>
+#include <QUrl>
 #include <QtPlugin>
 #include <interfaces/IDataProvider.h>
 #include <carbondata.h>
@@ -29,6 +30,11 @@ public:
     virtual ~Uk();
 
     CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region);
+    QHash<QString, CarbonData> carbonPerKiloWatt(const QLocale::Country country, const QStringList &regions,
+                                                 const QDateTime &from, const QDateTime &to);
+
+    QUrl baseUrl() const;
+    void setBaseUrl(const QUrl &baseUrl);
 
 private:
     void initialize();
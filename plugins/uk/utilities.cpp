@@ -5,69 +5,164 @@
  *
  * @date 21.09.2022
  */
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkProxyFactory>
 #include <QNetworkReply>
 #include <QScopeGuard>
 #include <QUrl>
 #include <QDebug>
 #include "utilities.h"
 
+/**
+ * @brief Creates the network access manager used for the API requests.
+ *
+ * The manager keeps its connections to the API alive between requests and,
+ * if a \p cacheDirectory is given, caches the replies on disk. The cache
+ * honours \c Cache-Control and revalidates stale entries with \c ETag and
+ * \c Last-Modified, so a repeated request costs a 304 or nothing at all.
+ *
+ * The system proxy configuration is only resolved on the first call.
+ *
+ * \remark The caller takes ownership of the returned object.
+ *
+ * @param cacheDirectory The directory for the disk cache. If empty, replies
+ *        are not cached.
+ * @return The new network access manager.
+ */
+/* static */
+QNetworkAccessManager *Utilities::createNetworkAccessManager(const QString &cacheDirectory)
+{
+    static const bool proxyConfigured = []() {
+        QNetworkProxyFactory::setUseSystemConfiguration(true);
+        return true;
+    }();
+    Q_UNUSED(proxyConfigured)
+
+    QNetworkAccessManager *network = new QNetworkAccessManager;
+
+    if(!cacheDirectory.isEmpty())
+    {
+        // The replies are a few kilobytes, a megabyte holds plenty of them.
+        QNetworkDiskCache *cache = new QNetworkDiskCache(network);
+        cache->setCacheDirectory(cacheDirectory);
+        cache->setMaximumCacheSize(1024 * 1024);
+
+        network->setCache(cache);
+    }
+
+    return network;
+}
+
 /**
  * @brief Requests the carbon data from the national grid API.
  *
  * For this to happen we need to provide this static method with a valid
- * \p network access manager,a \p regionID, a \p from and a \p to date.
+ * \p network access manager, the API's \p baseUrl, a \p regionID, a \p from
+ * and a \p to date.
+ *
+ * \remark This method blocks until the reply is ready, but no longer than
+ * \p timeout milliseconds.
  *
- * \remark This method blocks until the reply is ready, but nor longer than 5
- * seconds.
+ * \sa defaultBaseUrl()
  *
  * @param network The network access manager to use for the call.
+ * @param baseUrl The API base URL, usually defaultBaseUrl().
  * @param regionID The region ID to ask the API for.
  * @param from The start date for the request.
  * @param to The to date for the request.
+ * @param timeout The time in milliseconds we wait for the reply. Default: 5000.
  * @return The carbon data as a CarbonData object.
  */
 CarbonData Utilities::requestCarbonData(QNetworkAccessManager *network,
+                                        const QUrl &baseUrl,
                                         int regionID,
                                         const QDateTime &from,
-                                        const QDateTime &to)
+                                        const QDateTime &to,
+                                        int timeout /* = 5000 */)
 {
     if(network == nullptr)
     {
         return CarbonData::error(QStringLiteral("No network object provided."));
     }
 
+    if(!baseUrl.isValid())
+    {
+        return CarbonData::error(QStringLiteral("No valid API URL provided."));
+    }
+
     QString format = QStringLiteral("yyyy-MM-ddThh:mm");
     QString fromString = from.toString(format) + "Z";
     QString toString = to.toString(format) + "Z";
 
-    QString address = QStringLiteral("https://api.carbonintensity.org.uk/regional/intensity/%1/%2/regionid/%3");
-    QUrl url = QString(address).arg(fromString, toString).arg(regionID);
-    QNetworkReply *reply = network->get(QNetworkRequest(url));
+    QString path = QStringLiteral("/regional/intensity/%1/%2/regionid/%3");
+    path = path.arg(fromString, toString).arg(regionID);
 
-    // This guarantees that reply will be cleaned up no matter when and how
-    // we exit this method.
-    auto cleanup = qScopeGuard([=]() { reply->deleteLater();});
+    QByteArray data;
+    QString errorString;
 
-    Utilities::awaitSignal(reply, &QNetworkReply::finished);
-    if(!reply->isFinished())
+    if(!Utilities::get(network, Utilities::apiUrl(baseUrl, path), timeout, data, errorString))
     {
-        return CarbonData::error(QStringLiteral("API didn't reply in time."));
+        return CarbonData::error(errorString);
     }
 
-    if(reply->error() != QNetworkReply::NoError)
+    return Utilities::fromByteArray(data);
+}
+
+/**
+ * @brief Requests the carbon data of all regions from the national grid API.
+ *
+ * This needs a single request, no matter how many regions we are interested
+ * in. The parameters are the same as for requestCarbonData().
+ *
+ * \remark This method blocks until the reply is ready, but no longer than
+ * \p timeout milliseconds.
+ *
+ * \sa fromRegionalByteArray()
+ *
+ * @param network The network access manager to use for the call.
+ * @param baseUrl The API base URL, usually defaultBaseUrl().
+ * @param from The start date for the request.
+ * @param to The to date for the request.
+ * @param errorString Set to the reason if the request failed.
+ * @param timeout The time in milliseconds we wait for the reply. Default: 5000.
+ * @return A hash with the region ID as key, empty if the request failed.
+ */
+/* static */
+QHash<int, CarbonData> Utilities::requestRegionalCarbonData(QNetworkAccessManager *network,
+                                                            const QUrl &baseUrl,
+                                                            const QDateTime &from,
+                                                            const QDateTime &to,
+                                                            QString &errorString,
+                                                            int timeout /* = 5000 */)
+{
+    if(network == nullptr)
     {
-        QString msg("Network request could not be processed. Error: %1(%2).");
-        msg = msg.arg(reply->error()).arg(reply->errorString());
+        errorString = QStringLiteral("No network object provided.");
+        return QHash<int, CarbonData>();
+    }
 
-        return CarbonData::error(msg);
+    if(!baseUrl.isValid())
+    {
+        errorString = QStringLiteral("No valid API URL provided.");
+        return QHash<int, CarbonData>();
     }
 
-    QByteArray data = reply->readAll();
+    QString format = QStringLiteral("yyyy-MM-ddThh:mm");
+    QString path = QStringLiteral("/regional/intensity/%1/%2");
+    path = path.arg(from.toString(format) + "Z", to.toString(format) + "Z");
 
-    return Utilities::fromByteArray(data);
+    QByteArray data;
+
+    if(!Utilities::get(network, Utilities::apiUrl(baseUrl, path), timeout, data, errorString))
+    {
+        return QHash<int, CarbonData>();
+    }
+
+    return Utilities::fromRegionalByteArray(data, errorString);
 }
 
 /**
@@ -118,7 +213,100 @@ CarbonData Utilities::fromByteArray(const QByteArray &data)
     }
 
     // Now we can assume we have the actual data
-    return Utilities::fromApiResponse(hash);
+    CarbonData carbonData = Utilities::fromApiResponse(hash);
+
+    // The flat hash doesn't keep the order of the half hour slots, so the
+    // forecast series is read from the reply itself.
+    const QJsonArray timeSlots = reply.value(QStringLiteral("data")).toObject().value(QStringLiteral("data")).toArray();
+    if(carbonData.isValid && !timeSlots.isEmpty())
+    {
+        QList<int> series;
+        for(const QJsonValue &timeSlot : timeSlots)
+        {
+            series << timeSlot.toObject().value(QStringLiteral("intensity")).toObject().value(QStringLiteral("forecast")).toInt(-1);
+        }
+
+        Utilities::setForecast(carbonData, series, timeSlots.first().toObject());
+    }
+
+    return carbonData;
+}
+
+/**
+ * @brief Creates the carbon data per region from an all regions \p data reply.
+ *
+ * The reply contains one entry per half hour slot, each listing the forecast
+ * of every region. Every slot becomes part of the region's forecast series,
+ * see setForecast().
+ *
+ * @param data The JSON API response.
+ * @param errorString Set to the reason if the reply can't be used.
+ * @return A hash with the region ID as key, empty on error.
+ */
+/* static */
+QHash<int, CarbonData> Utilities::fromRegionalByteArray(const QByteArray &data, QString &errorString)
+{
+    QJsonParseError parseError;
+
+    const QJsonDocument json = QJsonDocument::fromJson(data, &parseError);
+    if(json.isNull() || !json.isObject())
+    {
+        errorString = QString("The regional reply seems not to be a valid JSON text. Error: %1(#%2) at %3.");
+        errorString = errorString.arg(parseError.errorString()).arg(parseError.error).arg(parseError.offset);
+
+        return QHash<int, CarbonData>();
+    }
+
+    const QJsonObject reply = json.object();
+    if(reply.contains(QStringLiteral("error")))
+    {
+        errorString = Utilities::fromApiError(Utilities::flatJsonHash(reply)).errorString;
+        return QHash<int, CarbonData>();
+    }
+
+    const QJsonArray timeSlots = reply.value(QStringLiteral("data")).toArray();
+    if(timeSlots.isEmpty())
+    {
+        errorString = QStringLiteral("The regional reply contains no data.");
+        return QHash<int, CarbonData>();
+    }
+
+    QHash<int, QList<int>> series;
+
+    for(const QJsonValue &timeSlot : timeSlots)
+    {
+        const QJsonArray regions = timeSlot.toObject().value(QStringLiteral("regions")).toArray();
+
+        for(const QJsonValue &region : regions)
+        {
+            const QJsonObject regionObject = region.toObject();
+            const int regionID = regionObject.value(QStringLiteral("regionid")).toInt(-1);
+            const int forecast = regionObject.value(QStringLiteral("intensity")).toObject().value(QStringLiteral("forecast")).toInt(-1);
+
+            if(regionID >= 0)
+            {
+                series[regionID] << forecast;
+            }
+        }
+    }
+
+    QHash<int, CarbonData> result;
+    const QJsonObject firstSlot = timeSlots.first().toObject();
+
+    for(auto it = series.cbegin(); it != series.cend(); ++it)
+    {
+        CarbonData regionData = CarbonData::ok(-1, -1, -1, QDateTime(), QDateTime());
+        Utilities::setForecast(regionData, it.value(), firstSlot);
+
+        result.insert(it.key(), regionData);
+    }
+
+    if(result.isEmpty())
+    {
+        errorString = QStringLiteral("The regional reply contains no regions.");
+    }
+
+    return result;
 }
 
 /**
@@ -260,3 +448,103 @@ QString Utilities::dateTimeFormat()
 {
     return QStringLiteral("yyyy-MM-ddThh:mmt");
 }
+
+/**
+ * @brief Returns the base URL of the National Grid carbon intensity API.
+ *
+ * @return The URL as a QUrl object.
+ */
+QUrl Utilities::defaultBaseUrl()
+{
+    return QUrl(QStringLiteral("https://api.carbonintensity.org.uk"));
+}
+
+/**
+ * @brief Sets the forecast \p series of \p data.
+ *
+ * The \p firstSlot of the reply is the validity period of \p data and its
+ * length the forecast interval. The first three values of the \p series
+ * become the now, next and later forecasts.
+ */
+/* static */
+void Utilities::setForecast(CarbonData &data, const QList<int> &series, const QJsonObject &firstSlot)
+{
+    const QString dateTimeFormat = Utilities::dateTimeFormat();
+    const QDateTime from = QDateTime::fromString(firstSlot.value(QStringLiteral("from")).toString(), dateTimeFormat).toTimeSpec(Qt::LocalTime);
+    const QDateTime to = QDateTime::fromString(firstSlot.value(QStringLiteral("to")).toString(), dateTimeFormat).toTimeSpec(Qt::LocalTime);
+
+    data.co2PerkWhNow = series.value(0, -1);
+    data.co2PerkWhNext = series.value(1, -1);
+    data.co2PerkWhLater = series.value(2, -1);
+
+    if(from.isValid() && to.isValid())
+    {
+        data.validFrom = from;
+        data.validTo = to;
+    }
+
+    data.forecast = series;
+    data.forecastIntervalInSeconds = data.validFrom.isValid() ? static_cast<int>(data.validFrom.secsTo(data.validTo)) : 0;
+}
+
+/**
+ * @brief Appends the API \p path to the \p baseUrl's path.
+ */
+/* static */
+QUrl Utilities::apiUrl(const QUrl &baseUrl, const QString &path)
+{
+    QUrl url = baseUrl;
+    QString basePath = url.path();
+    while(basePath.endsWith('/'))
+    {
+        basePath.chop(1);
+    }
+    url.setPath(basePath + path);
+
+    return url;
+}
+
+/**
+ * @brief Sends a GET request for \p url and waits for the reply \p data.
+ *
+ * \remark This method blocks until the reply is ready, but no longer than
+ * \p timeout milliseconds.
+ *
+ * @return \arg \c true  The reply was read into \p data.
+ *         \arg \c false The request failed, see \p errorString.
+ */
+/* static */
+bool Utilities::get(QNetworkAccessManager *network, const QUrl &url, int timeout,
+                    QByteArray &data, QString &errorString)
+{
+    // Use a fresh cache entry as is, revalidate a stale one.
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+    request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true);
+
+    QNetworkReply *reply = network->get(request);
+
+    // This guarantees that reply will be cleaned up no matter when and how
+    // we exit this method.
+    auto cleanup = qScopeGuard([=]() { reply->deleteLater();});
+
+    Utilities::awaitSignal(reply, &QNetworkReply::finished, timeout);
+    if(!reply->isFinished())
+    {
+        reply->abort();
+        errorString = QStringLiteral("API didn't reply in time.");
+        return false;
+    }
+
+    if(reply->error() != QNetworkReply::NoError)
+    {
+        QString msg("Network request could not be processed. Error: %1(%2).");
+        errorString = msg.arg(reply->error()).arg(reply->errorString());
+
+        return false;
+    }
+
+    data = reply->readAll();
+
+    return true;
+}
@@ -12,11 +12,14 @@
 #define UTILITIES_H
 
 #include <QEventLoop>
+#include <QHash>
 #include <QTimer>
+#include <QUrl>
 
 #include "carbondata.h"
 
 QT_BEGIN_NAMESPACE
+class QJsonObject;
 class QNetworkAccessManager;
 QT_END_NAMESPACE
 
@@ -53,12 +56,25 @@ public:
         waitLoop.exec();
     }
 
-    static CarbonData requestCarbonData(QNetworkAccessManager *network, int regionID, const QDateTime &from, const QDateTime &to);
+    static QNetworkAccessManager *createNetworkAccessManager(const QString &cacheDirectory);
+    static CarbonData requestCarbonData(QNetworkAccessManager *network, const QUrl &baseUrl, int regionID,
+                                        const QDateTime &from, const QDateTime &to, int timeout = 5000);
+    static QHash<int, CarbonData> requestRegionalCarbonData(QNetworkAccessManager *network, const QUrl &baseUrl,
+                                                            const QDateTime &from, const QDateTime &to,
+                                                            QString &errorString, int timeout = 5000);
     static CarbonData fromByteArray(const QByteArray &data);
+    static QHash<int, CarbonData> fromRegionalByteArray(const QByteArray &data, QString &errorString);
     static CarbonData fromApiError(const QMultiHash<QString, QVariant> &errorHash);
     static CarbonData fromApiResponse(const QMultiHash<QString, QVariant> &replyHash);
     static QMultiHash<QString, QVariant> flatJsonHash(const QJsonObject &object);
     static QString dateTimeFormat();
+    static QUrl defaultBaseUrl();
+
+private:
+    static void setForecast(CarbonData &data, const QList<int> &series, const QJsonObject &firstSlot);
+    static QUrl apiUrl(const QUrl &baseUrl, const QString &path);
+    static bool get(QNetworkAccessManager *network, const QUrl &url, int timeout,
+                    QByteArray &data, QString &errorString);
 };
 
 #endif // UTILITIES_H
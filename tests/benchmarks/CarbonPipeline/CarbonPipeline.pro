@@ -0,0 +1,18 @@
+QT += testlib concurrent network
+QT -= gui
+
+# Not a testcase, benchmarks are run by hand:
+#   ./tst_carbonpipeline -median 5
+CONFIG += qt console warn_on depend_includepath
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../plugins/uk/utilities.cpp \
+           tst_carbonpipeline.cpp
+
+HEADERS = ../../../plugins/uk/utilities.h
+
+INCLUDEPATH *= ../../../plugins/uk
+
+include(../../../leif/pri/core.pri)
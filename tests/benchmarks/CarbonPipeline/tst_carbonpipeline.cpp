@@ -0,0 +1,327 @@
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <memory>
+
+#include "utilities.h"
+
+#include "interfaces/IDataProvider.h"
+#include "interfaces/IPower.h"
+#include "log/loggerbase.h"
+#include "log/trace.h"
+#include "services/carbonservice.h"
+#include "services/settingsservice.h"
+#include "utils/carbonplugindata.h"
+
+namespace
+{
+class FakePower : public IPower
+{
+public:
+    virtual float powerDrawInWatts() override
+    {
+        return 42.5f;
+    }
+};
+
+class FakeDataProvider : public IDataProvider
+{
+public:
+    using IDataProvider::carbonPerKiloWatt;
+
+    explicit FakeDataProvider(bool expired):
+        m_expired {expired}
+    {}
+
+    virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override
+    {
+        Q_UNUSED(country)
+        Q_UNUSED(region)
+
+        // Expired data makes the service ask again on every tick.
+        const QDateTime now = QDateTime::currentDateTime();
+        return m_expired ? CarbonData::ok(152, 147, 139, now.addSecs(-3600), now.addSecs(-1800))
+                         : CarbonData::ok(152, 147, 139, now, now.addSecs(1800));
+    }
+
+private:
+    bool m_expired;
+};
+
+class MessageLogger : public Log::LoggerBase
+{
+public:
+    using Log::LoggerBase::makeMessage;
+
+protected:
+    virtual void logDigestedMessage(const QString &digestedMessage) override
+    {
+        Q_UNUSED(digestedMessage)
+    }
+};
+}
+
+/**
+ * Benchmarks of the carbon calculation pipeline, from parsing the API reply
+ * to a full CarbonService tick. Run by hand, e.g. with -median 5, and compare
+ * the numbers before and after a change.
+ */
+class CarbonPipelineBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    CarbonPipelineBenchmark() = default;
+    virtual ~CarbonPipelineBenchmark() = default;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void utilitiesFromByteArray();
+    void pluginDataFromJson();
+    void pluginDataLookups();
+    void loggerMakeMessage();
+    void calculateCarbonTick();
+    void traceSpan();
+
+    void utilitiesFromByteArray_data();
+    void pluginDataFromJson_data();
+    void calculateCarbonTick_data();
+    void traceSpan_data();
+
+private:
+    static QByteArray forecastPayload(const QByteArray &recorded, int slotCount);
+    static QJsonObject pluginManifest(int territoryCount, int regionCount);
+
+private:
+    QByteArray m_recordedReply;
+    QJsonObject m_ukManifest;
+};
+
+void CarbonPipelineBenchmark::initTestCase()
+{
+    // Keep the settings of the benchmark apart from the real ones.
+    QCoreApplication::setOrganizationName(QStringLiteral("leif-benchmarks"));
+    QCoreApplication::setApplicationName(QStringLiteral("tst_carbonpipeline"));
+
+    QFile reply {QFINDTESTDATA("../../plugins/common/data/regional_intensity_london.json")};
+    QVERIFY(reply.open(QIODevice::ReadOnly));
+    m_recordedReply = reply.readAll();
+
+    QFile manifest {QFINDTESTDATA("../../../plugins/uk/uk.json")};
+    QVERIFY(manifest.open(QIODevice::ReadOnly));
+    m_ukManifest = QJsonDocument::fromJson(manifest.readAll()).object();
+    QVERIFY(!m_ukManifest.isEmpty());
+}
+
+void CarbonPipelineBenchmark::cleanupTestCase()
+{
+    QSettings().clear();
+}
+
+void CarbonPipelineBenchmark::utilitiesFromByteArray()
+{
+    QFETCH(QByteArray, payload);
+    QFETCH(int, slotCount);
+
+    CarbonData data;
+    QBENCHMARK {
+        data = Utilities::fromByteArray(payload);
+    }
+
+    QVERIFY2(data.isValid, qPrintable(data.errorString));
+    QCOMPARE(data.forecast.count(), slotCount);
+}
+
+void CarbonPipelineBenchmark::pluginDataFromJson()
+{
+    QFETCH(QJsonObject, manifest);
+
+    Utils::CarbonPluginData data;
+    QBENCHMARK {
+        data = Utils::CarbonPluginData::fromJson(manifest);
+    }
+
+    QVERIFY(data.isValid());
+}
+
+/**
+ * The lookups the CarbonPluginManager delegates to the plugin data of the
+ * plugin for a territory, on a large manifest.
+ */
+void CarbonPipelineBenchmark::pluginDataLookups()
+{
+    const Utils::CarbonPluginData data = Utils::CarbonPluginData::fromJson(pluginManifest(60, 200));
+    const QLocale::Territory territory = data.territoryList().constLast();
+    const QString regionId = data.regionIds(territory).constLast();
+
+    QString translated;
+    QBENCHMARK {
+        data.territoryList();
+        data.regionIds(territory);
+        translated = data.translatedRegionId(territory, regionId);
+    }
+
+    QVERIFY(!translated.isEmpty());
+}
+
+void CarbonPipelineBenchmark::loggerMakeMessage()
+{
+    const QString file {QStringLiteral(__FILE__)};
+    const QString function {QStringLiteral("CarbonService::calculateCarbon")};
+    const QString message {QStringLiteral("Received carbon data is: valid.")};
+
+    QString digested;
+    QBENCHMARK {
+        digested = MessageLogger::makeMessage(file, function, __LINE__, Log::MessageType::Information, message);
+    }
+
+    QVERIFY(digested.contains(message));
+}
+
+void CarbonPipelineBenchmark::calculateCarbonTick()
+{
+    QFETCH(bool, expired);
+
+    SettingsService settings;
+    settings.saveLocation(QLocale::UnitedKingdom, QStringLiteral("13"));
+
+    FakeDataProvider provider {expired};
+    CarbonService service {&settings, std::make_unique<FakePower>(), &provider};
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(&service, "calculateCarbon", Qt::DirectConnection);
+    }
+
+    QVERIFY(service.sessionCarbon() > 0);
+    QCOMPARE(service.snapshot().carbon.co2PerkWhNow, 152);
+}
+
+/**
+ * A disabled span must cost no more than a branch.
+ */
+void CarbonPipelineBenchmark::traceSpan()
+{
+    QFETCH(bool, enabled);
+
+    Log::Trace::setEnabled(enabled);
+    Log::Trace::clear();
+
+    QBENCHMARK {
+        TRACE_SPAN("benchmark");
+    }
+
+    Log::Trace::setEnabled(false);
+    Log::Trace::clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CarbonPipelineBenchmark::utilitiesFromByteArray_data()
+{
+    QTest::addColumn<QByteArray>("payload");
+    QTest::addColumn<int>("slotCount");
+
+    const int recordedSlots = QJsonDocument::fromJson(m_recordedReply)["data"]["data"].toArray().count();
+
+    QTest::addRow("recorded") << m_recordedReply << recordedSlots;
+    QTest::addRow("48h") << forecastPayload(m_recordedReply, 96) << 96;
+}
+
+void CarbonPipelineBenchmark::pluginDataFromJson_data()
+{
+    QTest::addColumn<QJsonObject>("manifest");
+
+    QTest::addRow("uk") << m_ukManifest;
+    QTest::addRow("60x200") << pluginManifest(60, 200);
+}
+
+void CarbonPipelineBenchmark::calculateCarbonTick_data()
+{
+    QTest::addColumn<bool>("expired");
+
+    QTest::addRow("cached") << false;
+    QTest::addRow("refetch") << true;
+}
+
+void CarbonPipelineBenchmark::traceSpan_data()
+{
+    QTest::addColumn<bool>("enabled");
+
+    QTest::addRow("disabled") << false;
+    QTest::addRow("enabled") << true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Returns the \p recorded regional reply with \p slotCount half hour
+ * slots, like a 48 hour forecast request.
+ */
+/* static */
+QByteArray CarbonPipelineBenchmark::forecastPayload(const QByteArray &recorded, int slotCount)
+{
+    QJsonObject root = QJsonDocument::fromJson(recorded).object();
+    QJsonObject region = root.value(QStringLiteral("data")).toObject();
+    const QJsonObject templateSlot = region.value(QStringLiteral("data")).toArray().first().toObject();
+    const QDateTime from = QDateTime::fromString(templateSlot.value(QStringLiteral("from")).toString(), Qt::ISODate);
+
+    QJsonArray timeSlots;
+    for(int i = 0; i < slotCount; ++i)
+    {
+        QJsonObject slot = templateSlot;
+        slot.insert(QStringLiteral("from"), from.addSecs(i * 1800).toString(Utilities::dateTimeFormat()));
+        slot.insert(QStringLiteral("to"), from.addSecs((i + 1) * 1800).toString(Utilities::dateTimeFormat()));
+        slot.insert(QStringLiteral("intensity"), QJsonObject {{QStringLiteral("forecast"), 100 + (i * 37) % 200},
+                                                              {QStringLiteral("index"), QStringLiteral("moderate")}});
+        timeSlots.append(slot);
+    }
+
+    region.insert(QStringLiteral("data"), timeSlots);
+    root.insert(QStringLiteral("data"), region);
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Returns a plugin manifest with \p territoryCount territories of
+ * \p regionCount regions, each translated into three languages.
+ */
+/* static */
+QJsonObject CarbonPipelineBenchmark::pluginManifest(int territoryCount, int regionCount)
+{
+    QJsonArray territories;
+    for(int t = 0; t < territoryCount; ++t)
+    {
+        QJsonArray regions;
+        for(int r = 0; r < regionCount; ++r)
+        {
+            const QString id = QString("Region %1-%2").arg(t).arg(r);
+
+            regions.append(QJsonObject {
+                {QStringLiteral("id"), id},
+                {QStringLiteral("translations"), QJsonArray {
+                    QJsonObject {{QStringLiteral("locale"), QStringLiteral("en_GB")}, {QStringLiteral("string"), id}},
+                    QJsonObject {{QStringLiteral("locale"), QStringLiteral("de_DE")}, {QStringLiteral("string"), id + QStringLiteral(" (de)")}},
+                    QJsonObject {{QStringLiteral("locale"), QStringLiteral("fr_FR")}, {QStringLiteral("string"), id + QStringLiteral(" (fr)")}}
+                }}
+            });
+        }
+
+        territories.append(QJsonObject {
+            {QStringLiteral("territory"), static_cast<int>(QLocale::Afghanistan) + t},
+            {QStringLiteral("description"), QString("Territory %1").arg(t)},
+            {QStringLiteral("regions"), regions}
+        });
+    }
+
+    return QJsonObject {
+        {QStringLiteral("name"), QStringLiteral("Benchmark")},
+        {QStringLiteral("description"), QStringLiteral("Generated plugin manifest")},
+        {QStringLiteral("territories"), territories}
+    };
+}
+
+QTEST_MAIN(CarbonPipelineBenchmark)
+#include "tst_carbonpipeline.moc"
@@ -0,0 +1,198 @@
+#include <QtTest>
+
+#include <memory>
+
+#include "interfaces/IDataProvider.h"
+#include "interfaces/IPower.h"
+#include "services/carbonservice.h"
+#include "services/settingsservice.h"
+#include "utils/clock.h"
+
+namespace
+{
+class FakePower : public IPower
+{
+public:
+    explicit FakePower(float watts):
+        m_watts {watts}
+    {}
+
+    virtual float powerDrawInWatts() override
+    {
+        return m_watts;
+    }
+
+private:
+    float m_watts;
+};
+
+/**
+ * Answers with half hour slots, like the carbon APIs. The intensity changes
+ * to \c m_after at \c m_changeAt.
+ */
+class SlotDataProvider : public IDataProvider
+{
+public:
+    using IDataProvider::carbonPerKiloWatt;
+
+    SlotDataProvider(int before, int after, const QDateTime &changeAt):
+        m_before {before},
+        m_after {after},
+        m_changeAt {changeAt},
+        m_requests {0}
+    {}
+
+    virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override
+    {
+        Q_UNUSED(country)
+        Q_UNUSED(region)
+
+        ++m_requests;
+
+        const QDateTime now = Utils::Clock::instance()->now();
+        const qint64 slotLength = 30 * 60 * 1000;
+        const QDateTime from = QDateTime::fromMSecsSinceEpoch(now.toMSecsSinceEpoch() / slotLength * slotLength);
+        const int intensity = now < m_changeAt ? m_before : m_after;
+
+        return CarbonData::ok(intensity, intensity, intensity, from, from.addMSecs(slotLength - 1));
+    }
+
+    int requests() const
+    {
+        return m_requests;
+    }
+
+private:
+    int m_before;
+    int m_after;
+    QDateTime m_changeAt;
+    int m_requests;
+};
+}
+
+/**
+ * Runs the CarbonService on a simulated clock, a day takes milliseconds.
+ */
+class CarbonServiceTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CarbonServiceTest() = default;
+    virtual ~CarbonServiceTest() = default;
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void cleanupTestCase();
+
+    void calculatesOnceAMinute();
+    void dayAtConstantIntensity();
+    void expiredDataIsRequestedAgain();
+    void usageLevelFollowsIntensity();
+    void snapshotIsPublishedPerCalculation();
+
+private:
+    QDateTime m_start;
+    std::unique_ptr<Utils::SimulatedClock> m_clock;
+    std::unique_ptr<SettingsService> m_settings;
+};
+
+void CarbonServiceTest::initTestCase()
+{
+    // Keep the settings of the test apart from the real ones.
+    QCoreApplication::setOrganizationName(QStringLiteral("leif-tests"));
+    QCoreApplication::setApplicationName(QStringLiteral("tst_carbonservice"));
+
+    m_start = QDateTime(QDate(2026, 10, 19), QTime(0, 0), Qt::UTC);
+}
+
+void CarbonServiceTest::init()
+{
+    m_clock.reset(new Utils::SimulatedClock {m_start});
+    Utils::Clock::setInstance(m_clock.get());
+
+    m_settings.reset(new SettingsService);
+    m_settings->saveLifetimeCarbon(0);
+}
+
+void CarbonServiceTest::cleanup()
+{
+    m_settings.reset();
+    m_clock.reset();
+}
+
+void CarbonServiceTest::cleanupTestCase()
+{
+    QSettings().clear();
+}
+
+void CarbonServiceTest::calculatesOnceAMinute()
+{
+    SlotDataProvider provider {200, 200, m_start.addYears(1)};
+    CarbonService service {m_settings.get(), std::make_unique<FakePower>(60), &provider};
+
+    const quint64 firstSequence = service.snapshot().sequence;
+    m_clock->advance(10 * 60 * 1000);
+
+    QCOMPARE(service.snapshot().sequence, firstSequence + 10);
+}
+
+void CarbonServiceTest::dayAtConstantIntensity()
+{
+    SlotDataProvider provider {200, 200, m_start.addYears(1)};
+    CarbonService service {m_settings.get(), std::make_unique<FakePower>(60), &provider};
+
+    m_clock->runUntil(m_start.addDays(1));
+
+    // 1441 calculations (start and end included) of 60W for a minute at
+    // 200g/kWh, 0.2g each.
+    QVERIFY2(qAbs(service.sessionCarbon() - 288.2f) < 0.05f, qPrintable(QString::number(service.sessionCarbon())));
+    QCOMPARE(service.lifetimeCarbon(), service.sessionCarbon());
+
+    // The processes of the test machine didn't cause the simulated day.
+    QVERIFY(service.applicationCarbon().isEmpty());
+}
+
+void CarbonServiceTest::expiredDataIsRequestedAgain()
+{
+    SlotDataProvider provider {200, 200, m_start.addYears(1)};
+    CarbonService service {m_settings.get(), std::make_unique<FakePower>(60), &provider};
+
+    m_clock->runUntil(m_start.addDays(1));
+
+    // Once per half hour slot, the calculation at midnight starts a new one.
+    QCOMPARE(provider.requests(), 49);
+}
+
+void CarbonServiceTest::usageLevelFollowsIntensity()
+{
+    SlotDataProvider provider {200, 40, m_start.addSecs(12 * 60 * 60)};
+    CarbonService service {m_settings.get(), std::make_unique<FakePower>(60), &provider};
+
+    m_clock->runUntil(m_start.addSecs(12 * 60 * 60 - 60));
+    QCOMPARE(service.carbonUsageLevel(), CarbonUsageLevel::Medium);
+
+    m_clock->runUntil(m_start.addSecs(12 * 60 * 60));
+    QCOMPARE(service.carbonUsageLevel(), CarbonUsageLevel::VeryLow);
+    QCOMPARE(service.snapshot().carbon.co2PerkWhNow, 40);
+}
+
+void CarbonServiceTest::snapshotIsPublishedPerCalculation()
+{
+    SlotDataProvider provider {200, 200, m_start.addYears(1)};
+    CarbonService service {m_settings.get(), std::make_unique<FakePower>(60), &provider};
+
+    QSignalSpy spy {&service, &CarbonService::snapshotChanged};
+    m_clock->advance(60 * 60 * 1000);
+
+    QCOMPARE(spy.count(), 60);
+
+    const CarbonSnapshot last = spy.last().first().value<CarbonSnapshot>();
+    QCOMPARE(last.timestamp, m_start.addSecs(60 * 60));
+    QCOMPARE(last.sessionCarbon, service.sessionCarbon());
+}
+
+QTEST_MAIN(CarbonServiceTest)
+#include "tst_carbonservice.moc"
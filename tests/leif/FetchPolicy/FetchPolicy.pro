@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../leif/plugin/fetchpolicy.cpp \
+           tst_fetchpolicy.cpp
+
+HEADERS = ../../../leif/plugin/fetchpolicy.h
+
+INCLUDEPATH *= ../../../leif/plugin ../../../leif/include
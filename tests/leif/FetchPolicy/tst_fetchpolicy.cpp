@@ -0,0 +1,225 @@
+#include <QtTest>
+
+#include <fetchpolicy.h>
+
+using State = FetchPolicy::State;
+
+class FetchPolicyTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    FetchPolicyTest() = default;
+    virtual ~FetchPolicyTest() = default;
+
+private slots:
+    void initTestCase();
+
+    void newPolicyAllowsRequests();
+    void failureDelaysNextRequest();
+    void delayGrowsExponentiallyWithJitter();
+    void delayIsCapped();
+    void breakerOpensAfterThreshold();
+    void openBreakerLetsOneProbeThrough();
+    void successfulProbeClosesBreaker();
+    void failedProbeReopensBreaker();
+    void pendingResultIsNoFailure();
+    void lastKnownForecastShiftsSlots();
+    void lastKnownForecastExpiresAtNextAttempt();
+    void lastKnownForecastRunsOut();
+
+    void lastKnownForecastShiftsSlots_data();
+
+private:
+    QDateTime m_now;
+    CarbonData m_forecast;
+};
+
+void FetchPolicyTest::initTestCase()
+{
+    m_now = QDateTime(QDate(2026, 10, 19), QTime(12, 0));
+    m_forecast = CarbonData::ok(200, 150, 100, m_now, m_now.addSecs(30 * 60));
+}
+
+void FetchPolicyTest::newPolicyAllowsRequests()
+{
+    FetchPolicy policy {1};
+
+    QCOMPARE(policy.state(), State::Closed);
+    QVERIFY(policy.allowRequest(m_now));
+    QVERIFY(!policy.nextAttempt().isValid());
+}
+
+void FetchPolicyTest::failureDelaysNextRequest()
+{
+    FetchPolicy policy {1};
+
+    policy.recordFailure(m_now);
+
+    QCOMPARE(policy.state(), State::Closed);
+    QCOMPARE(policy.failureCount(), 1);
+    QVERIFY(!policy.allowRequest(m_now.addSecs(FetchPolicy::BaseDelayInSeconds / 2 - 1)));
+    QVERIFY(policy.allowRequest(m_now.addSecs(FetchPolicy::BaseDelayInSeconds)));
+}
+
+void FetchPolicyTest::delayGrowsExponentiallyWithJitter()
+{
+    for(quint32 seed = 0; seed < 20; ++seed)
+    {
+        FetchPolicy policy {seed};
+
+        for(int failure = 1; failure < FetchPolicy::FailureThreshold; ++failure)
+        {
+            policy.recordFailure(m_now);
+
+            const qint64 delay = m_now.secsTo(policy.nextAttempt());
+            const qint64 fullDelay = FetchPolicy::BaseDelayInSeconds << (failure - 1);
+
+            QVERIFY(delay >= fullDelay / 2);
+            QVERIFY(delay <= fullDelay);
+        }
+    }
+}
+
+void FetchPolicyTest::delayIsCapped()
+{
+    FetchPolicy policy {7};
+
+    for(int i = 0; i < 40; ++i)
+        policy.recordFailure(m_now);
+
+    QVERIFY(m_now.secsTo(policy.nextAttempt()) <= FetchPolicy::MaxDelayInSeconds);
+    QVERIFY(m_now.secsTo(policy.nextAttempt()) >= FetchPolicy::MaxDelayInSeconds / 2);
+}
+
+void FetchPolicyTest::breakerOpensAfterThreshold()
+{
+    FetchPolicy policy {1};
+
+    for(int i = 0; i < FetchPolicy::FailureThreshold; ++i)
+        policy.recordFailure(m_now);
+
+    QCOMPARE(policy.state(), State::Open);
+    QVERIFY(!policy.allowRequest(m_now));
+    QCOMPARE(policy.state(), State::Open);
+}
+
+void FetchPolicyTest::openBreakerLetsOneProbeThrough()
+{
+    FetchPolicy policy {1};
+
+    for(int i = 0; i < FetchPolicy::FailureThreshold; ++i)
+        policy.recordFailure(m_now);
+
+    const QDateTime later = policy.nextAttempt();
+
+    QVERIFY(policy.allowRequest(later));
+    QCOMPARE(policy.state(), State::HalfOpen);
+    QVERIFY(!policy.allowRequest(later));
+}
+
+void FetchPolicyTest::successfulProbeClosesBreaker()
+{
+    FetchPolicy policy {1};
+
+    for(int i = 0; i < FetchPolicy::FailureThreshold; ++i)
+        policy.recordFailure(m_now);
+
+    QVERIFY(policy.allowRequest(policy.nextAttempt()));
+    policy.recordSuccess();
+
+    QCOMPARE(policy.state(), State::Closed);
+    QCOMPARE(policy.failureCount(), 0);
+    QVERIFY(policy.allowRequest(m_now));
+}
+
+void FetchPolicyTest::failedProbeReopensBreaker()
+{
+    FetchPolicy policy {1};
+
+    for(int i = 0; i < FetchPolicy::FailureThreshold; ++i)
+        policy.recordFailure(m_now);
+
+    const QDateTime probeTime = policy.nextAttempt();
+    QVERIFY(policy.allowRequest(probeTime));
+    policy.recordFailure(probeTime);
+
+    QCOMPARE(policy.state(), State::Open);
+    QVERIFY(policy.nextAttempt() > probeTime);
+    QVERIFY(!policy.allowRequest(probeTime));
+}
+
+void FetchPolicyTest::pendingResultIsNoFailure()
+{
+    FetchPolicy policy {1};
+
+    policy.record(CarbonData::pending(QStringLiteral("Waiting.")), m_now);
+
+    QCOMPARE(policy.state(), State::Closed);
+    QCOMPARE(policy.failureCount(), 0);
+    QVERIFY(policy.allowRequest(m_now));
+
+    // A pending probe lets the next request through to pick up the reply.
+    for(int i = 0; i < FetchPolicy::FailureThreshold; ++i)
+        policy.record(CarbonData::error(QStringLiteral("Failed.")), m_now);
+
+    const QDateTime probeTime = policy.nextAttempt();
+    QVERIFY(policy.allowRequest(probeTime));
+    policy.record(CarbonData::pending(QStringLiteral("Waiting.")), probeTime);
+
+    QCOMPARE(policy.failureCount(), FetchPolicy::FailureThreshold);
+    QVERIFY(policy.allowRequest(probeTime));
+
+    policy.record(m_forecast, probeTime);
+    QCOMPARE(policy.state(), State::Closed);
+    QCOMPARE(policy.failureCount(), 0);
+}
+
+void FetchPolicyTest::lastKnownForecastShiftsSlots()
+{
+    QFETCH(int, minutes);
+    QFETCH(int, now);
+    QFETCH(int, next);
+    QFETCH(int, later);
+
+    const CarbonData data = FetchPolicy::lastKnownForecast(m_forecast, m_now.addSecs(minutes * 60), QDateTime());
+
+    QVERIFY(data.isValid);
+    QCOMPARE(data.co2PerkWhNow, now);
+    QCOMPARE(data.co2PerkWhNext, next);
+    QCOMPARE(data.co2PerkWhLater, later);
+    QVERIFY(data.validFrom <= m_now.addSecs(minutes * 60));
+    QVERIFY(data.validTo > m_now.addSecs(minutes * 60));
+}
+
+void FetchPolicyTest::lastKnownForecastExpiresAtNextAttempt()
+{
+    const QDateTime nextAttempt = m_now.addSecs(5 * 60);
+
+    const CarbonData data = FetchPolicy::lastKnownForecast(m_forecast, m_now.addSecs(60), nextAttempt);
+
+    QVERIFY(data.isValid);
+    QCOMPARE(data.validTo, nextAttempt);
+}
+
+void FetchPolicyTest::lastKnownForecastRunsOut()
+{
+    QVERIFY(!FetchPolicy::lastKnownForecast(CarbonData(), m_now, QDateTime()).isValid);
+    QVERIFY(!FetchPolicy::lastKnownForecast(m_forecast, m_now.addSecs(90 * 60), QDateTime()).isValid);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FetchPolicyTest::lastKnownForecastShiftsSlots_data()
+{
+    QTest::addColumn<int>("minutes");
+    QTest::addColumn<int>("now");
+    QTest::addColumn<int>("next");
+    QTest::addColumn<int>("later");
+
+    QTest::addRow("sameSlot") << 10 << 200 << 150 << 100;
+    QTest::addRow("nextSlot") << 35 << 150 << 100 << 100;
+    QTest::addRow("laterSlot") << 70 << 100 << 100 << 100;
+}
+
+QTEST_MAIN(FetchPolicyTest)
+#include "tst_fetchpolicy.moc"
@@ -0,0 +1,26 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../leif/log/logfilterbase.cpp \
+           ../../../leif/log/logfilterbyfile.cpp \
+           ../../../leif/log/loggerbase.cpp \
+           ../../../leif/log/logmanager.cpp \
+           ../../../leif/log/logrecord.cpp \
+           tst_logmanager.cpp
+
+HEADERS = ../../../leif/log/ilogger.h \
+          ../../../leif/log/ilogmanager.h \
+          ../../../leif/log/logfilterbase.h \
+          ../../../leif/log/logfilterbyfile.h \
+          ../../../leif/log/loggerbase.h \
+          ../../../leif/log/logmanager.h \
+          ../../../leif/log/logrecord.h \
+          ../../../leif/log/logsite.h \
+          ../../../leif/log/messagetype.h
+
+INCLUDEPATH *= ../../../leif/log
@@ -0,0 +1,250 @@
+#include <QtTest>
+
+#include <logfilterbyfile.h>
+#include <loggerbase.h>
+#include <logmanager.h>
+
+namespace
+{
+class RecordingLogger : public Log::LoggerBase
+{
+public:
+    explicit RecordingLogger(QStringList *lines):
+        m_lines {lines}
+    {}
+
+    using Log::LoggerBase::makeMessage;
+
+protected:
+    virtual void logDigestedMessage(const QString &digestedMessage) override
+    {
+        *m_lines << digestedMessage;
+    }
+
+private:
+    QStringList *m_lines;
+};
+
+/**
+ * Only implements the old interface, like loggers written before LogRecord.
+ */
+class PlainLogger : public Log::ILogger
+{
+public:
+    explicit PlainLogger(QStringList *messages):
+        m_messages {messages}
+    {}
+
+    virtual void logMessage(const QString &file, const QString &methodName, const int &codeLine,
+                            const Log::MessageType &type, const QString &message) override
+    {
+        Q_UNUSED(file)
+        Q_UNUSED(methodName)
+        Q_UNUSED(codeLine)
+        Q_UNUSED(type)
+
+        *m_messages << message;
+    }
+
+private:
+    QStringList *m_messages;
+};
+
+/**
+ * Accepts everything and counts how often it was asked.
+ */
+class CountingFilter : public Log::LogFilterBase
+{
+public:
+    CountingFilter(int *calls, Log::ILogger *logger):
+        Log::LogFilterBase {logger},
+        m_calls {calls}
+    {}
+
+protected:
+    virtual bool canLogMessage(const QString &file, const QString &methodName, const int &codeLine,
+                               const Log::MessageType &type, const QString &message) const override
+    {
+        Q_UNUSED(file)
+        Q_UNUSED(methodName)
+        Q_UNUSED(codeLine)
+        Q_UNUSED(type)
+        Q_UNUSED(message)
+
+        ++*m_calls;
+        return true;
+    }
+
+private:
+    int *m_calls;
+};
+
+// Compile time, like in LOG().
+static_assert(Log::LogSite::baseNameOf("C:\\leif\\carbonservice.cpp")[0] == 'c');
+static_assert(Log::LogSite::baseNameOf("/leif/services/")[0] == '\0');
+}
+
+class LogManagerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LogManagerTest() = default;
+    virtual ~LogManagerTest() = default;
+
+private slots:
+    void textIsFormattedOnce();
+    void textFormat();
+    void filterPassesRecordOn();
+    void oldLoggersStillWork();
+    void siteBaseName();
+    void siteTextFormat();
+    void siteFilterIsAskedOnce();
+    void siteCacheIsResetByRegisterLogger();
+    void siteRejectedByAllLoggers();
+};
+
+void LogManagerTest::textIsFormattedOnce()
+{
+    QStringList first;
+    QStringList second;
+
+    Log::LogManager manager;
+    manager.registerLogger(new RecordingLogger {&first});
+    manager.registerLogger(new RecordingLogger {&second});
+
+    manager.logMessage(QStringLiteral("carbonservice.cpp"), QStringLiteral("calculateCarbon"), 42,
+                       Log::MessageType::Information, QStringLiteral("Hello"));
+
+    QCOMPARE(first.count(), 1);
+    QCOMPARE(first, second);
+
+    // Both loggers got the very same string, not two equal ones.
+    QCOMPARE(first.first().constData(), second.first().constData());
+}
+
+void LogManagerTest::textFormat()
+{
+    const QString text = RecordingLogger::makeMessage(QStringLiteral("C:\\leif\\services\\carbonservice.cpp"),
+                                                      QStringLiteral("calculateCarbon"), 42,
+                                                      Log::MessageType::Warning, QStringLiteral("Hello"));
+
+    const QRegularExpression format {QStringLiteral("^\\d{8} \\d\\d:\\d\\d:\\d\\d\\.\\d{3} \\[WRN\\] \\(carbonservice\\.cpp:42/calculateCarbon\\) - Hello$")};
+    QVERIFY2(format.match(text).hasMatch(), qPrintable(text));
+}
+
+void LogManagerTest::filterPassesRecordOn()
+{
+    QStringList lines;
+
+    Log::LogManager manager;
+    manager.registerLogger(new Log::LogFilterByFile {QStringLiteral("carbon"), new RecordingLogger {&lines}});
+
+    manager.logMessage(QStringLiteral("carbonservice.cpp"), QStringLiteral("f"), 1, Log::MessageType::Debug, QStringLiteral("in"));
+    manager.logMessage(QStringLiteral("settingsservice.cpp"), QStringLiteral("f"), 1, Log::MessageType::Debug, QStringLiteral("out"));
+
+    QCOMPARE(lines.count(), 1);
+    QVERIFY(lines.first().endsWith(QStringLiteral(" - in")));
+}
+
+void LogManagerTest::oldLoggersStillWork()
+{
+    QStringList messages;
+
+    Log::LogManager manager;
+    manager.registerLogger(new PlainLogger {&messages});
+
+    manager.logMessage(QStringLiteral("main.cpp"), QStringLiteral("main"), 1, Log::MessageType::Error, QStringLiteral("Hello"));
+
+    QCOMPARE(messages, QStringList {QStringLiteral("Hello")});
+}
+
+void LogManagerTest::siteBaseName()
+{
+    QCOMPARE(Log::LogSite::baseNameOf("C:\\leif\\services\\carbonservice.cpp"), "carbonservice.cpp");
+    QCOMPARE(Log::LogSite::baseNameOf("/home/leif/services/carbonservice.cpp"), "carbonservice.cpp");
+    QCOMPARE(Log::LogSite::baseNameOf("carbonservice.cpp"), "carbonservice.cpp");
+
+    static const Log::LogSite site {"../leif/services/carbonservice.cpp", "calculateCarbon", 42, Log::MessageType::Debug};
+    QCOMPARE(site.baseName(), "carbonservice.cpp");
+}
+
+void LogManagerTest::siteTextFormat()
+{
+    QStringList lines;
+
+    Log::LogManager manager;
+    manager.registerLogger(new RecordingLogger {&lines});
+
+    static const Log::LogSite site {"/home/leif/services/carbonservice.cpp", "calculateCarbon", 42, Log::MessageType::Warning};
+    manager.logMessage(site, QStringLiteral("Hello"));
+
+    QCOMPARE(lines.count(), 1);
+    QVERIFY2(lines.first().endsWith(QStringLiteral(" [WRN] (carbonservice.cpp:42/calculateCarbon) - Hello")),
+             qPrintable(lines.first()));
+}
+
+void LogManagerTest::siteFilterIsAskedOnce()
+{
+    int calls {0};
+    QStringList lines;
+
+    Log::LogManager manager;
+    manager.registerLogger(new CountingFilter {&calls, new RecordingLogger {&lines}});
+
+    static const Log::LogSite site {__FILE__, __FUNCTION__, __LINE__, Log::MessageType::Debug};
+    for(int i = 0; i < 3; ++i)
+    {
+        QVERIFY(manager.isEnabled(site));
+        manager.logMessage(site, QStringLiteral("Hello"));
+    }
+
+    QCOMPARE(calls, 1);
+    QCOMPARE(lines.count(), 3);
+}
+
+void LogManagerTest::siteCacheIsResetByRegisterLogger()
+{
+    QStringList carbon;
+    QStringList other;
+
+    Log::LogManager manager;
+    manager.registerLogger(new Log::LogFilterByFile {QStringLiteral("carbon"), new RecordingLogger {&carbon}});
+
+    static const Log::LogSite site {"settingsservice.cpp", "f", 1, Log::MessageType::Debug};
+    QVERIFY(!manager.isEnabled(site));
+
+    manager.registerLogger(new RecordingLogger {&other});
+    QVERIFY(manager.isEnabled(site));
+
+    manager.logMessage(site, QStringLiteral("Hello"));
+
+    QVERIFY(carbon.isEmpty());
+    QCOMPARE(other.count(), 1);
+}
+
+void LogManagerTest::siteRejectedByAllLoggers()
+{
+    QStringList lines;
+
+    static const Log::LogSite site {"settingsservice.cpp", "f", 1, Log::MessageType::Debug};
+
+    {
+        Log::LogManager manager;
+        QVERIFY(!manager.isEnabled(site));
+
+        manager.registerLogger(new Log::LogFilterByFile {QStringLiteral("carbon"), new RecordingLogger {&lines}});
+        QVERIFY(!manager.isEnabled(site));
+
+        manager.logMessage(site, QStringLiteral("Hello"));
+        QVERIFY(lines.isEmpty());
+    }
+
+    // A new manager doesn't inherit what the site cached for the old one.
+    Log::LogManager manager;
+    manager.registerLogger(new RecordingLogger {&lines});
+    QVERIFY(manager.isEnabled(site));
+}
+
+QTEST_MAIN(LogManagerTest)
+#include "tst_logmanager.moc"
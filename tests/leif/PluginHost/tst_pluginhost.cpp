@@ -0,0 +1,200 @@
+#include <QtTest>
+
+#include <fetchpolicy.h>
+#include <pluginhostprotocol.h>
+#include <remotecarbonplugin.h>
+
+class PluginHostTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PluginHostTest() = default;
+    virtual ~PluginHostTest() = default;
+
+private slots:
+    void requestRoundTrip();
+    void batchRequestRoundTrip();
+    void replyRoundTrip();
+    void resultRoundTrip();
+    void batchResultRoundTrip();
+    void partialFrameIsNotConsumed();
+    void corruptRequestIsRejected();
+    void slowHostIsNoFailure();
+};
+
+void PluginHostTest::requestRoundTrip()
+{
+    PluginHost::Request request;
+    request.id = 42;
+    request.country = QLocale::UnitedKingdom;
+    request.region = QStringLiteral("London");
+
+    PluginHost::Request decoded;
+    QVERIFY(PluginHost::decodeRequest(PluginHost::encodeRequest(request), decoded));
+
+    QCOMPARE(decoded.type, PluginHost::RequestType::Carbon);
+    QCOMPARE(decoded.id, 42u);
+    QCOMPARE(decoded.country, QLocale::UnitedKingdom);
+    QCOMPARE(decoded.region, QStringLiteral("London"));
+}
+
+void PluginHostTest::batchRequestRoundTrip()
+{
+    PluginHost::Request request;
+    request.type = PluginHost::RequestType::CarbonBatch;
+    request.id = 7;
+    request.country = QLocale::UnitedKingdom;
+    request.regions = QStringList {QStringLiteral("London"), QStringLiteral("Wales")};
+    request.from = QDateTime(QDate(2026, 10, 19), QTime(10, 0), Qt::UTC);
+    request.to = request.from.addSecs(90 * 60);
+
+    PluginHost::Request decoded;
+    QVERIFY(PluginHost::decodeRequest(PluginHost::encodeRequest(request), decoded));
+
+    QCOMPARE(decoded.type, PluginHost::RequestType::CarbonBatch);
+    QCOMPARE(decoded.regions, request.regions);
+    QCOMPARE(decoded.from, request.from);
+    QCOMPARE(decoded.to, request.to);
+}
+
+void PluginHostTest::replyRoundTrip()
+{
+    PluginHost::Reply reply;
+    reply.id = 3;
+    reply.result = PluginHost::encodeResult(CarbonData::ok(152, 147, 139, QDateTime(), QDateTime()));
+
+    PluginHost::Reply decoded;
+    QVERIFY(PluginHost::decodeReply(PluginHost::encodeReply(reply), decoded));
+
+    QCOMPARE(decoded.id, 3u);
+    QVERIFY(decoded.errorString.isEmpty());
+    QCOMPARE(decoded.result, reply.result);
+
+    PluginHost::Reply error;
+    error.id = 4;
+    error.errorString = QStringLiteral("The plugin host received an invalid request.");
+
+    QVERIFY(PluginHost::decodeReply(PluginHost::encodeReply(error), decoded));
+    QCOMPARE(decoded.id, 4u);
+    QCOMPARE(decoded.errorString, error.errorString);
+    QVERIFY(decoded.result.isEmpty());
+}
+
+void PluginHostTest::resultRoundTrip()
+{
+    const QDateTime from {QDate(2026, 10, 19), QTime(10, 0)};
+    CarbonData data = CarbonData::ok(152, 147, 139, from, from.addSecs(1800));
+    data.forecast = QList<int> {152, 147, 139, 120};
+    data.forecastIntervalInSeconds = 1800;
+
+    CarbonData decoded;
+    QVERIFY(PluginHost::decodeResult(PluginHost::encodeResult(data), decoded));
+
+    QVERIFY(decoded.isValid);
+    QCOMPARE(decoded.co2PerkWhNow, 152);
+    QCOMPARE(decoded.co2PerkWhNext, 147);
+    QCOMPARE(decoded.co2PerkWhLater, 139);
+    QCOMPARE(decoded.validFrom, data.validFrom);
+    QCOMPARE(decoded.validTo, data.validTo);
+    QCOMPARE(decoded.forecast, data.forecast);
+    QCOMPARE(decoded.forecastIntervalInSeconds, 1800);
+}
+
+void PluginHostTest::batchResultRoundTrip()
+{
+    QHash<QString, CarbonData> data;
+    data.insert(QStringLiteral("London"), CarbonData::ok(152, 147, 139, QDateTime(), QDateTime()));
+    data.insert(QStringLiteral("Atlantis"), CarbonData::error(QStringLiteral("Unknown region.")));
+
+    QHash<QString, CarbonData> decoded;
+    QVERIFY(PluginHost::decodeResult(PluginHost::encodeResult(data), decoded));
+
+    QCOMPARE(decoded.count(), 2);
+    QCOMPARE(decoded.value(QStringLiteral("London")).co2PerkWhNow, 152);
+    QVERIFY(!decoded.value(QStringLiteral("Atlantis")).isValid);
+    QCOMPARE(decoded.value(QStringLiteral("Atlantis")).errorString, QStringLiteral("Unknown region."));
+}
+
+void PluginHostTest::partialFrameIsNotConsumed()
+{
+    QBuffer written;
+    written.open(QIODevice::WriteOnly);
+    PluginHost::writeFrame(&written, QByteArray("hello"));
+    const QByteArray stream = written.data();
+
+    QBuffer buffer;
+    buffer.setData(stream.left(stream.size() - 1));
+    buffer.open(QIODevice::ReadOnly);
+
+    QByteArray frame;
+    QVERIFY(!PluginHost::readFrame(&buffer, frame));
+    QCOMPARE(buffer.pos(), qint64(0));
+
+    buffer.close();
+    buffer.setData(stream);
+    buffer.open(QIODevice::ReadOnly);
+
+    QVERIFY(PluginHost::readFrame(&buffer, frame));
+    QCOMPARE(frame, QByteArray("hello"));
+}
+
+void PluginHostTest::corruptRequestIsRejected()
+{
+    PluginHost::Request decoded;
+
+    QVERIFY(!PluginHost::decodeRequest(QByteArray(), decoded));
+    QVERIFY(!PluginHost::decodeRequest(QByteArray("\x09\x00\x00\x00\x01", 5), decoded));
+}
+
+void PluginHostTest::slowHostIsNoFailure()
+{
+#ifdef Q_OS_UNIX
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // A host that never connects.
+    QFile host {dir.filePath(QStringLiteral("slowhost"))};
+    QVERIFY(host.open(QIODevice::WriteOnly));
+    host.write("#!/bin/sh\nexec sleep 30\n");
+    host.close();
+    QVERIFY(host.setPermissions(host.permissions() | QFileDevice::ExeOwner));
+
+    qputenv("LEIF_PLUGIN_HOST", QFile::encodeName(host.fileName()));
+
+    RemoteCarbonPlugin plugin {QStringLiteral("libuk.so")};
+    QVERIFY(plugin.start());
+
+    // The manager records every result like this.
+    FetchPolicy policy {1};
+    const QDateTime now = QDateTime::currentDateTime();
+
+    for(int i = 0; i < FetchPolicy::FailureThreshold + 1; ++i)
+    {
+        QTest::qWait(100);
+
+        const CarbonData data = plugin.carbonPerKiloWatt(QLocale::UnitedKingdom, QStringLiteral("13"));
+        QVERIFY(!data.isValid);
+        QVERIFY(data.isPending);
+        policy.record(data, now);
+
+        const QHash<QString, CarbonData> batch = plugin.carbonPerKiloWatt(QLocale::UnitedKingdom, {QStringLiteral("13")},
+                                                                          now, now.addDays(1));
+        QVERIFY(batch.value(QStringLiteral("13")).isPending);
+    }
+
+    QCOMPARE(policy.failureCount(), 0);
+    QCOMPARE(policy.state(), FetchPolicy::State::Closed);
+
+    plugin.stop();
+    qunsetenv("LEIF_PLUGIN_HOST");
+
+    // The host is killed a second after it was stopped.
+    QTest::qWait(1500);
+#else
+    QSKIP("The slow host is a shell script.");
+#endif
+}
+
+QTEST_MAIN(PluginHostTest)
+#include "tst_pluginhost.moc"
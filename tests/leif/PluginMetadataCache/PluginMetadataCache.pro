@@ -0,0 +1,24 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../leif/plugin/pluginmetadatacache.cpp \
+           ../../../leif/utils/carbonplugindata.cpp     \
+           ../../../leif/utils/localeid.cpp             \
+           ../../../leif/utils/territory.cpp            \
+           ../../../leif/utils/translatedstring.cpp     \
+           ../../../leif/utils/translation.cpp          \
+           tst_pluginmetadatacache.cpp
+
+HEADERS = ../../../leif/plugin/pluginmetadatacache.h \
+          ../../../leif/utils/carbonplugindata.h     \
+          ../../../leif/utils/localeid.h             \
+          ../../../leif/utils/territory.h            \
+          ../../../leif/utils/translatedstring.h     \
+          ../../../leif/utils/translation.h
+
+INCLUDEPATH *= ../../../leif ../../../leif/plugin ../../../leif/utils
@@ -0,0 +1,185 @@
+#include <QtTest>
+
+#include <pluginmetadatacache.h>
+
+class PluginMetadataCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PluginMetadataCacheTest() = default;
+    virtual ~PluginMetadataCacheTest() = default;
+
+private slots:
+    void init();
+
+    void missingFileLeavesCacheEmpty();
+    void unknownPluginIsAMiss();
+    void savedEntryIsFoundAfterLoad();
+    void changedPluginIsAMiss();
+    void retainDropsRemovedPlugins();
+    void saveWithoutChangesKeepsFile();
+    void otherLocaleDropsCache();
+    void corruptFileLeavesCacheEmpty();
+
+private:
+    QString writePlugin(const QString &name, const QByteArray &content);
+    Utils::CarbonPluginData pluginData() const;
+
+private:
+    QScopedPointer<QTemporaryDir> m_dir;
+    QString m_cacheFile;
+};
+
+void PluginMetadataCacheTest::init()
+{
+    m_dir.reset(new QTemporaryDir());
+    QVERIFY(m_dir->isValid());
+
+    m_cacheFile = m_dir->filePath(QStringLiteral("cache/plugins.cache"));
+}
+
+void PluginMetadataCacheTest::missingFileLeavesCacheEmpty()
+{
+    PluginMetadataCache cache {m_cacheFile};
+
+    QVERIFY(!cache.load());
+    QVERIFY(cache.isEmpty());
+    QVERIFY(!cache.isDirty());
+}
+
+void PluginMetadataCacheTest::unknownPluginIsAMiss()
+{
+    PluginMetadataCache cache {m_cacheFile};
+    Utils::CarbonPluginData data {};
+
+    QVERIFY(!cache.lookup(QFileInfo(writePlugin("uk", "binary")), data));
+}
+
+void PluginMetadataCacheTest::savedEntryIsFoundAfterLoad()
+{
+    const QFileInfo plugin {writePlugin("uk", "binary")};
+
+    {
+        PluginMetadataCache cache {m_cacheFile};
+        cache.insert(plugin, pluginData());
+
+        QVERIFY(cache.isDirty());
+        QVERIFY(cache.save());
+        QVERIFY(!cache.isDirty());
+    }
+
+    PluginMetadataCache cache {m_cacheFile};
+    Utils::CarbonPluginData data {};
+
+    QVERIFY(cache.load());
+    QVERIFY(cache.lookup(plugin, data));
+    QCOMPARE(data.name(), pluginData().name());
+    QCOMPARE(data.regionIds(QLocale::UnitedKingdom), pluginData().regionIds(QLocale::UnitedKingdom));
+}
+
+void PluginMetadataCacheTest::changedPluginIsAMiss()
+{
+    const QString path {writePlugin("uk", "binary")};
+
+    PluginMetadataCache cache {m_cacheFile};
+    cache.insert(QFileInfo(path), pluginData());
+
+    writePlugin("uk", "a larger binary");
+
+    Utils::CarbonPluginData data {};
+    QVERIFY(!cache.lookup(QFileInfo(path), data));
+}
+
+void PluginMetadataCacheTest::retainDropsRemovedPlugins()
+{
+    const QString uk {writePlugin("uk", "binary")};
+    const QString de {writePlugin("de", "binary")};
+
+    PluginMetadataCache cache {m_cacheFile};
+    cache.insert(QFileInfo(uk), pluginData());
+    cache.insert(QFileInfo(de), pluginData());
+    QVERIFY(cache.save());
+
+    cache.retain({uk});
+
+    Utils::CarbonPluginData data {};
+    QVERIFY(cache.isDirty());
+    QVERIFY(cache.lookup(QFileInfo(uk), data));
+    QVERIFY(!cache.lookup(QFileInfo(de), data));
+}
+
+void PluginMetadataCacheTest::saveWithoutChangesKeepsFile()
+{
+    PluginMetadataCache cache {m_cacheFile};
+
+    QVERIFY(cache.save());
+    QVERIFY(!QFile::exists(m_cacheFile));
+}
+
+void PluginMetadataCacheTest::otherLocaleDropsCache()
+{
+    const QFileInfo plugin {writePlugin("uk", "binary")};
+
+    const QLocale systemLocale {};
+    auto cleanup = qScopeGuard([&systemLocale]() { QLocale::setDefault(systemLocale); });
+
+    QLocale::setDefault(QLocale(QStringLiteral("en_GB")));
+    {
+        PluginMetadataCache cache {m_cacheFile};
+        cache.insert(plugin, pluginData());
+        QVERIFY(cache.save());
+    }
+
+    QLocale::setDefault(QLocale(QStringLiteral("de_DE")));
+
+    PluginMetadataCache cache {m_cacheFile};
+    QVERIFY(!cache.load());
+    QVERIFY(cache.isEmpty());
+}
+
+void PluginMetadataCacheTest::corruptFileLeavesCacheEmpty()
+{
+    const QFileInfo plugin {writePlugin("uk", "binary")};
+
+    {
+        PluginMetadataCache cache {m_cacheFile};
+        cache.insert(plugin, pluginData());
+        QVERIFY(cache.save());
+    }
+
+    QFile file {m_cacheFile};
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() / 2));
+    file.close();
+
+    PluginMetadataCache cache {m_cacheFile};
+    QVERIFY(!cache.load());
+    QVERIFY(cache.isEmpty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+QString PluginMetadataCacheTest::writePlugin(const QString &name, const QByteArray &content)
+{
+    const QString path {m_dir->filePath(name + QStringLiteral(".so"))};
+
+    QFile file {path};
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return QString();
+
+    file.write(content);
+
+    return path;
+}
+
+Utils::CarbonPluginData PluginMetadataCacheTest::pluginData() const
+{
+    const QList<Utils::TranslatedString> regions {Utils::TranslatedString {QStringLiteral("London"), {}},
+                                                  Utils::TranslatedString {QStringLiteral("Wales"), {}}};
+
+    return Utils::CarbonPluginData {QStringLiteral("uk"), QStringLiteral("UK plugin"),
+                                    {Utils::Territory {QLocale::UnitedKingdom, QStringLiteral("UK"), regions}}};
+}
+
+QTEST_MAIN(PluginMetadataCacheTest)
+#include "tst_pluginmetadatacache.moc"
@@ -0,0 +1,11 @@
+QT += testlib quick qml
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+# The page is loaded from the sources, with stand-ins for the Leif modules.
+DEFINES += LEIF_QML_DIR=\\\"$$PWD/../../../leif/qml\\\"
+
+SOURCES =  tst_statuspage.cpp
@@ -0,0 +1,154 @@
+#include <QtTest>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+
+namespace
+{
+// The page in a window, like Leif.qml shows it.
+const QByteArray PageWindow = R"(
+import QtQuick
+import QtQuick.Window
+
+Window {
+    width: 640
+    height: 480
+
+    Item {
+        id: stateHandler
+        property string state: "STATUS"
+    }
+
+    Item {
+        anchors.fill: parent
+
+        StatusPage {
+            objectName: "statusPage"
+        }
+    }
+}
+)";
+}
+
+class FakeCarbonController : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(float sessionCarbon MEMBER m_sessionCarbon NOTIFY carbonChanged)
+    Q_PROPERTY(float lifetimeCarbon MEMBER m_lifetimeCarbon NOTIFY carbonChanged)
+
+public:
+    void setCarbon(float session, float lifetime)
+    {
+        m_sessionCarbon = session;
+        m_lifetimeCarbon = lifetime;
+        emit carbonChanged();
+    }
+
+signals:
+    void carbonChanged();
+
+private:
+    float m_sessionCarbon {0};
+    float m_lifetimeCarbon {0};
+};
+
+class StatusPageTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    StatusPageTest() = default;
+    virtual ~StatusPageTest() = default;
+
+    static void initMain();
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void animatesWhileShown();
+    void jumpsWhileHidden();
+
+private:
+    double sessionDisplay() const;
+
+private:
+    FakeCarbonController m_controller;
+    QQmlEngine *m_engine {nullptr};
+    QQuickWindow *m_window {nullptr};
+    QQuickItem *m_page {nullptr};
+};
+
+/* static */
+void StatusPageTest::initMain()
+{
+    if(!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+}
+
+void StatusPageTest::initTestCase()
+{
+    qmlRegisterModule("Leif", 1, 0);
+    qmlRegisterSingletonInstance<FakeCarbonController>("Leif.Controllers", 1, 0, "CarbonController", &m_controller);
+}
+
+void StatusPageTest::init()
+{
+    m_engine = new QQmlEngine;
+
+    QQmlComponent component {m_engine};
+    component.setData(PageWindow, QUrl::fromLocalFile(QStringLiteral(LEIF_QML_DIR "/tst_statuspage.qml")));
+
+    m_window = qobject_cast<QQuickWindow*>(component.create());
+    QVERIFY2(m_window != nullptr, qPrintable(component.errorString()));
+
+    m_page = m_window->findChild<QQuickItem*>(QStringLiteral("statusPage"));
+    QVERIFY(m_page != nullptr);
+
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+    QTRY_VERIFY(m_page->isVisible());
+}
+
+void StatusPageTest::cleanup()
+{
+    delete m_window;
+    m_window = nullptr;
+    m_page = nullptr;
+
+    delete m_engine;
+    m_engine = nullptr;
+}
+
+void StatusPageTest::animatesWhileShown()
+{
+    const double from = sessionDisplay();
+    m_controller.setCarbon(from + 10, 100);
+
+    // The number counts up instead of jumping.
+    QVERIFY(sessionDisplay() < from + 10);
+    QTRY_COMPARE(sessionDisplay(), from + 10);
+}
+
+void StatusPageTest::jumpsWhileHidden()
+{
+    m_window->hide();
+    QTRY_COMPARE(m_window->visibility(), QWindow::Hidden);
+
+    const double to = sessionDisplay() + 10;
+    m_controller.setCarbon(to, 200);
+
+    QCOMPARE(sessionDisplay(), to);
+}
+
+double StatusPageTest::sessionDisplay() const
+{
+    return m_page->property("sessionDisplay").toDouble();
+}
+
+QTEST_MAIN(StatusPageTest)
+#include "tst_statuspage.moc"
@@ -0,0 +1,146 @@
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <trace.h>
+
+class TraceTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    TraceTest() = default;
+    virtual ~TraceTest() = default;
+
+private slots:
+    void init();
+    void cleanup();
+
+    void disabledSpanRecordsNothing();
+    void spanIsRecorded();
+    void nestedSpansAreContained();
+    void threadsHaveTheirOwnBuffer();
+    void fullBufferKeepsRecentSpans();
+
+private:
+    static QList<QJsonObject> spans(const QString &name = QString());
+};
+
+void TraceTest::init()
+{
+    Log::Trace::clear();
+}
+
+void TraceTest::cleanup()
+{
+    Log::Trace::setEnabled(false);
+}
+
+void TraceTest::disabledSpanRecordsNothing()
+{
+    QVERIFY(!Log::Trace::isEnabled());
+
+    {
+        TRACE_SPAN("disabled");
+    }
+
+    QVERIFY(spans().isEmpty());
+}
+
+void TraceTest::spanIsRecorded()
+{
+    Log::Trace::setEnabled(true);
+
+    {
+        TRACE_SPAN("sleep");
+        QThread::msleep(5);
+    }
+
+    const QList<QJsonObject> recorded = spans(QStringLiteral("sleep"));
+    QCOMPARE(recorded.count(), 1);
+    QCOMPARE(recorded.first().value("ph").toString(), QStringLiteral("X"));
+    QCOMPARE(recorded.first().value("cat").toString(), QStringLiteral("leif"));
+    QVERIFY(recorded.first().value("dur").toDouble() >= 4000);
+}
+
+void TraceTest::nestedSpansAreContained()
+{
+    Log::Trace::setEnabled(true);
+
+    {
+        TRACE_SPAN("outer");
+        {
+            TRACE_SPAN("inner");
+        }
+    }
+
+    const QJsonObject outer = spans(QStringLiteral("outer")).value(0);
+    const QJsonObject inner = spans(QStringLiteral("inner")).value(0);
+
+    const double outerStart = outer.value("ts").toDouble();
+    const double innerStart = inner.value("ts").toDouble();
+    QVERIFY(innerStart >= outerStart);
+    QVERIFY(innerStart + inner.value("dur").toDouble() <= outerStart + outer.value("dur").toDouble());
+}
+
+void TraceTest::threadsHaveTheirOwnBuffer()
+{
+    Log::Trace::setEnabled(true);
+
+    {
+        TRACE_SPAN("main");
+    }
+
+    QThread *thread = QThread::create([]() { TRACE_SPAN("worker"); });
+    thread->start();
+    QVERIFY(thread->wait(5000));
+    delete thread;
+
+    // The spans of a finished thread are kept.
+    const QList<QJsonObject> main = spans(QStringLiteral("main"));
+    const QList<QJsonObject> worker = spans(QStringLiteral("worker"));
+    QCOMPARE(main.count(), 1);
+    QCOMPARE(worker.count(), 1);
+    QVERIFY(main.first().value("tid") != worker.first().value("tid"));
+}
+
+void TraceTest::fullBufferKeepsRecentSpans()
+{
+    Log::Trace::setEnabled(true);
+
+    for(int i = 0; i < Log::Trace::MaxEventsPerThread; ++i)
+    {
+        TRACE_SPAN("old");
+    }
+
+    {
+        TRACE_SPAN("new");
+    }
+
+    QCOMPARE(spans(QStringLiteral("old")).count(), Log::Trace::MaxEventsPerThread - 1);
+    QCOMPARE(spans(QStringLiteral("new")).count(), 1);
+}
+
+/**
+ * @brief Returns the complete events of the trace, only those called \p name
+ * if given.
+ */
+/* static */
+QList<QJsonObject> TraceTest::spans(const QString &name /* = QString() */)
+{
+    const QJsonDocument document = QJsonDocument::fromJson(Log::Trace::toChromeJson());
+
+    QList<QJsonObject> result;
+    for(const QJsonValue &value : document.object().value("traceEvents").toArray())
+    {
+        const QJsonObject event = value.toObject();
+        if(event.value("ph").toString() == QStringLiteral("X") && (name.isEmpty() || event.value("name").toString() == name))
+            result << event;
+    }
+
+    return result;
+}
+
+QTEST_MAIN(TraceTest)
+#include "tst_trace.moc"
@@ -1,3 +1,5 @@
 TEMPLATE = subdirs
 
-SUBDIRS = CarbonData utils
+SUBDIRS = CarbonData CarbonService FetchPolicy LogManager PluginHost PluginMetadataCache StatusPage Trace utils
+
+linux: SUBDIRS += linux
@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../../leif/linux/powersupply.cpp \
+           tst_powersupply.cpp
+
+HEADERS = ../../../../leif/linux/powersupply.h
+
+INCLUDEPATH *= ../../../../leif/linux
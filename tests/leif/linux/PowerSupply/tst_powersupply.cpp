@@ -0,0 +1,186 @@
+#include <QtTest>
+
+#include <powersupply.h>
+
+using Status = PowerSupply::Status;
+
+class PowerSupplyTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PowerSupplyTest() = default;
+    virtual ~PowerSupplyTest() = default;
+
+private slots:
+    void init();
+
+    void missingSysfsDirFails();
+    void desktopHasNoBattery();
+    void powerAndEnergyAreRead();
+    void currentAndChargeAreConverted();
+    void batteriesAreSummed();
+    void deviceBatteriesAreIgnored();
+    void absentBatteryIsIgnored();
+    void adapterPowerIsRead();
+    void statusIsParsed();
+
+    void statusIsParsed_data();
+
+private:
+    void writeSupply(const QString &name, const QHash<QByteArray, QByteArray> &values);
+
+private:
+    QScopedPointer<QTemporaryDir> _sysfs;
+};
+
+void PowerSupplyTest::init()
+{
+    _sysfs.reset(new QTemporaryDir());
+    QVERIFY(_sysfs->isValid());
+}
+
+void PowerSupplyTest::missingSysfsDirFails()
+{
+    PowerSupply supply {_sysfs->filePath("missing")};
+
+    QVERIFY(!supply.read());
+    QVERIFY(!supply.hasBattery());
+}
+
+void PowerSupplyTest::desktopHasNoBattery()
+{
+    writeSupply("AC", {{"type", "Mains"}, {"online", "1"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QVERIFY(!supply.hasBattery());
+    QVERIFY(supply.isOnline());
+}
+
+void PowerSupplyTest::powerAndEnergyAreRead()
+{
+    writeSupply("AC", {{"type", "Mains"}, {"online", "0"}});
+    writeSupply("BAT0", {{"type", "Battery"}, {"status", "Discharging"},
+                         {"power_now", "12500000"}, {"energy_now", "41000000"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QVERIFY(supply.hasBattery());
+    QVERIFY(!supply.isOnline());
+    QCOMPARE(supply.status(), Status::Discharging);
+    QCOMPARE(supply.powerInMilliWatts(), 12500);
+    QCOMPARE(supply.energyInMilliWattHours(), 41000);
+}
+
+void PowerSupplyTest::currentAndChargeAreConverted()
+{
+    // Some drivers report a negative current while discharging.
+    writeSupply("BAT0", {{"type", "Battery"}, {"status", "Discharging"}, {"voltage_now", "12000000"},
+                         {"current_now", "-1000000"}, {"charge_now", "3000000"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QCOMPARE(supply.powerInMilliWatts(), 12000);
+    QCOMPARE(supply.energyInMilliWattHours(), 36000);
+}
+
+void PowerSupplyTest::batteriesAreSummed()
+{
+    writeSupply("BAT0", {{"type", "Battery"}, {"status", "Full"}, {"power_now", "0"}, {"energy_now", "20000000"}});
+    writeSupply("BAT1", {{"type", "Battery"}, {"status", "Charging"}, {"power_now", "15000000"}, {"energy_now", "10000000"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QCOMPARE(supply.status(), Status::Charging);
+    QCOMPARE(supply.powerInMilliWatts(), 15000);
+    QCOMPARE(supply.energyInMilliWattHours(), 30000);
+}
+
+void PowerSupplyTest::deviceBatteriesAreIgnored()
+{
+    writeSupply("hidpp_battery_0", {{"type", "Battery"}, {"scope", "Device"}, {"status", "Discharging"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QVERIFY(!supply.hasBattery());
+}
+
+void PowerSupplyTest::absentBatteryIsIgnored()
+{
+    writeSupply("BAT1", {{"type", "Battery"}, {"present", "0"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QVERIFY(!supply.hasBattery());
+}
+
+void PowerSupplyTest::adapterPowerIsRead()
+{
+    writeSupply("AC", {{"type", "Mains"}, {"online", "1"}});
+    writeSupply("ucsi-source-psy-USBC000:001", {{"type", "USB"}, {"online", "1"},
+                                                {"voltage_now", "20000000"}, {"current_now", "1500000"}});
+    writeSupply("ucsi-source-psy-USBC000:002", {{"type", "USB"}, {"online", "0"}, {"power_now", "5000000"}});
+    writeSupply("BAT0", {{"type", "Battery"}, {"status", "Full"}, {"power_now", "0"}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QCOMPARE(supply.powerInMilliWatts(), 0);
+    QCOMPARE(supply.adapterPowerInMilliWatts(), 30000);
+
+    // Most adapters don't tell.
+    writeSupply("ucsi-source-psy-USBC000:001", {{"online", "0"}});
+
+    QVERIFY(supply.read());
+    QCOMPARE(supply.adapterPowerInMilliWatts(), 0);
+}
+
+void PowerSupplyTest::statusIsParsed()
+{
+    QFETCH(QByteArray, status);
+    QFETCH(Status, expected);
+
+    writeSupply("BAT0", {{"type", "Battery"}, {"status", status}});
+
+    PowerSupply supply {_sysfs->path()};
+
+    QVERIFY(supply.read());
+    QCOMPARE(supply.status(), expected);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PowerSupplyTest::statusIsParsed_data()
+{
+    QTest::addColumn<QByteArray>("status");
+    QTest::addColumn<Status>("expected");
+
+    QTest::addRow("charging") << QByteArray("Charging") << Status::Charging;
+    QTest::addRow("discharging") << QByteArray("Discharging") << Status::Discharging;
+    QTest::addRow("notCharging") << QByteArray("Not charging") << Status::NotCharging;
+    QTest::addRow("full") << QByteArray("Full") << Status::Full;
+    QTest::addRow("unknown") << QByteArray("Unknown") << Status::Unknown;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PowerSupplyTest::writeSupply(const QString &name, const QHash<QByteArray, QByteArray> &values)
+{
+    QDir dir {_sysfs->path()};
+    QVERIFY(dir.mkpath(name));
+
+    for(auto it = values.cbegin(); it != values.cend(); ++it)
+    {
+        QFile file {dir.filePath(name + QLatin1Char('/') + QString::fromLatin1(it.key()))};
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(it.value() + '\n');
+    }
+}
+
+QTEST_MAIN(PowerSupplyTest)
+#include "tst_powersupply.moc"
@@ -0,0 +1,188 @@
+#include <QtTest>
+
+#include <processsampler.h>
+
+class ProcessSamplerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProcessSamplerTest() = default;
+    virtual ~ProcessSamplerTest() = default;
+
+private slots:
+    void init();
+
+    void missingProcDirFails();
+    void firstSampleOnlyRecordsBaseline();
+    void ticksAreSummedPerApplication();
+    void processNameWithSpacesAndParentheses();
+    void reusedPidIsTreatedAsNewProcess();
+    void exitedProcessesAreForgotten();
+    void applicationIsTakenFromCgroup();
+
+    void applicationIsTakenFromCgroup_data();
+
+private:
+    void writeProcess(int pid, const QByteArray &comm, quint64 utime, quint64 stime,
+                      quint64 startTime = 100, const QByteArray &cgroup = QByteArray());
+    void removeProcess(int pid);
+
+private:
+    QScopedPointer<QTemporaryDir> _proc;
+};
+
+void ProcessSamplerTest::init()
+{
+    _proc.reset(new QTemporaryDir());
+    QVERIFY(_proc->isValid());
+}
+
+void ProcessSamplerTest::missingProcDirFails()
+{
+    ProcessSampler sampler {_proc->filePath("missing")};
+
+    QVERIFY(!sampler.sample());
+}
+
+void ProcessSamplerTest::firstSampleOnlyRecordsBaseline()
+{
+    writeProcess(1, "init", 50, 50);
+
+    ProcessSampler sampler {_proc->path()};
+
+    QVERIFY(sampler.sample());
+    QVERIFY(sampler.applicationTicks().isEmpty());
+    QCOMPARE(sampler.totalTicks(), Q_UINT64_C(0));
+}
+
+void ProcessSamplerTest::ticksAreSummedPerApplication()
+{
+    writeProcess(10, "firefox", 100, 10);
+    writeProcess(11, "firefox", 200, 20);
+    writeProcess(12, "bash", 5, 5);
+
+    ProcessSampler sampler {_proc->path()};
+    QVERIFY(sampler.sample());
+
+    writeProcess(10, "firefox", 130, 20);
+    writeProcess(11, "firefox", 210, 20);
+    writeProcess(12, "bash", 5, 5);
+
+    QVERIFY(sampler.sample());
+    QCOMPARE(sampler.applicationTicks().value("firefox"), Q_UINT64_C(50));
+    QVERIFY(!sampler.applicationTicks().contains("bash"));
+    QCOMPARE(sampler.totalTicks(), Q_UINT64_C(50));
+}
+
+void ProcessSamplerTest::processNameWithSpacesAndParentheses()
+{
+    writeProcess(20, "Web Content (x)", 10, 0);
+
+    ProcessSampler sampler {_proc->path()};
+    QVERIFY(sampler.sample());
+
+    writeProcess(20, "Web Content (x)", 25, 5);
+
+    QVERIFY(sampler.sample());
+    QCOMPARE(sampler.applicationTicks().value("Web Content (x)"), Q_UINT64_C(20));
+}
+
+void ProcessSamplerTest::reusedPidIsTreatedAsNewProcess()
+{
+    writeProcess(30, "make", 500, 100, 100);
+
+    ProcessSampler sampler {_proc->path()};
+    QVERIFY(sampler.sample());
+
+    // Same pid, later start time and fewer ticks: a different process.
+    writeProcess(30, "cc1plus", 40, 2, 900);
+
+    QVERIFY(sampler.sample());
+    QCOMPARE(sampler.applicationTicks().value("cc1plus"), Q_UINT64_C(42));
+    QVERIFY(!sampler.applicationTicks().contains("make"));
+}
+
+void ProcessSamplerTest::exitedProcessesAreForgotten()
+{
+    writeProcess(40, "short", 10, 0);
+    writeProcess(41, "long", 10, 0);
+
+    ProcessSampler sampler {_proc->path()};
+    QVERIFY(sampler.sample());
+
+    removeProcess(40);
+    writeProcess(41, "long", 20, 0);
+
+    QVERIFY(sampler.sample());
+    QCOMPARE(sampler.totalTicks(), Q_UINT64_C(10));
+    QCOMPARE(sampler.applicationTicks().count(), 1);
+}
+
+void ProcessSamplerTest::applicationIsTakenFromCgroup()
+{
+    QFETCH(QByteArray, cgroup);
+    QFETCH(QString, application);
+
+    writeProcess(50, "worker", 0, 0, 100, cgroup);
+
+    ProcessSampler sampler {_proc->path()};
+    QVERIFY(sampler.sample());
+
+    writeProcess(50, "worker", 7, 0, 100, cgroup);
+
+    QVERIFY(sampler.sample());
+    QCOMPARE(sampler.applicationTicks().value(application), Q_UINT64_C(7));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProcessSamplerTest::applicationIsTakenFromCgroup_data()
+{
+    QTest::addColumn<QByteArray>("cgroup");
+    QTest::addColumn<QString>("application");
+
+    QTest::addRow("none") << QByteArray() << "worker";
+    QTest::addRow("service") << QByteArray("0::/system.slice/cups.service\n") << "cups";
+    QTest::addRow("appScope")
+        << QByteArray("0::/user.slice/user-1000.slice/user@1000.service/app.slice/app-org.gnome.Terminal-4242.scope\n")
+        << "org.gnome.Terminal";
+    QTest::addRow("templateService")
+        << QByteArray("0::/user.slice/user-1000.slice/user@1000.service\n") << "worker";
+    QTest::addRow("session") << QByteArray("0::/user.slice/user-1000.slice/session-2.scope\n") << "worker";
+    QTest::addRow("cgroupV1") << QByteArray("12:cpu,cpuacct:/system.slice/sshd.service\n") << "sshd";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProcessSamplerTest::writeProcess(int pid, const QByteArray &comm, quint64 utime, quint64 stime,
+                                      quint64 startTime /* = 100 */, const QByteArray &cgroup /* = QByteArray() */)
+{
+    QDir proc {_proc->path()};
+    QVERIFY(proc.mkpath(QString::number(pid)));
+
+    // pid (comm) state ppid pgrp session tty tpgid flags minflt cminflt majflt
+    // cmajflt utime stime cutime cstime priority nice threads itrealvalue starttime
+    const QByteArray stat = QByteArray::number(pid) + " (" + comm + ") S 1 1 1 0 -1 0 0 0 0 0 "
+                            + QByteArray::number(utime) + ' ' + QByteArray::number(stime)
+                            + " 0 0 20 0 1 0 " + QByteArray::number(startTime) + " 0 0\n";
+
+    QFile statFile {proc.filePath(QString("%1/stat").arg(pid))};
+    QVERIFY(statFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    statFile.write(stat);
+    statFile.close();
+
+    if(cgroup.isEmpty())
+        return;
+
+    QFile cgroupFile {proc.filePath(QString("%1/cgroup").arg(pid))};
+    QVERIFY(cgroupFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    cgroupFile.write(cgroup);
+}
+
+void ProcessSamplerTest::removeProcess(int pid)
+{
+    QDir process {_proc->filePath(QString::number(pid))};
+    QVERIFY(process.removeRecursively());
+}
+
+QTEST_MAIN(ProcessSamplerTest)
+#include "tst_processsampler.moc"
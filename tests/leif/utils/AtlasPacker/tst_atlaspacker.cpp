@@ -0,0 +1,112 @@
+#include <QtTest>
+
+#include <atlaspacker.h>
+
+class AtlasPackerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    AtlasPackerTest() = default;
+    virtual ~AtlasPackerTest() = default;
+
+private slots:
+    void emptyListGivesEmptyAtlas();
+    void rectsKeepTheInputOrder();
+    void rowsWrapAtMaximumWidth();
+    void imagesDontOverlap();
+    void imagesKeepPaddingToTheBorder();
+    void tooWideImageFails();
+    void invalidImageFails();
+};
+
+void AtlasPackerTest::emptyListGivesEmptyAtlas()
+{
+    Utils::AtlasPacker packer;
+
+    QVERIFY(packer.pack({}));
+    QVERIFY(packer.rects().isEmpty());
+    QVERIFY(packer.size().isEmpty());
+}
+
+void AtlasPackerTest::rectsKeepTheInputOrder()
+{
+    Utils::AtlasPacker packer {256, 1};
+
+    QVERIFY(packer.pack({QSize(32, 24), QSize(48, 48), QSize(32, 24)}));
+
+    const QList<QRect> rects = packer.rects();
+    QCOMPARE(rects.count(), 3);
+
+    // The highest image goes first, the others keep their order.
+    QCOMPARE(rects.at(1), QRect(1, 1, 48, 48));
+    QCOMPARE(rects.at(0), QRect(50, 1, 32, 24));
+    QCOMPARE(rects.at(2), QRect(83, 1, 32, 24));
+    QCOMPARE(packer.size(), QSize(116, 50));
+}
+
+void AtlasPackerTest::rowsWrapAtMaximumWidth()
+{
+    Utils::AtlasPacker packer {100, 1};
+
+    QVERIFY(packer.pack(QList<QSize>(4, QSize(32, 24))));
+
+    const QList<QRect> rects = packer.rects();
+    QCOMPARE(rects.at(2).topLeft(), QPoint(67, 1));
+    QCOMPARE(rects.at(3).topLeft(), QPoint(1, 26));
+    QCOMPARE(packer.size(), QSize(100, 51));
+}
+
+void AtlasPackerTest::imagesDontOverlap()
+{
+    QList<QSize> sizes;
+    for(int i = 0; i < 200; ++i)
+    {
+        sizes << QSize(16 + i % 24, 12 + i % 17);
+    }
+
+    Utils::AtlasPacker packer {256, 1};
+    QVERIFY(packer.pack(sizes));
+
+    const QList<QRect> rects = packer.rects();
+    const QRect atlas {QPoint(0, 0), packer.size()};
+
+    for(qsizetype i = 0; i < rects.count(); ++i)
+    {
+        QCOMPARE(rects.at(i).size(), sizes.at(i));
+        QVERIFY(atlas.contains(rects.at(i)));
+
+        for(qsizetype j = i + 1; j < rects.count(); ++j)
+        {
+            QVERIFY2(!rects.at(i).adjusted(-1, -1, 1, 1).intersects(rects.at(j)),
+                     qPrintable(QString("%1 and %2 touch").arg(i).arg(j)));
+        }
+    }
+}
+
+void AtlasPackerTest::imagesKeepPaddingToTheBorder()
+{
+    Utils::AtlasPacker packer {256, 2};
+
+    QVERIFY(packer.pack({QSize(32, 24)}));
+    QCOMPARE(packer.rects().first(), QRect(2, 2, 32, 24));
+    QCOMPARE(packer.size(), QSize(36, 28));
+}
+
+void AtlasPackerTest::tooWideImageFails()
+{
+    Utils::AtlasPacker packer {64, 1};
+
+    QVERIFY(!packer.pack({QSize(32, 24), QSize(63, 24)}));
+    QVERIFY(packer.rects().isEmpty());
+}
+
+void AtlasPackerTest::invalidImageFails()
+{
+    Utils::AtlasPacker packer;
+
+    QVERIFY(!packer.pack({QSize(32, 24), QSize(0, 24)}));
+}
+
+QTEST_MAIN(AtlasPackerTest)
+#include "tst_atlaspacker.moc"
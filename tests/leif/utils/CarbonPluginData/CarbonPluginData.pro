@@ -9,12 +9,14 @@ TEMPLATE = app
 SOURCES =  ../../../../leif/utils/carbonplugindata.cpp \
            ../../../../leif/utils/translatedstring.cpp \
            ../../../../leif/utils/translation.cpp      \
+           ../../../../leif/utils/localeid.cpp         \
            ../../../../leif/utils/territory.cpp        \
            tst_carbonplugindata.cpp
 
 HEADERS = ../../../../leif/utils/carbonplugindata.h \
           ../../../../leif/utils/translatedstring.h \
           ../../../../leif/utils/translation.h      \
+          ../../../../leif/utils/localeid.h         \
           ../../../../leif/utils/territory.h        \
           ../common/common.h
 
@@ -30,6 +30,7 @@ private slots:
     void regionIdsReturnsTheCorrectStringListForAGivenTerritory();
     void translatedRegionIdReturnsCorrectValuesForATerritoryAndRegionId();
     void fromJsonReturnsAnObjectWithNameDescriptionAndTerritories();
+    void dataStreamRoundTripKeepsAllFields();
 
     void ctorCreatesObjectWithGivenArguments_data();
     void isValidReturnsCorrectValueDependingOnNameAndTerritories_data();
@@ -42,6 +43,7 @@ private slots:
     void regionIdsReturnsTheCorrectStringListForAGivenTerritory_data();
     void translatedRegionIdReturnsCorrectValuesForATerritoryAndRegionId_data();
     void fromJsonReturnsAnObjectWithNameDescriptionAndTerritories_data();
+    void dataStreamRoundTripKeepsAllFields_data();
 
 private:
     static bool compareTerritoryLists(const QList<Utils::Territory> &lhs, const QList<Utils::Territory> &rhs);
@@ -210,6 +212,30 @@ void CarbonPluginDataTest::fromJsonReturnsAnObjectWithNameDescriptionAndTerritor
     QVERIFY(CarbonPluginDataTest::compareTerritoryLists(cpd.territories(), territories));
 }
 
+void CarbonPluginDataTest::dataStreamRoundTripKeepsAllFields()
+{
+    QFETCH(QString, name);
+    QFETCH(QString, description);
+    QFETCH(QList<Utils::Territory>, territories);
+
+    const Utils::CarbonPluginData cpd {name, description, territories};
+
+    QByteArray buffer;
+    {
+        QDataStream out(&buffer, QIODevice::WriteOnly);
+        out << cpd;
+    }
+
+    Utils::CarbonPluginData restored {};
+    QDataStream in(buffer);
+    in >> restored;
+
+    QCOMPARE(in.status(), QDataStream::Ok);
+    QCOMPARE(restored.name(), name);
+    QCOMPARE(restored.description(), description);
+    QVERIFY(compareTerritoryLists(restored.territories(), territories));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void CarbonPluginDataTest::ctorCreatesObjectWithGivenArguments_data()
 {
@@ -512,6 +538,18 @@ bool CarbonPluginDataTest::compareTerritoryLists(const QList<Utils::Territory> &
     return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), predicate);
 }
 
+void CarbonPluginDataTest::dataStreamRoundTripKeepsAllFields_data()
+{
+    genericConstructorData();
+
+    QList<Utils::TranslatedString> regions {Utils::TranslatedString {QStringLiteral("London"), {}},
+                                            Utils::TranslatedString {QStringLiteral("Wales"),
+                                                                     {Utils::Translation {QStringLiteral("Cymru"), QLocale()}}}};
+    QList<Utils::Territory> territories {Utils::Territory {QLocale::UnitedKingdom, QStringLiteral("UK"), regions}};
+
+    QTest::addRow("regions") << QStringLiteral("uk") << QStringLiteral("UK plugin") << territories;
+}
+
 void CarbonPluginDataTest::genericConstructorData()
 {
     QTest::addColumn<QString>("name");
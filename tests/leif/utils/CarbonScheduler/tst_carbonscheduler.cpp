@@ -0,0 +1,160 @@
+#include <QtTest>
+
+#include <carbonscheduler.h>
+
+class CarbonSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CarbonSchedulerTest() = default;
+    virtual ~CarbonSchedulerTest() = default;
+
+private slots:
+    void initTestCase();
+
+    void findsLowestWindow();
+    void findsLowestWindow_data();
+    void deadlineLimitsTheWindow();
+    void startInsideASlotIsWeighted();
+    void gramsUseTheJobEnergy();
+    void tieTakesTheEarlierStart();
+    void jobLongerThanForecastFails();
+    void invalidForecastFails();
+    void nowNextLaterIsUsedWithoutSeries();
+    void seriesEndsAtUnknownValue();
+
+private:
+    CarbonData forecast(const QList<int> &series) const;
+
+private:
+    QDateTime m_start;
+};
+
+void CarbonSchedulerTest::initTestCase()
+{
+    m_start = QDateTime(QDate(2026, 10, 19), QTime(10, 0), Qt::UTC);
+}
+
+void CarbonSchedulerTest::findsLowestWindow()
+{
+    QFETCH(int, duration);
+    QFETCH(int, expectedOffset);
+    QFETCH(double, expectedAverage);
+
+    const CarbonData data = forecast({300, 200, 100, 100, 250, 50, 400});
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(data, m_start, duration, 0, QDateTime());
+
+    QVERIFY2(schedule.isValid(), qPrintable(schedule.errorString()));
+    QCOMPARE(schedule.start(), m_start.addSecs(expectedOffset));
+    QCOMPARE(schedule.end(), schedule.start().addSecs(duration));
+    QVERIFY(qAbs(schedule.averageIntensity() - expectedAverage) < 0.01);
+}
+
+void CarbonSchedulerTest::deadlineLimitsTheWindow()
+{
+    const CarbonData data = forecast({300, 200, 100, 100, 250, 50, 400});
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(data, m_start, 3600, 0, m_start.addSecs(3 * 1800));
+
+    QVERIFY(schedule.isValid());
+    QCOMPARE(schedule.start(), m_start.addSecs(1800));
+    QVERIFY(schedule.end() <= m_start.addSecs(3 * 1800));
+    QVERIFY(qAbs(schedule.averageIntensity() - 150.0) < 0.01);
+}
+
+void CarbonSchedulerTest::startInsideASlotIsWeighted()
+{
+    const CarbonData data = forecast({300, 200, 100, 100, 250, 50, 400});
+    const QDateTime earliest = m_start.addSecs(2 * 1800 + 900);
+
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(data, earliest, 3600, 0, QDateTime());
+
+    // 900s at 100, 1800s at 100 and 900s at 250.
+    QVERIFY(schedule.isValid());
+    QCOMPARE(schedule.start(), earliest);
+    QVERIFY(qAbs(schedule.averageIntensity() - 137.5) < 0.01);
+}
+
+void CarbonSchedulerTest::gramsUseTheJobEnergy()
+{
+    const CarbonData data = forecast({300, 200, 100, 100});
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(data, m_start, 3600, 2.0, QDateTime());
+
+    QVERIFY(schedule.isValid());
+    QVERIFY(qAbs(schedule.grams() - 200.0) < 0.01);
+    QVERIFY(qAbs(schedule.gramsIfStartedNow() - 500.0) < 0.01);
+}
+
+void CarbonSchedulerTest::tieTakesTheEarlierStart()
+{
+    const CarbonData data = forecast({100, 100, 100, 100});
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(data, m_start, 1800, 0, QDateTime());
+
+    QVERIFY(schedule.isValid());
+    QCOMPARE(schedule.start(), m_start);
+}
+
+void CarbonSchedulerTest::jobLongerThanForecastFails()
+{
+    const CarbonData data = forecast({100, 200});
+
+    QVERIFY(!Utils::CarbonScheduler::findWindow(data, m_start, 3 * 1800, 0, QDateTime()).isValid());
+    QVERIFY(!Utils::CarbonScheduler::findWindow(data, m_start, 1800, 0, m_start.addSecs(900)).isValid());
+    QVERIFY(!Utils::CarbonScheduler::findWindow(data, m_start, 0, 0, QDateTime()).isValid());
+}
+
+void CarbonSchedulerTest::invalidForecastFails()
+{
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(CarbonData::error(QStringLiteral("Offline.")),
+                                                                              m_start, 1800, 0, QDateTime());
+
+    QVERIFY(!schedule.isValid());
+    QVERIFY(!schedule.errorString().isEmpty());
+}
+
+void CarbonSchedulerTest::nowNextLaterIsUsedWithoutSeries()
+{
+    const CarbonData data = CarbonData::ok(300, 100, 200, m_start, m_start.addSecs(1800));
+
+    QCOMPARE(Utils::CarbonScheduler::forecastSeries(data), QList<int>({300, 100, 200}));
+    QCOMPARE(Utils::CarbonScheduler::forecastInterval(data), 1800);
+
+    const Utils::CarbonSchedule schedule = Utils::CarbonScheduler::findWindow(data, m_start, 1800, 0, QDateTime());
+
+    QVERIFY(schedule.isValid());
+    QCOMPARE(schedule.start(), m_start.addSecs(1800));
+}
+
+void CarbonSchedulerTest::seriesEndsAtUnknownValue()
+{
+    const CarbonData data = forecast({300, 200, -1, 10});
+
+    QCOMPARE(Utils::CarbonScheduler::forecastSeries(data), QList<int>({300, 200}));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CarbonSchedulerTest::findsLowestWindow_data()
+{
+    QTest::addColumn<int>("duration");
+    QTest::addColumn<int>("expectedOffset");
+    QTest::addColumn<double>("expectedAverage");
+
+    QTest::addRow("oneSlot") << 1800 << 5 * 1800 << 50.0;
+    QTest::addRow("twoSlots") << 3600 << 2 * 1800 << 100.0;
+    QTest::addRow("oneAndAHalfSlots") << 2700 << 2 * 1800 << 100.0;
+    QTest::addRow("fourSlots") << 4 * 1800 << 2 * 1800 << 125.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CarbonData CarbonSchedulerTest::forecast(const QList<int> &series) const
+{
+    CarbonData data = CarbonData::ok(series.value(0, -1), series.value(1, -1), series.value(2, -1),
+                                     m_start, m_start.addSecs(1800));
+    data.forecast = series;
+    data.forecastIntervalInSeconds = 1800;
+
+    return data;
+}
+
+QTEST_MAIN(CarbonSchedulerTest)
+#include "tst_carbonscheduler.moc"
@@ -0,0 +1,16 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../../leif/utils/fleetaggregator.cpp \
+           ../../../../leif/utils/fleetreport.cpp \
+           tst_fleetaggregator.cpp
+
+HEADERS = ../../../../leif/utils/fleetaggregator.h \
+          ../../../../leif/utils/fleetreport.h
+
+INCLUDEPATH *= ../../../../leif/utils ../../../../leif/include
@@ -0,0 +1,348 @@
+#include <QtTest>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "fleetaggregator.h"
+#include "fleetreport.h"
+
+namespace
+{
+Utils::FleetReport::Sample sample(QLocale::Country country, const QString &region, quint16 co2, quint32 energy)
+{
+    Utils::FleetReport::Sample result;
+    result.timeInMs = 1792368000000;
+    result.country = static_cast<quint16>(country);
+    result.setRegionId(region);
+    result.co2PerkWh = co2;
+    result.energyInMilliWattHours = energy;
+    result.carbonInMilligrams = energy * co2 / 1000;
+
+    return result;
+}
+
+const Utils::FleetAggregator::Rollup *find(const QList<Utils::FleetAggregator::Rollup> &rollups, QLocale::Country country, const QString &region)
+{
+    for(const Utils::FleetAggregator::Rollup &rollup : rollups)
+    {
+        if(rollup.country == country && rollup.region == region)
+        {
+            return &rollup;
+        }
+    }
+
+    return nullptr;
+}
+}
+
+class FleetAggregatorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    FleetAggregatorTest() = default;
+    virtual ~FleetAggregatorTest() = default;
+
+private slots:
+    void reportRoundTrip();
+    void malformedReportsAreRejected();
+    void regionIdMustFit();
+    void hostileRegionsAreRejected();
+    void unfitRegionIdsAreShortened();
+    void samplesAreSummedPerRegion();
+    void takeRollupsResets();
+    void fullTableDropsNewRegions();
+    void concurrentReportsAddUp();
+    void csvLines();
+};
+
+void FleetAggregatorTest::reportRoundTrip()
+{
+    Utils::FleetReport::Header header;
+    header.sender = 0x0123456789abcdefull;
+    header.sequence = 42;
+
+    const QList<Utils::FleetReport::Sample> samples {sample(QLocale::UnitedKingdom, QStringLiteral("13"), 152, 1250),
+                                                    sample(QLocale::Germany, QStringLiteral("DE-BY-1234"), 380, 900)};
+
+    const QByteArray datagram = Utils::FleetReport::encode(header, samples);
+    QCOMPARE(datagram.size(), Utils::FleetReport::HeaderSize + 2 * Utils::FleetReport::SampleSize);
+
+    Utils::FleetReport::Header decoded;
+    QVERIFY(Utils::FleetReport::decodeHeader(datagram.constData(), datagram.size(), &decoded));
+    QCOMPARE(decoded.sender, header.sender);
+    QCOMPARE(decoded.sequence, 42u);
+    QCOMPARE(decoded.sampleCount, quint16(2));
+
+    for(int i = 0; i < samples.count(); ++i)
+    {
+        const Utils::FleetReport::Sample read = Utils::FleetReport::decodeSample(datagram.constData(), i);
+        QCOMPARE(read.timeInMs, samples.at(i).timeInMs);
+        QCOMPARE(read.country, samples.at(i).country);
+        QCOMPARE(read.co2PerkWh, samples.at(i).co2PerkWh);
+        QCOMPARE(read.energyInMilliWattHours, samples.at(i).energyInMilliWattHours);
+        QCOMPARE(read.carbonInMilligrams, samples.at(i).carbonInMilligrams);
+        QCOMPARE(read.regionId(), samples.at(i).regionId());
+    }
+
+    // Too many samples are cut off.
+    const QList<Utils::FleetReport::Sample> many(Utils::FleetReport::MaxSamples + 5, samples.first());
+    const QByteArray full = Utils::FleetReport::encode(header, many);
+    QVERIFY(Utils::FleetReport::decodeHeader(full.constData(), full.size(), &decoded));
+    QCOMPARE(decoded.sampleCount, quint16(Utils::FleetReport::MaxSamples));
+}
+
+void FleetAggregatorTest::malformedReportsAreRejected()
+{
+    const QByteArray datagram = Utils::FleetReport::encode({}, {sample(QLocale::UnitedKingdom, QStringLiteral("13"), 152, 1250)});
+    Utils::FleetReport::Header header;
+
+    QVERIFY(!Utils::FleetReport::decodeHeader(nullptr, 0, &header));
+    QVERIFY(!Utils::FleetReport::decodeHeader(datagram.constData(), Utils::FleetReport::HeaderSize - 1, &header));
+    QVERIFY(!Utils::FleetReport::decodeHeader(datagram.constData(), datagram.size() - 1, &header));
+
+    QByteArray tooLong = datagram + '\0';
+    QVERIFY(!Utils::FleetReport::decodeHeader(tooLong.constData(), tooLong.size(), &header));
+
+    QByteArray badMagic = datagram;
+    badMagic[0] = 'X';
+    QVERIFY(!Utils::FleetReport::decodeHeader(badMagic.constData(), badMagic.size(), &header));
+
+    QByteArray badVersion = datagram;
+    badVersion[4] = 2;
+    QVERIFY(!Utils::FleetReport::decodeHeader(badVersion.constData(), badVersion.size(), &header));
+
+    QByteArray badCount = datagram;
+    badCount[6] = 2;
+    QVERIFY(!Utils::FleetReport::decodeHeader(badCount.constData(), badCount.size(), &header));
+
+    Utils::FleetAggregator aggregator;
+    QCOMPARE(aggregator.addReport(badMagic.constData(), badMagic.size()), -1);
+    QCOMPARE(aggregator.addReport(datagram.constData(), datagram.size()), 1);
+    QCOMPARE(aggregator.malformedCount(), 1ull);
+    QCOMPARE(aggregator.reportCount(), 1ull);
+}
+
+void FleetAggregatorTest::regionIdMustFit()
+{
+    Utils::FleetReport::Sample fits;
+    QVERIFY(fits.setRegionId(QStringLiteral("123456789012")));
+    QCOMPARE(fits.regionId(), QStringLiteral("123456789012"));
+
+    Utils::FleetReport::Sample tooLong;
+    QVERIFY(tooLong.setRegionId(QStringLiteral("13")));
+    QVERIFY(!tooLong.setRegionId(QStringLiteral("1234567890123")));
+    QCOMPARE(tooLong.regionId(), QStringLiteral("13"));
+}
+
+void FleetAggregatorTest::hostileRegionsAreRejected()
+{
+    Utils::FleetReport::Sample valid = sample(QLocale::UnitedKingdom, QStringLiteral("13"), 152, 1250);
+    QVERIFY(valid.hasValidRegionId());
+    QVERIFY(valid.setRegionId(QStringLiteral("DE-BY_1234")));
+    QVERIFY(!valid.setRegionId(QStringLiteral("13,\n=cmd()")));
+    QVERIFY(!valid.setRegionId(QStringLiteral("\"13\"")));
+    QCOMPARE(valid.regionId(), QStringLiteral("DE-BY_1234"));
+
+    // A sender that doesn't use setRegionId().
+    Utils::FleetReport::Sample hostile = valid;
+    std::memcpy(hostile.region, "1\n2,3", 6);
+
+    Utils::FleetReport::Sample hidden = valid;
+    std::memset(hidden.region, 0, Utils::FleetReport::RegionSize);
+    std::memcpy(hidden.region, "13\0,x", 5);
+
+    QVERIFY(!hostile.hasValidRegionId());
+    QVERIFY(!hidden.hasValidRegionId());
+
+    Utils::FleetAggregator aggregator;
+
+    for(const Utils::FleetReport::Sample &bad : {hostile, hidden})
+    {
+        // The valid sample is not counted either.
+        const QByteArray datagram = Utils::FleetReport::encode({}, {valid, bad});
+        QCOMPARE(aggregator.addReport(datagram.constData(), datagram.size()), -1);
+    }
+
+    QCOMPARE(aggregator.malformedCount(), 2ull);
+    QCOMPARE(aggregator.reportCount(), 0ull);
+    QCOMPARE(aggregator.regionCount(), 0);
+}
+
+void FleetAggregatorTest::unfitRegionIdsAreShortened()
+{
+    QCOMPARE(Utils::FleetReport::fittingRegionId(QStringLiteral("13")), QStringLiteral("13"));
+    QCOMPARE(Utils::FleetReport::fittingRegionId(QStringLiteral("123456789012")), QStringLiteral("123456789012"));
+
+    const QString tooLong = Utils::FleetReport::fittingRegionId(QStringLiteral("1234567890123"));
+    const QString unsafe = Utils::FleetReport::fittingRegionId(QStringLiteral("Île,de\nFrance"));
+
+    QVERIFY(tooLong.startsWith(QStringLiteral("123-")));
+    QVERIFY(unsafe.startsWith(QStringLiteral("_le-")));
+
+    for(const QString &shortened : {tooLong, unsafe})
+    {
+        Utils::FleetReport::Sample sample;
+        QVERIFY2(sample.setRegionId(shortened), qPrintable(shortened));
+        QCOMPARE(shortened.size(), Utils::FleetReport::RegionSize);
+    }
+
+    // Stable, and different regions stay apart.
+    QCOMPARE(Utils::FleetReport::fittingRegionId(QStringLiteral("1234567890123")), tooLong);
+    QVERIFY(Utils::FleetReport::fittingRegionId(QStringLiteral("1234567890124")) != tooLong);
+}
+
+void FleetAggregatorTest::samplesAreSummedPerRegion()
+{
+    Utils::FleetAggregator aggregator;
+
+    QVERIFY(aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("13"), 100, 1000)));
+    QVERIFY(aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("13"), 200, 3000)));
+    QVERIFY(aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("14"), 300, 500)));
+    QVERIFY(aggregator.add(sample(QLocale::Germany, QStringLiteral("13"), 400, 2000)));
+    QCOMPARE(aggregator.regionCount(), 3);
+
+    const QList<Utils::FleetAggregator::Rollup> rollups = aggregator.takeRollups();
+    QCOMPARE(rollups.count(), 3);
+
+    const Utils::FleetAggregator::Rollup *london = find(rollups, QLocale::UnitedKingdom, QStringLiteral("13"));
+    QVERIFY(london != nullptr);
+    QCOMPARE(london->samples, 2ull);
+    QCOMPARE(london->energyInMilliWattHours, 4000ull);
+    QCOMPARE(london->carbonInMilligrams, 700ull);
+    QCOMPARE(london->averageCo2PerkWh(), 150.0);
+
+    const Utils::FleetAggregator::Rollup *germany = find(rollups, QLocale::Germany, QStringLiteral("13"));
+    QVERIFY(germany != nullptr);
+    QCOMPARE(germany->samples, 1ull);
+    QCOMPARE(germany->carbonInMilligrams, 800ull);
+}
+
+void FleetAggregatorTest::takeRollupsResets()
+{
+    Utils::FleetAggregator aggregator;
+
+    aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("13"), 100, 1000));
+    aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("14"), 100, 1000));
+    QCOMPARE(aggregator.takeRollups().count(), 2);
+
+    // Quiet regions are left out.
+    QVERIFY(aggregator.takeRollups().isEmpty());
+
+    aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("13"), 300, 2000));
+
+    const QList<Utils::FleetAggregator::Rollup> rollups = aggregator.takeRollups();
+    QCOMPARE(rollups.count(), 1);
+    QCOMPARE(rollups.first().samples, 1ull);
+    QCOMPARE(rollups.first().energyInMilliWattHours, 2000ull);
+    QCOMPARE(aggregator.regionCount(), 2);
+}
+
+void FleetAggregatorTest::fullTableDropsNewRegions()
+{
+    Utils::FleetAggregator aggregator {4};
+
+    for(int region = 0; region < 4; ++region)
+    {
+        QVERIFY(aggregator.add(sample(QLocale::UnitedKingdom, QString::number(region), 100, 1000)));
+    }
+
+    QVERIFY(!aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("4"), 100, 1000)));
+    QCOMPARE(aggregator.droppedCount(), 1ull);
+
+    // Known regions still count.
+    QVERIFY(aggregator.add(sample(QLocale::UnitedKingdom, QStringLiteral("2"), 100, 1000)));
+    QCOMPARE(aggregator.regionCount(), 4);
+}
+
+void FleetAggregatorTest::concurrentReportsAddUp()
+{
+    constexpr int ThreadCount {4};
+    constexpr int ReportsPerThread {20000};
+    constexpr int Regions {50};
+
+    Utils::FleetAggregator aggregator;
+
+    QList<QByteArray> datagrams;
+    for(int i = 0; i < Regions; ++i)
+    {
+        QList<Utils::FleetReport::Sample> samples;
+        for(int j = 0; j < 15; ++j)
+        {
+            samples << sample(QLocale::UnitedKingdom, QString::number((i + j) % Regions), 200, 1000);
+        }
+
+        datagrams << Utils::FleetReport::encode({}, samples);
+    }
+
+    std::atomic<bool> running {true};
+    quint64 rolledUpSamples {0};
+    quint64 rolledUpEnergy {0};
+
+    // Rollups are taken while the reports come in.
+    std::thread writer([&]() {
+        while(running.load())
+        {
+            for(const Utils::FleetAggregator::Rollup &rollup : aggregator.takeRollups())
+            {
+                rolledUpSamples += rollup.samples;
+                rolledUpEnergy += rollup.energyInMilliWattHours;
+            }
+        }
+    });
+
+    std::vector<std::thread> receivers;
+    for(int t = 0; t < ThreadCount; ++t)
+    {
+        receivers.emplace_back([&, t]() {
+            for(int i = 0; i < ReportsPerThread; ++i)
+            {
+                const QByteArray &datagram = datagrams.at((t + i) % Regions);
+                aggregator.addReport(datagram.constData(), datagram.size());
+            }
+        });
+    }
+
+    for(std::thread &receiver : receivers)
+    {
+        receiver.join();
+    }
+
+    running.store(false);
+    writer.join();
+
+    for(const Utils::FleetAggregator::Rollup &rollup : aggregator.takeRollups())
+    {
+        rolledUpSamples += rollup.samples;
+        rolledUpEnergy += rollup.energyInMilliWattHours;
+    }
+
+    const quint64 expectedSamples = static_cast<quint64>(ThreadCount) * ReportsPerThread * 15;
+    QCOMPARE(aggregator.reportCount(), static_cast<quint64>(ThreadCount) * ReportsPerThread);
+    QCOMPARE(rolledUpSamples, expectedSamples);
+    QCOMPARE(rolledUpEnergy, expectedSamples * 1000);
+    QCOMPARE(aggregator.regionCount(), Regions);
+    QCOMPARE(aggregator.droppedCount(), 0ull);
+}
+
+void FleetAggregatorTest::csvLines()
+{
+    Utils::FleetAggregator::Rollup rollup;
+    rollup.country = QLocale::UnitedKingdom;
+    rollup.region = QStringLiteral("13");
+    rollup.samples = 4;
+    rollup.energyInMilliWattHours = 12500;
+    rollup.carbonInMilligrams = 1875;
+    rollup.co2Sum = 602;
+
+    const QDateTime time(QDate(2026, 10, 19), QTime(12, 0), Qt::UTC);
+
+    QCOMPARE(Utils::FleetAggregator::csvHeader(), QByteArray("time,country,region,samples,energy_wh,carbon_g,avg_gco2_per_kwh\n"));
+    QCOMPARE(Utils::FleetAggregator::toCsv(time, {rollup}), QByteArray("2026-10-19T12:00:00Z,GB,13,4,12.500,1.875,150.5\n"));
+    QVERIFY(Utils::FleetAggregator::toCsv(time, {}).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(FleetAggregatorTest)
+#include "tst_fleetaggregator.moc"
@@ -0,0 +1,323 @@
+#include <QtTest>
+
+#include <memory>
+#include <vector>
+
+#include "interfaces/IDataProvider.h"
+#include "interfaces/IPower.h"
+#include "plugin/shareddataprovider.h"
+#include "sharedpower.h"
+#include "utils/clock.h"
+#include "utils/hostcache.h"
+
+namespace
+{
+/**
+ * Answers with data for the next half hour and counts the requests.
+ */
+class CountingDataProvider : public IDataProvider
+{
+public:
+    using IDataProvider::carbonPerKiloWatt;
+
+    explicit CountingDataProvider(int *requests):
+        m_requests {requests}
+    {}
+
+    virtual CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override
+    {
+        Q_UNUSED(country)
+        Q_UNUSED(region)
+
+        ++*m_requests;
+
+        const QDateTime now = Utils::Clock::instance()->now();
+        return CarbonData::ok(150, 140, 130, now, now.addSecs(30 * 60));
+    }
+
+private:
+    int *m_requests;
+};
+
+class CountingPower : public IPower
+{
+public:
+    CountingPower(float watts, int *measurements):
+        m_watts {watts},
+        m_measurements {measurements}
+    {}
+
+    virtual float powerDrawInWatts() override
+    {
+        ++*m_measurements;
+        return m_watts;
+    }
+
+private:
+    float m_watts;
+    int *m_measurements;
+};
+}
+
+class HostCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    HostCacheTest() = default;
+    virtual ~HostCacheTest() = default;
+
+private slots:
+    void init();
+    void cleanup();
+
+    void carbonIsShared();
+    void onlyOneLeads();
+    void leaseRunsOut();
+    void releaseHandsOver();
+    void regionsHaveTheirOwnSlots();
+    void implausibleDataIsIgnored();
+    void fetchesScaleWithHosts();
+    void followerTakesOverFromDeadLeader();
+    void powerIsMeasuredOnce();
+
+private:
+    int fetchesForOneDay(int instanceCount);
+
+private:
+    std::unique_ptr<Utils::SimulatedClock> m_clock;
+    QString m_name;
+};
+
+void HostCacheTest::init()
+{
+    static int segment {0};
+
+    m_clock.reset(new Utils::SimulatedClock {QDateTime(QDate(2026, 10, 19), QTime(0, 0), Qt::UTC)});
+    Utils::Clock::setInstance(m_clock.get());
+
+    // Every test gets a fresh segment.
+    m_name = QStringLiteral("leif-test-%1-%2").arg(QCoreApplication::applicationPid()).arg(++segment);
+}
+
+void HostCacheTest::cleanup()
+{
+    Utils::HostCache::remove(m_name);
+    m_clock.reset();
+}
+
+void HostCacheTest::carbonIsShared()
+{
+    Utils::HostCache leader {m_name};
+    Utils::HostCache follower {m_name};
+    QVERIFY(leader.isAttached());
+    QVERIFY(follower.isAttached());
+
+    CarbonData data = CarbonData::ok(152, 147, 139, m_clock->now(), m_clock->now().addSecs(1800));
+    data.forecast = {152, 147, 139, 120};
+    data.forecastIntervalInSeconds = 1800;
+
+    QVERIFY(leader.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+    QVERIFY(leader.publishCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), data));
+
+    CarbonData shared;
+    QVERIFY(follower.readCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), &shared));
+    QVERIFY(shared.isValid);
+    QCOMPARE(shared.co2PerkWhNow, 152);
+    QCOMPARE(shared.co2PerkWhNext, 147);
+    QCOMPARE(shared.co2PerkWhLater, 139);
+    QCOMPARE(shared.validFrom, data.validFrom);
+    QCOMPARE(shared.validTo, data.validTo);
+    QCOMPARE(shared.forecast, data.forecast);
+    QCOMPARE(shared.forecastIntervalInSeconds, 1800);
+}
+
+void HostCacheTest::onlyOneLeads()
+{
+    Utils::HostCache first {m_name};
+    Utils::HostCache second {m_name};
+
+    QVERIFY(first.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+    QVERIFY(!second.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+
+    // Renewing is fine.
+    QVERIFY(first.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+
+    QVERIFY(first.leadPower());
+    QVERIFY(!second.leadPower());
+    QVERIFY(!second.publishPower(42.0f));
+}
+
+void HostCacheTest::leaseRunsOut()
+{
+    Utils::HostCache first {m_name, 1000};
+    Utils::HostCache second {m_name, 1000};
+
+    QVERIFY(first.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+
+    m_clock->advance(1001);
+
+    QVERIFY(second.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+    QVERIFY(!first.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+
+    const CarbonData data = CarbonData::ok(152, 147, 139, m_clock->now(), m_clock->now().addSecs(1800));
+    QVERIFY(!first.publishCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), data));
+    QVERIFY(second.publishCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), data));
+}
+
+void HostCacheTest::releaseHandsOver()
+{
+    Utils::HostCache second {m_name};
+
+    {
+        Utils::HostCache first {m_name};
+        QVERIFY(first.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+        QVERIFY(first.leadPower());
+    }
+
+    QVERIFY(second.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+    QVERIFY(second.leadPower());
+}
+
+void HostCacheTest::regionsHaveTheirOwnSlots()
+{
+    Utils::HostCache first {m_name};
+    Utils::HostCache second {m_name};
+
+    QVERIFY(first.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+    QVERIFY(second.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("14")));
+    QVERIFY(second.leadCarbon(QLocale::Germany, QStringLiteral("13")));
+
+    const CarbonData data = CarbonData::ok(152, 147, 139, m_clock->now(), m_clock->now().addSecs(1800));
+    QVERIFY(first.publishCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), data));
+
+    CarbonData shared;
+    QVERIFY(second.readCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), &shared));
+    QVERIFY(!second.readCarbon(QLocale::UnitedKingdom, QStringLiteral("14"), &shared));
+    QVERIFY(!second.readCarbon(QLocale::Germany, QStringLiteral("13"), &shared));
+}
+
+void HostCacheTest::implausibleDataIsIgnored()
+{
+    Utils::HostCache leader {m_name};
+    Utils::HostCache follower {m_name};
+
+    QVERIFY(leader.leadCarbon(QLocale::UnitedKingdom, QStringLiteral("13")));
+    QVERIFY(leader.publishCarbon(QLocale::UnitedKingdom, QStringLiteral("13"),
+                                 CarbonData::ok(100000, 147, 139, m_clock->now(), m_clock->now().addSecs(1800))));
+
+    CarbonData shared;
+    QVERIFY(!follower.readCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), &shared));
+
+    // Nothing to share.
+    QVERIFY(!leader.publishCarbon(QLocale::UnitedKingdom, QStringLiteral("13"), CarbonData::error(QStringLiteral("Offline"))));
+}
+
+/**
+ * The API is asked as often for ten users as for one.
+ */
+void HostCacheTest::fetchesScaleWithHosts()
+{
+    const int alone = fetchesForOneDay(1);
+    const int shared = fetchesForOneDay(10);
+
+    QVERIFY(alone > 0);
+    QVERIFY2(alone <= 24 * 2 + 1, qPrintable(QString::number(alone)));
+    QCOMPARE(shared, alone);
+}
+
+void HostCacheTest::followerTakesOverFromDeadLeader()
+{
+    int requests {0};
+    CountingDataProvider source {&requests};
+
+    Utils::HostCache leaderCache {m_name};
+    Utils::HostCache followerCache {m_name};
+    SharedDataProvider leader {&source, &leaderCache};
+    SharedDataProvider follower {&source, &followerCache};
+
+    QVERIFY(leader.carbonPerKiloWatt(QLocale::UnitedKingdom, QStringLiteral("13")).isValid);
+    QVERIFY(follower.carbonPerKiloWatt(QLocale::UnitedKingdom, QStringLiteral("13")).isValid);
+    QCOMPARE(requests, 1);
+
+    // The leader hangs and never asks again, the follower fetches once the
+    // data ran out.
+    m_clock->advance(31 * 60 * 1000);
+
+    const CarbonData data = follower.carbonPerKiloWatt(QLocale::UnitedKingdom, QStringLiteral("13"));
+    QVERIFY(data.isValid);
+    QVERIFY(data.validTo > m_clock->now());
+    QCOMPARE(requests, 2);
+}
+
+void HostCacheTest::powerIsMeasuredOnce()
+{
+    int leaderMeasurements {0};
+    int followerMeasurements {0};
+
+    Utils::HostCache leaderCache {m_name};
+    Utils::HostCache followerCache {m_name};
+    SharedPower leader {std::make_unique<CountingPower>(42.5f, &leaderMeasurements), &leaderCache};
+    SharedPower follower {std::make_unique<CountingPower>(10.0f, &followerMeasurements), &followerCache};
+
+    for(int minute = 0; minute < 10; ++minute)
+    {
+        QCOMPARE(leader.powerDrawInWatts(), 42.5f);
+        QCOMPARE(follower.powerDrawInWatts(), 42.5f);
+        m_clock->advance(60 * 1000);
+    }
+
+    QCOMPARE(leaderMeasurements, 10);
+    QCOMPARE(followerMeasurements, 0);
+
+    // Without the leader the reading gets old and the follower takes over.
+    m_clock->advance(Utils::HostCache::DefaultLeaseInMs);
+
+    QCOMPARE(follower.powerDrawInWatts(), 10.0f);
+    QCOMPARE(followerMeasurements, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Runs \p instanceCount instances for a day, each asking for carbon
+ * data every minute like CarbonService, and returns the API requests.
+ */
+int HostCacheTest::fetchesForOneDay(int instanceCount)
+{
+    static int run {0};
+    const QString name = m_name + QStringLiteral("-") + QString::number(++run);
+
+    int requests {0};
+    CountingDataProvider source {&requests};
+
+    std::vector<std::unique_ptr<Utils::HostCache>> caches;
+    std::vector<std::unique_ptr<SharedDataProvider>> providers;
+
+    for(int i = 0; i < instanceCount; ++i)
+    {
+        caches.push_back(std::make_unique<Utils::HostCache>(name));
+        providers.push_back(std::make_unique<SharedDataProvider>(&source, caches.back().get()));
+    }
+
+    for(int minute = 0; minute < 24 * 60; ++minute)
+    {
+        for(const std::unique_ptr<SharedDataProvider> &provider : providers)
+        {
+            if(!provider->carbonPerKiloWatt(QLocale::UnitedKingdom, QStringLiteral("13")).isValid)
+            {
+                return -1;
+            }
+        }
+
+        m_clock->advance(60 * 1000);
+    }
+
+    providers.clear();
+    caches.clear();
+    Utils::HostCache::remove(name);
+
+    return requests;
+}
+
+QTEST_MAIN(HostCacheTest)
+#include "tst_hostcache.moc"
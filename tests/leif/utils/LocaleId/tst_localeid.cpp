@@ -0,0 +1,90 @@
+#include <QtTest>
+
+#include <localeid.h>
+
+class LocaleIdTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    LocaleIdTest() = default;
+    virtual ~LocaleIdTest() = default;
+
+private slots:
+    void defaultCtorCreatesZeroId();
+    void localeRoundTripKeepsTheLocale();
+    void fromNameMatchesLocaleCtor();
+    void fromNameWithoutTerritoryHasNoTerritory();
+    void fromNameIsStable();
+    void sameLanguageIgnoresTerritoryAndScript();
+
+    void localeRoundTripKeepsTheLocale_data();
+};
+
+void LocaleIdTest::defaultCtorCreatesZeroId()
+{
+    Utils::LocaleId id {};
+
+    QCOMPARE(id.value(), Q_UINT64_C(0));
+    QCOMPARE(id.language(), QLocale::AnyLanguage);
+    QVERIFY(!id.hasTerritory());
+}
+
+void LocaleIdTest::localeRoundTripKeepsTheLocale()
+{
+    QFETCH(QString, name);
+
+    const QLocale locale {name};
+    const Utils::LocaleId id {locale};
+
+    QCOMPARE(id.language(), locale.language());
+    QCOMPARE(id.territory(), locale.territory());
+    QCOMPARE(id.toLocale().name(), locale.name());
+}
+
+void LocaleIdTest::fromNameMatchesLocaleCtor()
+{
+    QCOMPARE(Utils::LocaleId::fromName(QStringLiteral("en_GB")), Utils::LocaleId(QLocale(QStringLiteral("en_GB"))));
+    QVERIFY(Utils::LocaleId::fromName(QStringLiteral("en_GB")) != Utils::LocaleId::fromName(QStringLiteral("en_US")));
+}
+
+void LocaleIdTest::fromNameWithoutTerritoryHasNoTerritory()
+{
+    const Utils::LocaleId id {Utils::LocaleId::fromName(QStringLiteral("de"))};
+
+    QCOMPARE(id.language(), QLocale::German);
+    QVERIFY(!id.hasTerritory());
+    QCOMPARE(id.toLocale().name(), QLocale(QStringLiteral("de")).name());
+}
+
+void LocaleIdTest::fromNameIsStable()
+{
+    const Utils::LocaleId first {Utils::LocaleId::fromName(QStringLiteral("pl_PL"))};
+    const Utils::LocaleId second {Utils::LocaleId::fromName(QStringLiteral("pl_PL"))};
+
+    QCOMPARE(first, second);
+}
+
+void LocaleIdTest::sameLanguageIgnoresTerritoryAndScript()
+{
+    const Utils::LocaleId austria {Utils::LocaleId::fromName(QStringLiteral("de_AT"))};
+
+    QVERIFY(austria.isSameLanguage(Utils::LocaleId::fromName(QStringLiteral("de_CH"))));
+    QVERIFY(austria.isSameLanguage(Utils::LocaleId::fromName(QStringLiteral("de"))));
+    QVERIFY(!austria.isSameLanguage(Utils::LocaleId::fromName(QStringLiteral("en_GB"))));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LocaleIdTest::localeRoundTripKeepsTheLocale_data()
+{
+    QTest::addColumn<QString>("name");
+
+    QTest::addRow("C") << QStringLiteral("C");
+    QTest::addRow("en_GB") << QStringLiteral("en_GB");
+    QTest::addRow("de_AT") << QStringLiteral("de_AT");
+    QTest::addRow("zh_TW") << QStringLiteral("zh_TW");
+    QTest::addRow("sr_Latn_RS") << QStringLiteral("sr_Latn_RS");
+}
+
+QTEST_MAIN(LocaleIdTest)
+#include "tst_localeid.moc"
@@ -0,0 +1,16 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../../leif/utils/carbonscheduler.cpp \
+           ../../../../leif/utils/metricsformat.cpp \
+           tst_metricsformat.cpp
+
+HEADERS = ../../../../leif/utils/carbonscheduler.h \
+          ../../../../leif/utils/metricsformat.h
+
+INCLUDEPATH *= ../../../../leif/utils ../../../../leif/include
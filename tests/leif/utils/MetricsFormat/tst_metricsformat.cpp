@@ -0,0 +1,150 @@
+#include <QtTest>
+
+#include <metricsformat.h>
+
+class MetricsFormatTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    MetricsFormatTest() = default;
+    virtual ~MetricsFormatTest() = default;
+
+private slots:
+    void prometheusContainsCurrentValues();
+    void prometheusContainsForecast();
+    void prometheusLinesAreWellFormed();
+    void invalidDataHasNoIntensity();
+    void jsonContainsCurrentValues();
+    void labelsAreEscaped();
+    void labelsAreEscaped_data();
+
+private:
+    CarbonSnapshot snapshot() const;
+};
+
+void MetricsFormatTest::prometheusContainsCurrentValues()
+{
+    const QByteArray text = Utils::MetricsFormat::prometheus(snapshot());
+
+    QVERIFY(text.contains("leif_power_draw_watts 12.5\n"));
+    QVERIFY(text.contains("leif_session_carbon_grams 3.25\n"));
+    QVERIFY(text.contains("leif_lifetime_carbon_grams 1024\n"));
+    QVERIFY(text.contains("leif_carbon_data_valid{country=\"GB\",region=\"13\"} 1\n"));
+    QVERIFY(text.contains("leif_carbon_intensity_grams_per_kwh{country=\"GB\",region=\"13\"} 152\n"));
+    QVERIFY(text.contains("leif_carbon_usage_level{country=\"GB\",region=\"13\"} 2\n"));
+    QVERIFY(text.contains("# TYPE leif_power_draw_watts gauge\n"));
+}
+
+void MetricsFormatTest::prometheusContainsForecast()
+{
+    const QByteArray text = Utils::MetricsFormat::prometheus(snapshot());
+
+    QVERIFY(text.contains("leif_carbon_forecast_grams_per_kwh{country=\"GB\",region=\"13\",offset_seconds=\"0\"} 152\n"));
+    QVERIFY(text.contains("leif_carbon_forecast_grams_per_kwh{country=\"GB\",region=\"13\",offset_seconds=\"1800\"} 147\n"));
+    QVERIFY(text.contains("leif_carbon_forecast_grams_per_kwh{country=\"GB\",region=\"13\",offset_seconds=\"5400\"} 120\n"));
+    QCOMPARE(text.count("leif_carbon_forecast_grams_per_kwh{"), 4);
+}
+
+void MetricsFormatTest::prometheusLinesAreWellFormed()
+{
+    const QList<QByteArray> lines = Utils::MetricsFormat::prometheus(snapshot()).split('\n');
+
+    QVERIFY(lines.last().isEmpty());
+
+    for(const QByteArray &line : lines.mid(0, lines.count() - 1))
+    {
+        if(line.startsWith('#'))
+        {
+            QVERIFY2(line.startsWith("# HELP ") || line.startsWith("# TYPE "), line.constData());
+            continue;
+        }
+
+        bool ok {false};
+        line.mid(line.lastIndexOf(' ') + 1).toDouble(&ok);
+        QVERIFY2(ok, line.constData());
+        QVERIFY2(line.startsWith("leif_"), line.constData());
+    }
+}
+
+void MetricsFormatTest::invalidDataHasNoIntensity()
+{
+    CarbonSnapshot data = snapshot();
+    data.carbon = CarbonData::error(QStringLiteral("Offline."));
+
+    const QByteArray text = Utils::MetricsFormat::prometheus(data);
+
+    QVERIFY(text.contains("leif_carbon_data_valid{country=\"GB\",region=\"13\"} 0\n"));
+    QVERIFY(!text.contains("leif_carbon_intensity_grams_per_kwh{"));
+    QVERIFY(!text.contains("leif_carbon_forecast_grams_per_kwh{"));
+
+    const QJsonObject json = QJsonDocument::fromJson(Utils::MetricsFormat::json(data)).object();
+    QCOMPARE(json.value("valid").toBool(), false);
+    QCOMPARE(json.value("error").toString(), QStringLiteral("Offline."));
+    QVERIFY(!json.contains("intensity"));
+}
+
+void MetricsFormatTest::jsonContainsCurrentValues()
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(Utils::MetricsFormat::json(snapshot()), &error);
+
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    const QJsonObject json = document.object();
+    QCOMPARE(json.value("country").toString(), QStringLiteral("GB"));
+    QCOMPARE(json.value("region").toString(), QStringLiteral("13"));
+    QCOMPARE(json.value("powerDrawWatts").toDouble(), 12.5);
+    QCOMPARE(json.value("lifetimeCarbonGrams").toDouble(), 1024.0);
+    QCOMPARE(json.value("intensity").toInt(), 152);
+    QCOMPARE(json.value("valid").toBool(), true);
+
+    const QJsonObject forecast = json.value("forecast").toObject();
+    QCOMPARE(forecast.value("intervalSeconds").toInt(), 1800);
+    QCOMPARE(forecast.value("values").toArray().count(), 4);
+    QCOMPARE(forecast.value("values").toArray().at(3).toInt(), 120);
+}
+
+void MetricsFormatTest::labelsAreEscaped()
+{
+    QFETCH(QString, value);
+    QFETCH(QByteArray, expected);
+
+    QCOMPARE(Utils::MetricsFormat::escapeLabel(value), expected);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsFormatTest::labelsAreEscaped_data()
+{
+    QTest::addColumn<QString>("value");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::addRow("plain") << QStringLiteral("13") << QByteArray("13");
+    QTest::addRow("quote") << QStringLiteral("a\"b") << QByteArray("a\\\"b");
+    QTest::addRow("backslash") << QStringLiteral("a\\b") << QByteArray("a\\\\b");
+    QTest::addRow("newline") << QStringLiteral("a\nb") << QByteArray("a\\nb");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CarbonSnapshot MetricsFormatTest::snapshot() const
+{
+    const QDateTime from(QDate(2026, 10, 19), QTime(10, 0), Qt::UTC);
+
+    CarbonSnapshot snapshot;
+    snapshot.sequence = 7;
+    snapshot.timestamp = from.addSecs(60);
+    snapshot.country = QLocale::UnitedKingdom;
+    snapshot.region = QStringLiteral("13");
+    snapshot.powerDrawInWatts = 12.5f;
+    snapshot.sessionCarbon = 3.25f;
+    snapshot.lifetimeCarbon = 1024.0f;
+    snapshot.usageLevel = CarbonUsageLevel::Medium;
+    snapshot.carbon = CarbonData::ok(152, 147, 139, from, from.addSecs(1800));
+    snapshot.carbon.forecast = {152, 147, 139, 120};
+    snapshot.carbon.forecastIntervalInSeconds = 1800;
+
+    return snapshot;
+}
+
+QTEST_MAIN(MetricsFormatTest)
+#include "tst_metricsformat.moc"
@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../../leif/utils/powerprofile.cpp \
+           tst_powerprofile.cpp
+
+HEADERS = ../../../../leif/utils/powerprofile.h
+
+INCLUDEPATH *= ../../../../leif/utils
@@ -0,0 +1,185 @@
+#include <QtTest>
+
+#include <powerprofile.h>
+
+using Mode = Utils::PowerProfile::Mode;
+
+class PowerProfileTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PowerProfileTest() = default;
+    virtual ~PowerProfileTest() = default;
+
+private slots:
+    void defaultCtorCreatesEmptyProfile();
+    void firstSampleIsTakenAsIs();
+    void invalidSamplesAreIgnored();
+    void averageIsWeightedByInterval();
+    void averageConvergesToConstantLoad();
+    void estimateFallsBackToBatteryAverage();
+    void needsPersistingOnlyEveryPersistInterval();
+    void byteArrayRoundTripKeepsAverages();
+    void fromByteArrayRejectsCorruptData();
+    void fromAverageDischargeRateSeedsBatteryAverage();
+
+    void averageIsWeightedByInterval_data();
+    void fromByteArrayRejectsCorruptData_data();
+};
+
+void PowerProfileTest::defaultCtorCreatesEmptyProfile()
+{
+    Utils::PowerProfile profile {};
+
+    QVERIFY(profile.isEmpty());
+    QVERIFY(!profile.isDirty());
+    QVERIFY(!profile.hasSamples(Mode::Battery));
+    QVERIFY(!profile.hasSamples(Mode::Charging));
+    QVERIFY(!profile.hasSamples(Mode::FullyCharged));
+    QCOMPARE(profile.estimate(Mode::FullyCharged), 0.0f);
+}
+
+void PowerProfileTest::firstSampleIsTakenAsIs()
+{
+    Utils::PowerProfile profile {};
+
+    profile.addSample(Mode::Battery, 12000, 300);
+
+    QVERIFY(!profile.isEmpty());
+    QVERIFY(profile.isDirty());
+    QCOMPARE(profile.sampleCount(Mode::Battery), 1u);
+    QCOMPARE(profile.average(Mode::Battery), 12000.0f);
+}
+
+void PowerProfileTest::invalidSamplesAreIgnored()
+{
+    Utils::PowerProfile profile {};
+
+    profile.addSample(Mode::Battery, -1, 300);
+    profile.addSample(Mode::Battery, 1000, 0);
+    profile.addSample(Mode::Battery, 1000, -300);
+
+    QVERIFY(profile.isEmpty());
+    QVERIFY(!profile.isDirty());
+}
+
+void PowerProfileTest::averageIsWeightedByInterval()
+{
+    QFETCH(int, interval);
+    QFETCH(float, expected);
+
+    Utils::PowerProfile profile {};
+
+    profile.addSample(Mode::Charging, 10000, 300);
+    profile.addSample(Mode::Charging, 20000, interval);
+
+    QVERIFY(qAbs(profile.average(Mode::Charging) - expected) < 1.0f);
+}
+
+void PowerProfileTest::averageConvergesToConstantLoad()
+{
+    Utils::PowerProfile profile {};
+
+    profile.addSample(Mode::Battery, 40000, 300);
+
+    // A day of five minute samples at 8W.
+    for(int i = 0; i < 24 * 12; ++i)
+        profile.addSample(Mode::Battery, 8000, 300);
+
+    QVERIFY(qAbs(profile.average(Mode::Battery) - 8000.0f) < 10.0f);
+}
+
+void PowerProfileTest::estimateFallsBackToBatteryAverage()
+{
+    Utils::PowerProfile profile {};
+
+    profile.addSample(Mode::Battery, 9000, 300);
+
+    QCOMPARE(profile.estimate(Mode::FullyCharged), 9000.0f);
+
+    profile.addSample(Mode::FullyCharged, 15000, 300);
+
+    QCOMPARE(profile.estimate(Mode::FullyCharged), 15000.0f);
+    QCOMPARE(profile.estimate(Mode::Battery), 9000.0f);
+}
+
+void PowerProfileTest::needsPersistingOnlyEveryPersistInterval()
+{
+    const QDateTime start {QDate(2026, 10, 19), QTime(12, 0)};
+
+    Utils::PowerProfile profile {};
+
+    QVERIFY(!profile.needsPersisting(start));
+
+    profile.addSample(Mode::Battery, 9000, 300);
+    QVERIFY(profile.needsPersisting(start));
+
+    profile.markPersisted(start);
+    QVERIFY(!profile.needsPersisting(start));
+
+    profile.addSample(Mode::Battery, 9500, 300);
+    QVERIFY(!profile.needsPersisting(start.addSecs(Utils::PowerProfile::PersistIntervalInSeconds - 1)));
+    QVERIFY(profile.needsPersisting(start.addSecs(Utils::PowerProfile::PersistIntervalInSeconds)));
+}
+
+void PowerProfileTest::byteArrayRoundTripKeepsAverages()
+{
+    Utils::PowerProfile profile {};
+
+    profile.addSample(Mode::Battery, 9000, 300);
+    profile.addSample(Mode::Battery, 11000, 300);
+    profile.addSample(Mode::FullyCharged, 14000, 300);
+
+    const QByteArray data {profile.toByteArray()};
+    const Utils::PowerProfile restored {Utils::PowerProfile::fromByteArray(data)};
+
+    QVERIFY(data.size() < 32);
+    QVERIFY(!restored.isDirty());
+    QCOMPARE(restored.average(Mode::Battery), profile.average(Mode::Battery));
+    QCOMPARE(restored.sampleCount(Mode::Battery), 2u);
+    QCOMPARE(restored.average(Mode::FullyCharged), 14000.0f);
+    QVERIFY(!restored.hasSamples(Mode::Charging));
+}
+
+void PowerProfileTest::fromByteArrayRejectsCorruptData()
+{
+    QFETCH(QByteArray, data);
+
+    QVERIFY(Utils::PowerProfile::fromByteArray(data).isEmpty());
+}
+
+void PowerProfileTest::fromAverageDischargeRateSeedsBatteryAverage()
+{
+    QVERIFY(Utils::PowerProfile::fromAverageDischargeRate(0).isEmpty());
+
+    const Utils::PowerProfile profile {Utils::PowerProfile::fromAverageDischargeRate(7000)};
+
+    QCOMPARE(profile.average(Mode::Battery), 7000.0f);
+    QCOMPARE(profile.estimate(Mode::FullyCharged), 7000.0f);
+    QVERIFY(profile.isDirty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PowerProfileTest::averageIsWeightedByInterval_data()
+{
+    QTest::addColumn<int>("interval");
+    QTest::addColumn<float>("expected");
+
+    // alpha = 1 - exp(-interval / 7200)
+    QTest::addRow("5min") << 300 << 10408.1f;
+    QTest::addRow("1h") << 3600 << 13934.7f;
+    QTest::addRow("2h") << 7200 << 16321.2f;
+}
+
+void PowerProfileTest::fromByteArrayRejectsCorruptData_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::addRow("empty") << QByteArray();
+    QTest::addRow("unknownVersion") << QByteArray("\x07", 1);
+    QTest::addRow("truncated") << QByteArray("\x01\x00\x00", 3);
+}
+
+QTEST_MAIN(PowerProfileTest)
+#include "tst_powerprofile.moc"
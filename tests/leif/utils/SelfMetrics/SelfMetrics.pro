@@ -0,0 +1,11 @@
+QT += testlib concurrent network
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  tst_selfmetrics.cpp
+
+include(../../../../leif/pri/core.pri)
@@ -0,0 +1,78 @@
+#include <QtTest>
+
+#include "utils/selfmetrics.h"
+
+class SelfMetricsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SelfMetricsTest() = default;
+    virtual ~SelfMetricsTest() = default;
+
+private slots:
+    void processValuesAreAvailable();
+    void countersAddUp();
+    void negativeBytesAreIgnored();
+    void timerEventsAreWakeUps();
+    void wakeUpsPerHour();
+};
+
+void SelfMetricsTest::processValuesAreAvailable()
+{
+    QVERIFY(Utils::SelfMetrics::cpuTimeInMs() >= 0);
+    QVERIFY(Utils::SelfMetrics::residentBytes() > 0);
+}
+
+void SelfMetricsTest::countersAddUp()
+{
+    const Utils::SelfMetrics::Sample before = Utils::SelfMetrics::sample();
+
+    Utils::SelfMetrics::addLoggedBytes(100);
+    Utils::SelfMetrics::addLoggedBytes(20);
+    Utils::SelfMetrics::addNetworkBytes(512);
+
+    const Utils::SelfMetrics::Sample after = Utils::SelfMetrics::sample();
+    QCOMPARE(after.loggedBytes - before.loggedBytes, quint64(120));
+    QCOMPARE(after.networkBytes - before.networkBytes, quint64(512));
+}
+
+void SelfMetricsTest::negativeBytesAreIgnored()
+{
+    const Utils::SelfMetrics::Sample before = Utils::SelfMetrics::sample();
+
+    // A failed QIODevice::write() returns -1.
+    Utils::SelfMetrics::addNetworkBytes(-1);
+    Utils::SelfMetrics::addLoggedBytes(0);
+
+    const Utils::SelfMetrics::Sample after = Utils::SelfMetrics::sample();
+    QCOMPARE(after.loggedBytes, before.loggedBytes);
+    QCOMPARE(after.networkBytes, before.networkBytes);
+}
+
+void SelfMetricsTest::timerEventsAreWakeUps()
+{
+    Utils::SelfMetrics metrics;
+    const quint64 before = Utils::SelfMetrics::sample().wakeUps;
+
+    QTimer timer;
+    int timeouts {0};
+    connect(&timer, &QTimer::timeout, this, [&]() { ++timeouts; });
+    timer.start(5);
+
+    QTRY_VERIFY(timeouts >= 3);
+    QVERIFY(Utils::SelfMetrics::sample().wakeUps - before >= 3);
+}
+
+void SelfMetricsTest::wakeUpsPerHour()
+{
+    Utils::SelfMetrics::Sample sample;
+    QCOMPARE(sample.wakeUpsPerHour(), 0.0);
+
+    sample.uptimeInSeconds = 1800;
+    sample.wakeUps = 30;
+    QCOMPARE(sample.wakeUpsPerHour(), 60.0);
+}
+
+QTEST_MAIN(SelfMetricsTest)
+#include "tst_selfmetrics.moc"
@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES =  ../../../../leif/utils/clock.cpp \
+           tst_simulatedclock.cpp
+
+HEADERS = ../../../../leif/utils/clock.h
+
+INCLUDEPATH *= ../../../../leif/utils
@@ -0,0 +1,147 @@
+#include <QtTest>
+
+#include <memory>
+
+#include <clock.h>
+
+class SimulatedClockTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SimulatedClockTest() = default;
+    virtual ~SimulatedClockTest() = default;
+
+private slots:
+    void initTestCase();
+
+    void clockStandsStill();
+    void advanceMovesTime();
+    void timersFireInDueOrder();
+    void callbackSeesDueTime();
+    void timerDiesWithContext();
+    void callbackMayAddTimers();
+    void instanceDefaultsToSystemClock();
+    void installedClockIsUsed();
+
+private:
+    QDateTime m_start;
+};
+
+void SimulatedClockTest::initTestCase()
+{
+    m_start = QDateTime(QDate(2026, 10, 19), QTime(12, 0));
+}
+
+void SimulatedClockTest::clockStandsStill()
+{
+    Utils::SimulatedClock clock {m_start};
+
+    QCOMPARE(clock.now(), m_start);
+    QTest::qWait(5);
+    QCOMPARE(clock.now(), m_start);
+}
+
+void SimulatedClockTest::advanceMovesTime()
+{
+    Utils::SimulatedClock clock {m_start};
+
+    clock.advance(90 * 1000);
+    QCOMPARE(clock.now(), m_start.addSecs(90));
+
+    clock.runUntil(m_start.addDays(1));
+    QCOMPARE(clock.now(), m_start.addDays(1));
+
+    // The clock never goes back.
+    clock.runUntil(m_start);
+    QCOMPARE(clock.now(), m_start.addDays(1));
+}
+
+void SimulatedClockTest::timersFireInDueOrder()
+{
+    Utils::SimulatedClock clock {m_start};
+    QObject context;
+    QStringList fired;
+
+    clock.repeat(3000, &context, [&]() { fired << QStringLiteral("slow"); });
+    clock.repeat(1000, &context, [&]() { fired << QStringLiteral("fast"); });
+
+    clock.advance(6000);
+
+    // Timers due at the same time fire in the order they were added.
+    QCOMPARE(fired, QStringList({"fast", "fast", "slow", "fast", "fast", "fast", "slow", "fast"}));
+    QCOMPARE(clock.firedCount(), quint64(8));
+}
+
+void SimulatedClockTest::callbackSeesDueTime()
+{
+    Utils::SimulatedClock clock {m_start};
+    QObject context;
+    QList<QDateTime> times;
+
+    clock.repeat(60 * 1000, &context, [&]() { times << clock.now(); });
+
+    clock.advance(150 * 1000);
+
+    QCOMPARE(times, QList<QDateTime>({m_start.addSecs(60), m_start.addSecs(120)}));
+    QCOMPARE(clock.now(), m_start.addSecs(150));
+}
+
+void SimulatedClockTest::timerDiesWithContext()
+{
+    Utils::SimulatedClock clock {m_start};
+    std::unique_ptr<QObject> context {new QObject};
+    int count {0};
+
+    clock.repeat(1000, context.get(), [&]() { ++count; });
+    clock.advance(2000);
+    QCOMPARE(count, 2);
+    QCOMPARE(clock.timerCount(), qsizetype(1));
+
+    context.reset();
+    clock.advance(2000);
+    QCOMPARE(count, 2);
+    QCOMPARE(clock.timerCount(), qsizetype(0));
+}
+
+void SimulatedClockTest::callbackMayAddTimers()
+{
+    Utils::SimulatedClock clock {m_start};
+    QObject context;
+    int inner {0};
+
+    clock.repeat(1000, &context, [&]() {
+        if(clock.firedCount() == 1)
+            clock.repeat(500, &context, [&]() { ++inner; });
+    });
+
+    clock.advance(3000);
+
+    // Added at 1s, fires at 1.5s, 2s, 2.5s and 3s.
+    QCOMPARE(inner, 4);
+}
+
+void SimulatedClockTest::instanceDefaultsToSystemClock()
+{
+    Utils::Clock *clock = Utils::Clock::instance();
+    QVERIFY(clock != nullptr);
+    QVERIFY(qAbs(clock->now().msecsTo(QDateTime::currentDateTime())) < 1000);
+}
+
+void SimulatedClockTest::installedClockIsUsed()
+{
+    {
+        Utils::SimulatedClock clock {m_start};
+        Utils::Clock::setInstance(&clock);
+
+        QCOMPARE(Utils::Clock::instance(), &clock);
+        QCOMPARE(Utils::Clock::instance()->now(), m_start);
+    }
+
+    // A destroyed clock uninstalls itself.
+    QVERIFY(Utils::Clock::instance()->now() > m_start.addYears(-10));
+    QVERIFY(dynamic_cast<Utils::SimulatedClock*>(Utils::Clock::instance()) == nullptr);
+}
+
+QTEST_MAIN(SimulatedClockTest)
+#include "tst_simulatedclock.moc"
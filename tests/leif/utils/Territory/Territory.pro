@@ -7,11 +7,13 @@ CONFIG -= app_bundle
 TEMPLATE = app
 
 SOURCES =  ../../../../leif/utils/translation.cpp           \
+           ../../../../leif/utils/localeid.cpp              \
            ../../../../leif/utils/translatedstring.cpp      \
            ../../../../leif/utils/territory.cpp             \
            tst_territory.cpp
 
 HEADERS = ../../../../leif/utils/translation.h \
+          ../../../../leif/utils/localeid.h    \
           ../../../../leif/utils/translatedstring.h \
           ../../../../leif/utils/territory.h \
           ../common/common.h
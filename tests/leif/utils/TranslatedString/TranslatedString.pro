@@ -7,10 +7,12 @@ CONFIG -= app_bundle
 TEMPLATE = app
 
 SOURCES =  ../../../../leif/utils/translation.cpp           \
+           ../../../../leif/utils/localeid.cpp              \
            ../../../../leif/utils/translatedstring.cpp      \
            tst_translatedstring.cpp
 
 HEADERS = ../../../../leif/utils/translation.h \
+          ../../../../leif/utils/localeid.h    \
           ../../../../leif/utils/translatedstring.h
 
 INCLUDEPATH *= ../../../../leif/utils
@@ -23,6 +23,7 @@ private slots:
     void idReturnsTheSetString();
     void translatedIdReturnsCorrectStringOnlyIfNotEmpty();
     void translateWillReturnTheStringForTheCurrentLocale();
+    void translateFallsBackToTheClosestLocale();
     void fromJsonReturnsAValidObject();
     void fromJsonArrayReturnsAListOfObjects();
 
@@ -31,6 +32,7 @@ private slots:
     void idReturnsTheSetString_data();
     void translatedIdReturnsCorrectStringOnlyIfNotEmpty_data();
     void translateWillReturnTheStringForTheCurrentLocale_data();
+    void translateFallsBackToTheClosestLocale_data();
     void fromJsonReturnsAValidObject_data();
     void fromJsonArrayReturnsAListOfObjects_data();
 };
@@ -125,6 +127,22 @@ void TranslatedStringTest::translateWillReturnTheStringForTheCurrentLocale()
     QCOMPARE(str, translatedString);
 }
 
+void TranslatedStringTest::translateFallsBackToTheClosestLocale()
+{
+    QFETCH(QStringList, locales);
+    QFETCH(QString, translatedString);
+
+    const QLocale systemLocale {};
+    auto cleanup = qScopeGuard([&systemLocale]() { QLocale::setDefault(systemLocale); });
+    QLocale::setDefault(QLocale(QStringLiteral("de_AT")));
+
+    QList<Utils::Translation> translations;
+    for(const QString &locale : locales)
+        translations << Utils::Translation(QStringLiteral("tr_") + locale, locale);
+
+    QCOMPARE(Utils::TranslatedString::translate(translations), translatedString);
+}
+
 void TranslatedStringTest::fromJsonReturnsAValidObject()
 {
     QFETCH(QString, id);
@@ -222,6 +240,19 @@ void TranslatedStringTest::translateWillReturnTheStringForTheCurrentLocale_data(
     QTest::addRow("three") << translatedString << translations;
 }
 
+void TranslatedStringTest::translateFallsBackToTheClosestLocale_data()
+{
+    QTest::addColumn<QStringList>("locales");
+    QTest::addColumn<QString>("translatedString");
+
+    QTest::addRow("sameLocale") << QStringList {"de_DE", "de", "en_GB", "de_AT"} << QStringLiteral("tr_de_AT");
+    QTest::addRow("sameLanguage") << QStringList {"en_GB", "de_DE", "de"} << QStringLiteral("tr_de");
+    QTest::addRow("otherCountry") << QStringList {"fr_FR", "en_GB", "de_CH"} << QStringLiteral("tr_de_CH");
+    QTest::addRow("firstOfEqual") << QStringList {"de_DE", "de_CH"} << QStringLiteral("tr_de_DE");
+    QTest::addRow("english") << QStringList {"fr_FR", "en_GB", "pl_PL"} << QStringLiteral("tr_en_GB");
+    QTest::addRow("noMatch") << QStringList {"fr_FR", "pl_PL"} << QString();
+}
+
 void TranslatedStringTest::fromJsonReturnsAValidObject_data()
 {
     QTest::addColumn<QString>("id");
@@ -7,8 +7,10 @@ CONFIG -= app_bundle
 TEMPLATE = app
 
 SOURCES =  ../../../../leif/utils/translation.cpp      \
+           ../../../../leif/utils/localeid.cpp         \
            tst_translation.cpp
 
-HEADERS = ../../../../leif/utils/translation.h
+HEADERS = ../../../../leif/utils/translation.h \
+          ../../../../leif/utils/localeid.h
 
 INCLUDEPATH *= ../../../../leif/utils
@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS = Translation TranslatedString Territory CarbonPluginData
+SUBDIRS = LocaleId Translation TranslatedString Territory CarbonPluginData PowerProfile CarbonScheduler MetricsFormat AtlasPacker SimulatedClock SelfMetrics HostCache FleetAggregator
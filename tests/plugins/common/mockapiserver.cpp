@@ -0,0 +1,352 @@
+/**
+ * @brief Implements the MockApiServer class.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#include <QDir>
+#include <QFile>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "mockapiserver.h"
+
+namespace
+{
+const QByteArray RequestEnd {"\r\n\r\n"};
+}
+
+/**
+ * @class MockApiServer
+ *
+ * @brief A local HTTP/1.1 server serving one configurable response.
+ *
+ * Every request, regardless of its path, gets the same response. Connections
+ * are kept alive and, if cache headers are set, conditional requests with a
+ * matching \c If-None-Match are answered with 304 Not Modified. The server
+ * lives in the thread it was created in, so it keeps working while the code
+ * under test waits for a reply in a nested event loop.
+ *
+ * \code
+ * MockApiServer server;
+ * server.start();
+ * server.setRecordedResponse("regional_intensity_london.json");
+ *
+ * Utilities::requestCarbonData(network, server.baseUrl(), 13, from, to);
+ * \endcode
+ */
+
+/**
+ * @brief Creates a server replying with an empty JSON object.
+ *
+ * @param parent Optional QObject parent pointer. Default: \c nullptr.
+ */
+MockApiServer::MockApiServer(QObject *parent /* = nullptr */):
+    QTcpServer(parent),
+    m_body {"{}"},
+    m_statusCode {200},
+    m_latency {0},
+    m_payloadSize {0},
+    m_failure {Failure::None},
+    m_maxAge {-1},
+    m_requestCount {0},
+    m_connectionCount {0},
+    m_notModifiedCount {0}
+{}
+
+/**
+ * @brief Starts listening on a free port on the loopback interface.
+ *
+ * @return \arg \c true  The server is listening.
+ *         \arg \c false The server could not be started.
+ */
+bool MockApiServer::start()
+{
+    return listen(QHostAddress::LocalHost, 0);
+}
+
+/**
+ * @brief Returns the URL clients should use as API base URL.
+ *
+ * @return The URL, e.g. \c http://127.0.0.1:43210.
+ */
+QUrl MockApiServer::baseUrl() const
+{
+    QUrl url;
+    url.setScheme(QStringLiteral("http"));
+    url.setHost(serverAddress().toString());
+    url.setPort(serverPort());
+
+    return url;
+}
+
+/**
+ * @brief Sets the \p body and \p statusCode of the response.
+ *
+ * @param body The response body.
+ * @param statusCode The HTTP status code. Default: \c 200.
+ */
+void MockApiServer::setResponse(const QByteArray &body, int statusCode /* = 200 */)
+{
+    m_body = body;
+    m_statusCode = statusCode;
+}
+
+/**
+ * @brief Uses a recorded API response from the data directory as response.
+ *
+ * @param fileName The file name, e.g. \c regional_intensity_london.json.
+ * @param statusCode The HTTP status code. Default: \c 200.
+ * @return \arg \c true  The recording was loaded.
+ *         \arg \c false The recording could not be read.
+ */
+bool MockApiServer::setRecordedResponse(const QString &fileName, int statusCode /* = 200 */)
+{
+    QFile file(recordedResponsePath(fileName));
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    setResponse(file.readAll(), statusCode);
+
+    return true;
+}
+
+/**
+ * @brief Delays every reply by \p milliseconds.
+ *
+ * @param milliseconds The latency. \c 0 replies right away.
+ */
+void MockApiServer::setLatency(int milliseconds)
+{
+    m_latency = qMax(0, milliseconds);
+}
+
+/**
+ * @brief Makes the following requests fail in the given way.
+ *
+ * @param failure The failure to simulate, Failure::None to reply normally.
+ */
+void MockApiServer::setFailure(Failure failure)
+{
+    m_failure = failure;
+}
+
+/**
+ * @brief Pads the response body with whitespace up to \p bytes.
+ *
+ * JSON allows trailing whitespace, so this grows the payload without changing
+ * its meaning. Bodies larger than \p bytes are sent as they are.
+ *
+ * @param bytes The minimum body size. \c 0 disables the padding.
+ */
+void MockApiServer::setPayloadSize(int bytes)
+{
+    m_payloadSize = qMax(0, bytes);
+}
+
+/**
+ * @brief Sends an \c ETag and a \c Cache-Control header with every reply.
+ *
+ * @param etag The entity tag without quotes. Empty disables both headers.
+ * @param maxAge The \c max-age in seconds. \c -1 sends no \c Cache-Control.
+ */
+void MockApiServer::setCacheHeaders(const QByteArray &etag, int maxAge /* = -1 */)
+{
+    m_etag = etag;
+    m_maxAge = maxAge;
+}
+
+/**
+ * @brief Returns the number of requests received so far.
+ *
+ * @return The request count.
+ */
+int MockApiServer::requestCount() const
+{
+    return m_requestCount;
+}
+
+/**
+ * @brief Returns the number of connections accepted so far.
+ *
+ * @return The connection count.
+ */
+int MockApiServer::connectionCount() const
+{
+    return m_connectionCount;
+}
+
+/**
+ * @brief Returns the number of requests answered with 304 Not Modified.
+ *
+ * @return The count of conditional requests that hit.
+ */
+int MockApiServer::notModifiedCount() const
+{
+    return m_notModifiedCount;
+}
+
+/**
+ * @brief Returns the path (and query) of the last request.
+ *
+ * @return The path as sent by the client.
+ */
+QByteArray MockApiServer::lastRequestPath() const
+{
+    return m_lastRequestPath;
+}
+
+/**
+ * @brief Returns the full path of the recording \p fileName.
+ *
+ * @param fileName The file name of the recording.
+ * @return The absolute file path.
+ */
+/* static */
+QString MockApiServer::recordedResponsePath(const QString &fileName)
+{
+    return QDir(QStringLiteral(MOCKAPI_DATA_DIR)).filePath(fileName);
+}
+
+void MockApiServer::incomingConnection(qintptr socketDescriptor)
+{
+    QTcpSocket *socket = new QTcpSocket(this);
+    if(!socket->setSocketDescriptor(socketDescriptor))
+    {
+        delete socket;
+        return;
+    }
+
+    ++m_connectionCount;
+
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+    connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+}
+
+void MockApiServer::readRequests(QTcpSocket *socket)
+{
+    // We only answer GET requests, so a request ends with its headers.
+    QByteArray buffer = socket->property("request").toByteArray() + socket->readAll();
+
+    int end = buffer.indexOf(RequestEnd);
+    while(end >= 0)
+    {
+        handleRequest(socket, buffer.left(end));
+
+        buffer.remove(0, end + RequestEnd.size());
+        end = buffer.indexOf(RequestEnd);
+    }
+
+    socket->setProperty("request", buffer);
+}
+
+void MockApiServer::handleRequest(QTcpSocket *socket, const QByteArray &request)
+{
+    ++m_requestCount;
+
+    const QList<QByteArray> requestLine = request.left(request.indexOf("\r\n")).split(' ');
+    m_lastRequestPath = requestLine.value(1);
+
+    switch(m_failure)
+    {
+    case Failure::CloseConnection:
+        socket->abort();
+        return;
+    case Failure::NoReply:
+        return;
+    case Failure::None:
+        break;
+    }
+
+    const QByteArray ifNoneMatch = headerValue(request, "if-none-match");
+    const bool notModified = !m_etag.isEmpty() && ifNoneMatch == '"' + m_etag + '"';
+
+    if(notModified)
+    {
+        ++m_notModifiedCount;
+    }
+
+    if(m_latency == 0)
+    {
+        sendResponse(socket, notModified);
+        return;
+    }
+
+    QTimer::singleShot(m_latency, socket, [this, socket, notModified]() { sendResponse(socket, notModified); });
+}
+
+void MockApiServer::sendResponse(QTcpSocket *socket, bool notModified)
+{
+    const int statusCode = notModified ? 304 : m_statusCode;
+    const QByteArray body = notModified ? QByteArray() : responseBody();
+
+    QByteArray response;
+    response.reserve(body.size() + 256);
+    response += "HTTP/1.1 " + QByteArray::number(statusCode) + ' ' + reasonPhrase(statusCode) + "\r\n";
+    response += "Content-Type: application/json\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+
+    if(!m_etag.isEmpty())
+    {
+        response += "ETag: \"" + m_etag + "\"\r\n";
+
+        if(m_maxAge >= 0)
+        {
+            response += "Cache-Control: max-age=" + QByteArray::number(m_maxAge) + "\r\n";
+        }
+    }
+
+    response += "\r\n";
+    response += body;
+
+    socket->write(response);
+}
+
+QByteArray MockApiServer::responseBody() const
+{
+    if(m_body.size() >= m_payloadSize)
+    {
+        return m_body;
+    }
+
+    QByteArray body = m_body;
+    body.append(m_payloadSize - m_body.size(), ' ');
+
+    return body;
+}
+
+/* static */
+QByteArray MockApiServer::headerValue(const QByteArray &request, const QByteArray &name)
+{
+    const QList<QByteArray> lines = request.split('\n');
+
+    for(const QByteArray &line : lines)
+    {
+        const int colon = line.indexOf(':');
+        if(colon > 0 && line.left(colon).trimmed().toLower() == name)
+        {
+            return line.mid(colon + 1).trimmed();
+        }
+    }
+
+    return QByteArray();
+}
+
+/* static */
+QByteArray MockApiServer::reasonPhrase(int statusCode)
+{
+    switch(statusCode)
+    {
+    case 200: return "OK";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "Unknown";
+    }
+}
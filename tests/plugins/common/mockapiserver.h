@@ -0,0 +1,82 @@
+/**
+ * @brief Defines the MockApiServer class.
+ *
+ * The MockApiServer is a tiny local HTTP server which stands in for the carbon
+ * data web APIs in tests and benchmarks. It serves recorded responses and can
+ * simulate latency, errors and large payloads.
+ *
+ * @author Dariusz Scharsig
+ *
+ * @date 19.10.2026
+ */
+#ifndef MOCKAPISERVER_H
+#define MOCKAPISERVER_H
+
+#include <QByteArray>
+#include <QTcpServer>
+#include <QUrl>
+
+class MockApiServer : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief The ways a request can fail.
+     */
+    enum class Failure
+    {
+        None,           //!< Reply with the configured response.
+        CloseConnection,//!< Close the connection without a reply.
+        NoReply         //!< Keep the connection open, but never reply.
+    };
+
+    explicit MockApiServer(QObject *parent = nullptr);
+    virtual ~MockApiServer() = default;
+
+    bool start();
+    QUrl baseUrl() const;
+
+    void setResponse(const QByteArray &body, int statusCode = 200);
+    bool setRecordedResponse(const QString &fileName, int statusCode = 200);
+    void setLatency(int milliseconds);
+    void setFailure(Failure failure);
+    void setPayloadSize(int bytes);
+    void setCacheHeaders(const QByteArray &etag, int maxAge = -1);
+
+    int requestCount() const;
+    int connectionCount() const;
+    int notModifiedCount() const;
+    QByteArray lastRequestPath() const;
+
+    static QString recordedResponsePath(const QString &fileName);
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    void readRequests(QTcpSocket *socket);
+    void handleRequest(QTcpSocket *socket, const QByteArray &request);
+    void sendResponse(QTcpSocket *socket, bool notModified);
+    QByteArray responseBody() const;
+
+    static QByteArray headerValue(const QByteArray &request, const QByteArray &name);
+    static QByteArray reasonPhrase(int statusCode);
+
+private:
+    Q_DISABLE_COPY_MOVE(MockApiServer)
+
+    QByteArray m_body;
+    int m_statusCode;
+    int m_latency;
+    int m_payloadSize;
+    Failure m_failure;
+    QByteArray m_etag;
+    int m_maxAge;
+    int m_requestCount;
+    int m_connectionCount;
+    int m_notModifiedCount;
+    QByteArray m_lastRequestPath;
+};
+
+#endif // MOCKAPISERVER_H
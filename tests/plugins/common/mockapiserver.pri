@@ -0,0 +1,11 @@
+# Local stand-in for the carbon data web APIs. Include this in a test project
+# to serve recorded API responses without network access.
+QT *= network
+
+SOURCES += $$PWD/mockapiserver.cpp
+
+HEADERS += $$PWD/mockapiserver.h
+
+INCLUDEPATH *= $$PWD
+
+DEFINES += MOCKAPI_DATA_DIR=\\\"$$PWD/data\\\"
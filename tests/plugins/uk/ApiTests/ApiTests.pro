@@ -0,0 +1,21 @@
+QT += testlib network
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase no_testcase_installs
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+# The plugin sources are built into the test, so nothing is imported.
+DEFINES += UK_LIBRARY
+
+SOURCES =  tst_apitest.cpp \
+           ../../../../plugins/uk/uk.cpp \
+           ../../../../plugins/uk/utilities.cpp
+
+HEADERS += ../../../../plugins/uk/uk.h \
+           ../../../../plugins/uk/utilities.h
+
+INCLUDEPATH *= ../../../../plugins/uk ../../../../leif/include
+
+include(../../common/mockapiserver.pri)
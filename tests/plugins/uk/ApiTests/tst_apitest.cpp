@@ -0,0 +1,430 @@
+#include <QtTest>
+#include <QNetworkAccessManager>
+
+#include "mockapiserver.h"
+#include "uk.h"
+#include "utilities.h"
+
+namespace
+{
+// Only implements the single region call, so the batch uses the default.
+class SingleRegionProvider : public IDataProvider
+{
+public:
+    CarbonData carbonPerKiloWatt(const QLocale::Country country, const QString &region) override
+    {
+        Q_UNUSED(country)
+
+        requestedRegions << region;
+        return CarbonData::ok(region.size(), -1, -1, QDateTime(), QDateTime());
+    }
+
+    using IDataProvider::carbonPerKiloWatt;
+
+    QStringList requestedRegions;
+};
+}
+
+class ApiTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ApiTest() = default;
+    virtual ~ApiTest() = default;
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void recordedResponseIsParsed();
+    void forecastIsInTimeOrder();
+    void requestPathContainsRegionAndDates();
+    void baseUrlPathIsKept();
+    void apiErrorIsReported();
+    void httpErrorIsReported();
+    void closedConnectionIsReported();
+    void slowReplyTimesOut();
+    void latencyBelowTimeoutIsFine();
+    void largePayloadIsParsed();
+    void invalidBaseUrlIsRejected();
+
+    void connectionIsReused();
+    void freshCacheEntryIsUsed();
+    void staleCacheEntryIsRevalidated();
+    void changedEntityIsRefetched();
+
+    void regionalResponseIsParsed();
+    void regionalRequestPathContainsDates();
+    void regionalApiErrorIsReported();
+    void ukBatchNeedsOneRequest();
+    void ukBatchReportsUnknownRegions();
+    void defaultBatchAsksEveryRegionOnce();
+
+    void ukUsesBaseUrl();
+    void ukBaseUrlFromEnvironment();
+    void ukEmptyBaseUrlRestoresDefault();
+
+    void benchmarkRequestCarbonData();
+    void benchmarkRequestCarbonData_data();
+
+    void httpErrorIsReported_data();
+
+private:
+    CarbonData request(int timeout = 5000);
+
+private:
+    QScopedPointer<MockApiServer> m_server;
+    QScopedPointer<QNetworkAccessManager> m_network;
+    QDateTime m_from;
+    QDateTime m_to;
+};
+
+void ApiTest::initTestCase()
+{
+    m_from = QDateTime(QDate(2022, 9, 21), QTime(10, 0), Qt::UTC);
+    m_to = m_from.addSecs(90 * 60);
+}
+
+void ApiTest::init()
+{
+    m_server.reset(new MockApiServer());
+    QVERIFY(m_server->start());
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("regional_intensity_london.json")));
+
+    // A fresh manager per test, so no connection is reused across tests.
+    m_network.reset(new QNetworkAccessManager());
+}
+
+void ApiTest::recordedResponseIsParsed()
+{
+    const CarbonData data = request();
+
+    QVERIFY2(data.isValid, qPrintable(data.errorString));
+    QVERIFY(QList<int>({152, 147, 139}).contains(data.co2PerkWhNow));
+    QVERIFY(data.validFrom.isValid());
+    QVERIFY(data.validTo.isValid());
+    QCOMPARE(m_server->requestCount(), 1);
+}
+
+void ApiTest::forecastIsInTimeOrder()
+{
+    const CarbonData data = request();
+
+    QVERIFY2(data.isValid, qPrintable(data.errorString));
+    QCOMPARE(data.forecast.mid(0, 3), QList<int>({152, 147, 139}));
+    QCOMPARE(data.forecastIntervalInSeconds, 1800);
+    QCOMPARE(data.co2PerkWhNow, 152);
+    QCOMPARE(data.co2PerkWhNext, 147);
+    QCOMPARE(data.co2PerkWhLater, 139);
+    QCOMPARE(data.validFrom, QDateTime(QDate(2022, 9, 21), QTime(10, 0), Qt::UTC));
+}
+
+void ApiTest::requestPathContainsRegionAndDates()
+{
+    request();
+
+    QCOMPARE(m_server->lastRequestPath(),
+             QByteArray("/regional/intensity/2022-09-21T10:00Z/2022-09-21T11:30Z/regionid/13"));
+}
+
+void ApiTest::baseUrlPathIsKept()
+{
+    QUrl baseUrl = m_server->baseUrl();
+    baseUrl.setPath(QStringLiteral("/proxy/"));
+
+    Utilities::requestCarbonData(m_network.get(), baseUrl, 13, m_from, m_to);
+
+    QVERIFY(m_server->lastRequestPath().startsWith("/proxy/regional/intensity/"));
+}
+
+void ApiTest::apiErrorIsReported()
+{
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("api_error.json")));
+
+    const CarbonData data = request();
+
+    QVERIFY(!data.isValid);
+    QVERIFY(data.errorString.contains(QStringLiteral("400 Bad Request")));
+}
+
+void ApiTest::httpErrorIsReported()
+{
+    QFETCH(int, statusCode);
+
+    m_server->setResponse(QByteArray("{}"), statusCode);
+
+    const CarbonData data = request();
+
+    QVERIFY(!data.isValid);
+    QVERIFY(data.errorString.startsWith(QStringLiteral("Network request could not be processed.")));
+}
+
+void ApiTest::closedConnectionIsReported()
+{
+    m_server->setFailure(MockApiServer::Failure::CloseConnection);
+
+    const CarbonData data = request();
+
+    QVERIFY(!data.isValid);
+    QVERIFY(data.errorString.startsWith(QStringLiteral("Network request could not be processed.")));
+}
+
+void ApiTest::slowReplyTimesOut()
+{
+    m_server->setLatency(2000);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const CarbonData data = request(200);
+
+    QVERIFY(!data.isValid);
+    QCOMPARE(data.errorString, QStringLiteral("API didn't reply in time."));
+    QVERIFY(timer.elapsed() < 1500);
+}
+
+void ApiTest::latencyBelowTimeoutIsFine()
+{
+    m_server->setLatency(100);
+
+    const CarbonData data = request(2000);
+
+    QVERIFY2(data.isValid, qPrintable(data.errorString));
+}
+
+void ApiTest::largePayloadIsParsed()
+{
+    m_server->setPayloadSize(4 * 1024 * 1024);
+
+    const CarbonData data = request();
+
+    QVERIFY2(data.isValid, qPrintable(data.errorString));
+}
+
+void ApiTest::invalidBaseUrlIsRejected()
+{
+    const CarbonData data = Utilities::requestCarbonData(m_network.get(), QUrl(), 13, m_from, m_to);
+
+    QVERIFY(!data.isValid);
+    QCOMPARE(m_server->requestCount(), 0);
+}
+
+void ApiTest::connectionIsReused()
+{
+    QVERIFY(request().isValid);
+    QVERIFY(request().isValid);
+
+    QCOMPARE(m_server->requestCount(), 2);
+    QCOMPARE(m_server->connectionCount(), 1);
+}
+
+void ApiTest::freshCacheEntryIsUsed()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    m_network.reset(Utilities::createNetworkAccessManager(cacheDir.path()));
+
+    m_server->setCacheHeaders("v1", 600);
+
+    const CarbonData first = request();
+    const CarbonData second = request();
+
+    QVERIFY2(first.isValid, qPrintable(first.errorString));
+    QVERIFY2(second.isValid, qPrintable(second.errorString));
+    QCOMPARE(second.co2PerkWhNow, first.co2PerkWhNow);
+    QCOMPARE(m_server->requestCount(), 1);
+}
+
+void ApiTest::staleCacheEntryIsRevalidated()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    m_network.reset(Utilities::createNetworkAccessManager(cacheDir.path()));
+
+    m_server->setCacheHeaders("v1", 0);
+
+    const CarbonData first = request();
+    const CarbonData second = request();
+
+    QVERIFY2(first.isValid, qPrintable(first.errorString));
+    QVERIFY2(second.isValid, qPrintable(second.errorString));
+    QCOMPARE(second.co2PerkWhNow, first.co2PerkWhNow);
+    QCOMPARE(m_server->requestCount(), 2);
+    QCOMPARE(m_server->notModifiedCount(), 1);
+}
+
+void ApiTest::changedEntityIsRefetched()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    m_network.reset(Utilities::createNetworkAccessManager(cacheDir.path()));
+
+    m_server->setCacheHeaders("v1", 0);
+    QVERIFY(request().isValid);
+
+    m_server->setCacheHeaders("v2", 0);
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("api_error.json")));
+
+    const CarbonData data = request();
+
+    QVERIFY(!data.isValid);
+    QCOMPARE(m_server->notModifiedCount(), 0);
+}
+
+void ApiTest::regionalResponseIsParsed()
+{
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("regional_intensity_all.json")));
+
+    QString errorString;
+    const QHash<int, CarbonData> data = Utilities::requestRegionalCarbonData(m_network.get(), m_server->baseUrl(),
+                                                                              m_from, m_to, errorString);
+
+    QVERIFY2(!data.isEmpty(), qPrintable(errorString));
+    QCOMPARE(data.count(), 17);
+
+    const CarbonData london = data.value(13);
+    QVERIFY(london.isValid);
+    QCOMPARE(london.co2PerkWhNow, 152);
+    QCOMPARE(london.co2PerkWhNext, 147);
+    QCOMPARE(london.co2PerkWhLater, 139);
+    QVERIFY(london.validFrom.isValid());
+    QVERIFY(london.validTo.isValid());
+    QCOMPARE(m_server->requestCount(), 1);
+}
+
+void ApiTest::regionalRequestPathContainsDates()
+{
+    QString errorString;
+    Utilities::requestRegionalCarbonData(m_network.get(), m_server->baseUrl(), m_from, m_to, errorString);
+
+    QCOMPARE(m_server->lastRequestPath(), QByteArray("/regional/intensity/2022-09-21T10:00Z/2022-09-21T11:30Z"));
+}
+
+void ApiTest::regionalApiErrorIsReported()
+{
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("api_error.json")));
+
+    QString errorString;
+    const QHash<int, CarbonData> data = Utilities::requestRegionalCarbonData(m_network.get(), m_server->baseUrl(),
+                                                                              m_from, m_to, errorString);
+
+    QVERIFY(data.isEmpty());
+    QVERIFY(errorString.contains(QStringLiteral("400 Bad Request")));
+}
+
+void ApiTest::ukBatchNeedsOneRequest()
+{
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("regional_intensity_all.json")));
+
+    Uk uk;
+    uk.setBaseUrl(m_server->baseUrl());
+
+    const QStringList regions {QStringLiteral("London"), QStringLiteral("Wales"), QStringLiteral("North Scotland")};
+    const QHash<QString, CarbonData> data = uk.carbonPerKiloWatt(QLocale::UnitedKingdom, regions, m_from, m_to);
+
+    QCOMPARE(data.count(), 3);
+    QCOMPARE(data.value(QStringLiteral("London")).co2PerkWhNow, 152);
+    QVERIFY(data.value(QStringLiteral("Wales")).isValid);
+    QVERIFY(data.value(QStringLiteral("North Scotland")).isValid);
+    QCOMPARE(m_server->requestCount(), 1);
+}
+
+void ApiTest::ukBatchReportsUnknownRegions()
+{
+    QVERIFY(m_server->setRecordedResponse(QStringLiteral("regional_intensity_all.json")));
+
+    Uk uk;
+    uk.setBaseUrl(m_server->baseUrl());
+
+    const QStringList regions {QStringLiteral("London"), QStringLiteral("Atlantis")};
+    const QHash<QString, CarbonData> data = uk.carbonPerKiloWatt(QLocale::UnitedKingdom, regions, m_from, m_to);
+
+    QVERIFY(data.value(QStringLiteral("London")).isValid);
+    QVERIFY(!data.value(QStringLiteral("Atlantis")).isValid);
+    QVERIFY(data.value(QStringLiteral("Atlantis")).errorString.contains(QStringLiteral("unknown")));
+}
+
+void ApiTest::defaultBatchAsksEveryRegionOnce()
+{
+    SingleRegionProvider provider;
+
+    const QStringList regions {QStringLiteral("a"), QStringLiteral("bb"), QStringLiteral("a")};
+    const QHash<QString, CarbonData> data = provider.carbonPerKiloWatt(QLocale::Germany, regions, m_from, m_to);
+
+    QCOMPARE(data.count(), 2);
+    QCOMPARE(data.value(QStringLiteral("bb")).co2PerkWhNow, 2);
+    QCOMPARE(provider.requestedRegions, QStringList({QStringLiteral("a"), QStringLiteral("bb")}));
+}
+
+void ApiTest::ukUsesBaseUrl()
+{
+    Uk uk;
+    uk.setBaseUrl(m_server->baseUrl());
+
+    const CarbonData data = uk.carbonPerKiloWatt(QLocale::UnitedKingdom, QStringLiteral("London"));
+
+    QVERIFY2(data.isValid, qPrintable(data.errorString));
+    QCOMPARE(m_server->requestCount(), 1);
+    QVERIFY(m_server->lastRequestPath().endsWith("/regionid/13"));
+}
+
+void ApiTest::ukBaseUrlFromEnvironment()
+{
+    qputenv("LEIF_UK_API_URL", m_server->baseUrl().toString().toUtf8());
+    auto cleanup = qScopeGuard([]() { qunsetenv("LEIF_UK_API_URL"); });
+
+    Uk uk;
+
+    QCOMPARE(uk.baseUrl(), m_server->baseUrl());
+}
+
+void ApiTest::ukEmptyBaseUrlRestoresDefault()
+{
+    Uk uk;
+    uk.setBaseUrl(m_server->baseUrl());
+    uk.setBaseUrl(QUrl());
+
+    QCOMPARE(uk.baseUrl(), Utilities::defaultBaseUrl());
+}
+
+void ApiTest::benchmarkRequestCarbonData()
+{
+    QFETCH(int, payloadSize);
+
+    m_server->setPayloadSize(payloadSize);
+
+    QBENCHMARK {
+        const CarbonData data = request();
+        QVERIFY(data.isValid);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ApiTest::benchmarkRequestCarbonData_data()
+{
+    QTest::addColumn<int>("payloadSize");
+
+    QTest::addRow("recorded") << 0;
+    QTest::addRow("64KiB") << 64 * 1024;
+    QTest::addRow("1MiB") << 1024 * 1024;
+}
+
+void ApiTest::httpErrorIsReported_data()
+{
+    QTest::addColumn<int>("statusCode");
+
+    QTest::addRow("404") << 404;
+    QTest::addRow("429") << 429;
+    QTest::addRow("500") << 500;
+    QTest::addRow("503") << 503;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CarbonData ApiTest::request(int timeout /* = 5000 */)
+{
+    return Utilities::requestCarbonData(m_network.get(), m_server->baseUrl(), 13, m_from, m_to, timeout);
+}
+
+QTEST_MAIN(ApiTest)
+#include "tst_apitest.moc"
@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS = UtilitiesTests
+SUBDIRS = UtilitiesTests ApiTests
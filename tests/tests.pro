@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS = plugins leif
+SUBDIRS = plugins leif benchmarks